@@ -0,0 +1,319 @@
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
+#include "Benchmark.h"
+
+using namespace irr;
+
+namespace
+{
+
+//! Fields shared by the local and the central directory header
+void appendHeaderFields(core::array<u8>& data, bool store, u32 crc,
+	u32 compressedSize, u32 size, u32 nameLength)
+{
+	appendLE16(data, 20); // version needed to extract
+	appendLE16(data, 0); // flags
+	appendLE16(data, store ? 0 : 8);
+	appendLE16(data, 0); // time
+	appendLE16(data, 0x21); // date, 1980-01-01
+	appendLE32(data, crc);
+	appendLE32(data, compressedSize);
+	appendLE32(data, size);
+	appendLE16(data, nameLength);
+	appendLE16(data, 0); // extra field length
+}
+
+//! Deflate without zlib header, as stored in zip files
+bool deflateRaw(const core::array<u8>& in, core::array<u8>& out, u32& outSize)
+{
+	z_stream stream;
+	memset(&stream, 0, sizeof(z_stream));
+	if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return false;
+
+	stream.next_in = (Bytef*)in.const_pointer();
+	stream.avail_in = in.size();
+	stream.next_out = out.pointer();
+	stream.avail_out = out.size();
+
+	const s32 err = deflate(&stream, Z_FINISH);
+	outSize = stream.total_out;
+	deflateEnd(&stream);
+	return err == Z_STREAM_END;
+}
+
+//! Builds a zip archive with seeded content for the given file names
+/** \param storeEvery Every n-th file is stored instead of deflated, 1 stores
+all files and 0 none. */
+bool createZip(SBenchmarkContext& ctx, const core::array<io::path>& names,
+	u32 fileSize, u32 storeEvery, core::array<u8>& zip)
+{
+	core::array<u8> central;
+	core::array<u8> content(fileSize);
+	core::array<u8> compressed;
+	compressed.set_used(compressBound(fileSize));
+
+	zip.clear();
+	for (u32 i=0; i<names.size(); ++i)
+	{
+		// compressible content: runs of random length from a small alphabet
+		content.set_used(0);
+		while (content.size() < fileSize)
+		{
+			const u8 value = (u8)('a' + ctx.Random->rand() % 16);
+			u32 run = 1 + ctx.Random->rand() % 12;
+			while (run-- && content.size() < fileSize)
+				content.push_back(value);
+		}
+
+		const bool store = storeEvery && (i % storeEvery) == storeEvery - 1;
+		u32 compressedSize = fileSize;
+		if (!store && !deflateRaw(content, compressed, compressedSize))
+			return false;
+
+		const u32 crc = crc32(0, content.const_pointer(), fileSize);
+		const u32 offset = zip.size();
+		const core::stringc name(names[i]);
+
+		appendLE32(zip, 0x04034b50);
+		appendHeaderFields(zip, store, crc, compressedSize, fileSize, name.size());
+		appendBytes(zip, name.c_str(), name.size());
+		appendBytes(zip, store ? content.const_pointer() : compressed.const_pointer(), compressedSize);
+
+		appendLE32(central, 0x02014b50);
+		appendLE16(central, 20);
+		appendHeaderFields(central, store, crc, compressedSize, fileSize, name.size());
+		appendLE16(central, 0); // comment length
+		appendLE16(central, 0); // disk number
+		appendLE16(central, 0); // internal attributes
+		appendLE32(central, 0); // external attributes
+		appendLE32(central, offset);
+		appendBytes(central, name.c_str(), name.size());
+	}
+
+	const u32 centralOffset = zip.size();
+	appendBytes(zip, central.const_pointer(), central.size());
+
+	appendLE32(zip, 0x06054b50);
+	appendLE16(zip, 0);
+	appendLE16(zip, 0);
+	appendLE16(zip, names.size());
+	appendLE16(zip, names.size());
+	appendLE32(zip, central.size());
+	appendLE32(zip, centralOffset);
+	appendLE16(zip, 0);
+	return true;
+}
+
+//! Mounts a zip archive kept in memory
+bool mountZip(SBenchmarkContext& ctx, const core::array<u8>& zip,
+	const io::path& name, io::IFileArchive** archive)
+{
+	// the memory file owns the data and is kept alive by the archive
+	u8* data = new u8[zip.size()];
+	memcpy(data, zip.const_pointer(), zip.size());
+
+	io::IFileSystem* fs = ctx.Device->getFileSystem();
+	io::IReadFile* file = fs->createMemoryReadFile(data, zip.size(), name, true);
+	const bool added = fs->addFileArchive(file, true, false, io::EFAT_ZIP, "", archive);
+	file->drop();
+	return added;
+}
+
+//! Reads every file of a generated zip archive, once per iteration
+class CArchiveZipReadBenchmark : public IBenchmark
+{
+public:
+
+	CArchiveZipReadBenchmark() : IBenchmark("archive.zip.read"), Archive(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		const u32 fileCount = 64 * ctx.Scale;
+		const u32 fileSize = 64 * 1024;
+
+		Names.clear();
+		for (u32 i=0; i<fileCount; ++i)
+		{
+			c8 name[64];
+			snprintf(name, sizeof(name), "data/file%04u.bin", i);
+			Names.push_back(name);
+		}
+
+		// every fourth file is stored to also cover the uncompressed path
+		core::array<u8> zip;
+		if (!createZip(ctx, Names, fileSize, 4, zip))
+			return false;
+
+		Buffer.set_used(fileSize);
+		return mountZip(ctx, zip, "benchmark.zip", &Archive);
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		io::IFileSystem* fs = ctx.Device->getFileSystem();
+
+		u32 bytes = 0;
+		for (u32 i=0; i<Names.size(); ++i)
+		{
+			io::IReadFile* file = fs->createAndOpenFile(Names[i]);
+			if (!file)
+				continue;
+			bytes += (u32)file->read(Buffer.pointer(), Buffer.size());
+			file->drop();
+		}
+		return bytes;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		if (Archive)
+			ctx.Device->getFileSystem()->removeFileArchive(Archive);
+		Archive = 0;
+		Names.clear();
+		Buffer.clear();
+	}
+
+private:
+
+	io::IFileArchive* Archive;
+	core::array<io::path> Names;
+	core::array<u8> Buffer;
+};
+
+//! Reads a large deflated file in chunks, as a streaming loader would
+class CArchiveZipLargeBenchmark : public IBenchmark
+{
+public:
+
+	CArchiveZipLargeBenchmark() : IBenchmark("archive.zip.large"), Archive(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		core::array<io::path> names;
+		names.push_back("data/large.bin");
+
+		core::array<u8> zip;
+		if (!createZip(ctx, names, 16 * 1024 * 1024 * ctx.Scale, 0, zip))
+			return false;
+
+		Buffer.set_used(64 * 1024);
+		return mountZip(ctx, zip, "large.zip", &Archive);
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		io::IReadFile* file = ctx.Device->getFileSystem()->createAndOpenFile("data/large.bin");
+		if (!file)
+			return 0;
+
+		u32 bytes = 0;
+		size_t r;
+		while ((r = file->read(Buffer.pointer(), Buffer.size())) != 0)
+			bytes += (u32)r;
+
+		file->drop();
+		return bytes;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		if (Archive)
+			ctx.Device->getFileSystem()->removeFileArchive(Archive);
+		Archive = 0;
+		Buffer.clear();
+	}
+
+private:
+
+	io::IFileArchive* Archive;
+	core::array<u8> Buffer;
+};
+
+//! Opens small files spread over many mounted archives
+class CArchiveLookupBenchmark : public IBenchmark
+{
+public:
+
+	CArchiveLookupBenchmark() : IBenchmark("archive.lookup") {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		const u32 archiveCount = 48;
+		const u32 filesPerArchive = 64 * ctx.Scale;
+
+		Names.clear();
+		for (u32 a=0; a<archiveCount; ++a)
+		{
+			core::array<io::path> names(filesPerArchive);
+			for (u32 i=0; i<filesPerArchive; ++i)
+			{
+				c8 name[64];
+				snprintf(name, sizeof(name), "pack%02u/Textures/Asset%04u.dat", a, i);
+				names.push_back(name);
+			}
+
+			// small stored files, so the lookup dominates
+			core::array<u8> zip;
+			if (!createZip(ctx, names, 256, 1, zip))
+				return false;
+
+			c8 zipName[64];
+			snprintf(zipName, sizeof(zipName), "pack%02u.zip", a);
+			io::IFileArchive* archive = 0;
+			if (!mountZip(ctx, zip, zipName, &archive))
+				return false;
+			Archives.push_back(archive);
+
+			// searched in a different case than stored
+			for (u32 i=0; i<names.size(); ++i)
+				Names.push_back(names[i].make_lower());
+		}
+
+		// seeded shuffle, so consecutive lookups go to different archives
+		for (u32 i=Names.size()-1; i>0; --i)
+		{
+			const u32 j = (u32)ctx.Random->rand() % (i+1);
+			io::path t = Names[i];
+			Names[i] = Names[j];
+			Names[j] = t;
+		}
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		io::IFileSystem* fs = ctx.Device->getFileSystem();
+
+		u32 opened = 0;
+		for (u32 i=0; i<Names.size(); ++i)
+		{
+			io::IReadFile* file = fs->createAndOpenFile(Names[i]);
+			if (!file)
+				continue;
+			++opened;
+			file->drop();
+		}
+		return opened;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		for (u32 i=0; i<Archives.size(); ++i)
+			ctx.Device->getFileSystem()->removeFileArchive(Archives[i]);
+		Archives.clear();
+		Names.clear();
+	}
+
+private:
+
+	core::array<io::IFileArchive*> Archives;
+	core::array<io::path> Names;
+};
+
+CArchiveZipReadBenchmark archiveZipRead;
+CArchiveZipLargeBenchmark archiveZipLarge;
+CArchiveLookupBenchmark archiveLookup;
+
+} // end anonymous namespace
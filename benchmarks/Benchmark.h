@@ -0,0 +1,107 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __IRR_BENCHMARK_H_INCLUDED__
+#define __IRR_BENCHMARK_H_INCLUDED__
+
+#include <irrlicht.h>
+
+namespace irr
+{
+
+//! State shared by all benchmarks of one run
+struct SBenchmarkContext
+{
+	SBenchmarkContext() : Device(0), Random(0), Seed(0), Scale(1) {}
+
+	IrrlichtDevice* Device;
+
+	//! Reset to Seed before each benchmark's setUp()
+	IRandomizer* Random;
+
+	//! Directory containing the example media
+	io::path MediaPath;
+
+	s32 Seed;
+
+	//! Multiplier for the workload sizes, 1 is the default size
+	u32 Scale;
+};
+
+//! A repeatable workload measured by the benchmark runner
+/** Instances register themselves on construction, so a benchmark is added
+by defining a static instance of it in any source file of the target. */
+class IBenchmark
+{
+public:
+
+	IBenchmark(const c8* name) : Name(name), Next(First)
+	{
+		First = this;
+	}
+
+	virtual ~IBenchmark() {}
+
+	//! Creates the data for the workload, not timed
+	/** \return false if the workload can't run, it's skipped then. */
+	virtual bool setUp(SBenchmarkContext& ctx) { return true; }
+
+	//! Runs one timed iteration
+	/** \return Number of items processed, e.g. nodes, rays or bytes. */
+	virtual u32 run(SBenchmarkContext& ctx) = 0;
+
+	//! Verifies the results of the workload after the timed iterations, not timed
+	/** \return false if the results are wrong, the run fails then. */
+	virtual bool check(SBenchmarkContext& ctx) { return true; }
+
+	//! Releases everything created by setUp(), not timed
+	virtual void tearDown(SBenchmarkContext& ctx) {}
+
+	//! Name in the form group.workload, used for filtering and the report
+	const c8* getName() const { return Name; }
+
+	//! Returns the next registered benchmark
+	IBenchmark* getNext() const { return Next; }
+
+	//! Returns the first registered benchmark
+	static IBenchmark* getFirst() { return First; }
+
+private:
+
+	const c8* Name;
+	IBenchmark* Next;
+
+	static IBenchmark* First;
+};
+
+//! Returns a random value between low and high
+inline f32 randomRange(IRandomizer* random, f32 low, f32 high)
+{
+	return low + random->frand() * (high - low);
+}
+
+//! Appends a little endian 16 bit value, used to build file formats in memory
+inline void appendLE16(core::array<u8>& data, u32 value)
+{
+	data.push_back((u8)(value & 0xff));
+	data.push_back((u8)((value >> 8) & 0xff));
+}
+
+//! Appends a little endian 32 bit value
+inline void appendLE32(core::array<u8>& data, u32 value)
+{
+	appendLE16(data, value & 0xffff);
+	appendLE16(data, value >> 16);
+}
+
+//! Appends raw bytes
+inline void appendBytes(core::array<u8>& data, const void* bytes, u32 size)
+{
+	const u8* p = (const u8*)bytes;
+	for (u32 i=0; i<size; ++i)
+		data.push_back(p[i]);
+}
+
+} // end namespace irr
+
+#endif
@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include "Benchmark.h"
+
+using namespace irr;
+
+namespace
+{
+
+//! Heap allocations made through CCountingAllocator
+u32 AllocationCount = 0;
+
+//! Allocator which counts the allocations of the containers using it
+template <typename T>
+class CCountingAllocator : public core::irrAllocator<T>
+{
+protected:
+
+	virtual void* internal_new(size_t cnt)
+	{
+		++AllocationCount;
+		return core::irrAllocator<T>::internal_new(cnt);
+	}
+};
+
+typedef core::string<c8, CCountingAllocator<c8> > CountedString;
+typedef core::array<CountedString, CCountingAllocator<CountedString> > CountedStringArray;
+
+//! Grows, fills and thins out an array of strings
+/** run() returns the number of heap allocations instead of processed items,
+so the report compares allocation counts between builds. */
+class CCoreArrayStringsBenchmark : public IBenchmark
+{
+public:
+
+	CCoreArrayStringsBenchmark(const c8* name, const c8* prefix)
+		: IBenchmark(name), Prefix(prefix) {}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		const u32 count = 20000 * ctx.Scale;
+		AllocationCount = 0;
+
+		CountedStringArray names;
+		for (u32 i=0; i<count; ++i)
+		{
+			c8 name[64];
+			snprintf(name, sizeof(name), "%s%u", Prefix, i);
+			names.push_back(CountedString(name));
+		}
+
+		// some in the middle, as done when editing lists
+		for (u32 i=0; i<64; ++i)
+			names.insert(CountedString(Prefix), names.size() / 2);
+		for (u32 i=0; i<64; ++i)
+			names.erase(names.size() / 3);
+
+		names.sort();
+		return AllocationCount;
+	}
+
+private:
+
+	const c8* Prefix;
+};
+
+//! Short strings as used for names, numbers and concatenation
+/** run() returns the number of heap allocations. */
+class CCoreStringShortBenchmark : public IBenchmark
+{
+public:
+
+	CCoreStringShortBenchmark() : IBenchmark("core.string.short") {}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		const u32 count = 50000 * ctx.Scale;
+		AllocationCount = 0;
+
+		u32 length = 0;
+		for (u32 i=0; i<count; ++i)
+		{
+			CountedString empty;
+			CountedString number(i);
+			CountedString name = CountedString("id") + number;
+			name.make_upper();
+			length += empty.size() + name.size();
+		}
+
+		// keeps the loop from being optimized away
+		return length ? AllocationCount : 0;
+	}
+};
+
+//! Growth of an array of materials, which aren't trivially copyable
+class CCoreArrayMaterialsBenchmark : public IBenchmark
+{
+public:
+
+	CCoreArrayMaterialsBenchmark() : IBenchmark("core.array.materials") {}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		const u32 count = 20000 * ctx.Scale;
+
+		core::array<video::SMaterial> materials;
+		video::SMaterial material;
+		for (u32 i=0; i<count; ++i)
+		{
+			material.Shininess = (f32)i;
+			materials.push_back(material);
+		}
+
+		for (u32 i=0; i<16; ++i)
+			materials.erase(0);
+
+		return materials.size();
+	}
+};
+
+//! Mesh buffer addresses as used by the hardware buffer links
+void createKey(u32 i, const u8* objects, const void*& key)
+{
+	key = objects + i * 32;
+}
+
+//! File names as used by the caches
+void createKey(u32 i, const u8* objects, core::stringc& key)
+{
+	c8 name[64];
+	snprintf(name, sizeof(name), "media/models/node_%u.obj", i);
+	key = name;
+}
+
+//! Lookups in an associative container, as done for buffer links and names
+/** The keys are inserted once, then looked up repeatedly and half of them is
+removed again. TMap is core::map or core::hash_map. */
+template <class TMap, class TKey>
+class CCoreMapBenchmark : public IBenchmark
+{
+public:
+
+	CCoreMapBenchmark(const c8* name) : IBenchmark(name) {}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		const u32 count = 4096;
+		const u32 lookups = 200000 * ctx.Scale;
+
+		core::array<TKey> keys(count);
+		for (u32 i=0; i<count; ++i)
+		{
+			TKey key;
+			createKey(i, Objects, key);
+			keys.push_back(key);
+		}
+
+		TMap map;
+		for (u32 i=0; i<count; ++i)
+			map.insert(keys[i], i);
+
+		// lcg walk over the keys, so the order doesn't follow the insertion
+		u32 found = 0;
+		u32 k = 1;
+		for (u32 i=0; i<lookups; ++i)
+		{
+			k = k * 1664525 + 1013904223;
+			if (map.find(keys[(k >> 8) % count]))
+				++found;
+		}
+
+		for (u32 i=0; i<count; i+=2)
+			map.remove(keys[i]);
+
+		return map.size() ? found : 0;
+	}
+
+private:
+
+	u8 Objects[4096 * 32];
+};
+
+CCoreArrayStringsBenchmark coreArrayStringsShort("core.array.strings.short", "node");
+CCoreArrayStringsBenchmark coreArrayStringsLong("core.array.strings.long", "media/textures/terrain/detail_");
+CCoreStringShortBenchmark coreStringShort;
+CCoreArrayMaterialsBenchmark coreArrayMaterials;
+CCoreMapBenchmark<core::map<const void*, u32>, const void*> coreMapPointers("core.map.pointers");
+CCoreMapBenchmark<core::hash_map<const void*, u32>, const void*> coreHashMapPointers("core.hash_map.pointers");
+CCoreMapBenchmark<core::map<core::stringc, u32>, core::stringc> coreMapStrings("core.map.strings");
+CCoreMapBenchmark<core::hash_map<core::stringc, u32>, core::stringc> coreHashMapStrings("core.hash_map.strings");
+
+} // end anonymous namespace
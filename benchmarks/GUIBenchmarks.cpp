@@ -0,0 +1,239 @@
+#include "Benchmark.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace irr;
+
+namespace
+{
+
+//! Number of heap allocations of the whole process
+/** irrAllocator and everything else in the engine allocate through the
+global operator new, which is replaced below to count them. */
+std::atomic<u32> HeapAllocations(0);
+
+} // end anonymous namespace
+
+void* operator new(size_t size)
+{
+	++HeapAllocations;
+	void* p = malloc(size ? size : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+namespace
+{
+
+//! Builds seeded text of the given length, with paragraphs of random words
+core::stringw createText(SBenchmarkContext& ctx, u32 length)
+{
+	const wchar_t* words[] = {
+		L"irrlicht", L"engine", L"scene", L"node", L"mesh", L"buffer", L"vertex",
+		L"a", L"of", L"the", L"and", L"texture", L"material", L"animator",
+		L"collision", L"gui", L"element", L"skin", L"font", L"driver" };
+	const u32 wordCount = sizeof(words) / sizeof(words[0]);
+
+	core::stringw text;
+	text.reserve(length + 16);
+	while (text.size() < length)
+	{
+		text += words[ctx.Random->rand() % wordCount];
+		text += (ctx.Random->rand() % 24) ? L" " : L"\n";
+	}
+	return text;
+}
+
+//! Word wrapping and drawing of long multi-line text
+class CGUITextLayoutBenchmark : public IBenchmark
+{
+public:
+
+	CGUITextLayoutBenchmark() : IBenchmark("gui.text.layout"), EditBox(0), StaticText(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		gui::IGUIEnvironment* env = ctx.Device->getGUIEnvironment();
+
+		Text = createText(ctx, 20000 * ctx.Scale);
+
+		EditBox = env->addEditBox(L"", core::rect<s32>(10, 10, 410, 310));
+		EditBox->setMultiLine(true);
+		EditBox->setWordWrap(true);
+		EditBox->setAutoScroll(true);
+
+		StaticText = env->addStaticText(L"", core::rect<s32>(420, 10, 820, 310), false, true);
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		// both elements break the whole text again on setText
+		EditBox->setText(Text.c_str());
+		StaticText->setText(Text.c_str());
+		ctx.Device->getGUIEnvironment()->drawAll();
+		return Text.size() * 2;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		ctx.Device->getGUIEnvironment()->clear();
+		EditBox = 0;
+		StaticText = 0;
+		Text = L"";
+	}
+
+private:
+
+	core::stringw Text;
+	gui::IGUIEditBox* EditBox;
+	gui::IGUIStaticText* StaticText;
+};
+
+//! Typing into a long word wrapped edit box
+class CGUITextEditBenchmark : public IBenchmark
+{
+public:
+
+	CGUITextEditBenchmark() : IBenchmark("gui.text.edit"), EditBox(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		gui::IGUIEnvironment* env = ctx.Device->getGUIEnvironment();
+
+		Text = createText(ctx, 20000 * ctx.Scale);
+
+		EditBox = env->addEditBox(L"", core::rect<s32>(10, 10, 410, 310));
+		EditBox->setMultiLine(true);
+		EditBox->setWordWrap(true);
+		EditBox->setAutoScroll(true);
+		EditBox->setText(Text.c_str());
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		const u32 keyCount = 64;
+
+		SEvent event;
+		event.EventType = EET_KEY_INPUT_EVENT;
+		event.KeyInput.PressedDown = true;
+		event.KeyInput.SystemKeyCode = 0;
+		event.KeyInput.Shift = false;
+
+		// ctrl+home puts the cursor in front of the first paragraph
+		event.KeyInput.Key = KEY_HOME;
+		event.KeyInput.Char = 0;
+		event.KeyInput.Control = true;
+		EditBox->OnEvent(event);
+
+		event.KeyInput.Control = false;
+		for (u32 i=0; i<keyCount; ++i)
+		{
+			if (i % 2)
+			{
+				event.KeyInput.Key = KEY_BACK;
+				event.KeyInput.Char = 0;
+			}
+			else
+			{
+				event.KeyInput.Key = KEY_KEY_X;
+				event.KeyInput.Char = L'x';
+			}
+			EditBox->OnEvent(event);
+		}
+
+		ctx.Device->getGUIEnvironment()->drawAll();
+		return keyCount;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		ctx.Device->getGUIEnvironment()->clear();
+		EditBox = 0;
+		Text = L"";
+	}
+
+private:
+
+	core::stringw Text;
+	gui::IGUIEditBox* EditBox;
+};
+
+//! Frames of short labels drawn with the built-in font
+/** Each label draws through the sprite bank, whose scratch arrays come from
+the driver's frame arena. */
+class CGUIFontDrawBenchmark : public IBenchmark
+{
+public:
+
+	CGUIFontDrawBenchmark() : IBenchmark("gui.font.draw") {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		Label = L"node 1234: position 10.5, 20.25, 30.125";
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		return drawFrames(ctx, 20 * ctx.Scale);
+	}
+
+	//! Frames after the first ones must not allocate heap memory
+	virtual bool check(SBenchmarkContext& ctx)
+	{
+		// the arena has grown to the size of a frame during the timed runs
+		drawFrames(ctx, 2);
+
+		const u32 allocations = HeapAllocations;
+		drawFrames(ctx, 10);
+		const u32 frameAllocations = HeapAllocations - allocations;
+
+		if (frameAllocations)
+		{
+			fprintf(stderr, "  %u heap allocations in 10 frames\n", frameAllocations);
+			return false;
+		}
+		return true;
+	}
+
+private:
+
+	u32 drawFrames(SBenchmarkContext& ctx, u32 frameCount)
+	{
+		const u32 labelCount = 200;
+
+		video::IVideoDriver* driver = ctx.Device->getVideoDriver();
+		gui::IGUIFont* font = ctx.Device->getGUIEnvironment()->getBuiltInFont();
+
+		u32 characters = 0;
+		for (u32 frame=0; frame<frameCount; ++frame)
+		{
+			driver->beginScene(video::ECBF_NONE);
+			for (u32 i=0; i<labelCount; ++i)
+			{
+				const s32 y = (s32)(i % 40) * 12;
+				font->draw(Label, core::rect<s32>(10, y, 400, y + 12), video::SColor(255, 255, 255, 255));
+				characters += Label.size();
+			}
+			driver->endScene();
+		}
+		return characters;
+	}
+
+	core::stringw Label;
+};
+
+CGUITextLayoutBenchmark guiTextLayout;
+CGUITextEditBenchmark guiTextEdit;
+CGUIFontDrawBenchmark guiFontDraw;
+
+} // end anonymous namespace
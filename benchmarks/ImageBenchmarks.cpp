@@ -0,0 +1,823 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "Benchmark.h"
+
+using namespace irr;
+
+namespace
+{
+
+//! Side length of the generated test images
+const u32 IMAGE_SIZE = 512;
+
+//! Creates a gradient with noise, so compressed formats have realistic ratios
+video::IImage* createTestImage(SBenchmarkContext& ctx, u32 size)
+{
+	video::IImage* image = ctx.Device->getVideoDriver()->createImage(
+		video::ECF_A8R8G8B8, core::dimension2du(size, size));
+	if (!image)
+		return 0;
+
+	u32* pixels = (u32*)image->getData();
+	for (u32 y=0; y<size; ++y)
+	{
+		for (u32 x=0; x<size; ++x)
+		{
+			const u32 noise = (u32)ctx.Random->rand() & 0x1f;
+			const u32 r = core::min_(255u, x * 255 / size + noise);
+			const u32 g = core::min_(255u, y * 255 / size + noise);
+			const u32 b = core::min_(255u, ((x ^ y) & 0xff) / 2 + noise);
+			pixels[y * size + x] = video::SColor(255, r, g, b).color;
+		}
+	}
+	return image;
+}
+
+//! Decodes an image file kept in memory, once per iteration
+class CImageDecodeBenchmark : public IBenchmark
+{
+public:
+
+	CImageDecodeBenchmark(const c8* name, const c8* fileName)
+		: IBenchmark(name), FileName(fileName) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		video::IImage* image = createTestImage(ctx, IMAGE_SIZE);
+		if (!image)
+			return false;
+
+		const bool success = encode(ctx, image);
+		image->drop();
+		return success && Data.size();
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		u32 pixels = 0;
+		for (u32 i=0; i<ctx.Scale; ++i)
+		{
+			io::IReadFile* file = ctx.Device->getFileSystem()->createMemoryReadFile(
+				Data.const_pointer(), Data.size(), FileName);
+			video::IImage* image = ctx.Device->getVideoDriver()->createImageFromFile(file);
+			file->drop();
+
+			if (image)
+			{
+				pixels += image->getDimension().getArea();
+				image->drop();
+			}
+		}
+		return pixels;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		Data.clear();
+	}
+
+protected:
+
+	//! Fills Data with the encoded image
+	virtual bool encode(SBenchmarkContext& ctx, video::IImage* image)
+	{
+		// the engine's writers, selected by the file extension
+		Data.set_used(IMAGE_SIZE * IMAGE_SIZE * 4 + 4096);
+		io::IWriteFile* file = ctx.Device->getFileSystem()->createMemoryWriteFile(
+			Data.pointer(), Data.size(), FileName);
+		const bool success = ctx.Device->getVideoDriver()->writeImageToFile(image, file);
+		Data.set_used(file->getPos());
+		file->drop();
+		return success;
+	}
+
+	io::path FileName;
+	core::array<u8> Data;
+};
+
+//! Uncompressed 24 bit bmp, there is no bmp writer in the engine
+class CImageDecodeBMPBenchmark : public CImageDecodeBenchmark
+{
+public:
+
+	CImageDecodeBMPBenchmark() : CImageDecodeBenchmark("image.decode.bmp", "benchmark.bmp") {}
+
+protected:
+
+	virtual bool encode(SBenchmarkContext& ctx, video::IImage* image)
+	{
+		const core::dimension2du& size = image->getDimension();
+		const u32 pitch = (size.Width * 3 + 3) & ~3u;
+		const u32 dataSize = pitch * size.Height;
+
+		Data.clear();
+		Data.reallocate(54 + dataSize);
+
+		// file header
+		appendLE16(Data, 0x4d42);
+		appendLE32(Data, 54 + dataSize);
+		appendLE32(Data, 0);
+		appendLE32(Data, 54);
+
+		// info header
+		appendLE32(Data, 40);
+		appendLE32(Data, size.Width);
+		appendLE32(Data, size.Height);
+		appendLE16(Data, 1);
+		appendLE16(Data, 24);
+		appendLE32(Data, 0);
+		appendLE32(Data, dataSize);
+		appendLE32(Data, 2835);
+		appendLE32(Data, 2835);
+		appendLE32(Data, 0);
+		appendLE32(Data, 0);
+
+		// bottom up rows of bgr pixels
+		for (s32 y=size.Height-1; y>=0; --y)
+		{
+			for (u32 x=0; x<size.Width; ++x)
+			{
+				const video::SColor c = image->getPixel(x, y);
+				Data.push_back((u8)c.getBlue());
+				Data.push_back((u8)c.getGreen());
+				Data.push_back((u8)c.getRed());
+			}
+			for (u32 x=size.Width*3; x<pitch; ++x)
+				Data.push_back(0);
+		}
+		return true;
+	}
+};
+
+//! Decodes a texture pack of png and jpg files with the batch loader
+class CImageDecodePackBenchmark : public IBenchmark
+{
+public:
+
+	//! \param threadCount Decoding threads, 0 for one per hardware thread
+	CImageDecodePackBenchmark(const c8* name, u32 threadCount)
+		: IBenchmark(name), ThreadCount(threadCount) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		const u32 imageCount = 32 * ctx.Scale;
+		const u32 imageSize = IMAGE_SIZE / 2;
+
+		io::IFileSystem* fs = ctx.Device->getFileSystem();
+		video::IVideoDriver* driver = ctx.Device->getVideoDriver();
+
+		for (u32 i=0; i<imageCount; ++i)
+		{
+			video::IImage* image = createTestImage(ctx, imageSize);
+			if (!image)
+				return false;
+
+			c8 name[64];
+			snprintf(name, sizeof(name), "pack/texture%04u.%s", i, (i % 2) ? "jpg" : "png");
+
+			// the memory file owns the data
+			const u32 maxSize = imageSize * imageSize * 4 + 4096;
+			u8* data = new u8[maxSize];
+			io::IWriteFile* writeFile = fs->createMemoryWriteFile(data, maxSize, name);
+			const bool written = driver->writeImageToFile(image, writeFile);
+			const long size = writeFile->getPos();
+			writeFile->drop();
+			image->drop();
+
+			if (!written)
+			{
+				delete [] data;
+				return false;
+			}
+
+			Files.push_back(fs->createMemoryReadFile(data, size, name, true));
+		}
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		core::array<video::IImage*> images =
+			ctx.Device->getVideoDriver()->createImagesFromFiles(Files, ThreadCount);
+
+		u32 pixels = 0;
+		for (u32 i=0; i<images.size(); ++i)
+		{
+			if (images[i])
+			{
+				pixels += images[i]->getDimension().getArea();
+				images[i]->drop();
+			}
+		}
+		return pixels;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		for (u32 i=0; i<Files.size(); ++i)
+			Files[i]->drop();
+		Files.clear();
+	}
+
+private:
+
+	u32 ThreadCount;
+	core::array<io::IReadFile*> Files;
+};
+
+//! Color format conversion of a whole image
+class CImageConvertBenchmark : public IBenchmark
+{
+public:
+
+	CImageConvertBenchmark() : IBenchmark("image.convert"), Image(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		Image = createTestImage(ctx, IMAGE_SIZE * 2);
+		if (!Image)
+			return false;
+
+		Target.set_used(Image->getImageDataSizeInBytes());
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		const video::ECOLOR_FORMAT formats[] =
+			{ video::ECF_R8G8B8, video::ECF_R5G6B5, video::ECF_A1R5G5B5 };
+		const u32 count = sizeof(formats) / sizeof(formats[0]);
+
+		const core::dimension2du& size = Image->getDimension();
+		for (u32 i=0; i<count; ++i)
+			Image->copyToScaling(Target.pointer(), size.Width, size.Height, formats[i]);
+
+		return size.getArea() * count;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		if (Image)
+			Image->drop();
+		Image = 0;
+		Target.clear();
+	}
+
+private:
+
+	video::IImage* Image;
+	core::array<u8> Target;
+};
+
+//! Conversion between one pair of the color formats which convert_viaFormat supports
+class CImageConvertFormatBenchmark : public IBenchmark
+{
+public:
+
+	CImageConvertFormatBenchmark(const c8* name, video::ECOLOR_FORMAT source, video::ECOLOR_FORMAT target)
+		: IBenchmark(name), SourceFormat(source), TargetFormat(target), Image(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		video::IImage* image = createTestImage(ctx, IMAGE_SIZE * 2);
+		if (!image)
+			return false;
+
+		Image = ctx.Device->getVideoDriver()->createImage(SourceFormat, image->getDimension());
+		if (Image)
+			image->copyTo(Image);
+		image->drop();
+		if (!Image)
+			return false;
+
+		Target.set_used(Image->getDimension().getArea() * video::IImage::getBitsPerPixelFromFormat(TargetFormat) / 8);
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		const core::dimension2du& size = Image->getDimension();
+		Image->copyToScaling(Target.pointer(), size.Width, size.Height, TargetFormat);
+		return size.getArea();
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		if (Image)
+			Image->drop();
+		Image = 0;
+		Target.clear();
+	}
+
+private:
+
+	video::ECOLOR_FORMAT SourceFormat;
+	video::ECOLOR_FORMAT TargetFormat;
+	video::IImage* Image;
+	core::array<u8> Target;
+};
+
+//! Downscaling as used for mipmaps and thumbnails
+class CImageScaleBenchmark : public IBenchmark
+{
+public:
+
+	CImageScaleBenchmark() : IBenchmark("image.scale"), Image(0), Half(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		Image = createTestImage(ctx, IMAGE_SIZE * 2);
+		if (!Image)
+			return false;
+
+		Half = ctx.Device->getVideoDriver()->createImage(video::ECF_A8R8G8B8,
+			core::dimension2du(IMAGE_SIZE, IMAGE_SIZE));
+		return Half != 0;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		Image->copyToScaling(Half);
+		Image->copyToScalingBoxFilter(Half);
+		return Image->getDimension().getArea() * 2;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		if (Image)
+			Image->drop();
+		if (Half)
+			Half->drop();
+		Image = 0;
+		Half = 0;
+	}
+
+private:
+
+	video::IImage* Image;
+	video::IImage* Half;
+};
+
+//! Resamples an image to a size which isn't a fraction of it
+class CImageResampleBenchmark : public IBenchmark
+{
+public:
+
+	CImageResampleBenchmark(const c8* name, video::E_IMAGE_FILTER filter, u32 threadCount)
+		: IBenchmark(name), Filter(filter), ThreadCount(threadCount), Image(0), Target(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		Image = createTestImage(ctx, IMAGE_SIZE * 2);
+		if (!Image)
+			return false;
+
+		Target = ctx.Device->getVideoDriver()->createImage(video::ECF_A8R8G8B8,
+			core::dimension2du(IMAGE_SIZE + IMAGE_SIZE / 5, IMAGE_SIZE - IMAGE_SIZE / 3));
+		return Target != 0;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		if (!Image->copyToResampled(Target, Filter, ThreadCount))
+			return 0;
+		return Target->getDimension().getArea();
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		if (Image)
+			Image->drop();
+		if (Target)
+			Target->drop();
+		Image = 0;
+		Target = 0;
+	}
+
+private:
+
+	video::E_IMAGE_FILTER Filter;
+	u32 ThreadCount;
+	video::IImage* Image;
+	video::IImage* Target;
+};
+
+//! Creates the full mipmap chain of an image
+class CImageMipMapsBenchmark : public IBenchmark
+{
+public:
+
+	CImageMipMapsBenchmark(const c8* name, video::E_IMAGE_FILTER filter)
+		: IBenchmark(name), Filter(filter), Image(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		Image = createTestImage(ctx, IMAGE_SIZE * 2);
+		return Image != 0;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		if (!Image->createMipMaps(Filter))
+			return 0;
+		return Image->getDimension().getArea();
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		if (Image)
+			Image->drop();
+		Image = 0;
+	}
+
+private:
+
+	video::E_IMAGE_FILTER Filter;
+	video::IImage* Image;
+};
+
+//! Expands a 565 color of a DXT block
+video::SColor decodeColorDXT(u32 c)
+{
+	const u32 r = (c >> 11) & 0x1f;
+	const u32 g = (c >> 5) & 0x3f;
+	const u32 b = c & 0x1f;
+	return video::SColor(255, (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+}
+
+//! Decodes the 8 byte color block of DXT1 and DXT5
+void decodeColorBlockDXT(const u8* in, bool dxt1, u32* pixels)
+{
+	const u32 c0 = in[0] | (in[1] << 8);
+	const u32 c1 = in[2] | (in[3] << 8);
+
+	video::SColor colors[4];
+	colors[0] = decodeColorDXT(c0);
+	colors[1] = decodeColorDXT(c1);
+	if (c0 > c1 || !dxt1)
+	{
+		colors[2] = colors[1].getInterpolated(colors[0], 1.f / 3.f);
+		colors[3] = colors[1].getInterpolated(colors[0], 2.f / 3.f);
+	}
+	else
+	{
+		colors[2] = colors[1].getInterpolated(colors[0], 0.5f);
+		colors[3] = video::SColor(0, 0, 0, 0);
+	}
+
+	for (u32 i=0; i<16; ++i)
+		pixels[i] = colors[(in[4 + i / 4] >> ((i & 3) * 2)) & 3].color;
+}
+
+//! Decodes the 8 byte alpha block of DXT5 into the alpha of the pixels
+void decodeAlphaBlockDXT(const u8* in, u32* pixels)
+{
+	u32 alpha[8];
+	alpha[0] = in[0];
+	alpha[1] = in[1];
+	if (alpha[0] > alpha[1])
+	{
+		for (u32 i=1; i<7; ++i)
+			alpha[i + 1] = ((7 - i) * alpha[0] + i * alpha[1]) / 7;
+	}
+	else
+	{
+		for (u32 i=1; i<5; ++i)
+			alpha[i + 1] = ((5 - i) * alpha[0] + i * alpha[1]) / 5;
+		alpha[6] = 0;
+		alpha[7] = 255;
+	}
+
+	u64 indices = 0;
+	for (u32 i=0; i<6; ++i)
+		indices |= (u64)in[2 + i] << (i * 8);
+
+	for (u32 i=0; i<16; ++i)
+		pixels[i] = (pixels[i] & 0x00ffffff) | (alpha[(indices >> (i * 3)) & 7] << 24);
+}
+
+//! Reads the 8 bytes of an ETC block, which are stored big endian
+u64 readBlockETC(const u8* in)
+{
+	u64 bits = 0;
+	for (u32 i=0; i<8; ++i)
+		bits = (bits << 8) | in[i];
+	return bits;
+}
+
+//! Decodes the 8 byte color block of ETC2
+/** \return false for the T, H and planar modes, which the engine's encoder
+doesn't use. */
+bool decodeColorBlockETC(const u8* in, u32* pixels)
+{
+	const s32 modifiers[8][4] = {
+		{ 2, 8, -2, -8 }, { 5, 17, -5, -17 }, { 9, 29, -9, -29 }, { 13, 42, -13, -42 },
+		{ 18, 60, -18, -60 }, { 24, 80, -24, -80 }, { 33, 106, -33, -106 }, { 47, 183, -47, -183 } };
+
+	const u64 bits = readBlockETC(in);
+	const bool diff = (bits >> 33) & 1;
+	const bool flip = (bits >> 32) & 1;
+
+	s32 base[2][3];
+	for (u32 c=0; c<3; ++c)
+	{
+		const u32 shift = 59 - c * 8;
+		if (diff)
+		{
+			const s32 first = (s32)((bits >> shift) & 0x1f);
+			s32 delta = (s32)((bits >> (shift - 3)) & 7);
+			if (delta > 3)
+				delta -= 8;
+			const s32 second = first + delta;
+			if (second < 0 || second > 31)
+				return false;
+
+			base[0][c] = (first << 3) | (first >> 2);
+			base[1][c] = (second << 3) | (second >> 2);
+		}
+		else
+		{
+			base[0][c] = (s32)((bits >> (shift + 1)) & 0xf) * 17;
+			base[1][c] = (s32)((bits >> (shift - 3)) & 0xf) * 17;
+		}
+	}
+
+	const u32 table[2] = { (u32)(bits >> 37) & 7, (u32)(bits >> 34) & 7 };
+
+	for (u32 y=0; y<4; ++y)
+	{
+		for (u32 x=0; x<4; ++x)
+		{
+			// the indices are stored column by column
+			const u32 i = x * 4 + y;
+			const u32 index = (((bits >> (i + 16)) & 1) << 1) | ((bits >> i) & 1);
+			const u32 half = flip ? y / 2 : x / 2;
+			const s32 modifier = modifiers[table[half]][index];
+
+			pixels[y * 4 + x] = video::SColor(255,
+				core::s32_clamp(base[half][0] + modifier, 0, 255),
+				core::s32_clamp(base[half][1] + modifier, 0, 255),
+				core::s32_clamp(base[half][2] + modifier, 0, 255)).color;
+		}
+	}
+	return true;
+}
+
+//! Decodes the 8 byte EAC alpha block of ETC2_ARGB into the alpha of the pixels
+void decodeAlphaBlockEAC(const u8* in, u32* pixels)
+{
+	const s32 modifiers[16][8] = {
+		{ -3, -6, -9, -15, 2, 5, 8, 14 }, { -3, -7, -10, -13, 2, 6, 9, 12 },
+		{ -2, -5, -8, -13, 1, 4, 7, 12 }, { -2, -4, -6, -13, 1, 3, 5, 12 },
+		{ -3, -6, -8, -12, 2, 5, 7, 11 }, { -3, -7, -9, -11, 2, 6, 8, 10 },
+		{ -4, -7, -8, -11, 3, 6, 7, 10 }, { -3, -5, -8, -11, 2, 4, 7, 10 },
+		{ -2, -6, -8, -10, 1, 5, 7, 9 }, { -2, -5, -8, -10, 1, 4, 7, 9 },
+		{ -2, -4, -8, -10, 1, 3, 7, 9 }, { -2, -5, -7, -10, 1, 4, 6, 9 },
+		{ -3, -4, -7, -10, 2, 3, 6, 9 }, { -1, -2, -3, -10, 0, 1, 2, 9 },
+		{ -4, -6, -8, -9, 3, 5, 7, 8 }, { -3, -5, -7, -9, 2, 4, 6, 8 } };
+
+	const u64 bits = readBlockETC(in);
+	const s32 base = (s32)(bits >> 56);
+	const s32 multiplier = (s32)(bits >> 52) & 0xf;
+	const s32* table = modifiers[(bits >> 48) & 0xf];
+
+	for (u32 y=0; y<4; ++y)
+	{
+		for (u32 x=0; x<4; ++x)
+		{
+			const u32 i = x * 4 + y;
+			const u32 index = (u32)(bits >> (45 - i * 3)) & 7;
+			const u32 alpha = core::s32_clamp(base + table[index] * multiplier, 0, 255);
+			pixels[y * 4 + x] = (pixels[y * 4 + x] & 0x00ffffff) | (alpha << 24);
+		}
+	}
+}
+
+//! Decodes a block compressed image into A8R8G8B8 pixels
+/** Reference decoders written after the format specifications, so the
+engine's encoder isn't checked against itself.
+\return false if the format or a block isn't supported. */
+bool decodeImage(video::IImage* image, core::array<u32>& pixels)
+{
+	const video::ECOLOR_FORMAT format = image->getColorFormat();
+	const core::dimension2du& size = image->getDimension();
+	const u8* in = (const u8*)image->getData();
+	const u32 blockSize = (format == video::ECF_DXT1 || format == video::ECF_ETC2_RGB) ? 8 : 16;
+
+	pixels.set_used(size.getArea());
+	for (u32 by=0; by<size.Height; by+=4)
+	{
+		for (u32 bx=0; bx<size.Width; bx+=4, in+=blockSize)
+		{
+			u32 block[16];
+			switch (format)
+			{
+			case video::ECF_DXT1:
+				decodeColorBlockDXT(in, true, block);
+				break;
+			case video::ECF_DXT5:
+				decodeColorBlockDXT(in + 8, false, block);
+				decodeAlphaBlockDXT(in, block);
+				break;
+			case video::ECF_ETC2_RGB:
+				if (!decodeColorBlockETC(in, block))
+					return false;
+				break;
+			case video::ECF_ETC2_ARGB:
+				if (!decodeColorBlockETC(in + 8, block))
+					return false;
+				decodeAlphaBlockEAC(in, block);
+				break;
+			default:
+				return false;
+			}
+
+			for (u32 y=0; y<4 && by + y<size.Height; ++y)
+				for (u32 x=0; x<4 && bx + x<size.Width; ++x)
+					pixels[(by + y) * size.Width + bx + x] = block[y * 4 + x];
+		}
+	}
+	return true;
+}
+
+//! Returns the peak signal to noise ratio of the decoded pixels in dB
+f64 getPSNR(video::IImage* image, const core::array<u32>& pixels)
+{
+	const u32* source = (const u32*)image->getData();
+
+	f64 error = 0.0;
+	for (u32 i=0; i<pixels.size(); ++i)
+	{
+		for (u32 shift=0; shift<32; shift+=8)
+		{
+			const f64 d = (f64)((source[i] >> shift) & 0xff) - (f64)((pixels[i] >> shift) & 0xff);
+			error += d * d;
+		}
+	}
+
+	if (error == 0.0)
+		return 100.0;
+	return 10.0 * log10(255.0 * 255.0 * pixels.size() * 4 / error);
+}
+
+//! Loads an image from memory
+video::IImage* loadImage(SBenchmarkContext& ctx, const u8* data, u32 size, const io::path& fileName)
+{
+	io::IReadFile* file = ctx.Device->getFileSystem()->createMemoryReadFile(data, size, fileName);
+	video::IImage* image = ctx.Device->getVideoDriver()->createImageFromFile(file);
+	file->drop();
+	return image;
+}
+
+//! Compresses a generated image into blocks, as done for ETCF_BLOCK_COMPRESSION
+class CImageCompressBenchmark : public IBenchmark
+{
+public:
+
+	CImageCompressBenchmark(const c8* name, video::ECOLOR_FORMAT format, u32 threadCount)
+		: IBenchmark(name), Format(format), ThreadCount(threadCount), Image(0), Target(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		Image = createTestImage(ctx, IMAGE_SIZE);
+		if (!Image)
+			return false;
+
+		Target = ctx.Device->getVideoDriver()->createImage(Format, Image->getDimension());
+		return Target != 0;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		if (!Image->copyToCompressed(Target, ThreadCount))
+			return 0;
+		return Image->getDimension().getArea();
+	}
+
+	//! Round trip through a KTX file, and loading of broken KTX files
+	virtual bool check(SBenchmarkContext& ctx)
+	{
+		core::array<u8> data;
+		data.set_used(Target->getImageDataSizeInBytes() + 1024);
+		io::IWriteFile* file = ctx.Device->getFileSystem()->createMemoryWriteFile(
+			data.pointer(), data.size(), "check.ktx");
+		const bool written = ctx.Device->getVideoDriver()->writeImageToFile(Target, file);
+		data.set_used(file->getPos());
+		file->drop();
+
+		video::IImage* loaded = written ? loadImage(ctx, data.const_pointer(), data.size(), "check.ktx") : 0;
+		if (!loaded)
+		{
+			fprintf(stderr, "  KTX round trip failed\n");
+			return false;
+		}
+
+		const bool same = loaded->getColorFormat() == Format &&
+			loaded->getDimension() == Target->getDimension() &&
+			!memcmp(loaded->getData(), Target->getData(), Target->getImageDataSizeInBytes());
+
+		core::array<u32> pixels;
+		const bool decoded = same && decodeImage(loaded, pixels);
+		loaded->drop();
+
+		if (!decoded)
+		{
+			fprintf(stderr, "  the loaded KTX file differs or can't be decoded\n");
+			return false;
+		}
+
+		// the encoders reach about 40 dB on the noisy generated image
+		const f64 psnr = getPSNR(Image, pixels);
+		if (psnr < MIN_PSNR)
+		{
+			fprintf(stderr, "  %.1f dB PSNR of the decoded image, expected %.1f dB\n", psnr, MIN_PSNR);
+			return false;
+		}
+
+		// a file cut in the middle of the image data
+		video::IImage* truncated = loadImage(ctx, data.const_pointer(), data.size() / 2, "truncated.ktx");
+
+		// dimensions whose level size wraps to 0 in 32 bit, with a matching
+		// image size of 0. The pixel width and height follow the identifier
+		// and six 32 bit fields, the image size follows the 64 byte header.
+		const u32 hugeSize = 0x20000;
+		const u32 wrappedSize = 0;
+		memcpy(&data[36], &hugeSize, 4);
+		memcpy(&data[40], &hugeSize, 4);
+		memcpy(&data[64], &wrappedSize, 4);
+		video::IImage* oversized = loadImage(ctx, data.const_pointer(), data.size(), "oversized.ktx");
+
+		const bool rejected = !truncated && !oversized;
+		if (truncated)
+			truncated->drop();
+		if (oversized)
+			oversized->drop();
+
+		if (!rejected)
+		{
+			fprintf(stderr, "  broken KTX files were loaded\n");
+			return false;
+		}
+		return true;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		if (Image)
+			Image->drop();
+		if (Target)
+			Target->drop();
+		Image = 0;
+		Target = 0;
+	}
+
+private:
+
+	//! Lowest PSNR of the round trip in dB
+	static const f64 MIN_PSNR;
+
+	video::ECOLOR_FORMAT Format;
+	u32 ThreadCount;
+	video::IImage* Image;
+	video::IImage* Target;
+};
+
+const f64 CImageCompressBenchmark::MIN_PSNR = 36.0;
+
+CImageDecodeBenchmark imageDecodePNG("image.decode.png", "benchmark.png");
+CImageDecodeBenchmark imageDecodeJPG("image.decode.jpg", "benchmark.jpg");
+CImageDecodeBMPBenchmark imageDecodeBMP;
+CImageDecodePackBenchmark imageDecodePack("image.decode.pack", 0);
+CImageDecodePackBenchmark imageDecodePackSerial("image.decode.pack.serial", 1);
+CImageConvertBenchmark imageConvert;
+CImageConvertFormatBenchmark imageConvertA1R5G5B5toA1R5G5B5("image.convert.a1r5g5b5.a1r5g5b5", video::ECF_A1R5G5B5, video::ECF_A1R5G5B5);
+CImageConvertFormatBenchmark imageConvertA1R5G5B5toR5G6B5("image.convert.a1r5g5b5.r5g6b5", video::ECF_A1R5G5B5, video::ECF_R5G6B5);
+CImageConvertFormatBenchmark imageConvertA1R5G5B5toR8G8B8("image.convert.a1r5g5b5.r8g8b8", video::ECF_A1R5G5B5, video::ECF_R8G8B8);
+CImageConvertFormatBenchmark imageConvertA1R5G5B5toA8R8G8B8("image.convert.a1r5g5b5.a8r8g8b8", video::ECF_A1R5G5B5, video::ECF_A8R8G8B8);
+CImageConvertFormatBenchmark imageConvertR5G6B5toA1R5G5B5("image.convert.r5g6b5.a1r5g5b5", video::ECF_R5G6B5, video::ECF_A1R5G5B5);
+CImageConvertFormatBenchmark imageConvertR5G6B5toR5G6B5("image.convert.r5g6b5.r5g6b5", video::ECF_R5G6B5, video::ECF_R5G6B5);
+CImageConvertFormatBenchmark imageConvertR5G6B5toR8G8B8("image.convert.r5g6b5.r8g8b8", video::ECF_R5G6B5, video::ECF_R8G8B8);
+CImageConvertFormatBenchmark imageConvertR5G6B5toA8R8G8B8("image.convert.r5g6b5.a8r8g8b8", video::ECF_R5G6B5, video::ECF_A8R8G8B8);
+CImageConvertFormatBenchmark imageConvertR8G8B8toA1R5G5B5("image.convert.r8g8b8.a1r5g5b5", video::ECF_R8G8B8, video::ECF_A1R5G5B5);
+CImageConvertFormatBenchmark imageConvertR8G8B8toR5G6B5("image.convert.r8g8b8.r5g6b5", video::ECF_R8G8B8, video::ECF_R5G6B5);
+CImageConvertFormatBenchmark imageConvertR8G8B8toR8G8B8("image.convert.r8g8b8.r8g8b8", video::ECF_R8G8B8, video::ECF_R8G8B8);
+CImageConvertFormatBenchmark imageConvertR8G8B8toA8R8G8B8("image.convert.r8g8b8.a8r8g8b8", video::ECF_R8G8B8, video::ECF_A8R8G8B8);
+CImageConvertFormatBenchmark imageConvertA8R8G8B8toA1R5G5B5("image.convert.a8r8g8b8.a1r5g5b5", video::ECF_A8R8G8B8, video::ECF_A1R5G5B5);
+CImageConvertFormatBenchmark imageConvertA8R8G8B8toR5G6B5("image.convert.a8r8g8b8.r5g6b5", video::ECF_A8R8G8B8, video::ECF_R5G6B5);
+CImageConvertFormatBenchmark imageConvertA8R8G8B8toR8G8B8("image.convert.a8r8g8b8.r8g8b8", video::ECF_A8R8G8B8, video::ECF_R8G8B8);
+CImageConvertFormatBenchmark imageConvertA8R8G8B8toA8R8G8B8("image.convert.a8r8g8b8.a8r8g8b8", video::ECF_A8R8G8B8, video::ECF_A8R8G8B8);
+CImageScaleBenchmark imageScale;
+CImageResampleBenchmark imageResampleBox("image.resample.box", video::EIF_BOX, 1);
+CImageResampleBenchmark imageResampleTriangle("image.resample.triangle", video::EIF_TRIANGLE, 1);
+CImageResampleBenchmark imageResampleLanczos("image.resample.lanczos", video::EIF_LANCZOS, 1);
+CImageResampleBenchmark imageResampleLanczosThreads("image.resample.lanczos.threads", video::EIF_LANCZOS, 0);
+CImageMipMapsBenchmark imageMipMapsBox("image.mipmaps.box", video::EIF_BOX);
+CImageMipMapsBenchmark imageMipMapsLanczos("image.mipmaps.lanczos", video::EIF_LANCZOS);
+CImageCompressBenchmark imageCompressDXT1("image.compress.dxt1", video::ECF_DXT1, 1);
+CImageCompressBenchmark imageCompressDXT5("image.compress.dxt5", video::ECF_DXT5, 1);
+CImageCompressBenchmark imageCompressETC2("image.compress.etc2", video::ECF_ETC2_RGB, 1);
+CImageCompressBenchmark imageCompressETC2Alpha("image.compress.etc2.alpha", video::ECF_ETC2_ARGB, 1);
+CImageCompressBenchmark imageCompressETC2Threads("image.compress.etc2.threads", video::ECF_ETC2_RGB, 0);
+
+} // end anonymous namespace
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include "Benchmark.h"
+
+using namespace irr;
+
+namespace
+{
+
+//! Loads a mesh file kept in memory, once per iteration
+class CMeshLoadBenchmark : public IBenchmark
+{
+public:
+
+	CMeshLoadBenchmark(const c8* name, const c8* fileName)
+		: IBenchmark(name), FileName(fileName) {}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+		io::IReadFile* file = ctx.Device->getFileSystem()->createMemoryReadFile(
+			Data.const_pointer(), Data.size(), FileName);
+		scene::IAnimatedMesh* mesh = smgr->getMesh(file);
+		file->drop();
+
+		// keep the cache from returning the same mesh next time
+		if (mesh)
+			smgr->getMeshCache()->removeMesh(mesh);
+
+		return Data.size();
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		Data.clear();
+	}
+
+protected:
+
+	//! Reads a file from disk into Data
+	bool readFile(SBenchmarkContext& ctx, const io::path& filename)
+	{
+		io::IReadFile* file = ctx.Device->getFileSystem()->createAndOpenFile(filename);
+		if (!file)
+			return false;
+
+		Data.set_used((u32)file->getSize());
+		const bool success = file->read(Data.pointer(), Data.size()) == (size_t)Data.size();
+		file->drop();
+		return success;
+	}
+
+	//! Memory file name, the extension selects the loader
+	io::path FileName;
+
+	core::array<u8> Data;
+};
+
+//! Generated Wavefront obj grid with positions, normals and texture coordinates
+class CMeshLoadOBJBenchmark : public CMeshLoadBenchmark
+{
+public:
+
+	CMeshLoadOBJBenchmark() : CMeshLoadBenchmark("mesh.load.obj", "benchmark.obj") {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		const u32 size = 96 * ctx.Scale;
+		const f32 texScale = 1.f / (f32)size;
+
+		Data.clear();
+		appendLine("o grid\n");
+		for (u32 z=0; z<=size; ++z)
+		{
+			for (u32 x=0; x<=size; ++x)
+				appendLine("v %.4f %.4f %.4f\n", (f32)x, randomRange(ctx.Random, 0.f, 4.f), (f32)z);
+		}
+		for (u32 z=0; z<=size; ++z)
+		{
+			for (u32 x=0; x<=size; ++x)
+				appendLine("vt %.4f %.4f\n", x * texScale, z * texScale);
+		}
+		for (u32 i=0; i<(size+1)*(size+1); ++i)
+		{
+			core::vector3df n(randomRange(ctx.Random, -0.2f, 0.2f), 1.f, randomRange(ctx.Random, -0.2f, 0.2f));
+			n.normalize();
+			appendLine("vn %.4f %.4f %.4f\n", n.X, n.Y, n.Z);
+		}
+		for (u32 z=0; z<size; ++z)
+		{
+			for (u32 x=0; x<size; ++x)
+			{
+				// obj indices are 1 based
+				const u32 a = z * (size+1) + x + 1;
+				const u32 b = a + 1;
+				const u32 c = a + size + 2;
+				const u32 d = a + size + 1;
+				appendLine("f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n",
+					a, a, a, b, b, b, c, c, c, d, d, d);
+			}
+		}
+		return true;
+	}
+
+private:
+
+	void appendLine(const c8* format, ...)
+	{
+		c8 line[256];
+		va_list args;
+		va_start(args, format);
+		const s32 len = vsnprintf(line, sizeof(line), format, args);
+		va_end(args);
+		if (len > 0)
+			appendBytes(Data, line, core::min_((u32)len, (u32)sizeof(line)-1));
+	}
+};
+
+//! The skinned example character in DirectX text format
+class CMeshLoadXBenchmark : public CMeshLoadBenchmark
+{
+public:
+
+	CMeshLoadXBenchmark() : CMeshLoadBenchmark("mesh.load.x", "benchmark.x") {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		return readFile(ctx, ctx.MediaPath + "coolguy_opt.x");
+	}
+};
+
+//! The skinned example character converted to b3d with the engine's writer
+class CMeshLoadB3DBenchmark : public CMeshLoadBenchmark
+{
+public:
+
+	CMeshLoadB3DBenchmark() : CMeshLoadBenchmark("mesh.load.b3d", "benchmark.b3d") {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+		scene::IAnimatedMesh* mesh = smgr->getMesh(ctx.MediaPath + "coolguy_opt.x");
+		if (!mesh)
+			return false;
+
+		bool success = false;
+		scene::IMeshWriter* writer = smgr->createMeshWriter(scene::EMWT_B3D);
+		if (writer)
+		{
+			Data.set_used(16 * 1024 * 1024);
+			io::IWriteFile* file = ctx.Device->getFileSystem()->createMemoryWriteFile(
+				Data.pointer(), Data.size(), "benchmark.b3d");
+			success = writer->writeMesh(file, mesh);
+			Data.set_used(file->getPos());
+			file->drop();
+			writer->drop();
+		}
+
+		smgr->getMeshCache()->removeMesh(mesh);
+		return success && Data.size();
+	}
+};
+
+CMeshLoadOBJBenchmark meshLoadOBJ;
+CMeshLoadXBenchmark meshLoadX;
+CMeshLoadB3DBenchmark meshLoadB3D;
+
+} // end anonymous namespace
@@ -0,0 +1,1144 @@
+#include "Benchmark.h"
+#include "IBSPLevelSceneNode.h"
+#include "IOctreeSceneNode.h"
+#include "IQ3LevelMesh.h"
+#include "IQ3Shader.h"
+
+using namespace irr;
+
+namespace
+{
+
+//! Time of one simulated frame in milliseconds
+const u32 FRAME_TIME = 33;
+
+//! Advances the stopped virtual timer by one frame and draws the scene
+void drawFrame(SBenchmarkContext& ctx)
+{
+	ITimer* timer = ctx.Device->getTimer();
+	timer->setTime(timer->getTime() + FRAME_TIME);
+
+	video::IVideoDriver* driver = ctx.Device->getVideoDriver();
+	driver->beginScene(true, true);
+	ctx.Device->getSceneManager()->drawAll();
+	driver->endScene();
+}
+
+//! Registration and frustum culling of many static nodes
+class CSceneCullBenchmark : public IBenchmark
+{
+public:
+
+	CSceneCullBenchmark(const c8* name, bool caching)
+		: IBenchmark(name), NodeCount(0), Caching(caching) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+		scene::IMesh* cube = smgr->getGeometryCreator()->createCubeMesh();
+		if (!cube)
+			return false;
+
+		// about half of the nodes end up outside of the view frustum
+		NodeCount = 4000 * ctx.Scale;
+		for (u32 i=0; i<NodeCount; ++i)
+		{
+			const core::vector3df pos(
+				randomRange(ctx.Random, -1000.f, 1000.f),
+				randomRange(ctx.Random, -200.f, 200.f),
+				randomRange(ctx.Random, -1000.f, 1000.f));
+			scene::IMeshSceneNode* node = smgr->addMeshSceneNode(cube, 0, -1, pos);
+			node->setMaterialFlag(video::EMF_LIGHTING, false);
+		}
+		cube->drop();
+
+		smgr->addCameraSceneNode(0, core::vector3df(0.f, 0.f, -1000.f),
+			core::vector3df(0.f, 0.f, 0.f));
+		smgr->setRenderListCaching(Caching);
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		drawFrame(ctx);
+		return NodeCount;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		ctx.Device->getSceneManager()->setRenderListCaching(false);
+		ctx.Device->getSceneManager()->clear();
+	}
+
+private:
+
+	u32 NodeCount;
+	bool Caching;
+};
+
+//! Software skinning of animated characters
+class CSceneSkinningBenchmark : public IBenchmark
+{
+public:
+
+	CSceneSkinningBenchmark() : IBenchmark("scene.skinning"), Mesh(0), NodeCount(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+		Mesh = smgr->getMesh(ctx.MediaPath + "coolguy_opt.x");
+		if (!Mesh)
+			return false;
+
+		NodeCount = 64 * ctx.Scale;
+		const u32 columns = 8;
+		for (u32 i=0; i<NodeCount; ++i)
+		{
+			const core::vector3df pos((f32)(i % columns) * 4.f, 0.f, (f32)(i / columns) * 4.f);
+			scene::IAnimatedMeshSceneNode* node = smgr->addAnimatedMeshSceneNode(Mesh, 0, -1, pos);
+			node->setMaterialFlag(video::EMF_LIGHTING, false);
+			node->setAutomaticCulling(scene::EAC_OFF);
+			node->setFrameLoop(0, 29);
+			node->setAnimationSpeed(30.f);
+			node->setCurrentFrame(randomRange(ctx.Random, 0.f, 29.f));
+		}
+
+		smgr->addCameraSceneNode(0, core::vector3df(14.f, 20.f, -20.f),
+			core::vector3df(14.f, 0.f, 14.f));
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		drawFrame(ctx);
+		return NodeCount;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+		smgr->clear();
+		if (Mesh)
+			smgr->getMeshCache()->removeMesh(Mesh);
+		Mesh = 0;
+	}
+
+private:
+
+	scene::IAnimatedMesh* Mesh;
+	u32 NodeCount;
+};
+
+//! Many transparent billboards, as used for foliage and particles
+/** Either one billboard scene node per billboard or one depth sorted
+billboard group for all of them. */
+class CSceneBillboardsBenchmark : public IBenchmark
+{
+public:
+
+	CSceneBillboardsBenchmark(const c8* name, bool group)
+		: IBenchmark(name), Group(group), Count(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+		scene::IBillboardGroupSceneNode* group = 0;
+		if (Group)
+		{
+			group = smgr->addBillboardGroupSceneNode();
+			if (!group)
+				return false;
+			group->setMaterialFlag(video::EMF_LIGHTING, false);
+			group->setMaterialType(video::EMT_TRANSPARENT_ALPHA_CHANNEL);
+			group->setDepthSorting(true);
+		}
+
+		Count = 4000 * ctx.Scale;
+		for (u32 i=0; i<Count; ++i)
+		{
+			const core::vector3df pos(
+				randomRange(ctx.Random, -200.f, 200.f),
+				randomRange(ctx.Random, 0.f, 20.f),
+				randomRange(ctx.Random, 0.f, 400.f));
+			const core::dimension2df size(randomRange(ctx.Random, 2.f, 6.f),
+				randomRange(ctx.Random, 2.f, 6.f));
+
+			if (group)
+			{
+				group->addBillboard(pos, size);
+			}
+			else
+			{
+				scene::IBillboardSceneNode* node = smgr->addBillboardSceneNode(0, size, pos);
+				node->setMaterialFlag(video::EMF_LIGHTING, false);
+				node->setMaterialType(video::EMT_TRANSPARENT_ALPHA_CHANNEL);
+			}
+		}
+
+		smgr->addCameraSceneNode(0, core::vector3df(0.f, 10.f, -50.f),
+			core::vector3df(0.f, 10.f, 200.f));
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		drawFrame(ctx);
+		return Count;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		ctx.Device->getSceneManager()->clear();
+	}
+
+private:
+
+	bool Group;
+	u32 Count;
+};
+
+//! Base for collision queries against a generated hilly terrain
+class CCollisionBenchmark : public IBenchmark
+{
+public:
+
+	CCollisionBenchmark(const c8* name) : IBenchmark(name), Selector(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+		scene::IMesh* mesh = smgr->getGeometryCreator()->createHillPlaneMesh(
+			core::dimension2df(8.f, 8.f), core::dimension2du(128, 128),
+			0, 40.f, core::dimension2df(6.f, 6.f), core::dimension2df(1.f, 1.f));
+		if (!mesh)
+			return false;
+
+		scene::IMeshSceneNode* node = smgr->addMeshSceneNode(mesh);
+		Selector = smgr->createOctreeTriangleSelector(mesh, node);
+		mesh->drop();
+
+		return Selector != 0;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		if (Selector)
+			Selector->drop();
+		Selector = 0;
+		ctx.Device->getSceneManager()->clear();
+	}
+
+protected:
+
+	scene::ITriangleSelector* Selector;
+};
+
+//! Ray picking against the terrain
+class CCollisionRayBenchmark : public CCollisionBenchmark
+{
+public:
+
+	CCollisionRayBenchmark() : CCollisionBenchmark("collision.ray") {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		if (!CCollisionBenchmark::setUp(ctx))
+			return false;
+
+		Rays.clear();
+		const u32 count = 2000 * ctx.Scale;
+		Rays.reallocate(count);
+		for (u32 i=0; i<count; ++i)
+		{
+			const core::vector3df start(
+				randomRange(ctx.Random, -500.f, 500.f), 200.f,
+				randomRange(ctx.Random, -500.f, 500.f));
+			const core::vector3df end(
+				start.X + randomRange(ctx.Random, -100.f, 100.f), -200.f,
+				start.Z + randomRange(ctx.Random, -100.f, 100.f));
+			Rays.push_back(core::line3df(start, end));
+		}
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		scene::ISceneCollisionManager* coll = ctx.Device->getSceneManager()->getSceneCollisionManager();
+
+		scene::SCollisionHit hit;
+		for (u32 i=0; i<Rays.size(); ++i)
+			coll->getCollisionPoint(hit, Rays[i], Selector);
+
+		return Rays.size();
+	}
+
+private:
+
+	core::array<core::line3df> Rays;
+};
+
+//! Ellipsoid sliding response as used by character movement
+class CCollisionResponseBenchmark : public CCollisionBenchmark
+{
+public:
+
+	CCollisionResponseBenchmark() : CCollisionBenchmark("collision.response") {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		if (!CCollisionBenchmark::setUp(ctx))
+			return false;
+
+		Positions.clear();
+		Velocities.clear();
+		const u32 count = 500 * ctx.Scale;
+		for (u32 i=0; i<count; ++i)
+		{
+			Positions.push_back(core::vector3df(
+				randomRange(ctx.Random, -450.f, 450.f), 60.f,
+				randomRange(ctx.Random, -450.f, 450.f)));
+			Velocities.push_back(core::vector3df(
+				randomRange(ctx.Random, -10.f, 10.f), -20.f,
+				randomRange(ctx.Random, -10.f, 10.f)));
+		}
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		scene::ISceneCollisionManager* coll = ctx.Device->getSceneManager()->getSceneCollisionManager();
+
+		const core::vector3df radius(3.f, 6.f, 3.f);
+		core::triangle3df triangle;
+		core::vector3df hitPosition;
+		bool falling;
+		scene::ISceneNode* node;
+		for (u32 i=0; i<Positions.size(); ++i)
+		{
+			coll->getCollisionResultPosition(Selector, Positions[i], radius,
+				Velocities[i], triangle, hitPosition, falling, node);
+		}
+
+		return Positions.size();
+	}
+
+private:
+
+	core::array<core::vector3df> Positions;
+	core::array<core::vector3df> Velocities;
+};
+
+//! Visibility of octree nodes on a large terrain mesh
+/** With EOV_USE_VBO_WITH_VISIBITLY, only the index ranges of the visible nodes
+are collected, otherwise their indices are copied into one list. */
+class CSceneOctreeBenchmark : public IBenchmark
+{
+public:
+
+	CSceneOctreeBenchmark(const c8* name, scene::EOCTREENODE_VBO useVBO)
+		: IBenchmark(name), UseVBO(useVBO), Camera(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+		scene::IMesh* mesh = smgr->getGeometryCreator()->createHillPlaneMesh(
+			core::dimension2df(8.f, 8.f), core::dimension2du(160, 160),
+			0, 40.f, core::dimension2df(6.f, 6.f), core::dimension2df(1.f, 1.f));
+		if (!mesh)
+			return false;
+
+		scene::IOctreeSceneNode* node = smgr->addOctreeSceneNode(mesh, 0, -1, 256);
+		mesh->drop();
+		if (!node)
+			return false;
+
+		node->setMaterialFlag(video::EMF_LIGHTING, false);
+		node->setUseVBO(UseVBO);
+		node->setPolygonChecks(scene::EOPC_FRUSTUM);
+
+		Camera = smgr->addCameraSceneNode(0, core::vector3df(0.f, 60.f, 0.f),
+			core::vector3df(0.f, 0.f, 300.f));
+		Camera->setFarValue(600.f);
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		// turn around, so different nodes become visible
+		const u32 frames = 16 * ctx.Scale;
+		for (u32 i=0; i<frames; ++i)
+		{
+			const f32 angle = (f32)i * core::PI * 2.f / (f32)frames;
+			Camera->setTarget(core::vector3df(sinf(angle) * 300.f, 0.f, cosf(angle) * 300.f));
+			drawFrame(ctx);
+		}
+		return frames;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		ctx.Device->getSceneManager()->clear();
+		Camera = 0;
+	}
+
+private:
+
+	scene::EOCTREENODE_VBO UseVBO;
+	scene::ICameraSceneNode* Camera;
+};
+
+//! Adds a terrain node for a generated hilly heightmap of 513x513 samples
+scene::ITerrainSceneNode* addTerrain(SBenchmarkContext& ctx)
+{
+	scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+	const u32 size = 513;
+	video::IImage* heightmap = ctx.Device->getVideoDriver()->createImage(video::ECF_A8R8G8B8,
+		core::dimension2du(size, size));
+	if (!heightmap)
+		return 0;
+
+	for (u32 z=0; z<size; ++z)
+	{
+		for (u32 x=0; x<size; ++x)
+		{
+			const f32 h = 127.5f + 60.f * sinf(x * 0.031f) * cosf(z * 0.023f)
+				+ 40.f * sinf((x + z) * 0.11f) + randomRange(ctx.Random, -8.f, 8.f);
+			const u32 c = (u32)core::clamp(h, 0.f, 255.f);
+			heightmap->setPixel(x, z, video::SColor(255, c, c, c));
+		}
+	}
+
+	scene::ITerrainSceneNode* terrain = smgr->addTerrainSceneNode((io::IReadFile*)0, 0, -1,
+		core::vector3df(-1024.f, -60.f, -1024.f), core::vector3df(0.f, 0.f, 0.f),
+		core::vector3df(4.f, 0.5f, 4.f), video::SColor(255,255,255,255), 5, scene::ETPS_17, 1, true);
+	if (terrain && !terrain->loadHeightMap(heightmap))
+	{
+		terrain->remove();
+		terrain = 0;
+	}
+
+	heightmap->drop();
+	return terrain;
+}
+
+//! Level of detail selection and drawing of a large terrain with a moving camera
+class CSceneTerrainBenchmark : public IBenchmark
+{
+public:
+
+	CSceneTerrainBenchmark() : IBenchmark("scene.terrain"), Camera(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		scene::ITerrainSceneNode* terrain = addTerrain(ctx);
+		if (!terrain)
+			return false;
+		terrain->setMaterialFlag(video::EMF_LIGHTING, false);
+
+		Camera = ctx.Device->getSceneManager()->addCameraSceneNode();
+		Camera->setFarValue(3000.f);
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		// fly over the terrain, so the patches change their LODs
+		const u32 frames = 16 * ctx.Scale;
+		for (u32 i=0; i<frames; ++i)
+		{
+			const f32 angle = (f32)i * core::PI * 2.f / (f32)frames;
+			const core::vector3df pos(sinf(angle) * 600.f, 120.f, cosf(angle) * 600.f);
+			Camera->setPosition(pos);
+			Camera->setTarget(core::vector3df(-pos.Z, 0.f, pos.X));
+			drawFrame(ctx);
+		}
+		return frames;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		ctx.Device->getSceneManager()->clear();
+		Camera = 0;
+	}
+
+private:
+
+	scene::ICameraSceneNode* Camera;
+};
+
+//! Height and ray queries answered from the heightmap of a terrain
+class CCollisionTerrainBenchmark : public IBenchmark
+{
+public:
+
+	CCollisionTerrainBenchmark() : IBenchmark("collision.terrain"), Terrain(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		Terrain = addTerrain(ctx);
+		if (!Terrain)
+			return false;
+
+		Rays.clear();
+		const u32 count = 2000 * ctx.Scale;
+		Rays.reallocate(count);
+		for (u32 i=0; i<count; ++i)
+		{
+			const core::vector3df start(
+				randomRange(ctx.Random, -1000.f, 1000.f), 200.f,
+				randomRange(ctx.Random, -1000.f, 1000.f));
+			const core::vector3df end(
+				start.X + randomRange(ctx.Random, -300.f, 300.f), -200.f,
+				start.Z + randomRange(ctx.Random, -300.f, 300.f));
+			Rays.push_back(core::line3df(start, end));
+		}
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		core::vector3df intersection;
+		for (u32 i=0; i<Rays.size(); ++i)
+		{
+			Terrain->getIntersectionWithLine(Rays[i], intersection);
+			Terrain->getHeight(Rays[i].start.X, Rays[i].start.Z);
+		}
+		return Rays.size();
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		ctx.Device->getSceneManager()->clear();
+		Terrain = 0;
+	}
+
+private:
+
+	scene::ITerrainSceneNode* Terrain;
+	core::array<core::line3df> Rays;
+};
+
+//! Hundreds of dynamic point lights, either sorted by distance or assigned to clusters
+class CSceneLightsBenchmark : public IBenchmark
+{
+public:
+
+	CSceneLightsBenchmark(const c8* name, bool clustered)
+		: IBenchmark(name), Clustered(clustered), Camera(0), Count(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+		if (Clustered)
+		{
+			scene::IClusteredLightManager* lightManager = smgr->createClusteredLightManager();
+			if (!lightManager)
+				return false;
+			smgr->setLightManager(lightManager);
+			lightManager->drop();
+		}
+
+		Count = 500 * ctx.Scale;
+		for (u32 i=0; i<Count; ++i)
+		{
+			const core::vector3df pos(
+				randomRange(ctx.Random, -500.f, 500.f),
+				randomRange(ctx.Random, 0.f, 50.f),
+				randomRange(ctx.Random, -500.f, 500.f));
+			const video::SColorf color(randomRange(ctx.Random, 0.f, 1.f),
+				randomRange(ctx.Random, 0.f, 1.f), randomRange(ctx.Random, 0.f, 1.f));
+			smgr->addLightSceneNode(0, pos, color, randomRange(ctx.Random, 5.f, 60.f));
+		}
+
+		Camera = smgr->addCameraSceneNode();
+		Camera->setFarValue(1500.f);
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		// turn around, so other lights are in front of the camera every frame
+		const u32 frames = 16 * ctx.Scale;
+		for (u32 i=0; i<frames; ++i)
+		{
+			const f32 angle = (f32)i * core::PI * 2.f / (f32)frames;
+			Camera->setPosition(core::vector3df(0.f, 30.f, 0.f));
+			Camera->setTarget(core::vector3df(sinf(angle) * 100.f, 20.f, cosf(angle) * 100.f));
+			drawFrame(ctx);
+		}
+		return frames * Count;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+		smgr->setLightManager(0);
+		smgr->clear();
+		Camera = 0;
+	}
+
+private:
+
+	bool Clustered;
+	scene::ICameraSceneNode* Camera;
+	u32 Count;
+};
+
+//! Quake 3 shader stages deforming and coloring large patches every frame
+/** The shader is built from a script in memory. Half of the patches are
+behind the camera. Skipped if the engine is compiled without the bsp loader. */
+class CSceneQ3ShaderBenchmark : public IBenchmark
+{
+public:
+
+	CSceneQ3ShaderBenchmark() : IBenchmark("scene.q3shader"), Lightmap(0), Count(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		// stage, variable and its content of the shader, stage 1 is the general one
+		static const struct { u32 Stage; const c8* Name; const c8* Content; } script[] =
+		{
+			{ 1, "cull", "disable" },
+			{ 1, "deformvertexes", "wave 64 sin 0 4 0 0.5" },
+			{ 1, "deformvertexes", "bulge 3 2 1" },
+			{ 2, "map", "$lightmap" },
+			{ 2, "rgbgen", "identity" },
+			{ 3, "map", "$lightmap" },
+			{ 3, "blendfunc", "add" },
+			{ 3, "rgbgen", "wave sin 0.5 0.5 0 1" },
+			{ 3, "tcmod", "scroll 0.1 0" }
+		};
+
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+		video::IVideoDriver* driver = ctx.Device->getVideoDriver();
+
+		Lightmap = driver->addTexture(core::dimension2du(16, 16), "benchmark_q3lightmap");
+		if (!Lightmap)
+			return false;
+
+		scene::quake3::SVarGroupList* groups = new scene::quake3::SVarGroupList();
+		groups->VariableGroup.set_used(4);
+		for (u32 i=0; i<sizeof(script) / sizeof(script[0]); ++i)
+			groups->VariableGroup[script[i].Stage].Variable.push_back(
+				scene::quake3::SVariable(script[i].Name, script[i].Content));
+		Shader.name = "benchmark/water";
+		Shader.VarGroup = groups;
+
+		// patches of 128x128 vertices in a ring around the camera
+		const u32 size = 128;
+		Count = 8 * ctx.Scale;
+		for (u32 p=0; p<Count; ++p)
+		{
+			scene::SMeshBufferLightMap* buffer = new scene::SMeshBufferLightMap();
+			buffer->Material.setTexture(1, Lightmap);
+
+			const f32 angle = (f32)p * core::PI * 2.f / (f32)Count;
+			const core::vector3df corner(sinf(angle) * 600.f - 256.f, -20.f, cosf(angle) * 600.f - 256.f);
+			for (u32 z=0; z<size; ++z)
+			{
+				for (u32 x=0; x<size; ++x)
+				{
+					const core::vector2df tc((f32)x / 8.f, (f32)z / 8.f);
+					buffer->Vertices.push_back(video::S3DVertex2TCoords(
+						corner + core::vector3df((f32)x * 4.f, 0.f, (f32)z * 4.f),
+						core::vector3df(0.f, 1.f, 0.f), video::SColor(255, 255, 255, 255),
+						tc, tc / 16.f));
+				}
+			}
+			for (u32 z=0; z+1<size; ++z)
+			{
+				for (u32 x=0; x+1<size; ++x)
+				{
+					const u16 i = (u16)(z * size + x);
+					buffer->Indices.push_back(i);
+					buffer->Indices.push_back(i + size);
+					buffer->Indices.push_back(i + 1);
+					buffer->Indices.push_back(i + 1);
+					buffer->Indices.push_back(i + size);
+					buffer->Indices.push_back(i + size + 1);
+				}
+			}
+			buffer->recalculateBoundingBox();
+
+			scene::IMeshSceneNode* node = smgr->addQuake3SceneNode(buffer, &Shader);
+			buffer->drop();
+			if (!node)
+				return false;
+		}
+
+		smgr->addCameraSceneNode(0, core::vector3df(0.f, 60.f, 0.f),
+			core::vector3df(0.f, 0.f, 400.f));
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		drawFrame(ctx);
+		return Count;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		ctx.Device->getSceneManager()->clear();
+
+		if (Shader.VarGroup)
+			Shader.VarGroup->drop();
+		Shader.VarGroup = 0;
+
+		if (Lightmap)
+			ctx.Device->getVideoDriver()->removeTexture(Lightmap);
+		Lightmap = 0;
+	}
+
+private:
+
+	scene::quake3::IShader Shader;
+	video::ITexture* Lightmap;
+	u32 Count;
+};
+
+//! Drawing a grid of detailed meshes from a distance, with or without levels of detail
+/** Returns the triangles drawn, so the report shows the count at each distance. */
+class CSceneLODBenchmark : public IBenchmark
+{
+public:
+
+	CSceneLODBenchmark(const c8* name, f32 distance, bool lod)
+		: IBenchmark(name), Distance(distance), LOD(lod), Mesh(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+		// 8k triangles each
+		scene::IMesh* sphere = smgr->getGeometryCreator()->createSphereMesh(10.f, 64, 64);
+		if (!sphere)
+			return false;
+
+		Mesh = sphere;
+		if (LOD)
+		{
+			// kept in the mesh cache like a loaded mesh
+			scene::SLODMesh* lodMesh = smgr->getMeshManipulator()->createLODMesh(sphere, 5);
+			sphere->drop();
+			smgr->getMeshCache()->addMesh("benchmark_sphere.lod", lodMesh);
+			lodMesh->drop();
+			Mesh = lodMesh;
+		}
+
+		const s32 count = 8;
+		for (s32 z=0; z<count; ++z)
+		{
+			for (s32 x=0; x<count; ++x)
+			{
+				const core::vector3df pos((x - count/2) * 40.f, 0.f, z * 40.f);
+				scene::IMeshSceneNode* node = smgr->addMeshSceneNode(Mesh, 0, -1, pos);
+				node->setMaterialFlag(video::EMF_LIGHTING, false);
+			}
+		}
+
+		smgr->addCameraSceneNode(0, core::vector3df(0.f, 40.f, -Distance),
+			core::vector3df(0.f, 0.f, count * 20.f));
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		drawFrame(ctx);
+		return ctx.Device->getVideoDriver()->getPrimitiveCountDrawn();
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		ctx.Device->getSceneManager()->clear();
+		if (LOD)
+			ctx.Device->getSceneManager()->getMeshCache()->removeMesh(Mesh);
+		else
+			Mesh->drop();
+		Mesh = 0;
+	}
+
+private:
+
+	f32 Distance;
+	bool LOD;
+	scene::IMesh* Mesh;
+};
+
+
+// A city block: a wall in front of the camera hides most of the scene
+class CSceneOcclusionBenchmark : public IBenchmark
+{
+public:
+
+	CSceneOcclusionBenchmark(const c8* name, bool occlusion)
+		: IBenchmark(name), Occlusion(occlusion) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+		scene::IMesh* cube = smgr->getGeometryCreator()->createCubeMesh(core::vector3df(10.f));
+		if (!cube)
+			return false;
+
+		scene::IMeshSceneNode* wall = smgr->addMeshSceneNode(cube, 0, -1,
+			core::vector3df(0.f, 0.f, 50.f), core::vector3df(0.f),
+			core::vector3df(30.f, 20.f, 1.f));
+		wall->setMaterialFlag(video::EMF_LIGHTING, false);
+		wall->setIsOccluder(true);
+		cube->drop();
+
+		scene::IMesh* sphere = smgr->getGeometryCreator()->createSphereMesh(5.f, 16, 16);
+		if (!sphere)
+			return false;
+
+		const s32 count = 10;
+		for (s32 z=0; z<count; ++z)
+		{
+			for (s32 x=0; x<count; ++x)
+			{
+				const core::vector3df pos((x - count/2) * 12.f, 0.f, 100.f + z * 12.f);
+				scene::IMeshSceneNode* node = smgr->addMeshSceneNode(sphere, 0, -1, pos);
+				node->setMaterialFlag(video::EMF_LIGHTING, false);
+			}
+		}
+		sphere->drop();
+
+		smgr->addCameraSceneNode(0, core::vector3df(0.f, 0.f, -50.f),
+			core::vector3df(0.f, 0.f, 100.f));
+		smgr->setOcclusionCulling(Occlusion);
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		drawFrame(ctx);
+		return ctx.Device->getVideoDriver()->getPrimitiveCountDrawn();
+	}
+
+	//! A node coming out from behind the wall has to be drawn in the same frame
+	virtual bool check(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+		video::IVideoDriver* driver = ctx.Device->getVideoDriver();
+
+		scene::IMesh* sphere = smgr->getGeometryCreator()->createSphereMesh(5.f, 16, 16);
+		scene::IMeshSceneNode* probe = smgr->addMeshSceneNode(sphere, 0, -1,
+			core::vector3df(0.f, 0.f, 80.f));
+		sphere->drop();
+
+		// long enough for the tests of the hidden probe to be scheduled
+		for (u32 i=0; i<10; ++i)
+			drawFrame(ctx);
+
+		probe->setPosition(core::vector3df(0.f, 0.f, 20.f));
+		drawFrame(ctx);
+		const u32 firstFrame = driver->getPrimitiveCountDrawn();
+
+		for (u32 i=0; i<10; ++i)
+			drawFrame(ctx);
+		const u32 laterFrame = driver->getPrimitiveCountDrawn();
+
+		probe->remove();
+
+		if (firstFrame != laterFrame)
+		{
+			fprintf(stderr, "  %u primitives drawn when the probe came into view, later %u\n",
+				firstFrame, laterFrame);
+			return false;
+		}
+		return true;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		ctx.Device->getSceneManager()->setOcclusionCulling(false);
+		ctx.Device->getSceneManager()->clear();
+	}
+
+private:
+
+	bool Occlusion;
+};
+
+//! Length, width and height of a room of the generated level
+const f32 ROOM_SIZE = 100.f;
+
+//! Quads along each side of a wall of a room
+const u32 WALL_DIVISIONS = 4;
+
+//! Faces of a room, of its floor, ceiling and two side walls
+const u32 ROOM_FACES = 4 * WALL_DIVISIONS * WALL_DIVISIONS;
+
+//! Generated level of rooms in a straight corridor along the x axis
+/** Each room is a leaf and a cluster of the bsp tree. From each room, the two
+rooms in each direction are potentially visible. */
+class CCorridorLevelMesh : public scene::IQ3LevelMesh
+{
+public:
+
+	CCorridorLevelMesh(u32 roomCount) : Mesh(new scene::SMesh)
+	{
+		scene::SMeshBuffer* buffer = new scene::SMeshBuffer;
+		buffer->Material.Lighting = false;
+		buffer->Material.BackfaceCulling = false;
+
+		for (u32 room=0; room<roomCount; ++room)
+		{
+			const f32 x = room * ROOM_SIZE;
+			const f32 h = ROOM_SIZE * 0.5f;
+			const core::vector3df length(ROOM_SIZE, 0.f, 0.f);
+
+			addWall(buffer, core::vector3df(x, 0.f, -h), length, core::vector3df(0.f, 0.f, ROOM_SIZE));
+			addWall(buffer, core::vector3df(x, ROOM_SIZE, -h), length, core::vector3df(0.f, 0.f, ROOM_SIZE));
+			addWall(buffer, core::vector3df(x, 0.f, -h), length, core::vector3df(0.f, ROOM_SIZE, 0.f));
+			addWall(buffer, core::vector3df(x, 0.f, h), length, core::vector3df(0.f, ROOM_SIZE, 0.f));
+
+			scene::quake3::SBSPLeaf leaf;
+			leaf.Box = core::aabbox3df(x, 0.f, -h, x + ROOM_SIZE, ROOM_SIZE, h);
+			leaf.Cluster = room;
+			leaf.FirstFace = room * ROOM_FACES;
+			leaf.FaceCount = ROOM_FACES;
+			Tree.Leafs.push_back(leaf);
+		}
+
+		buffer->recalculateBoundingBox();
+		Mesh->addMeshBuffer(buffer);
+		Mesh->recalculateBoundingBox();
+		buffer->drop();
+
+		for (u32 i=0; i<Tree.Faces.size(); ++i)
+			Tree.LeafFaces.push_back(i);
+
+		addNode(0, roomCount);
+
+		Tree.ClusterCount = roomCount;
+		Tree.BytesPerCluster = (roomCount + 7) / 8;
+		Tree.Visibility.set_used(roomCount * Tree.BytesPerCluster);
+		memset(Tree.Visibility.pointer(), 0, Tree.Visibility.size());
+		for (s32 from=0; from<(s32)roomCount; ++from)
+		{
+			for (s32 to=core::max_(from - 2, 0); to<=core::min_(from + 2, (s32)roomCount - 1); ++to)
+				Tree.Visibility[from * Tree.BytesPerCluster + (to >> 3)] |= 1 << (to & 7);
+		}
+	}
+
+	virtual ~CCorridorLevelMesh()
+	{
+		Mesh->drop();
+	}
+
+	virtual const scene::quake3::IShader* getShader(const c8* filename, bool fileNameIsValid=true) { return 0; }
+	virtual const scene::quake3::IShader* getShader(u32 index) const { return 0; }
+	virtual scene::quake3::tQ3EntityList& getEntityList() { return Entities; }
+	virtual scene::IMesh* getBrushEntityMesh(s32 num) const { return 0; }
+	virtual scene::IMesh* getBrushEntityMesh(scene::quake3::IEntity& ent) const { return 0; }
+	virtual const scene::quake3::SBSPTree& getBSPTree() const { return Tree; }
+
+	virtual u32 getFrameCount() const { return 1; }
+	virtual f32 getAnimationSpeed() const { return 0.f; }
+	virtual void setAnimationSpeed(f32 fps) {}
+
+	virtual scene::IMesh* getMesh(s32 frame, s32 detailLevel=255, s32 startFrameLoop=-1, s32 endFrameLoop=-1)
+	{
+		return frame == scene::quake3::E_Q3_MESH_GEOMETRY ? Mesh : 0;
+	}
+
+	virtual u32 getMeshBufferCount() const { return Mesh->getMeshBufferCount(); }
+	virtual scene::IMeshBuffer* getMeshBuffer(u32 nr) const { return Mesh->getMeshBuffer(nr); }
+	virtual scene::IMeshBuffer* getMeshBuffer(const video::SMaterial& material) const { return Mesh->getMeshBuffer(material); }
+	virtual const core::aabbox3d<f32>& getBoundingBox() const { return Mesh->getBoundingBox(); }
+	virtual void setBoundingBox(const core::aabbox3df& box) { Mesh->setBoundingBox(box); }
+	virtual void setMaterialFlag(video::E_MATERIAL_FLAG flag, bool newvalue) { Mesh->setMaterialFlag(flag, newvalue); }
+	virtual void setHardwareMappingHint(scene::E_HARDWARE_MAPPING newMappingHint, scene::E_BUFFER_TYPE buffer=scene::EBT_VERTEX_AND_INDEX) { Mesh->setHardwareMappingHint(newMappingHint, buffer); }
+	virtual void setDirty(scene::E_BUFFER_TYPE buffer=scene::EBT_VERTEX_AND_INDEX) { Mesh->setDirty(buffer); }
+
+private:
+
+	//! Adds the quads of a wall, each one a face of the level
+	void addWall(scene::SMeshBuffer* buffer, const core::vector3df& origin,
+		const core::vector3df& u, const core::vector3df& v)
+	{
+		const f32 step = 1.f / WALL_DIVISIONS;
+		for (u32 a=0; a<WALL_DIVISIONS; ++a)
+		{
+			for (u32 b=0; b<WALL_DIVISIONS; ++b)
+			{
+				const core::vector3df corner = origin + u * (a * step) + v * (b * step);
+				const u16 first = (u16)buffer->Vertices.size();
+				buffer->Vertices.push_back(video::S3DVertex(corner, core::vector3df(0.f, 1.f, 0.f),
+					video::SColor(255, 255, 255, 255), core::vector2df(0.f, 0.f)));
+				buffer->Vertices.push_back(video::S3DVertex(corner + u * step, core::vector3df(0.f, 1.f, 0.f),
+					video::SColor(255, 255, 255, 255), core::vector2df(1.f, 0.f)));
+				buffer->Vertices.push_back(video::S3DVertex(corner + u * step + v * step, core::vector3df(0.f, 1.f, 0.f),
+					video::SColor(255, 255, 255, 255), core::vector2df(1.f, 1.f)));
+				buffer->Vertices.push_back(video::S3DVertex(corner + v * step, core::vector3df(0.f, 1.f, 0.f),
+					video::SColor(255, 255, 255, 255), core::vector2df(0.f, 1.f)));
+
+				scene::quake3::SBSPFace face;
+				face.MeshBuffer = 0;
+				face.Indices.Start = buffer->Indices.size();
+				face.Indices.Count = 6;
+				Tree.Faces.push_back(face);
+
+				const u16 indices[6] = { 0, 1, 2, 0, 2, 3 };
+				for (u32 i=0; i<6; ++i)
+					buffer->Indices.push_back(first + indices[i]);
+			}
+		}
+	}
+
+	//! Adds the nodes splitting the rooms first to last, returns the child index
+	s32 addNode(u32 first, u32 last)
+	{
+		if (last - first == 1)
+			return -(s32)(first + 1);
+
+		const u32 split = (first + last) / 2;
+		const s32 index = Tree.Nodes.size();
+		Tree.Nodes.push_back(scene::quake3::SBSPNode());
+		Tree.Nodes[index].Plane.setPlane(core::vector3df(split * ROOM_SIZE, 0.f, 0.f),
+			core::vector3df(1.f, 0.f, 0.f));
+
+		// by index, adding the children may reallocate the array
+		const s32 back = addNode(first, split);
+		Tree.Nodes[index].Children[1] = back;
+		const s32 front = addNode(split, last);
+		Tree.Nodes[index].Children[0] = front;
+		return index;
+	}
+
+	scene::SMesh* Mesh;
+	scene::quake3::SBSPTree Tree;
+	scene::quake3::tQ3EntityList Entities;
+};
+
+//! Flight through a generated level drawn with its bsp tree and visibility data
+class CSceneBSPLevelBenchmark : public IBenchmark
+{
+public:
+
+	CSceneBSPLevelBenchmark() : IBenchmark("scene.bsp.level"), Level(0), Camera(0) {}
+
+	virtual bool setUp(SBenchmarkContext& ctx)
+	{
+		scene::ISceneManager* smgr = ctx.Device->getSceneManager();
+
+		CCorridorLevelMesh* mesh = new CCorridorLevelMesh(ROOM_COUNT);
+		Level = smgr->addBSPLevelSceneNode(mesh);
+		mesh->drop();
+		if (!Level)
+			return false;
+
+		Camera = smgr->addCameraSceneNode();
+		return true;
+	}
+
+	virtual u32 run(SBenchmarkContext& ctx)
+	{
+		const u32 frames = 16 * ctx.Scale;
+
+		u32 faces = 0;
+		for (u32 i=0; i<frames; ++i)
+		{
+			const f32 x = ((i * 7) % (ROOM_COUNT * 10)) * ROOM_SIZE * 0.1f;
+			setCamera(x, (i & 1) ? 1.f : -1.f);
+			drawFrame(ctx);
+			faces += Level->getVisibleFaceCount();
+		}
+		return faces;
+	}
+
+	//! The faces drawn from fixed camera positions
+	virtual bool check(SBenchmarkContext& ctx)
+	{
+		struct SView
+		{
+			//! Room of the camera
+			u32 Room;
+			//! Direction along the corridor
+			f32 Direction;
+			//! Rooms in front of the camera which are potentially visible
+			u32 VisibleRooms;
+		};
+
+		// the rooms behind the camera are outside of the frustum, those
+		// further than two rooms aren't potentially visible
+		const SView views[] = {
+			{ 10, 1.f, 3 },
+			{ 10, -1.f, 3 },
+			{ 1, -1.f, 2 },
+			{ ROOM_COUNT - 1, 1.f, 1 } };
+
+		video::IVideoDriver* driver = ctx.Device->getVideoDriver();
+		for (u32 i=0; i<sizeof(views) / sizeof(views[0]); ++i)
+		{
+			setCamera((views[i].Room + 0.5f) * ROOM_SIZE, views[i].Direction);
+			drawFrame(ctx);
+
+			const u32 faces = Level->getVisibleFaceCount();
+			const u32 primitives = driver->getPrimitiveCountDrawn();
+			if (faces != views[i].VisibleRooms * ROOM_FACES || primitives != faces * 2)
+			{
+				fprintf(stderr, "  %u faces and %u primitives drawn from room %u, expected %u faces\n",
+					faces, primitives, views[i].Room, views[i].VisibleRooms * ROOM_FACES);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	virtual void tearDown(SBenchmarkContext& ctx)
+	{
+		ctx.Device->getSceneManager()->clear();
+		Level = 0;
+		Camera = 0;
+	}
+
+private:
+
+	static const u32 ROOM_COUNT = 64;
+
+	//! Puts the camera in the middle of the corridor, looking along it
+	void setCamera(f32 x, f32 direction)
+	{
+		const core::vector3df pos(x, ROOM_SIZE * 0.5f, 0.f);
+		Camera->setPosition(pos);
+		Camera->setTarget(pos + core::vector3df(direction, 0.f, 0.f));
+	}
+
+	scene::IBSPLevelSceneNode* Level;
+	scene::ICameraSceneNode* Camera;
+};
+
+CSceneCullBenchmark sceneCull("scene.cull", false);
+CSceneCullBenchmark sceneCullCached("scene.cull.cached", true);
+CSceneSkinningBenchmark sceneSkinning;
+CSceneOctreeBenchmark sceneOctreePolys("scene.octree.polys", scene::EOV_NO_VBO);
+CSceneOctreeBenchmark sceneOctreeRanges("scene.octree.ranges", scene::EOV_USE_VBO_WITH_VISIBITLY);
+CSceneBillboardsBenchmark sceneBillboardsNodes("scene.billboards.nodes", false);
+CSceneBillboardsBenchmark sceneBillboardsGroup("scene.billboards.group", true);
+CSceneTerrainBenchmark sceneTerrain;
+CSceneLightsBenchmark sceneLightsSorted("scene.lights.sorted", false);
+CSceneLightsBenchmark sceneLightsClustered("scene.lights.clustered", true);
+CSceneQ3ShaderBenchmark sceneQ3Shader;
+CSceneLODBenchmark sceneLODNear("scene.lod.near", 60.f, true);
+CSceneLODBenchmark sceneLODMid("scene.lod.mid", 250.f, true);
+CSceneLODBenchmark sceneLODFar("scene.lod.far", 1000.f, true);
+CSceneLODBenchmark sceneLODFarFull("scene.lod.far.full", 1000.f, false);
+CSceneOcclusionBenchmark sceneOcclusionOff("scene.occlusion.off", false);
+CSceneOcclusionBenchmark sceneOcclusionOn("scene.occlusion.on", true);
+CSceneBSPLevelBenchmark sceneBSPLevel;
+CCollisionRayBenchmark collisionRay;
+CCollisionResponseBenchmark collisionResponse;
+CCollisionTerrainBenchmark collisionTerrain;
+
+} // end anonymous namespace
@@ -0,0 +1,295 @@
+#include <irrlicht.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "exampleHelper.h"
+#include "Benchmark.h"
+
+using namespace irr;
+
+IBenchmark* IBenchmark::First = 0;
+
+namespace
+{
+
+struct SBenchmarkEntry
+{
+	IBenchmark* Benchmark;
+
+	bool operator<(const SBenchmarkEntry& other) const
+	{
+		return strcmp(Benchmark->getName(), other.Benchmark->getName()) < 0;
+	}
+};
+
+struct SBenchmarkResult
+{
+	const c8* Name;
+	bool Skipped;
+	bool Failed;
+	u32 Iterations;
+	u64 Items;
+	u64 MinUs;
+	u64 MedianUs;
+	u64 MeanUs;
+	u64 MaxUs;
+};
+
+void printUsage()
+{
+	fprintf(stderr,
+		"Usage: Benchmarks [options]\n"
+		"  --filter <text>     only run benchmarks whose name contains text\n"
+		"  --iterations <n>    timed iterations per benchmark (default 20)\n"
+		"  --warmup <n>        untimed iterations before measuring (default 2)\n"
+		"  --seed <n>          seed for the generated workloads (default 1234)\n"
+		"  --scale <n>         workload size multiplier (default 1)\n"
+		"  --media <path>      media directory\n"
+		"  --out <file>        write the JSON report to file instead of stdout\n"
+		"  --trace <file>      write a Chrome trace of the timed iterations to file\n"
+		"  --list              list the benchmark names and exit\n"
+		"  --verbose           don't silence the engine log\n");
+}
+
+SBenchmarkResult runBenchmark(IBenchmark* benchmark, SBenchmarkContext& ctx,
+	u32 warmup, u32 iterations)
+{
+	SBenchmarkResult result;
+	memset(&result, 0, sizeof(SBenchmarkResult));
+	result.Name = benchmark->getName();
+
+	ITimer* timer = ctx.Device->getTimer();
+
+	ctx.Random->reset(ctx.Seed);
+	timer->setTime(0);
+
+	if (!benchmark->setUp(ctx))
+	{
+		benchmark->tearDown(ctx);
+		result.Skipped = true;
+		return result;
+	}
+
+	for (u32 i=0; i<warmup; ++i)
+		benchmark->run(ctx);
+
+	// shows up in the trace, with the engine's own scopes nested inside
+	const s32 profileId = getProfiler().add(core::stringw(result.Name), L"benchmarks");
+
+	core::array<u64> samples(iterations);
+	for (u32 i=0; i<iterations; ++i)
+	{
+		CProfileScope scope(profileId);
+		const u64 start = timer->getRealTimeUs();
+		result.Items += benchmark->run(ctx);
+		samples.push_back(timer->getRealTimeUs() - start);
+	}
+
+	result.Failed = !benchmark->check(ctx);
+
+	benchmark->tearDown(ctx);
+
+	result.Iterations = samples.size();
+	if (!samples.empty())
+	{
+		samples.sort();
+
+		u64 total = 0;
+		for (u32 i=0; i<samples.size(); ++i)
+			total += samples[i];
+
+		result.MinUs = samples[0];
+		result.MedianUs = samples[samples.size()/2];
+		result.MeanUs = total / samples.size();
+		result.MaxUs = samples.getLast();
+	}
+
+	return result;
+}
+
+void writeReport(FILE* out, const core::array<SBenchmarkResult>& results,
+	const SBenchmarkContext& ctx, u32 warmup, u32 iterations)
+{
+	fprintf(out, "{\n");
+	fprintf(out, "\t\"engine\": \"%s\",\n", IRRLICHT_SDK_VERSION);
+	fprintf(out, "\t\"seed\": %d,\n", ctx.Seed);
+	fprintf(out, "\t\"scale\": %u,\n", ctx.Scale);
+	fprintf(out, "\t\"warmup\": %u,\n", warmup);
+	fprintf(out, "\t\"iterations\": %u,\n", iterations);
+	fprintf(out, "\t\"benchmarks\": [");
+
+	for (u32 i=0; i<results.size(); ++i)
+	{
+		const SBenchmarkResult& r = results[i];
+
+		fprintf(out, "%s\n\t\t{\n", i ? "," : "");
+		fprintf(out, "\t\t\t\"name\": \"%s\",\n", r.Name);
+		if (r.Skipped)
+		{
+			fprintf(out, "\t\t\t\"skipped\": true\n\t\t}");
+			continue;
+		}
+
+		// items per second over the summed iteration times
+		const u64 totalUs = r.MeanUs * r.Iterations;
+		const f64 itemsPerSecond = totalUs ? (f64)r.Items * 1000000.0 / (f64)totalUs : 0.0;
+
+		fprintf(out, "\t\t\t\"skipped\": false,\n");
+		fprintf(out, "\t\t\t\"failed\": %s,\n", r.Failed ? "true" : "false");
+		fprintf(out, "\t\t\t\"iterations\": %u,\n", r.Iterations);
+		fprintf(out, "\t\t\t\"items\": %llu,\n", (unsigned long long)r.Items);
+		fprintf(out, "\t\t\t\"min_us\": %llu,\n", (unsigned long long)r.MinUs);
+		fprintf(out, "\t\t\t\"median_us\": %llu,\n", (unsigned long long)r.MedianUs);
+		fprintf(out, "\t\t\t\"mean_us\": %llu,\n", (unsigned long long)r.MeanUs);
+		fprintf(out, "\t\t\t\"max_us\": %llu,\n", (unsigned long long)r.MaxUs);
+		fprintf(out, "\t\t\t\"items_per_second\": %.1f\n", itemsPerSecond);
+		fprintf(out, "\t\t}");
+	}
+
+	fprintf(out, "\n\t]\n}\n");
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+	SBenchmarkContext ctx;
+	ctx.Seed = 1234;
+	ctx.MediaPath = getExampleMediaPath();
+
+	const c8* filter = 0;
+	const c8* outFile = 0;
+	const c8* traceFile = 0;
+	u32 iterations = 20;
+	u32 warmup = 2;
+	bool list = false;
+	bool verbose = false;
+
+	for (s32 i=1; i<argc; ++i)
+	{
+		const bool hasValue = i+1 < argc;
+
+		if (!strcmp(argv[i], "--filter") && hasValue)
+			filter = argv[++i];
+		else if (!strcmp(argv[i], "--iterations") && hasValue)
+			iterations = (u32)strtoul(argv[++i], 0, 10);
+		else if (!strcmp(argv[i], "--warmup") && hasValue)
+			warmup = (u32)strtoul(argv[++i], 0, 10);
+		else if (!strcmp(argv[i], "--seed") && hasValue)
+			ctx.Seed = (s32)strtol(argv[++i], 0, 10);
+		else if (!strcmp(argv[i], "--scale") && hasValue)
+			ctx.Scale = core::max_(1u, (u32)strtoul(argv[++i], 0, 10));
+		else if (!strcmp(argv[i], "--media") && hasValue)
+		{
+			ctx.MediaPath = argv[++i];
+			if (ctx.MediaPath.size() && ctx.MediaPath.lastChar() != '/')
+				ctx.MediaPath.append('/');
+		}
+		else if (!strcmp(argv[i], "--out") && hasValue)
+			outFile = argv[++i];
+		else if (!strcmp(argv[i], "--trace") && hasValue)
+			traceFile = argv[++i];
+		else if (!strcmp(argv[i], "--list"))
+			list = true;
+		else if (!strcmp(argv[i], "--verbose"))
+			verbose = true;
+		else
+		{
+			printUsage();
+			return 1;
+		}
+	}
+
+	// run in a stable order, registration order depends on the link order
+	core::array<SBenchmarkEntry> benchmarks;
+	for (IBenchmark* b = IBenchmark::getFirst(); b; b = b->getNext())
+	{
+		if (filter && !strstr(b->getName(), filter))
+			continue;
+		SBenchmarkEntry entry;
+		entry.Benchmark = b;
+		benchmarks.push_back(entry);
+	}
+	benchmarks.sort();
+
+	if (list)
+	{
+		for (u32 i=0; i<benchmarks.size(); ++i)
+			printf("%s\n", benchmarks[i].Benchmark->getName());
+		return 0;
+	}
+
+	SIrrlichtCreationParameters p;
+	p.DriverType = video::EDT_NULL;
+	p.WindowSize = core::dimension2du(1024, 768);
+	// the engine logs to stdout, which is where the report goes by default
+	p.LoggingLevel = verbose ? ELL_INFORMATION : ELL_NONE;
+
+	ctx.Device = createDeviceEx(p);
+	if (!ctx.Device)
+	{
+		fprintf(stderr, "Could not create a device with the null driver\n");
+		return 1;
+	}
+
+	ctx.Random = ctx.Device->createDefaultRandomizer();
+
+	// animations advance by the benchmarks setting the time, not by the clock
+	ctx.Device->getTimer()->stop();
+
+	if (traceFile)
+		getProfiler().startTrace(1 << 20);
+
+	bool failed = false;
+	core::array<SBenchmarkResult> results(benchmarks.size());
+	for (u32 i=0; i<benchmarks.size(); ++i)
+	{
+		fprintf(stderr, "%s\n", benchmarks[i].Benchmark->getName());
+		results.push_back(runBenchmark(benchmarks[i].Benchmark, ctx, warmup, iterations));
+		if (results.getLast().Skipped)
+			fprintf(stderr, "  skipped, setup failed\n");
+		else if (results.getLast().Failed)
+		{
+			fprintf(stderr, "  check failed\n");
+			failed = true;
+		}
+	}
+
+	if (traceFile)
+	{
+		getProfiler().stopTrace();
+
+		core::stringc trace;
+		getProfiler().printTrace(trace);
+
+		FILE* file = fopen(traceFile, "w");
+		if (file)
+		{
+			fwrite(trace.c_str(), 1, trace.size(), file);
+			fclose(file);
+		}
+		else
+			fprintf(stderr, "Could not open %s\n", traceFile);
+	}
+
+	ctx.Random->drop();
+	ctx.Device->drop();
+
+	FILE* out = stdout;
+	if (outFile)
+	{
+		out = fopen(outFile, "w");
+		if (!out)
+		{
+			fprintf(stderr, "Could not open %s\n", outFile);
+			return 1;
+		}
+	}
+
+	writeReport(out, results, ctx, warmup, iterations);
+
+	if (out != stdout)
+		fclose(out);
+
+	return failed ? 1 : 0;
+}
@@ -24,6 +24,9 @@ namespace io
 		//! CLimitReadFile
 		ERFT_LIMIT_READ_FILE = MAKE_IRR_ID('r','l','i','m'),
 
+		//! CInflateReadFile
+		ERFT_INFLATE_READ_FILE = MAKE_IRR_ID('r','i','n','f'),
+
 		//! Unknown type
 		EFIT_UNKNOWN        = MAKE_IRR_ID('u','n','k','n')
 	};
@@ -69,6 +69,9 @@ namespace scene
 		//! Billboard Scene Node
 		ESNT_BILLBOARD      = MAKE_IRR_ID('b','i','l','l'),
 
+		//! Billboard Group Scene Node
+		ESNT_BILLBOARD_GROUP = MAKE_IRR_ID('b','i','l','g'),
+
 		//! Animated Mesh Scene Node
 		ESNT_ANIMATED_MESH  = MAKE_IRR_ID('a','m','s','h'),
 
@@ -78,6 +81,9 @@ namespace scene
 		//! Quake3 Shader Scene Node
 		ESNT_Q3SHADER_SCENE_NODE  = MAKE_IRR_ID('q','3','s','h'),
 
+		//! Quake3 Level Scene Node drawing the faces visible in the bsp tree
+		ESNT_BSP_LEVEL      = MAKE_IRR_ID('b','s','p','l'),
+
 		//! Quake3 Model Scene Node ( has tag to link to )
 		ESNT_MD3_SCENE_NODE  = MAKE_IRR_ID('m','d','3','_'),
 
@@ -0,0 +1,50 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __I_BSP_LEVEL_SCENE_NODE_H_INCLUDED__
+#define __I_BSP_LEVEL_SCENE_NODE_H_INCLUDED__
+
+#include "ISceneNode.h"
+#include "SViewFrustum.h"
+
+namespace irr
+{
+namespace scene
+{
+
+//! Scene node drawing the geometry of a quake3 level with the help of its bsp tree
+/** Only the faces of leafs which are in a cluster potentially visible from the
+cluster of the camera, and which intersect the view frustum, are drawn. The
+visible faces of each mesh buffer are drawn with one
+IVideoDriver::drawMeshBufferRanges() call.
+Shader faces (E_Q3_MESH_ITEMS) aren't drawn by this node. */
+class IBSPLevelSceneNode : public ISceneNode
+{
+public:
+
+	//! Constructor
+	IBSPLevelSceneNode(ISceneNode* parent, ISceneManager* mgr, s32 id,
+			const core::vector3df& position = core::vector3df(0,0,0),
+			const core::vector3df& rotation = core::vector3df(0,0,0),
+			const core::vector3df& scale = core::vector3df(1,1,1))
+		: ISceneNode(parent, mgr, id, position, rotation, scale) {}
+
+	//! Collects the faces visible from a camera
+	/** render() does this for the active camera. It can also be called
+	without drawing, for example to test the visibility data of a level.
+	\param cameraPosition Position of the camera in world space.
+	\param frustum View frustum of the camera in world space.
+	\return Number of visible faces. */
+	virtual u32 calculateVisibleFaces(const core::vector3df& cameraPosition,
+			const SViewFrustum& frustum) = 0;
+
+	//! Returns the number of faces found by the last calculateVisibleFaces() call
+	virtual u32 getVisibleFaceCount() const = 0;
+};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
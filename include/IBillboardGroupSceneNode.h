@@ -0,0 +1,97 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __I_BILLBOARD_GROUP_SCENE_NODE_H_INCLUDED__
+#define __I_BILLBOARD_GROUP_SCENE_NODE_H_INCLUDED__
+
+#include "ISceneNode.h"
+
+namespace irr
+{
+namespace scene
+{
+
+//! A scene node drawing many billboards with one material.
+/** Each billboard is a quad which always looks to the camera, like the
+quad of an IBillboardSceneNode. The billboards of a group aren't scene nodes,
+they are stored in arrays of the group and the quads of all of them are built
+into one mesh buffer every frame, which is drawn with a single draw call. This
+is much faster for things like foliage, particles or name tags, where
+thousands of billboard scene nodes would need thousands of draw calls.
+All billboards share the material of the group, but each has its own
+texture coordinates, so they can show different parts of a texture atlas.
+Positions are relative to the group node, so moving, rotating or scaling the
+node changes all of its billboards. */
+class IBillboardGroupSceneNode : public ISceneNode
+{
+public:
+
+	//! Constructor
+	IBillboardGroupSceneNode(ISceneNode* parent, ISceneManager* mgr, s32 id,
+		const core::vector3df& position = core::vector3df(0,0,0))
+		: ISceneNode(parent, mgr, id, position) {}
+
+	//! Adds a billboard to the group.
+	/** \param position Center of the billboard, relative to the node.
+	\param size Width and height of the billboard.
+	\param color Color of all vertices of the billboard.
+	\param texCoords Texture coordinates of the upper left and lower right
+	corner of the billboard.
+	\return Index of the new billboard. */
+	virtual u32 addBillboard(const core::vector3df& position,
+		const core::dimension2d<f32>& size,
+		video::SColor color = video::SColor(0xFFFFFFFF),
+		const core::rect<f32>& texCoords = core::rect<f32>(0.f, 0.f, 1.f, 1.f)) = 0;
+
+	//! Removes a billboard from the group.
+	/** The last billboard of the group is moved to the index of the removed
+	one, so only its index changes. */
+	virtual void removeBillboard(u32 index) = 0;
+
+	//! Removes all billboards from the group.
+	virtual void removeAllBillboards() = 0;
+
+	//! Returns the number of billboards in the group.
+	virtual u32 getBillboardCount() const = 0;
+
+	//! Sets the position of a billboard, relative to the node.
+	virtual void setBillboardPosition(u32 index, const core::vector3df& position) = 0;
+
+	//! Returns the position of a billboard, relative to the node.
+	virtual const core::vector3df& getBillboardPosition(u32 index) const = 0;
+
+	//! Sets the width and height of a billboard.
+	virtual void setBillboardSize(u32 index, const core::dimension2d<f32>& size) = 0;
+
+	//! Returns the width and height of a billboard.
+	virtual const core::dimension2d<f32>& getBillboardSize(u32 index) const = 0;
+
+	//! Sets the color of all vertices of a billboard.
+	virtual void setBillboardColor(u32 index, video::SColor color) = 0;
+
+	//! Returns the color of a billboard.
+	virtual video::SColor getBillboardColor(u32 index) const = 0;
+
+	//! Sets the texture coordinates of the upper left and lower right corner of a billboard.
+	virtual void setBillboardTexCoords(u32 index, const core::rect<f32>& texCoords) = 0;
+
+	//! Returns the texture coordinates of a billboard.
+	virtual const core::rect<f32>& getBillboardTexCoords(u32 index) const = 0;
+
+	//! Sets if the billboards are drawn from back to front.
+	/** This is needed for transparent materials which write the depth
+	buffer or depend on the order of blending. The billboards are sorted by
+	their distance along the view direction of the camera every frame.
+	Disabled by default. */
+	virtual void setDepthSorting(bool sort) = 0;
+
+	//! Returns if the billboards are drawn from back to front.
+	virtual bool getDepthSorting() const = 0;
+};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
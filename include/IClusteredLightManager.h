@@ -0,0 +1,120 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __I_CLUSTERED_LIGHT_MANAGER_H_INCLUDED__
+#define __I_CLUSTERED_LIGHT_MANAGER_H_INCLUDED__
+
+#include "ISceneManager.h"
+#include "ILightManager.h"
+
+namespace irr
+{
+namespace scene
+{
+	class ILightSceneNode;
+
+	//! A light as stored in the light buffer of an IClusteredLightManager
+	/** Three vectors of 4 floats, so an array of them can be read by shaders
+	as a float4 buffer without conversion. All vectors are in view space. */
+	struct SClusteredLight
+	{
+		//! Position of point and spot lights
+		core::vector3df Position;
+
+		//! Radius of influence, 0 for directional lights
+		f32 Radius;
+
+		//! Diffuse color of the light
+		video::SColorf DiffuseColor;
+
+		//! Direction of spot and directional lights
+		core::vector3df Direction;
+
+		//! Cosine of half the outer cone of spot lights, -1 for the other lights
+		f32 CosOuterCone;
+	};
+
+	//! Light manager which assigns the lights of the scene to clusters of the view frustum.
+	/** Every frame, after the lights registered themselves, the view frustum
+	of the active camera is divided into a grid of clusters: tiles on the
+	screen, each split into slices along the view direction. Slices get
+	exponentially deeper between the near and the far plane of the camera.
+	Each point and spot light is assigned to the clusters its sphere of
+	influence touches, so a shader only needs to evaluate the lights of the
+	cluster a pixel is in, even with hundreds of lights in the scene.
+
+	The result is a light buffer with all lights in view space, a range of
+	the light index list for each cluster, and the index list itself.
+	Directional lights are at the start of the light buffer and don't appear
+	in the clusters, as they light everything.
+
+	All lights are still passed to the driver, nearest first, so materials
+	using the fixed function lighting get the closest lights.
+
+	Set it with ISceneManager::setLightManager(). */
+	class IClusteredLightManager : public ILightManager
+	{
+	public:
+
+		//! Sets the number of clusters
+		/** \param tilesX Columns of tiles on the screen, at most 64.
+		\param tilesY Rows of tiles on the screen, at most 64.
+		\param slices Slices along the view direction, at most 64.
+		The default is 16x8x24. */
+		virtual void setGridSize(u32 tilesX, u32 tilesY, u32 slices) = 0;
+
+		//! Returns the columns, rows and slices of the clusters
+		virtual core::vector3d<u32> getGridSize() const = 0;
+
+		//! Returns the number of clusters
+		virtual u32 getClusterCount() const = 0;
+
+		//! Sets how many lights can be assigned to one cluster
+		/** Lights are assigned nearest first, so the most distant lights of
+		a crowded cluster are left out. The default is 64. */
+		virtual void setMaxLightsPerCluster(u32 count) = 0;
+
+		//! Returns how many lights can be assigned to one cluster
+		virtual u32 getMaxLightsPerCluster() const = 0;
+
+		//! Sets the number of threads assigning the lights
+		/** \param count Number of threads including the calling one, 0 uses
+		one thread per hardware thread. Fewer threads are used when there are
+		only few lights. The default is 0. */
+		virtual void setThreadCount(u32 count) = 0;
+
+		//! Returns the index of the cluster containing a point
+		/** \param viewPosition Point in the view space of the last frame.
+		\return Index of the cluster, or -1 if the point is outside of the
+		view frustum. Clusters are numbered row by row from the lower left
+		tile of the nearest slice: x + (y + slice * tilesY) * tilesX. */
+		virtual s32 getClusterIndex(const core::vector3df& viewPosition) const = 0;
+
+		//! Returns the number of lights in the light buffer
+		virtual u32 getLightCount() const = 0;
+
+		//! Returns the number of directional lights at the start of the light buffer
+		virtual u32 getDirectionalLightCount() const = 0;
+
+		//! Returns the light buffer of the last frame
+		virtual const SClusteredLight* getLights() const = 0;
+
+		//! Returns the scene node of a light of the light buffer
+		virtual ILightSceneNode* getLightNode(u32 index) const = 0;
+
+		//! Returns the light ranges of all clusters
+		/** Two values per cluster, the offset of its first light index in
+		getLightIndices() and the number of its lights. */
+		virtual const u32* getClusterLightRanges() const = 0;
+
+		//! Returns the light indices of all clusters, indices into the light buffer
+		virtual const u16* getLightIndices() const = 0;
+
+		//! Returns the number of light indices of all clusters
+		virtual u32 getLightIndexCount() const = 0;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
@@ -91,6 +91,14 @@ public:
 	*/
 	virtual void addDirectoryToFileList(const io::path &filename) {}
 
+	//! Set how much decompressed data the archive may keep for opening files again
+	/** Archives with compressed files can keep recently opened files in
+	memory, so opening them again doesn't decompress them again. When the
+	budget is exceeded the least recently opened files are released first.
+	Archives which don't compress their files ignore this.
+	\param bytes Maximal size of all kept files. 0, the default, keeps none. */
+	virtual void setDecompressedCacheSize(u32 bytes) {}
+
 	//! An optionally used password string
 	/** This variable is publicly accessible from the interface in order to
 	avoid single access patterns to this place, and hence allow some more
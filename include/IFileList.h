@@ -74,6 +74,11 @@ public:
 	//! Returns the base path of the file list
 	virtual const io::path& getPath() const = 0;
 
+	//! Check if names are compared without their path
+	/** \return True if the list was created with ignorePaths. The full
+	names in the list are the file names without path then. */
+	virtual bool isIgnorePaths() const = 0;
+
 	//! Add as a file or folder to the list
 	/** \param fullPath The file name including path, from the root of the file list.
 	\param isDirectory True if this is a directory rather than a file.
@@ -17,6 +17,19 @@ namespace irr
 namespace video
 {
 
+//! Filters used to resample images
+enum E_IMAGE_FILTER
+{
+	//! Average of the covered pixels, the fastest filter
+	EIF_BOX = 0,
+
+	//! Linear interpolation, averaging the covered pixels when downscaling
+	EIF_TRIANGLE,
+
+	//! Lanczos with 3 lobes, sharper but may ring at hard edges
+	EIF_LANCZOS
+};
+
 //! Interface for software image data.
 /** Image loaders create these images from files. IVideoDrivers convert
 these images into their (hardware) textures.
@@ -359,6 +372,37 @@ public:
 	/**	NOTE: mipmaps are ignored */
 	virtual void copyToScalingBoxFilter(IImage* target, s32 bias = 0, bool blend = false) = 0;
 
+	//! Copies the image into the target, resampling it with a filter to fit
+	/**	Unlike copyToScaling every source pixel contributes to the result.
+	Works with ECF_A1R5G5B5, ECF_R5G6B5, ECF_R8G8B8 and ECF_A8R8G8B8 images.
+	NOTE: mipmaps are ignored
+	\param target Image which receives the resampled pixels.
+	\param filter Filter used in both directions.
+	\param threadCount Number of threads sharing the work, 0 uses one per
+	hardware thread. Small targets are resampled on the calling thread.
+	\return False if one of the color formats isn't supported. */
+	virtual bool copyToResampled(IImage* target, E_IMAGE_FILTER filter = EIF_TRIANGLE, u32 threadCount = 1) = 0;
+
+	//! Replaces the mipmaps data with mipmaps created from the image
+	/** Each level is downscaled from the level above it, the data has the
+	layout described in setMipMapsData. Works with the color formats
+	supported by copyToResampled.
+	\param filter Filter used to downscale the levels.
+	\param threadCount Number of threads sharing the work, 0 uses one per
+	hardware thread.
+	\return False if the color format isn't supported. */
+	virtual bool createMipMaps(E_IMAGE_FILTER filter = EIF_BOX, u32 threadCount = 1) = 0;
+
+	//! Compresses the image into the blocks of the target
+	/** The target must have the same size and one of the formats ECF_DXT1,
+	ECF_DXT5, ECF_ETC2_RGB or ECF_ETC2_ARGB. DXT1 blocks are always opaque.
+	NOTE: mipmaps are ignored
+	\param target Image which receives the compressed blocks.
+	\param threadCount Number of threads sharing the work, 0 uses one per
+	hardware thread.
+	\return False if the sizes or the color formats aren't supported. */
+	virtual bool copyToCompressed(IImage* target, u32 threadCount = 1) = 0;
+
 	//! fills the surface with given color
 	virtual void fill(const SColor &color) =0;
 
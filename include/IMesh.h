@@ -57,7 +57,10 @@ namespace scene
 		EAMT_SKINNED,
 
 		//! generic non-animated mesh
-		EAMT_STATIC
+		EAMT_STATIC,
+
+		//! static mesh with reduced levels of detail, see SLODMesh
+		EAMT_LOD
 	};
 
 
@@ -19,6 +19,7 @@ namespace scene
 {
 
 	struct SMesh;
+	struct SLODMesh;
 
 	//! An interface for easy manipulation of meshes.
 	/** Scale, set alpha value, flip surfaces, and so on. This exists for
@@ -321,6 +322,42 @@ namespace scene
 		\return A new mesh optimized for the vertex cache. */
 		virtual IMesh* createForsythOptimizedMesh(const IMesh *mesh) const = 0;
 
+		//! Creates a copy of a mesh with fewer triangles
+		/** Edges are collapsed in the order of their quadric error
+		metric, so flat areas lose their triangles first. Each mesh
+		buffer is reduced on its own and keeps its material, vertex type
+		and hardware mapping hints. The remaining vertices keep all
+		their attributes. Vertices on open borders only move along the
+		border, vertices on seams, where a position has several vertices
+		for different normals or texture coordinates, stay in place.
+
+		\param mesh Mesh with 16 bit indices.
+		\param ratio Part of the triangles to keep, between 0 and 1.
+		\return Reduced mesh, or 0 if a mesh buffer has 32 bit
+		indices. If you no longer need the mesh, you should call
+		IMesh::drop(). See IReferenceCounted::drop() for more
+		information. */
+		virtual SMesh* createSimplifiedMesh(IMesh* mesh, f32 ratio) const = 0;
+
+		//! Creates a level of detail chain of a mesh
+		/** Level 0 is the mesh itself, the following levels are
+		reduced like with createSimplifiedMesh(), each one continuing
+		from the previous. Level i is drawn down to a size of 0.5*ratio^i
+		of the viewport height, these thresholds can be changed in
+		SLODMesh::MinScreenSizes. The chain can be added to the mesh
+		cache with IMeshCache::addMesh() and to the scene with
+		ISceneManager::addMeshSceneNode().
+		\param mesh Mesh with 16 bit indices.
+		\param levelCount Number of levels including the mesh itself.
+		Fewer levels are created if the mesh can't be reduced further.
+		\param ratio Part of the triangles each level keeps of the
+		previous one, between 0 and 1 exclusive. With other values the
+		chain only has level 0.
+		\return Level of detail chain. If you no longer need it, you
+		should call IMesh::drop(). See IReferenceCounted::drop() for
+		more information. */
+		virtual SLODMesh* createLODMesh(IMesh* mesh, u32 levelCount=4, f32 ratio=0.5f) const = 0;
+
 		//! Optimize the mesh with an algorithm tuned for heightmaps.
 		/**
 		This differs from usual simplification methods in two ways:
@@ -30,9 +30,9 @@ enum EOCTREENODE_VBO
 	//! In most cases the other 2 options should work better with an octree.
 	EOV_USE_VBO,
 
-	//! VBO's used. The index-buffer information is updated each frame
-	//! with only the visible parts of a tree-node.
-	//! So the vertex-buffer is static and the index-buffer is dynamic.
+	//! VBO's used. The indices are sorted by tree-node, so that each node and its
+	//! children use one range of the index-buffer. Only the ranges of the visible
+	//! nodes are drawn, so vertex- and index-buffer are both static.
 	//! This is the default
 	EOV_USE_VBO_WITH_VISIBITLY
 };
@@ -63,9 +63,12 @@ public:
 			const core::vector3df& scale = core::vector3df(1,1,1))
 		: IMeshSceneNode(parent, mgr, id, position, rotation, scale) {}
 
+	//! Set if/how vertex buffer object are used for the meshbuffers
+	/** NOTE: When there is already a mesh in the node this will rebuild
+	the octree. */
+	virtual void setUseVBO(EOCTREENODE_VBO useVBO) = 0;
+
 	//! Get if/how vertex buffer object are used for the meshbuffers
-	// NOTE: Will currently _always_ return EOV_NO_VBO.
-	// Octree's with VBO's don't work yet correctly.
 	virtual EOCTREENODE_VBO getUseVBO() const = 0;
 
 	//! Set the kind of tests polygons do for visibility against the camera
@@ -10,6 +10,7 @@
 #include "irrArray.h"
 #include "ITimer.h"
 #include <limits.h>	// for INT_MAX (we should have a S32_MAX...)
+#include <atomic>
 
 namespace irr
 {
@@ -42,6 +43,11 @@ struct SProfileData
 		return GroupIndex;
 	}
 
+	s32 getId() const
+	{
+		return Id;
+	}
+
 	const core::stringw& getName() const
 	{
 		return Name;
@@ -102,7 +108,7 @@ class IProfiler
 {
 public:
 	//! Constructor. You could use this to create a new profiler, but usually getProfiler() is used to access the global instance.
-    IProfiler()	: Timer(0), NextAutoId(INT_MAX)
+    IProfiler()	: Timer(0), Tracing(false), NextAutoId(INT_MAX)
 	{}
 
 	virtual ~IProfiler()
@@ -205,6 +211,40 @@ public:
 	\param groupIndex_	*/
     virtual void printGroup(core::stringw &result, u32 groupIndex, bool suppressUncalled) const = 0;
 
+	//! Start recording a trace
+	/** While tracing, each start/stop pair and each CProfileTraceScope is recorded as one event
+	with nanosecond timestamps, the thread it ran on and its nesting depth. Recording is lock-free,
+	the events go into a ring buffer which overwrites the oldest events once it's full.
+	Stops a running trace first and waits until no thread writes an event anymore.
+	\param maxEvents Size of the ring buffer, rounded up to a power of two. */
+	virtual void startTrace(u32 maxEvents=65536) = 0;
+
+	//! Stop recording the trace. Recorded events are kept until the next startTrace.
+	/** Returns once no thread writes an event anymore. */
+	virtual void stopTrace() = 0;
+
+	//! Returns true while a trace is recorded
+	bool isTracing() const
+	{
+		return Tracing.load(std::memory_order_acquire);
+	}
+
+	//! Begin a traced scope for the given id on the calling thread
+	/** Unlike start() this doesn't touch the profile data, so it can be called from any thread.
+	Has to be followed by endTraceScope() on the same thread. Usually CProfileTraceScope is used instead.
+	\param id Any id which you did add to the profiler before. */
+	virtual void beginTraceScope(s32 id) = 0;
+
+	//! End the innermost traced scope of the calling thread
+	virtual void endTraceScope() = 0;
+
+	//! Write the recorded trace into a string in the Chrome trace event format
+	/** The result is JSON which can be loaded by chrome://tracing or Perfetto.
+	Names and groups of the ids are used as event names and categories.
+	Has to be called after stopTrace(), while recording the result only gets an empty trace.
+	\param result Receives the result string. */
+	virtual void printTrace(core::stringc &result) const = 0;
+
 protected:
 
     inline u32 addGroup(const core::stringw &name);
@@ -214,6 +254,8 @@ protected:
     ITimer * Timer;
 	core::array<SProfileData> ProfileDatas;
     core::array<SProfileData> ProfileGroups;
+	// read by the threads recording trace scopes
+	std::atomic<bool> Tracing;
 
 private:
     s32 NextAutoId;	// for giving out id's automatically
@@ -275,11 +317,40 @@ protected:
 	IProfiler& Profiler;
 };
 
+//! Class where the objects record their own life-time into the profiler trace.
+/** Unlike CProfileScope this doesn't update the profile data, so it can be used on worker threads.
+It does nothing while the profiler isn't tracing. */
+class CProfileTraceScope
+{
+public:
+	//! Construct with an known id.
+	/** \param id Any id which you did add to the profiler before. */
+	CProfileTraceScope(s32 id)
+	: Profiler(getProfiler()), Active(Profiler.isTracing())
+	{
+		if ( Active )
+			Profiler.beginTraceScope(id);
+	}
+
+	~CProfileTraceScope()
+	{
+		if ( Active )
+			Profiler.endTraceScope();
+	}
+
+protected:
+	IProfiler& Profiler;
+	bool Active;
+};
+
 
 // IMPLEMENTATION for in-line stuff
 
 void IProfiler::start(s32 id)
 {
+	if ( isTracing() )
+		beginTraceScope(id);
+
 	s32 idx = ProfileDatas.binary_search(SProfileData(id));
 	if ( idx >= 0 && Timer )
 	{
@@ -291,6 +362,9 @@ void IProfiler::start(s32 id)
 
 void IProfiler::stop(s32 id)
 {
+	if ( isTracing() )
+		endTraceScope();
+
 	if ( Timer )
 	{
 		u32 timeNow = Timer->getRealTime();
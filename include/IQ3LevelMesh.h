@@ -7,11 +7,103 @@
 
 #include "IAnimatedMesh.h"
 #include "IQ3Shader.h"
+#include "plane3d.h"
+#include "SVertexIndex.h"
 
 namespace irr
 {
 namespace scene
 {
+namespace quake3
+{
+	//! Node of the bsp tree of a quake3 level
+	struct SBSPNode
+	{
+		//! Splitting plane, Children[0] is in front of it
+		core::plane3df Plane;
+
+		//! Indices of the child nodes, a negative value -(i+1) refers to leaf i
+		s32 Children[2];
+	};
+
+	//! Leaf of the bsp tree of a quake3 level
+	struct SBSPLeaf
+	{
+		//! Bounding box of the leaf
+		core::aabbox3df Box;
+
+		//! Visibility cluster of the leaf, negative for leafs outside of the level
+		s32 Cluster;
+
+		//! First entry of the leaf in SBSPTree::LeafFaces
+		u32 FirstFace;
+
+		//! Number of faces of the leaf
+		u32 FaceCount;
+	};
+
+	//! Indices of a face of the level in the E_Q3_MESH_GEOMETRY mesh
+	struct SBSPFace
+	{
+		//! Index of the mesh buffer, or -1 if the face isn't part of the mesh
+		s32 MeshBuffer;
+
+		//! Indices of the face in the mesh buffer
+		video::SIndexRange Indices;
+	};
+
+	//! Bsp tree and potentially visible sets of a quake3 level
+	struct SBSPTree
+	{
+		SBSPTree() : ClusterCount(0), BytesPerCluster(0) {}
+
+		//! Returns the leaf which contains a position, or -1 if the tree is empty
+		s32 findLeaf(const core::vector3df& pos) const
+		{
+			if (Nodes.empty())
+				return -1;
+
+			s32 index = 0;
+			while (index >= 0)
+			{
+				const SBSPNode& node = Nodes[index];
+				index = node.Children[node.Plane.getDistanceTo(pos) >= 0.f ? 0 : 1];
+			}
+			return -(index + 1);
+		}
+
+		//! Returns if a cluster can be seen from another cluster
+		/** Everything is visible from outside of the level, or if the level
+		has no visibility data. */
+		bool isClusterVisible(s32 from, s32 to) const
+		{
+			if (from < 0 || from >= ClusterCount)
+				return true;
+			if (to < 0)
+				return false;
+			if (to >= ClusterCount)
+				return true;
+
+			return (Visibility[from * BytesPerCluster + (to >> 3)] & (1 << (to & 7))) != 0;
+		}
+
+		core::array<SBSPNode> Nodes;
+		core::array<SBSPLeaf> Leafs;
+
+		//! Face indices of the leafs
+		core::array<s32> LeafFaces;
+
+		//! Indices of all faces of the level
+		core::array<SBSPFace> Faces;
+
+		s32 ClusterCount;
+		s32 BytesPerCluster;
+
+		//! One bit per cluster pair, set if the second cluster can be seen from the first
+		core::array<u8> Visibility;
+	};
+} // end namespace quake3
+
 	//! Interface for a Mesh which can be loaded directly from a Quake3 .bsp-file.
 	/** The Mesh tries to load all textures of the map.*/
 	class IQ3LevelMesh : public IAnimatedMesh
@@ -37,6 +129,12 @@ namespace scene
 
 		//! returns the requested brush entity
 		virtual IMesh* getBrushEntityMesh(quake3::IEntity &ent) const = 0;
+
+		//! returns the bsp tree and the potentially visible sets of the level
+		/** Used by ISceneManager::addBSPLevelSceneNode() to draw only the
+		visible faces of the E_Q3_MESH_GEOMETRY mesh. The tree is empty
+		if the level has no bsp nodes. */
+		virtual const quake3::SBSPTree& getBSPTree() const = 0;
 	};
 
 } // end namespace scene
@@ -24,6 +24,27 @@ namespace io
 		\return How many bytes were read. */
 		virtual size_t read(void* buffer, size_t sizeToRead) = 0;
 
+		//! Reads an amount of bytes from a position in the file.
+		/** Unlike read() this doesn't use or change the current position.
+		Files on disk, in memory and inside of archives implement it without
+		touching any shared state, so several threads can read from streams of
+		the same archive at once. The default implementation seeks, reads and
+		seeks back, which is not safe to use from several threads.
+		\param pos Position in the file to start reading at.
+		\param buffer Pointer to buffer where read bytes are written to.
+		\param sizeToRead Amount of bytes to read from the file.
+		\return How many bytes were read. */
+		virtual size_t readAt(long pos, void* buffer, size_t sizeToRead)
+		{
+			const long oldPos = getPos();
+			if (!seek(pos))
+				return 0;
+
+			const size_t r = read(buffer, sizeToRead);
+			seek(oldPos);
+			return r;
+		}
+
 		//! Changes position in file
 		/** \param finalPos Destination position in the file.
 		\param relativeMovement If set to true, the position in the file is
@@ -49,6 +70,18 @@ namespace io
 		{
 			return EFIT_UNKNOWN;
 		}
+
+		//! Get direct access to the contents of the file, if possible.
+		/** Files in memory, files on disk which could be mapped into memory
+		and uncompressed files inside of those return a pointer to their
+		whole contents, starting at position 0 and getSize() bytes long.
+		It stays valid as long as the file is not dropped. Loaders can parse
+		straight from there instead of copying the file with read() first.
+		\return Pointer to the contents, or 0 if the file has to be read with read(). */
+		virtual const void* getBuffer() const
+		{
+			return 0;
+		}
 	};
 
 	//! Internal function, please do not use.
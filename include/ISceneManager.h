@@ -104,8 +104,11 @@ namespace scene
 	class IAnimatedMesh;
 	class IAnimatedMeshSceneNode;
 	class IBillboardSceneNode;
+	class IBillboardGroupSceneNode;
 	class IBillboardTextSceneNode;
+	class IBSPLevelSceneNode;
 	class ICameraSceneNode;
+	class IClusteredLightManager;
 	class IDummyTransformationSceneNode;
 	class ILightManager;
 	class ILightSceneNode;
@@ -119,6 +122,7 @@ namespace scene
 	class IMetaTriangleSelector;
 	class IOctreeSceneNode;
 	class IParticleSystemSceneNode;
+	class IQ3LevelMesh;
 	class ISceneCollisionManager;
 	class ISceneLoader;
 	class ISceneNode;
@@ -728,6 +732,23 @@ namespace scene
 			const core::vector3df& position = core::vector3df(0,0,0), s32 id=-1,
 			video::SColor colorTop = 0xFFFFFFFF, video::SColor colorBottom = 0xFFFFFFFF) = 0;
 
+		//! Adds a scene node drawing a group of billboards to the scene graph.
+		/** The quads of all billboards in the group are built into one
+		mesh buffer, which is drawn with a single draw call. This is much
+		faster than one billboard scene node per billboard when there are
+		many of them, e.g. for foliage or particles. The billboards are
+		added with IBillboardGroupSceneNode::addBillboard().
+		\param parent Parent scene node of the group. Can be null.
+		\param position Position of the group relative to its parent,
+		the billboards are placed relative to the group.
+		\param id An id of the node. This id can be used to identify
+		the node.
+		\return Pointer to the group if successful, otherwise NULL.
+		This pointer should not be dropped. See
+		IReferenceCounted::drop() for more information. */
+		virtual IBillboardGroupSceneNode* addBillboardGroupSceneNode(ISceneNode* parent = 0,
+			const core::vector3df& position = core::vector3df(0,0,0), s32 id=-1) = 0;
+
 		//! Adds a skybox scene node to the scene graph.
 		/** A skybox is a big cube with 6 textures on it and
 		is drawn around the camera position.
@@ -801,10 +822,10 @@ namespace scene
 
 		This scene node is capable of loading terrains and updating
 		the indices at runtime to enable viewing very large terrains
-		very quickly. It uses a CLOD (Continuous Level of Detail)
-		algorithm which updates the indices for each patch based on
-		a LOD (Level of Detail) which is determined based on a patch's
-		distance from the camera.
+		very quickly. Each patch is drawn with the coarsest LOD (Level
+		of Detail) whose height error, projected onto the screen, stays
+		below ITerrainSceneNode::setMaxScreenError(), and the sides
+		towards coarser patches are stitched so there are no cracks.
 
 		The patch size of the terrain must always be a size of 2^N+1,
 		i.e. 8+1(9), 16+1(17), etc.
@@ -817,10 +838,10 @@ namespace scene
 		the size of the patch, so having a LOD of 8, with a patch size
 		of 17, is asking the algorithm to generate indices every 2^8 (
 		256 ) vertices, which is not possible with a patch size of 17.
-		The maximum LOD for a patch size of 17 is 2^4 ( 16 ). So,
-		with a MaxLOD of 5, you'll have LOD 0 ( full detail ), LOD 1 (
-		every 2 vertices ), LOD 2 ( every 4 vertices ), LOD 3 ( every
-		8 vertices ) and LOD 4 ( every 16 vertices ).
+		The coarsest LOD keeps two cells along each side of a patch, so
+		with a patch size of 17 and a MaxLOD of 5, you'll have LOD 0 (
+		full detail ), LOD 1 ( every 2 vertices ), LOD 2 ( every 4
+		vertices ) and LOD 3 ( every 8 vertices ).
 		\param heightMapFileName: The name of the file on disk, to read vertex data from. This should
 		be a gray scale bitmap.
 		\param parent: Parent of the scene node. Can be 0 if no parent.
@@ -901,6 +922,21 @@ namespace scene
 												ISceneNode* parent=0, s32 id=-1
 												) = 0;
 
+		//! Adds a scene node drawing the geometry of a quake3 level with its bsp tree.
+		/** Only the faces in clusters which are potentially visible from the
+		camera and inside of the view frustum are drawn. This usually draws far
+		less triangles than an octree scene node for the same level.
+		\param mesh The level, its E_Q3_MESH_GEOMETRY mesh is drawn. The node
+		only uses that mesh and IQ3LevelMesh::getBSPTree(), so the level can
+		also come from an own implementation of IQ3LevelMesh.
+		\param parent Parent of the scene node. Can be NULL if no parent.
+		\param id Id of the node. This id can be used to identify the scene node.
+		\return Pointer to the created scene node, or 0 if mesh is 0 or the
+		node isn't compiled in. This pointer should not be dropped. See
+		IReferenceCounted::drop() for more information. */
+		virtual IBSPLevelSceneNode* addBSPLevelSceneNode(IQ3LevelMesh* mesh,
+			ISceneNode* parent=0, s32 id=-1) = 0;
+
 
 		//! Adds an empty scene node to the scene graph.
 		/** Can be used for doing advanced transformations
@@ -1147,6 +1183,14 @@ namespace scene
 		by existing scene node animators, culling of scene nodes is done, etc. */
 		virtual void drawAll() = 0;
 
+		//! Get the time which passed between the last two scene animations.
+		/** drawAll() measures it with the microsecond virtual timer before
+		it animates the scene nodes. Animators can move nodes by it at high
+		frame rates, where the millisecond time passed to
+		ISceneNodeAnimator::animateNode() only advances every few frames.
+		\return Time in seconds, 0 before the second call to drawAll(). */
+		virtual f32 getAnimationDeltaTime() const = 0;
+
 		//! Creates a rotation animator, which rotates the attached scene node around itself.
 		/** \param rotationSpeed Specifies the speed of the animation in degree per 10 milliseconds.
 		\return The animator. Attach it to a scene node with ISceneNode::addAnimator()
@@ -1665,6 +1709,54 @@ namespace scene
 			current callbacks manager and restore the default behavior. */
 		virtual void setLightManager(ILightManager* lightManager) = 0;
 
+		//! Creates a light manager which assigns the lights to clusters of the view frustum.
+		/** Pass it to setLightManager() to let shader materials use the
+		lights of the clusters, see IClusteredLightManager.
+		\return The light manager. If you no longer need it, you should call
+		IClusteredLightManager::drop(). See IReferenceCounted::drop() for more
+		information. */
+		virtual IClusteredLightManager* createClusteredLightManager() = 0;
+
+		//! Enables automatic occlusion culling of the nodes drawn by drawAll().
+		/** Nodes passing the other culling tests get their bounding boxes
+		tested in two ways:
+		- Before anything is drawn, against a small software depth buffer
+		of the nodes marked with ISceneNode::setIsOccluder() which passed
+		frustum culling. This works with any driver and without latency.
+		- With drivers supporting EVDF_OCCLUSION_QUERY, with occlusion
+		queries against the depth of the solid nodes drawn before. Results
+		are read frames later without waiting for the driver, until then a
+		node keeps the visibility of its last test: visible nodes are drawn
+		and tested again every few frames, occluded ones are tested every
+		frame and drawn again once a test finds them visible.
+		Nodes with the automatic culling EAC_OFF are never occluded.
+		\param enable True to enable occlusion culling, false to disable it
+		and forget all results. */
+		virtual void setOcclusionCulling(bool enable) = 0;
+
+		//! Returns if automatic occlusion culling is enabled.
+		virtual bool getOcclusionCulling() const = 0;
+
+		//! Enables keeping the render lists of drawAll() between frames.
+		/** Without it, every frame all nodes register themselves with
+		OnRegisterSceneNode() and the solid nodes are sorted again. With it,
+		the registrations are kept in sorted lists. Each frame only the
+		frustum and occlusion culling runs on them, and only the nodes marked
+		with ISceneNode::markChanged() since the last frame, the added ones
+		and the removed ones update the lists. Everything registers again when
+		the active camera changes or moves into another cell of a grid.
+		Moving nodes are culled at their new place without registering again.
+		Nodes choosing their level of detail or anything else by the camera
+		while registering only choose again when everything registers again.
+		\param enable True to keep the render lists, false to register all
+		nodes each frame.
+		\param cellSize Size of the cells of the grid the camera moves in,
+		0 to register everything again only when the active camera changes. */
+		virtual void setRenderListCaching(bool enable, f32 cellSize=100.f) = 0;
+
+		//! Returns if the render lists are kept between frames.
+		virtual bool getRenderListCaching() const = 0;
+
 		//! Get current render pass.
 		virtual E_SCENE_NODE_RENDER_PASS getCurrentRenderPass() const =0;
 
@@ -49,7 +49,8 @@ namespace scene
 			: RelativeTranslation(position), RelativeRotation(rotation), RelativeScale(scale),
 				Parent(0), SceneManager(mgr), TriangleSelector(0), ID(id),
 				AutomaticCullingState(EAC_BOX), DebugDataVisible(EDS_OFF),
-				IsVisible(true), IsDebugObject(false)
+				ChangeCounter(0), SubtreeChangeCounter(0),
+				IsVisible(true), IsDebugObject(false), IsOccluder(false)
 		{
 			if (parent)
 				parent->addChild(this);
@@ -266,6 +267,8 @@ namespace scene
 		\param isVisible If the node shall be visible. */
 		virtual void setVisible(bool isVisible)
 		{
+			if (IsVisible != isVisible)
+				markChanged();
 			IsVisible = isVisible;
 		}
 
@@ -304,6 +307,7 @@ namespace scene
 				child->remove(); // remove from old parent
 				Children.push_back(child);
 				child->Parent = this;
+				child->markChanged();
 			}
 		}
 
@@ -323,6 +327,7 @@ namespace scene
 					(*it)->Parent = 0;
 					(*it)->drop();
 					Children.erase(it);
+					markSubtreeChanged();
 					return true;
 				}
 
@@ -343,6 +348,8 @@ namespace scene
 				(*it)->drop();
 			}
 
+			if (!Children.empty())
+				markSubtreeChanged();
 			Children.clear();
 		}
 
@@ -440,6 +447,7 @@ namespace scene
 		{
 			for (u32 i=0; i<getMaterialCount(); ++i)
 				getMaterial(i).setFlag(flag, newvalue);
+			markChanged();
 		}
 
 
@@ -454,6 +462,7 @@ namespace scene
 
 			for (u32 i=0; i<getMaterialCount(); ++i)
 				getMaterial(i).setTexture(textureLayer, texture);
+			markChanged();
 		}
 
 
@@ -463,6 +472,7 @@ namespace scene
 		{
 			for (u32 i=0; i<getMaterialCount(); ++i)
 				getMaterial(i).MaterialType = newType;
+			markChanged();
 		}
 
 
@@ -596,6 +606,55 @@ namespace scene
 		}
 
 
+		//! Sets if this scene node hides the nodes behind it from occlusion culling.
+		/** With ISceneManager::setOcclusionCulling, the meshes of occluders are
+		drawn into a small software depth buffer each frame, and nodes whose
+		bounding box is behind it are not drawn. Mark only large nodes with
+		few triangles, like walls and terrain blocks of mesh or octree nodes.
+		The occluder has to be at least as large as its drawn mesh, so don't
+		mark nodes with transparent or alpha tested holes. */
+		void setIsOccluder(bool occluder)
+		{
+			IsOccluder = occluder;
+		}
+
+
+		//! Returns if this scene node hides the nodes behind it from occlusion culling.
+		bool isOccluder() const
+		{
+			return IsOccluder;
+		}
+
+
+		//! Tells the scene manager that the node has to register itself again.
+		/** With ISceneManager::setRenderListCaching, nodes are only asked to
+		register again when they changed. Visibility, children, the
+		material setters of ISceneNode, deserializeAttributes() and clone()
+		mark the node themselves, call this after changing the materials
+		returned by getMaterial() or anything else deciding the render
+		passes of the node. Moving nodes doesn't
+		need it. */
+		void markChanged()
+		{
+			++ChangeCounter;
+			markSubtreeChanged();
+		}
+
+
+		//! Returns how often the node was marked as changed.
+		u32 getChangeCounter() const
+		{
+			return ChangeCounter;
+		}
+
+
+		//! Returns how often the node, its children or their children changed.
+		u32 getSubtreeChangeCounter() const
+		{
+			return SubtreeChangeCounter;
+		}
+
+
 		//! Returns a const reference to the list of all children.
 		/** \return The list of all children of this node. */
 		const core::list<ISceneNode*>& getChildren() const
@@ -712,6 +771,7 @@ namespace scene
 			out->addInt("AutomaticCulling", AutomaticCullingState);
 			out->addInt("DebugDataVisible", DebugDataVisible );
 			out->addBool("IsDebugObject", IsDebugObject );
+			out->addBool("IsOccluder", IsOccluder );
 		}
 
 
@@ -746,8 +806,10 @@ namespace scene
 
 			DebugDataVisible = in->getAttributeAsInt("DebugDataVisible", DebugDataVisible);
 			IsDebugObject = in->getAttributeAsBool("IsDebugObject", IsDebugObject);
+			IsOccluder = in->getAttributeAsBool("IsOccluder", IsOccluder);
 
 			updateAbsolutePosition();
+			markChanged();
 		}
 
 		//! Creates a clone of this scene node and its children.
@@ -783,6 +845,8 @@ namespace scene
 			DebugDataVisible = toCopyFrom->DebugDataVisible;
 			IsVisible = toCopyFrom->IsVisible;
 			IsDebugObject = toCopyFrom->IsDebugObject;
+			IsOccluder = toCopyFrom->IsOccluder;
+			markChanged();
 
 			if (newManager)
 				SceneManager = newManager;
@@ -820,6 +884,13 @@ namespace scene
 				(*it)->setSceneManager(newManager);
 		}
 
+		//! Counts a change below this node in the node and its parents
+		void markSubtreeChanged()
+		{
+			for (ISceneNode* node=this; node; node=node->Parent)
+				++node->SubtreeChangeCounter;
+		}
+
 		//! Name of the scene node.
 		core::stringc Name;
 
@@ -859,11 +930,20 @@ namespace scene
 		//! Flag if debug data should be drawn, such as Bounding Boxes.
 		u32 DebugDataVisible;
 
+		//! Changes of the node, counted by markChanged()
+		u32 ChangeCounter;
+
+		//! Changes of the node and all nodes below it
+		u32 SubtreeChangeCounter;
+
 		//! Is the node visible?
 		bool IsVisible;
 
 		//! Is debug object?
 		bool IsDebugObject;
+
+		//! Does the node hide the nodes behind it from occlusion culling?
+		bool IsOccluder;
 	};
 
 
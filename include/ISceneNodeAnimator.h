@@ -36,7 +36,10 @@ namespace scene
 		}
 
 		//! Animates a scene node.
-		/** \param node Node to animate.
+		/** Animators moving nodes at a speed can use
+		ISceneManager::getAnimationDeltaTime() of the node's scene manager
+		for the time since the last frame instead of timeMs.
+		\param node Node to animate.
 		\param timeMs Current time in milliseconds. */
 		virtual void animateNode(ISceneNode* node, u32 timeMs) =0;
 
@@ -0,0 +1,124 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __I_TERRAIN_SCENE_NODE_H_INCLUDED__
+#define __I_TERRAIN_SCENE_NODE_H_INCLUDED__
+
+#include "ISceneNode.h"
+#include "ETerrainElements.h"
+#include "line3d.h"
+
+namespace irr
+{
+namespace video
+{
+	class IImage;
+} // end namespace video
+
+namespace scene
+{
+
+//! A scene node for displaying terrain using the geo mip map algorithm.
+/** The heightmap is split into square patches of E_TERRAIN_PATCH_SIZE
+samples. Each patch is drawn with the coarsest level of detail whose
+height error, projected onto the screen, is not larger than the maximum
+screen error. LOD 0 uses every sample of the heightmap, each further LOD
+every second vertex of the one before. Neighbouring patches differ by one
+LOD at most, and the edges towards coarser neighbours are drawn with index
+sets which leave out the vertices the neighbour doesn't have, so there are
+no cracks between patches.
+The LODs are only recalculated when the camera moves, and the vertices of a
+patch are only rebuilt when its LOD or those of its neighbours change. Only
+patches which have been visible keep vertices, so large heightmaps don't
+need vertices for the whole terrain.
+Heights and intersections are calculated from the heightmap at full
+resolution, independent of the LODs drawn.
+Heightmap samples become vertices one unit apart, with the height of the
+sample as Y coordinate. Position, rotation and scale of the node are
+applied to the whole terrain. */
+class ITerrainSceneNode : public ISceneNode
+{
+public:
+
+	//! Constructor
+	ITerrainSceneNode(ISceneNode* parent, ISceneManager* mgr, s32 id,
+		const core::vector3df& position = core::vector3df(0.0f, 0.0f, 0.0f),
+		const core::vector3df& rotation = core::vector3df(0.0f, 0.0f, 0.0f),
+		const core::vector3df& scale = core::vector3df(1.0f, 1.0f, 1.0f) )
+		: ISceneNode (parent, mgr, id, position, rotation, scale) {}
+
+	//! Initializes the terrain data from a heightmap image.
+	/** The height of a sample is the average of the color channels of
+	its pixel. The terrain uses the largest square of the image which is a
+	whole number of patches.
+	\param heightmap Image with the heights, usually gray scale.
+	\param vertexColor Color of all vertices.
+	\param smoothFactor Number of times the heights are smoothed.
+	\return True if successful, false if the image is smaller than one
+	patch. */
+	virtual bool loadHeightMap(video::IImage* heightmap,
+		video::SColor vertexColor=video::SColor(255,255,255,255),
+		s32 smoothFactor=0) =0;
+
+	//! Get height of a point of the terrain.
+	/** \param x X coordinate, in world space.
+	\param z Z coordinate, in world space.
+	\return World space height at the position, or -FLT_MAX if the
+	position is outside of the terrain. The node must not be rotated
+	around the X or Z axis. */
+	virtual f32 getHeight(f32 x, f32 z) const =0;
+
+	//! Finds the first intersection of a line with the terrain.
+	/** \param line Line in world space.
+	\param outIntersection Receives the intersection closest to the start
+	of the line.
+	\return True if the line intersects the terrain. */
+	virtual bool getIntersectionWithLine(const core::line3d<f32>& line,
+		core::vector3df& outIntersection) const =0;
+
+	//! Returns the number of heightmap samples along each side of the terrain.
+	virtual u32 getHeightMapSize() const =0;
+
+	//! Returns the height of a heightmap sample, in node space.
+	/** \param x Column of the sample, smaller than getHeightMapSize().
+	\param z Row of the sample, smaller than getHeightMapSize(). */
+	virtual f32 getHeightSample(u32 x, u32 z) const =0;
+
+	//! Sets the maximum height error of the drawn patches on the screen.
+	/** \param pixels Error in pixels. Larger values select coarser LODs,
+	0 draws all patches at LOD 0. The default is 4. */
+	virtual void setMaxScreenError(f32 pixels) =0;
+
+	//! Returns the maximum height error of the drawn patches on the screen, in pixels.
+	virtual f32 getMaxScreenError() const =0;
+
+	//! Gets the LODs selected for the patches in the last frame.
+	/** \param LODs Receives one LOD per patch, row by row along the Z axis.
+	\return Number of patches. */
+	virtual s32 getCurrentLODOfPatches(core::array<s32>& LODs) const =0;
+
+	//! Returns the number of indices drawn in the last frame.
+	virtual u32 getIndexCount() const =0;
+
+	//! Returns the center of the terrain, in world space.
+	virtual core::vector3df getTerrainCenter() const =0;
+
+	//! Scales the base texture, similar to makePlanarTextureMapping.
+	/** \param scale The scaling amount. Values above 1.0 increase the
+	number of times the texture is drawn on the terrain. Values below 1.0
+	decrease the number of times the texture is drawn on the terrain.
+	Using negative values will flip the texture, as well as still scaling
+	it.
+	\param scale2 If set to 0 (default value), this will set the second
+	texture coordinate set to the same values as in the first set. If this
+	is another value than zero, it will scale the second texture
+	coordinate set by this value. */
+	virtual void scaleTexture(f32 scale = 1.0f, f32 scale2=0.0f) =0;
+};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
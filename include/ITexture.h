@@ -49,7 +49,9 @@ enum E_TEXTURE_CREATION_FLAG
 	When using this flag, it does not make sense to use the flags
 	ETCF_ALWAYS_16_BIT, ETCF_ALWAYS_32_BIT, or ETCF_OPTIMIZED_FOR_SPEED at
 	the same time. 
-	Not all texture formats are affected (usually those up to ECF_A8R8G8B8). */
+	Not all texture formats are affected (usually those up to ECF_A8R8G8B8).
+	The OpenGL drivers also create missing mipmaps on the cpu with a
+	Lanczos filter, see IImage::createMipMaps. */
 	ETCF_OPTIMIZED_FOR_QUALITY = 0x00000004,
 
 	/** Lets the driver decide in which format the textures are created and
@@ -97,6 +99,18 @@ enum E_TEXTURE_CREATION_FLAG
 	  */
 	ETCF_AUTO_GENERATE_MIP_MAPS = 0x00000100,
 
+	//! Compress textures loaded from files into blocks on the cpu
+	/** Textures are compressed to DXT1/DXT5 if the driver supports
+	EVDF_TEXTURE_COMPRESSED_DXT, else to ETC2 RGB/ETC2 ARGB if it supports
+	EVDF_TEXTURE_COMPRESSED_ETC2. The alpha format is only used for images
+	with translucent pixels. Mipmaps are compressed as well when
+	ETCF_CREATE_MIP_MAPS is enabled. Images which already are compressed,
+	cubemaps and sizes the driver can't use are uploaded as before.
+	Compressing is slow, see IVideoDriver::setCompressedTextureCache to keep
+	the results on disk.
+	Default is false. */
+	ETCF_BLOCK_COMPRESSION = 0x00000200,
+
 	/** This flag is never used, it only forces the compiler to compile
 	these enumeration values to 32 bit. */
 	ETCF_FORCE_32_BIT_DO_NOT_USE = 0x7fffffff
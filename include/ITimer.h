@@ -21,6 +21,12 @@ public:
 	*/
 	virtual u32 getRealTime() const = 0;
 
+	//! Returns current real time in microseconds of the system.
+	/** Like getRealTime(), but with a higher resolution and 64 bit, so it
+	does not wrap around. Where the system supports it, a monotonic clock
+	is used which isn't affected by changes of the system time. */
+	virtual u64 getRealTimeUs() const = 0;
+
 	enum EWeekday
 	{
 		EWD_SUNDAY=0,
@@ -63,6 +69,17 @@ public:
 	use getRealTime() */
 	virtual u32 getTime() const = 0;
 
+	//! Returns current virtual time in microseconds.
+	/** Same as getTime(), but with a higher resolution and 64 bit, which
+	avoids quantization when interpolating at high frame rates. */
+	virtual u64 getTimeUs() const = 0;
+
+	//! Returns the virtual time passed with the last call to tick() in seconds.
+	/** As tick() is called once by IrrlichtDevice::run() this is the
+	duration of the last frame. It is 0 while the timer is stopped and is
+	scaled by the speed of the timer. */
+	virtual f32 getDeltaTime() const = 0;
+
 	//! sets current virtual time
 	virtual void setTime(u32 time) = 0;
 
@@ -9,6 +9,7 @@
 #include "SColor.h"
 #include "ITexture.h"
 #include "irrArray.h"
+#include "irrFrameArena.h"
 #include "matrix4.h"
 #include "plane3d.h"
 #include "dimension2d.h"
@@ -459,7 +460,8 @@ namespace video
 		//! Return query result.
 		/** Return value is the number of visible pixels/fragments.
 		The value is a safe approximation, i.e. can be larger than the
-		actual value of pixels. */
+		actual value of pixels. It is ~0 until the result of the last run
+		of the query arrived. */
 		virtual u32 getOcclusionQueryResult(scene::ISceneNode* node) const =0;
 
 		//! Create render target.
@@ -1004,6 +1006,17 @@ namespace video
 		/** \param mb Buffer to draw */
 		virtual void drawMeshBuffer(const scene::IMeshBuffer* mb) =0;
 
+		//! Draws parts of the index list of a mesh buffer
+		/** Only for triangle lists. The indices are kept in the hardware
+		buffer of the mesh buffer and the ranges are drawn with one multi
+		draw call where the driver supports it, so drawing a changing set
+		of ranges doesn't upload indices.
+		\param mb Buffer to draw
+		\param ranges Parts of the index list, the counts are multiples of 3
+		\param rangeCount Number of ranges */
+		virtual void drawMeshBufferRanges(const scene::IMeshBuffer* mb,
+			const SIndexRange* ranges, u32 rangeCount) =0;
+
 		//! Draws normals of a mesh buffer
 		/** \param mb Buffer to draw the normals of
 		\param length length scale factor of the normals
@@ -1068,6 +1081,15 @@ namespace video
 		\return Amount of primitives drawn in the last frame. */
 		virtual u32 getPrimitiveCountDrawn( u32 mode =0 ) const =0;
 
+		//! Returns the size of the index data uploaded to hardware buffers in the last frame.
+		/** Counts the bytes written to index buffers from one endScene()
+		to the next, useful to find meshes which update their indices
+		every frame. The OpenGL, OGLES1 and OGLES2 drivers count their
+		index buffer uploads, the other drivers have no index buffers and
+		return 0.
+		\return Size in bytes. */
+		virtual u32 getIndexBytesUploaded() const =0;
+
 		//! Deletes all dynamic lights which were previously added with addDynamicLight().
 		virtual void deleteAllDynamicLights() =0;
 
@@ -1142,6 +1164,19 @@ namespace video
 		\return The current texture creation flag enabled mode. */
 		virtual bool getTextureCreationFlag(E_TEXTURE_CREATION_FLAG flag) const =0;
 
+		//! Sets the directory in which block compressed textures are cached.
+		/** Textures loaded with ETCF_BLOCK_COMPRESSION enabled are stored
+		there as .ktx files, including their mipmaps. The names are made from
+		a hash of the source file and the creation flags, so later runs load
+		the compressed images directly, even from renamed files.
+		\param directory Existing directory the application can write to.
+		An empty path, the default, disables the cache. */
+		virtual void setCompressedTextureCache(const io::path& directory) =0;
+
+		//! Returns the directory in which block compressed textures are cached.
+		/** \return The directory, or an empty path if the cache is disabled. */
+		virtual const io::path& getCompressedTextureCache() const =0;
+
 		//! Creates a software images from a file.
 		/** No hardware texture will be created for those images. This
 		method is useful for example if you want to read a heightmap
@@ -1164,6 +1199,34 @@ namespace video
 		See IReferenceCounted::drop() for more information. */
 		virtual core::array<IImage*> createImagesFromFile(io::IReadFile* file, E_TEXTURE_TYPE* type = 0) = 0;
 
+		//! Creates software images from several files, decoding them on several threads.
+		/** The files are opened on the calling thread, only the image
+		loaders run in parallel. Useful for loading a texture pack, the
+		textures are then created from the images on the calling thread.
+		\param filenames Names of the files from which the images are created.
+		\param threadCount Number of threads decoding the images, including
+		the calling thread. 0 uses one thread per hardware thread.
+		\return One image per file in the same order, 0 for the files which
+		could not be loaded. If a file contains several images only the
+		first one is returned. If you no longer need the images, you should
+		call IImage::drop() on each of them.
+		See IReferenceCounted::drop() for more information. */
+		virtual core::array<IImage*> createImagesFromFiles(const core::array<io::path>& filenames, u32 threadCount = 0) = 0;
+
+		//! Creates software images from several files, decoding them on several threads.
+		/** Every file is read on one of the threads, so each must be
+		readable independently of the other files. This is the case for
+		the files opened by the file system, also for files in the same
+		archive. The files are not dropped.
+		\param files Files from which the images are created, entries can be 0.
+		\param threadCount Number of threads decoding the images, including
+		the calling thread. 0 uses one thread per hardware thread.
+		\return One image per file in the same order, 0 for the files which
+		could not be loaded. If you no longer need the images, you should
+		call IImage::drop() on each of them.
+		See IReferenceCounted::drop() for more information. */
+		virtual core::array<IImage*> createImagesFromFiles(const core::array<io::IReadFile*>& files, u32 threadCount = 0) = 0;
+
 		//! Creates a software image from a file.
 		/** No hardware texture will be created for this image. This
 		method is useful for example if you want to read a heightmap
@@ -1396,6 +1459,13 @@ namespace video
 		//! Returns a pointer to the mesh manipulator.
 		virtual scene::IMeshManipulator* getMeshManipulator() =0;
 
+		//! Returns the arena for scratch memory of the current frame.
+		/** The arena is reset by beginScene(), so its memory must not be
+		used after the frame. See core::irrFrameAllocator and
+		core::frame_arena::bind for containers using it.
+		\return Pointer to the arena, owned by the driver. */
+		virtual core::frame_arena* getFrameArena() =0;
+
 		//! Clear the color, depth and/or stencil buffers.
 		virtual void clearBuffers(u16 flag, SColor color = SColor(255,0,0,0), f32 depth = 1.f, u8 stencil = 0) = 0;
 
@@ -170,6 +170,15 @@ while it runs and enabling it will slow down the engine. */
 #undef _IRR_COMPILE_WITH_PROFILING_
 #endif
 
+//! Define _IRR_COMPILE_WITH_SIMD_ to use SSE2, SSSE3, AVX2 or NEON instructions in some inner loops
+/** Like the color conversions. On x86 the instruction sets are detected at runtime
+and the portable code is used on cpu's without them. NEON is used when the compiler
+targets it. */
+#define _IRR_COMPILE_WITH_SIMD_
+#ifdef NO_IRR_COMPILE_WITH_SIMD_
+#undef _IRR_COMPILE_WITH_SIMD_
+#endif
+
 //! Define _IRR_COMPILE_WITH_DIRECT3D_9_ to compile the Irrlicht engine with DIRECT3D9.
 /** If you only want to use the software device or opengl you can disable those defines.
 This switch is mostly disabled because people do not get the g++ compiler compile
@@ -416,6 +425,19 @@ tool <http://developer.nvidia.com/object/nvperfhud_home.html>. */
 #undef _IRR_COMPILE_WITH_BILLBOARD_SCENENODE_
 #endif
 
+//! Define _IRR_COMPILE_WITH_TERRAIN_SCENENODE_ to support TerrainSceneNodes
+#define _IRR_COMPILE_WITH_TERRAIN_SCENENODE_
+#ifdef NO_IRR_COMPILE_WITH_TERRAIN_SCENENODE_
+#undef _IRR_COMPILE_WITH_TERRAIN_SCENENODE_
+#endif
+
+//! Define _IRR_COMPILE_WITH_BSP_LEVEL_SCENENODE_ to support BSPLevelSceneNodes
+/** They draw any IQ3LevelMesh with its bsp tree, so they don't need the bsp loader. */
+#define _IRR_COMPILE_WITH_BSP_LEVEL_SCENENODE_
+#ifdef NO_IRR_COMPILE_WITH_BSP_LEVEL_SCENENODE_
+#undef _IRR_COMPILE_WITH_BSP_LEVEL_SCENENODE_
+#endif
+
 //! Define _IRR_COMPILE_WITH_SKINNED_MESH_SUPPORT_ if you want to use bone based
 /** animated meshes. If you compile without this, you will be unable to load
 B3D, MS3D or X meshes */
@@ -459,6 +481,11 @@ B3D, MS3D or X meshes */
 #ifdef NO_IRR_COMPILE_WITH_PNG_LOADER_
 #undef _IRR_COMPILE_WITH_PNG_LOADER_
 #endif
+//! Define _IRR_COMPILE_WITH_KTX_LOADER_ if you want to load block compressed .ktx files
+#define _IRR_COMPILE_WITH_KTX_LOADER_
+#ifdef NO_IRR_COMPILE_WITH_KTX_LOADER_
+#undef _IRR_COMPILE_WITH_KTX_LOADER_
+#endif
 
 //! Define _IRR_COMPILE_WITH_JPG_WRITER_ if you want to write .jpg files
 #define _IRR_COMPILE_WITH_JPG_WRITER_
@@ -470,6 +497,11 @@ B3D, MS3D or X meshes */
 #ifdef NO_IRR_COMPILE_WITH_PNG_WRITER_
 #undef _IRR_COMPILE_WITH_PNG_WRITER_
 #endif
+//! Define _IRR_COMPILE_WITH_KTX_WRITER_ if you want to write block compressed .ktx files
+#define _IRR_COMPILE_WITH_KTX_WRITER_
+#ifdef NO_IRR_COMPILE_WITH_KTX_WRITER_
+#undef _IRR_COMPILE_WITH_KTX_WRITER_
+#endif
 
 //! Define __IRR_COMPILE_WITH_ZIP_ARCHIVE_LOADER_ if you want to open ZIP and GZIP archives
 /** ZIP reading has several more options below to configure. */
@@ -136,6 +136,12 @@ namespace irr
 		\return Pointer to the ITimer object. */
 		virtual ITimer* getTimer() = 0;
 
+		//! Provides access to the arena for scratch memory of the current frame.
+		/** It belongs to the video driver and is reset by
+		video::IVideoDriver::beginScene().
+		\return Pointer to the arena, or 0 if there is no video driver. */
+		virtual core::frame_arena* getFrameArena() = 0;
+
 		//! Provides access to the engine's currently set randomizer.
 		/** \return Pointer to the IRandomizer object. */
 		virtual IRandomizer* getRandomizer() const =0;
@@ -0,0 +1,216 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __S_LOD_MESH_H_INCLUDED__
+#define __S_LOD_MESH_H_INCLUDED__
+
+#include "IAnimatedMesh.h"
+#include "IMesh.h"
+#include "aabbox3d.h"
+#include "irrArray.h"
+
+namespace irr
+{
+namespace scene
+{
+
+	//! A static mesh together with reduced versions of itself for drawing at a distance.
+	/** Level 0 is the full mesh, each following level has fewer triangles.
+	All levels have the same mesh buffers with the same materials. Mesh scene
+	nodes showing an SLODMesh select the level to draw from the size of the
+	mesh on the screen. As an IAnimatedMesh, the whole chain can be kept in
+	the mesh cache with IMeshCache::addMesh(). Created by
+	IMeshManipulator::createLODMesh(). */
+	struct SLODMesh : public IAnimatedMesh
+	{
+		//! constructor
+		SLODMesh() : IAnimatedMesh(), Hysteresis(0.1f)
+		{
+			#ifdef _DEBUG
+			setDebugName("SLODMesh");
+			#endif
+		}
+
+		//! destructor
+		virtual ~SLODMesh()
+		{
+			// drop levels
+			for (u32 i=0; i<Levels.size(); ++i)
+				Levels[i]->drop();
+		}
+
+		//! Adds a level with less detail than the ones added before.
+		/** \param mesh: Mesh of the level, with the mesh buffers of level 0.
+		\param minScreenSize: The level is drawn while the bounding sphere of
+		the mesh is at least this large, as fraction of the viewport height.
+		The value of the last level is ignored, it's drawn at any size. The
+		levels after one with a size of 0 are never drawn. */
+		void addLevel(IMesh* mesh, f32 minScreenSize)
+		{
+			if (mesh)
+			{
+				mesh->grab();
+				Levels.push_back(mesh);
+				MinScreenSizes.push_back(minScreenSize);
+				if (Levels.size() == 1)
+					recalculateBoundingBox();
+			}
+		}
+
+		//! Returns the level to draw for a size on the screen.
+		/** A level only changes once the size is past its threshold by the
+		hysteresis, so nodes near a threshold don't switch each frame.
+		\param screenSize: Diameter of the bounding sphere of the mesh as
+		fraction of the viewport height.
+		\param level: The level drawn before.
+		\return Index into Levels. */
+		u32 getLevel(f32 screenSize, u32 level) const
+		{
+			if (Levels.empty())
+				return 0;
+			if (level >= Levels.size())
+				level = Levels.size()-1;
+
+			while (level > 0 && screenSize >= MinScreenSizes[level-1] * (1.f + Hysteresis))
+				--level;
+			while (level+1 < Levels.size() && screenSize < MinScreenSizes[level] * (1.f - Hysteresis))
+				++level;
+
+			return level;
+		}
+
+		//! Gets the frame count of the animated mesh.
+		/** \return Always 1, the levels are no frames. */
+		virtual u32 getFrameCount() const _IRR_OVERRIDE_
+		{
+			return 1;
+		}
+
+		//! Gets the default animation speed of the animated mesh.
+		/** \return Always 0, the mesh is not animated. */
+		virtual f32 getAnimationSpeed() const _IRR_OVERRIDE_
+		{
+			return 0.f;
+		}
+
+		//! Ignored, the mesh is not animated.
+		virtual void setAnimationSpeed(f32 fps) _IRR_OVERRIDE_
+		{
+		}
+
+		//! Returns the level for a detail level.
+		/** \param frame: Ignored, the mesh has only one frame.
+		\param detailLevel: Level of detail. 255 returns level 0, 0 the level
+		with the fewest triangles.
+		\param startFrameLoop: Ignored.
+		\param endFrameLoop: Ignored.
+		\return The mesh of the level. */
+		virtual IMesh* getMesh(s32 frame, s32 detailLevel=255, s32 startFrameLoop=-1, s32 endFrameLoop=-1) _IRR_OVERRIDE_
+		{
+			if (Levels.empty())
+				return 0;
+
+			const s32 detail = core::s32_clamp(detailLevel, 0, 255);
+			return Levels[(255 - detail) * Levels.size() / 256];
+		}
+
+		//! Returns an axis aligned bounding box of the mesh.
+		/** \return A bounding box of this mesh is returned. */
+		virtual const core::aabbox3d<f32>& getBoundingBox() const _IRR_OVERRIDE_
+		{
+			return Box;
+		}
+
+		//! set user axis aligned bounding box
+		virtual void setBoundingBox(const core::aabbox3df& box) _IRR_OVERRIDE_
+		{
+			Box = box;
+		}
+
+		//! Recalculates the bounding box from level 0.
+		void recalculateBoundingBox()
+		{
+			Box.reset(0,0,0);
+
+			if (Levels.empty())
+				return;
+
+			Box = Levels[0]->getBoundingBox();
+		}
+
+		//! Returns the type of the animated mesh.
+		virtual E_ANIMATED_MESH_TYPE getMeshType() const _IRR_OVERRIDE_
+		{
+			return EAMT_LOD;
+		}
+
+		//! returns amount of mesh buffers.
+		virtual u32 getMeshBufferCount() const _IRR_OVERRIDE_
+		{
+			if (Levels.empty())
+				return 0;
+
+			return Levels[0]->getMeshBufferCount();
+		}
+
+		//! returns pointer to a mesh buffer of level 0
+		virtual IMeshBuffer* getMeshBuffer(u32 nr) const _IRR_OVERRIDE_
+		{
+			if (Levels.empty())
+				return 0;
+
+			return Levels[0]->getMeshBuffer(nr);
+		}
+
+		//! Returns pointer to a mesh buffer of level 0 which fits a material
+		/** \param material: material to search for
+		\return Returns the pointer to the mesh buffer or
+		NULL if there is no such mesh buffer. */
+		virtual IMeshBuffer* getMeshBuffer( const video::SMaterial &material) const _IRR_OVERRIDE_
+		{
+			if (Levels.empty())
+				return 0;
+
+			return Levels[0]->getMeshBuffer(material);
+		}
+
+		//! Set a material flag for all meshbuffers of all levels.
+		virtual void setMaterialFlag(video::E_MATERIAL_FLAG flag, bool newvalue) _IRR_OVERRIDE_
+		{
+			for (u32 i=0; i<Levels.size(); ++i)
+				Levels[i]->setMaterialFlag(flag, newvalue);
+		}
+
+		//! set the hardware mapping hint, for driver
+		virtual void setHardwareMappingHint( E_HARDWARE_MAPPING newMappingHint, E_BUFFER_TYPE buffer=EBT_VERTEX_AND_INDEX ) _IRR_OVERRIDE_
+		{
+			for (u32 i=0; i<Levels.size(); ++i)
+				Levels[i]->setHardwareMappingHint(newMappingHint, buffer);
+		}
+
+		//! flags the meshbuffers of all levels as changed, reloads hardware buffers
+		virtual void setDirty(E_BUFFER_TYPE buffer=EBT_VERTEX_AND_INDEX) _IRR_OVERRIDE_
+		{
+			for (u32 i=0; i<Levels.size(); ++i)
+				Levels[i]->setDirty(buffer);
+		}
+
+		//! The levels, from the full mesh to the one with the fewest triangles
+		core::array<IMesh*> Levels;
+
+		//! Smallest size on the screen each level is drawn at, see addLevel()
+		core::array<f32> MinScreenSizes;
+
+		//! Part of a threshold the size has to pass it by before the level changes
+		f32 Hysteresis;
+
+		//! The bounding box of level 0
+		core::aabbox3d<f32> Box;
+	};
+
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -71,6 +71,16 @@ struct SSpecificVertexIndex
 typedef u32 SVertexIndex;
 */
 
+//! Part of an index list, used to draw only some primitives of a mesh buffer
+struct SIndexRange
+{
+	//! First index of the range
+	u32 Start;
+
+	//! Number of indices in the range
+	u32 Count;
+};
+
 
 } // end namespace video
 } // end namespace irr
@@ -6,6 +6,7 @@
 #define __IRR_HEAPSORT_H_INCLUDED__
 
 #include "irrTypes.h"
+#include <utility>
 
 namespace irr
 {
@@ -25,9 +26,9 @@ inline void heapsink(T*array, s32 element, s32 max)
 
 		if (array[element] < array[j])
 		{
-			T t = array[j]; // swap elements
-			array[j] = array[element];
-			array[element] = t;
+			T t = std::move(array[j]); // swap elements
+			array[j] = std::move(array[element]);
+			array[element] = std::move(t);
 			element = j;
 		}
 		else
@@ -56,9 +57,9 @@ inline void heapsort(T* array_, s32 size)
 	// sort array, leave out the last element (0)
 	for (i=size-1; i>0; --i)
 	{
-		T t = array_[0];
-		array_[0] = array_[i];
-		array_[i] = t;
+		T t = std::move(array_[0]);
+		array_[0] = std::move(array_[i]);
+		array_[i] = std::move(t);
 		heapsink(virtualArray, 1, i + 1);
 	}
 }
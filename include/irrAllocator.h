@@ -7,6 +7,7 @@
 
 #include "irrTypes.h"
 #include <new>
+#include <utility>
 // necessary for older compilers
 #include <memory.h>
 
@@ -47,6 +48,19 @@ public:
 		new ((void*)ptr) T(e);
 	}
 
+	//! Construct an element, moving from another one
+	void construct(T* ptr, T&& e)
+	{
+		new ((void*)ptr) T(std::move(e));
+	}
+
+	//! Construct an element from the arguments of one of its constructors
+	template <typename... Args>
+	void emplace(T* ptr, Args&&... args)
+	{
+		new ((void*)ptr) T(std::forward<Args>(args)...);
+	}
+
 	//! Destruct an element
 	void destruct(T* ptr)
 	{
@@ -94,6 +108,19 @@ public:
 		new ((void*)ptr) T(e);
 	}
 
+	//! Construct an element, moving from another one
+	void construct(T* ptr, T&& e)
+	{
+		new ((void*)ptr) T(std::move(e));
+	}
+
+	//! Construct an element from the arguments of one of its constructors
+	template <typename... Args>
+	void emplace(T* ptr, Args&&... args)
+	{
+		new ((void*)ptr) T(std::forward<Args>(args)...);
+	}
+
 	//! Destruct an element
 	void destruct(T* ptr)
 	{
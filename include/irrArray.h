@@ -9,6 +9,9 @@
 #include "heapsort.h"
 #include "irrAllocator.h"
 #include "irrMath.h"
+#include <string.h>
+#include <type_traits>
+#include <utility>
 
 namespace irr
 {
@@ -41,6 +44,14 @@ public:
 	}
 
 
+	//! Constructs an empty array which allocates with a copy of the allocator
+	/** Used with allocators which have a state, like irrFrameAllocator. */
+	explicit array(const TAlloc& alloc) : data(0), allocated(0), used(0), allocator(alloc),
+			strategy(ALLOC_STRATEGY_DOUBLE), free_when_destroyed(true), is_sorted(true)
+	{
+	}
+
+
 	//! Copy constructor
 	array(const array<T, TAlloc>& other) : data(0)
 	{
@@ -48,6 +59,15 @@ public:
 	}
 
 
+	//! Move constructor
+	/** Takes over the memory of the other array, which is empty afterwards. */
+	array(array<T, TAlloc>&& other) : data(0), allocated(0), used(0),
+			strategy(ALLOC_STRATEGY_DOUBLE), free_when_destroyed(true), is_sorted(true)
+	{
+		swap(other);
+	}
+
+
 	//! Destructor.
 	/** Frees allocated memory, if set_free_when_destroyed was not set to
 	false by the user before. */
@@ -75,23 +95,31 @@ public:
 		data = allocator.allocate(new_size); //new T[new_size];
 		allocated = new_size;
 
-		// copy old data
+		// move old data
 		const s32 end = used < new_size ? used : new_size;
 
-		for (s32 i=0; i<end; ++i)
+		if (IsTrivial)
 		{
-			// data[i] = old_data[i];
-			allocator.construct(&data[i], old_data[i]);
+			if (end > 0)
+				memcpy((void*)data, (const void*)old_data, end * sizeof(T));
 		}
+		else
+		{
+			for (s32 i=0; i<end; ++i)
+				allocator.construct(&data[i], std::move(old_data[i]));
 
-		// destruct old data
-		for (u32 j=0; j<used; ++j)
-			allocator.destruct(&old_data[j]);
+			// destruct old data
+			for (u32 j=0; j<used; ++j)
+				allocator.destruct(&old_data[j]);
+		}
 
 		if (allocated < used)
 			used = allocated;
 
-		allocator.deallocate(old_data); //delete [] old_data;
+		// memory set with set_pointer stays with its owner
+		if (free_when_destroyed)
+			allocator.deallocate(old_data); //delete [] old_data;
+		free_when_destroyed = true;
 	}
 
 
@@ -114,6 +142,36 @@ public:
 	}
 
 
+	//! Moves an element to the back of the array.
+	/** If the array is too small to add this new element it is made bigger.
+	\param element: Element to move to the back of the array. */
+	void push_back(T&& element)
+	{
+		insert(std::move(element), used);
+	}
+
+
+	//! Constructs an element at the back of the array.
+	/** If the array is too small to add this new element it is made bigger.
+	\param args: Arguments passed to the constructor of the element. */
+	template <typename... Args>
+	void emplace_back(Args&&... args)
+	{
+		if (used + 1 > allocated)
+		{
+			// the arguments might refer to elements of this array, so
+			// the element is constructed before the array is reallocated
+			T e(std::forward<Args>(args)...);
+			insert(std::move(e), used);
+			return;
+		}
+
+		allocator.emplace(&data[used], std::forward<Args>(args)...);
+		is_sorted = false;
+		++used;
+	}
+
+
 	//! Adds an element at the front of the array.
 	/** If the array is to small to add this new element, the array is
 	made bigger. Please note that this is slow, because the whole array
@@ -125,6 +183,17 @@ public:
 	}
 
 
+	//! Moves an element to the front of the array.
+	/** If the array is to small to add this new element, the array is
+	made bigger. Please note that this is slow, because the whole array
+	needs to be moved for this.
+	\param element Element to move to the front of the array. */
+	void push_front(T&& element)
+	{
+		insert(std::move(element));
+	}
+
+
 	//! Insert item into array at specified position.
 	/**
 	\param element: Element to be inserted
@@ -133,13 +202,42 @@ public:
 	{
 		_IRR_DEBUG_BREAK_IF(index>used) // access violation
 
-		if (used + 1 > allocated)
+		if (used + 1 > allocated || contains(&element))
 		{
 			// this doesn't work if the element is in the same
 			// array. So we'll copy the element first to be sure
 			// we'll get no data corruption
-			const T e(element);
+			T e(element);
+			insert(std::move(e), index);
+			return;
+		}
+
+		open_gap(index);
+		allocator.construct(&data[index], element); // data[index] = element;
+
+		// set to false as we don't know if we have the comparison operators
+		is_sorted = false;
+		++used;
+	}
+
+
+	//! Moves an item into the array at specified position.
+	/**
+	\param element: Element to be moved into the array
+	\param index: Where position to insert the new element. */
+	void insert(T&& element, u32 index=0)
+	{
+		_IRR_DEBUG_BREAK_IF(index>used) // access violation
+
+		if (contains(&element))
+		{
+			T e(std::move(element));
+			insert(std::move(e), index);
+			return;
+		}
 
+		if (used + 1 > allocated)
+		{
 			// increase data block
 			u32 newAlloc;
 			switch ( strategy )
@@ -153,42 +251,11 @@ public:
 					break;
 			}
 			reallocate( newAlloc);
-
-			// move array content and construct new element
-			// first move end one up
-			for (u32 i=used; i>index; --i)
-			{
-				if (i<used)
-					allocator.destruct(&data[i]);
-				allocator.construct(&data[i], data[i-1]); // data[i] = data[i-1];
-			}
-			// then add new element
-			if (used > index)
-				allocator.destruct(&data[index]);
-			allocator.construct(&data[index], e); // data[index] = e;
-		}
-		else
-		{
-			// element inserted not at end
-			if ( used > index )
-			{
-				// create one new element at the end
-				allocator.construct(&data[used], data[used-1]);
-
-				// move the rest of the array content
-				for (u32 i=used-1; i>index; --i)
-				{
-					data[i] = data[i-1];
-				}
-				// insert the new element
-				data[index] = element;
-			}
-			else
-			{
-				// insert the new element to the end
-				allocator.construct(&data[index], element);
-			}
 		}
+
+		open_gap(index);
+		allocator.construct(&data[index], std::move(element)); // data[index] = element;
+
 		// set to false as we don't know if we have the comparison operators
 		is_sorted = false;
 		++used;
@@ -234,10 +301,10 @@ public:
 
 	//! Sets if the array should delete the memory it uses upon destruction.
 	/** Also clear and set_pointer will only delete the (original) memory
-	area if this flag is set to true, which is also the default. The
-	methods reallocate, set_used, push_back, push_front, insert, and erase
-	will still try to deallocate the original memory, which might cause
-	troubles depending on the intended use of the memory area.
+	area if this flag is set to true, which is also the default. When the
+	methods reallocate, set_used, push_back, push_front and insert need more
+	memory, the elements are moved to memory of the allocator. The original
+	memory area isn't freed then and the new memory belongs to the array.
 	\param f If true, the array frees the allocated memory in its
 	destructor, otherwise not. The default is true. */
 	void set_free_when_destroyed(bool f)
@@ -280,13 +347,34 @@ public:
 		is_sorted = other.is_sorted;
 		allocated = other.allocated;
 
-		for (u32 i=0; i<other.used; ++i)
-			allocator.construct(&data[i], other.data[i]); // data[i] = other.data[i];
+		if (IsTrivial)
+		{
+			if (other.used)
+				memcpy((void*)data, (const void*)other.data, other.used * sizeof(T));
+		}
+		else
+		{
+			for (u32 i=0; i<other.used; ++i)
+				allocator.construct(&data[i], other.data[i]); // data[i] = other.data[i];
+		}
 
 		return *this;
 	}
 
 
+	//! Move assignment operator
+	/** Takes over the memory of the other array, which is empty afterwards. */
+	const array<T, TAlloc>& operator=(array<T, TAlloc>&& other)
+	{
+		if (this == &other)
+			return *this;
+
+		clear();
+		swap(other);
+		return *this;
+	}
+
+
 	//! Equality operator
 	bool operator == (const array<T, TAlloc>& other) const
 	{
@@ -533,13 +621,17 @@ public:
 	{
 		_IRR_DEBUG_BREAK_IF(index>=used) // access violation
 
-		for (u32 i=index+1; i<used; ++i)
+		if (IsTrivial)
 		{
-			allocator.destruct(&data[i-1]);
-			allocator.construct(&data[i-1], data[i]); // data[i-1] = data[i];
+			memmove((void*)&data[index], (const void*)&data[index+1], (used-index-1) * sizeof(T));
 		}
+		else
+		{
+			for (u32 i=index+1; i<used; ++i)
+				data[i-1] = std::move(data[i]);
 
-		allocator.destruct(&data[used-1]);
+			allocator.destruct(&data[used-1]);
+		}
 
 		--used;
 	}
@@ -557,18 +649,18 @@ public:
 		if (index+count>used)
 			count = used-index;
 
-		u32 i;
-		for (i=index; i<index+count; ++i)
-			allocator.destruct(&data[i]);
-
-		for (i=index+count; i<used; ++i)
+		if (IsTrivial)
 		{
-			if (i-count >= index+count) // not already destructed before loop
-				allocator.destruct(&data[i-count]);
-
-			allocator.construct(&data[i-count], data[i]); // data[i-count] = data[i];
+			memmove((void*)&data[index], (const void*)&data[index+count], (used-index-count) * sizeof(T));
+		}
+		else
+		{
+			u32 i;
+			for (i=index+count; i<used; ++i)
+				data[i-count] = std::move(data[i]);
 
-			if (i >= used-count) // those which are not overwritten
+			// those which are not overwritten
+			for (i=used-count; i<used; ++i)
 				allocator.destruct(&data[i]);
 		}
 
@@ -609,6 +701,37 @@ public:
 	typedef u32 size_type;
 
 private:
+
+	//! Elements which can be moved around with memcpy
+	static const bool IsTrivial = std::is_trivially_copyable<T>::value;
+
+	//! Returns if the element is stored in this array
+	bool contains(const T* element) const
+	{
+		return element >= data && element < data + used;
+	}
+
+	//! Moves the elements from index on one place up
+	/** The array must have space for one more element. data[index] is not
+	constructed afterwards. */
+	void open_gap(u32 index)
+	{
+		if (index >= used)
+			return;
+
+		if (IsTrivial)
+		{
+			memmove((void*)&data[index+1], (const void*)&data[index], (used-index) * sizeof(T));
+		}
+		else
+		{
+			allocator.construct(&data[used], std::move(data[used-1]));
+			for (u32 i=used-1; i>index; --i)
+				data[i] = std::move(data[i-1]);
+			allocator.destruct(&data[index]);
+		}
+	}
+
 	T* data;
 	u32 allocated;
 	u32 used;
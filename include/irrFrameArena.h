@@ -0,0 +1,192 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __IRR_FRAME_ARENA_H_INCLUDED__
+#define __IRR_FRAME_ARENA_H_INCLUDED__
+
+#include "irrTypes.h"
+#include "irrAllocator.h"
+#include "irrArray.h"
+#include <type_traits>
+
+namespace irr
+{
+namespace core
+{
+
+//! Linear allocator for scratch memory which is only needed during one frame
+/** Allocations take the next bytes of the current block and are never freed
+one by one, reset() releases all of them at once. When a block is full, a
+further block is allocated. reset() replaces those blocks by one block which
+is large enough for all of them, so frames which don't need more memory than
+the frames before don't allocate heap memory.
+Destructors aren't called, so only trivially destructible objects should be
+placed in the arena. It isn't thread safe. */
+class frame_arena
+{
+public:
+
+	//! Constructor
+	/** \param blockSize Size of the first block, which is allocated by the
+	first allocation. */
+	explicit frame_arena(size_t blockSize = 64 * 1024)
+		: Position(0), End(0), Used(0), BlockSize(blockSize) {}
+
+	//! Destructor, frees all blocks
+	~frame_arena()
+	{
+		for (u32 i=0; i<Blocks.size(); ++i)
+			BlockAllocator.deallocate(Blocks[i].Data);
+	}
+
+	//! Allocates bytes which stay valid until the next reset()
+	/** \param alignment Power of two the address is a multiple of. */
+	void* allocate(size_t bytes, size_t alignment = 16)
+	{
+		u8* p = align(Position, alignment);
+		if (!Position || p + bytes > End)
+		{
+			addBlock(bytes + alignment);
+			p = align(Position, alignment);
+		}
+
+		Position = p + bytes;
+		Used += bytes;
+		return p;
+	}
+
+	//! Allocates uninitialized memory for count elements
+	template <class T>
+	T* allocate_array(u32 count)
+	{
+		return (T*)allocate(count * sizeof(T), alignof(T));
+	}
+
+	//! Lets an array use arena memory for up to count elements
+	/** The array is empty afterwards and takes count elements without
+	allocating. If it grows beyond that, it moves to memory of its own
+	allocator. As no constructors and destructors are called for the arena
+	memory, this is only allowed for trivially copyable elements. */
+	template <class T, typename TAlloc>
+	void bind(array<T, TAlloc>& a, u32 count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value,
+			"frame_arena::bind needs trivially copyable elements");
+		a.set_pointer(allocate_array<T>(count), count, false, false);
+		a.set_used(0);
+	}
+
+	//! Releases all allocations
+	/** If more than one block was needed since the last reset, they are
+	merged into one block. */
+	void reset()
+	{
+		if (Blocks.size() > 1)
+		{
+			size_t size = 0;
+			for (u32 i=0; i<Blocks.size(); ++i)
+			{
+				size += Blocks[i].Size;
+				BlockAllocator.deallocate(Blocks[i].Data);
+			}
+			Blocks.set_used(0);
+			BlockSize = size;
+			addBlock(size);
+		}
+		else if (Blocks.size())
+		{
+			Position = Blocks[0].Data;
+		}
+
+		Used = 0;
+	}
+
+	//! Returns the number of bytes allocated since the last reset()
+	size_t used_size() const
+	{
+		return Used;
+	}
+
+	//! Returns the number of bytes in all blocks
+	size_t allocated_size() const
+	{
+		size_t size = 0;
+		for (u32 i=0; i<Blocks.size(); ++i)
+			size += Blocks[i].Size;
+		return size;
+	}
+
+private:
+
+	frame_arena(const frame_arena& other);
+	frame_arena& operator=(const frame_arena& other);
+
+	struct SBlock
+	{
+		u8* Data;
+		size_t Size;
+	};
+
+	static u8* align(u8* p, size_t alignment)
+	{
+		return (u8*)(((size_t)p + alignment - 1) & ~(alignment - 1));
+	}
+
+	void addBlock(size_t minSize)
+	{
+		SBlock block;
+		block.Size = BlockSize > minSize ? BlockSize : minSize;
+		block.Data = BlockAllocator.allocate(block.Size);
+		Blocks.push_back(block);
+
+		Position = block.Data;
+		End = block.Data + block.Size;
+	}
+
+	array<SBlock> Blocks;
+	irrAllocator<u8> BlockAllocator;
+	u8* Position;
+	u8* End;
+	size_t Used;
+	size_t BlockSize;
+};
+
+
+//! Allocator which takes the memory of containers from a frame_arena
+/** deallocate() doesn't free anything, the memory is released by the next
+frame_arena::reset(), so containers using it must not live longer than the
+frame. Without arena, it allocates from the heap like irrAllocator. */
+template<typename T>
+class irrFrameAllocator : public irrAllocator<T>
+{
+public:
+
+	irrFrameAllocator(frame_arena* arena = 0) : Arena(arena) {}
+
+protected:
+
+	virtual void* internal_new(size_t cnt) _IRR_OVERRIDE_
+	{
+		if (Arena)
+			return Arena->allocate(cnt, alignof(T));
+		return irrAllocator<T>::internal_new(cnt);
+	}
+
+	virtual void internal_delete(void* ptr) _IRR_OVERRIDE_
+	{
+		if (!Arena)
+			irrAllocator<T>::internal_delete(ptr);
+	}
+
+private:
+
+	frame_arena* Arena;
+};
+
+
+} // end namespace core
+} // end namespace irr
+
+#endif
+
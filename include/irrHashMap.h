@@ -0,0 +1,529 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __IRR_HASH_MAP_H_INCLUDED__
+#define __IRR_HASH_MAP_H_INCLUDED__
+
+#include "irrTypes.h"
+#include "irrAllocator.h"
+#include "irrMath.h"
+#include "irrString.h"
+#include <string.h>
+#include <type_traits>
+#include <utility>
+
+namespace irr
+{
+namespace core
+{
+
+//! mixes the bits of an integer, so that hash_map can use the low bits of the result
+inline u32 hash_integer(u64 value)
+{
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdULL;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ULL;
+	value ^= value >> 33;
+	return (u32)value;
+}
+
+//! Hash function object used by hash_map
+/** The default handles integers and enumerations, there are
+specializations for pointers and strings. */
+template <class T>
+struct hash
+{
+	u32 operator()(const T& value) const
+	{
+		static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+			"core::hash needs a specialization for this key type");
+		return hash_integer((u64)value);
+	}
+};
+
+//! Hashes the address of a pointer
+template <class T>
+struct hash<T*>
+{
+	u32 operator()(const T* value) const
+	{
+		return hash_integer((u64)(size_t)value);
+	}
+};
+
+//! Hashes the characters of a string with FNV-1a
+template <class T, typename TAlloc>
+struct hash<string<T, TAlloc> >
+{
+	u32 operator()(const string<T, TAlloc>& value) const
+	{
+		const T* c = value.c_str();
+		u32 h = 2166136261u;
+		for (u32 i=0; i<value.size(); ++i)
+		{
+			h ^= (u32)c[i];
+			h *= 16777619u;
+		}
+		return h;
+	}
+};
+
+
+//! Element of a hash_map
+template <class KeyType, class ValueType>
+class hash_map_node
+{
+public:
+
+	hash_map_node(const KeyType& k, const ValueType& v) : Key(k), Value(v) {}
+
+	const KeyType& getKey() const
+	{
+		return Key;
+	}
+
+	const ValueType& getValue() const
+	{
+		return Value;
+	}
+
+	ValueType& getValue()
+	{
+		return Value;
+	}
+
+	void setValue(const ValueType& v)
+	{
+		Value = v;
+	}
+
+private:
+
+	KeyType Key;
+	ValueType Value;
+};
+
+
+//! Associative array using open addressing with Robin Hood hashing
+/** The elements are stored in one array, colliding keys are placed in the
+following slots. An insertion takes the slot of an element which is closer to
+its own home slot, which keeps the probe sequences short and lets lookups stop
+early. Removal shifts the following elements back instead of leaving
+tombstones. The hash of each slot is kept in a separate array, so probing only
+compares keys whose hashes match.
+Unlike map, the elements aren't sorted and inserting or removing elements
+moves other elements, which invalidates pointers to nodes and iterators. */
+template <class KeyType, class ValueType, class THash = hash<KeyType>,
+	typename TAlloc = irrAllocator<hash_map_node<KeyType, ValueType> > >
+class hash_map
+{
+public:
+
+	typedef hash_map_node<KeyType, ValueType> Node;
+
+	// typedefs
+	typedef KeyType key_type;
+	typedef ValueType value_type;
+	typedef u32 size_type;
+
+	//! Iterator over all elements, in no particular order
+	class Iterator
+	{
+	public:
+
+		Iterator() : Map(0), Slot(0) {}
+
+		explicit Iterator(hash_map* map) : Map(map), Slot(0)
+		{
+			skipEmpty();
+		}
+
+		bool atEnd() const
+		{
+			return Slot >= Map->Capacity;
+		}
+
+		void operator++(int)
+		{
+			++Slot;
+			skipEmpty();
+		}
+
+		Node* getNode()
+		{
+			return Map->Nodes + Slot;
+		}
+
+		Node* operator->()
+		{
+			return getNode();
+		}
+
+		Node& operator*()
+		{
+			return *getNode();
+		}
+
+	private:
+
+		void skipEmpty()
+		{
+			while (Slot < Map->Capacity && !Map->Hashes[Slot])
+				++Slot;
+		}
+
+		hash_map* Map;
+		u32 Slot;
+	};
+
+	//! Const iterator over all elements, in no particular order
+	class ConstIterator
+	{
+	public:
+
+		ConstIterator() : Map(0), Slot(0) {}
+
+		explicit ConstIterator(const hash_map* map) : Map(map), Slot(0)
+		{
+			skipEmpty();
+		}
+
+		bool atEnd() const
+		{
+			return Slot >= Map->Capacity;
+		}
+
+		void operator++(int)
+		{
+			++Slot;
+			skipEmpty();
+		}
+
+		const Node* getNode() const
+		{
+			return Map->Nodes + Slot;
+		}
+
+		const Node* operator->() const
+		{
+			return getNode();
+		}
+
+		const Node& operator*() const
+		{
+			return *getNode();
+		}
+
+	private:
+
+		void skipEmpty()
+		{
+			while (Slot < Map->Capacity && !Map->Hashes[Slot])
+				++Slot;
+		}
+
+		const hash_map* Map;
+		u32 Slot;
+	};
+
+	//! Constructor
+	hash_map() : Nodes(0), Hashes(0), Capacity(0), Size(0) {}
+
+	//! Copy constructor
+	hash_map(const hash_map& other) : Nodes(0), Hashes(0), Capacity(0), Size(0)
+	{
+		*this = other;
+	}
+
+	//! Move constructor
+	hash_map(hash_map&& other) : Nodes(0), Hashes(0), Capacity(0), Size(0)
+	{
+		swap(other);
+	}
+
+	//! Destructor
+	~hash_map()
+	{
+		clear();
+		allocator.deallocate(Nodes);
+		hashAllocator.deallocate(Hashes);
+	}
+
+	//! Assignment operator
+	hash_map& operator=(const hash_map& other)
+	{
+		if (this == &other)
+			return *this;
+
+		clear();
+		reallocate(other.Size);
+		for (u32 i=0; i<other.Capacity; ++i)
+		{
+			if (other.Hashes[i])
+				insertNew(other.Hashes[i], Node(other.Nodes[i]));
+		}
+		Size = other.Size;
+		return *this;
+	}
+
+	//! Move assignment operator
+	hash_map& operator=(hash_map&& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			swap(other);
+		}
+		return *this;
+	}
+
+	//! Inserts a new element
+	/** \param key The key of the new element.
+	\param value The value of the new element.
+	\return False if the key already exists, the value isn't changed then. */
+	bool insert(const KeyType& key, const ValueType& value)
+	{
+		const u32 h = hashKey(key);
+		if (findSlot(key, h) != -1)
+			return false;
+
+		grow();
+		++Size;
+		insertNew(h, Node(key, value));
+		return true;
+	}
+
+	//! Replaces the value if the key already exists, otherwise inserts a new element.
+	void set(const KeyType& key, const ValueType& value)
+	{
+		Node* node = find(key);
+		if (node)
+			node->setValue(value);
+		else
+			insert(key, value);
+	}
+
+	//! Finds an element
+	/** \return Pointer to the node of the key, or 0 if it wasn't found. The
+	pointer is only valid until elements are inserted or removed. */
+	Node* find(const KeyType& key)
+	{
+		const s32 slot = findSlot(key, hashKey(key));
+		return slot != -1 ? Nodes + slot : 0;
+	}
+
+	//! Finds an element
+	const Node* find(const KeyType& key) const
+	{
+		const s32 slot = findSlot(key, hashKey(key));
+		return slot != -1 ? Nodes + slot : 0;
+	}
+
+	//! Returns the value of a key, a default constructed value is inserted if it doesn't exist.
+	ValueType& operator[](const KeyType& key)
+	{
+		const u32 h = hashKey(key);
+		const s32 slot = findSlot(key, h);
+		if (slot != -1)
+			return Nodes[slot].getValue();
+
+		grow();
+		++Size;
+		return insertNew(h, Node(key, ValueType()))->getValue();
+	}
+
+	//! Removes an element
+	/** \return False if the key wasn't found. */
+	bool remove(const KeyType& key)
+	{
+		s32 slot = findSlot(key, hashKey(key));
+		if (slot == -1)
+			return false;
+
+		allocator.destruct(Nodes + slot);
+		Hashes[slot] = 0;
+
+		// shift the following elements of the probe sequence back by one
+		u32 next = (slot + 1) & (Capacity - 1);
+		while (Hashes[next] && distance(next) != 0)
+		{
+			allocator.construct(Nodes + slot, std::move(Nodes[next]));
+			allocator.destruct(Nodes + next);
+			Hashes[slot] = Hashes[next];
+			Hashes[next] = 0;
+			slot = next;
+			next = (next + 1) & (Capacity - 1);
+		}
+
+		--Size;
+		return true;
+	}
+
+	//! Removes all elements, the memory is kept for reuse
+	void clear()
+	{
+		for (u32 i=0; i<Capacity && Size; ++i)
+		{
+			if (Hashes[i])
+			{
+				allocator.destruct(Nodes + i);
+				Hashes[i] = 0;
+				--Size;
+			}
+		}
+		Size = 0;
+	}
+
+	//! Reserves memory, so that count elements can be inserted without rehashing
+	void reallocate(u32 count)
+	{
+		u32 capacity = 8;
+		while (capacity - capacity / 8 < count)
+			capacity <<= 1;
+
+		if (capacity > Capacity)
+			rehash(capacity);
+	}
+
+	//! Swap the content of this map with the content of another map
+	void swap(hash_map& other)
+	{
+		core::swap(Nodes, other.Nodes);
+		core::swap(Hashes, other.Hashes);
+		core::swap(Capacity, other.Capacity);
+		core::swap(Size, other.Size);
+		core::swap(allocator, other.allocator);
+		core::swap(hashAllocator, other.hashAllocator);
+	}
+
+	//! Returns the number of elements
+	u32 size() const
+	{
+		return Size;
+	}
+
+	//! Returns true if the map contains no elements
+	bool empty() const
+	{
+		return Size == 0;
+	}
+
+	//! Returns an iterator over all elements
+	Iterator getIterator()
+	{
+		return Iterator(this);
+	}
+
+	//! Returns a const iterator over all elements
+	ConstIterator getConstIterator() const
+	{
+		return ConstIterator(this);
+	}
+
+private:
+
+	//! hash of a key, the highest bit marks occupied slots
+	static u32 hashKey(const KeyType& key)
+	{
+		return THash()(key) | 0x80000000;
+	}
+
+	//! distance of an occupied slot to the home slot of its element
+	u32 distance(u32 slot) const
+	{
+		return (slot - Hashes[slot]) & (Capacity - 1);
+	}
+
+	s32 findSlot(const KeyType& key, u32 h) const
+	{
+		if (!Size)
+			return -1;
+
+		u32 slot = h & (Capacity - 1);
+		for (u32 dist=0; Hashes[slot] && distance(slot) >= dist; ++dist)
+		{
+			if (Hashes[slot] == h && Nodes[slot].getKey() == key)
+				return (s32)slot;
+			slot = (slot + 1) & (Capacity - 1);
+		}
+		return -1;
+	}
+
+	//! makes room for one more element
+	void grow()
+	{
+		if (Size + 1 > Capacity - Capacity / 8)
+			rehash(Capacity ? Capacity * 2 : 8);
+	}
+
+	//! places an element whose key doesn't exist yet, doesn't change Size
+	Node* insertNew(u32 h, Node&& node)
+	{
+		Node* result = 0;
+		u32 slot = h & (Capacity - 1);
+		u32 dist = 0;
+		for (;;)
+		{
+			if (!Hashes[slot])
+			{
+				Hashes[slot] = h;
+				allocator.construct(Nodes + slot, std::move(node));
+				return result ? result : Nodes + slot;
+			}
+
+			// take the slot of elements closer to their home slot
+			const u32 existing = distance(slot);
+			if (existing < dist)
+			{
+				core::swap(h, Hashes[slot]);
+				core::swap(node, Nodes[slot]);
+				if (!result)
+					result = Nodes + slot;
+				dist = existing;
+			}
+
+			slot = (slot + 1) & (Capacity - 1);
+			++dist;
+		}
+	}
+
+	void rehash(u32 capacity)
+	{
+		Node* oldNodes = Nodes;
+		u32* oldHashes = Hashes;
+		const u32 oldCapacity = Capacity;
+
+		Nodes = allocator.allocate(capacity);
+		Hashes = hashAllocator.allocate(capacity);
+		memset(Hashes, 0, capacity * sizeof(u32));
+		Capacity = capacity;
+
+		for (u32 i=0; i<oldCapacity; ++i)
+		{
+			if (oldHashes[i])
+			{
+				insertNew(oldHashes[i], std::move(oldNodes[i]));
+				allocator.destruct(oldNodes + i);
+			}
+		}
+
+		allocator.deallocate(oldNodes);
+		hashAllocator.deallocate(oldHashes);
+	}
+
+	Node* Nodes;
+	u32* Hashes;
+	u32 Capacity;
+	u32 Size;
+	TAlloc allocator;
+	irrAllocator<u32> hashAllocator;
+};
+
+
+} // end namespace core
+} // end namespace irr
+
+#endif
+
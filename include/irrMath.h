@@ -11,6 +11,7 @@
 #include <float.h>
 #include <stdlib.h> // for abs() etc.
 #include <limits.h> // For INT_MAX / UINT_MAX
+#include <utility> // for std::move
 
 namespace irr
 {
@@ -154,9 +155,9 @@ namespace core
 	template <class T1, class T2>
 	inline void swap(T1& a, T2& b)
 	{
-		T1 c(a);
-		a = b;
-		b = c;
+		T1 c(std::move(a));
+		a = std::move(b);
+		b = std::move(c);
 	}
 
 	template <class T>
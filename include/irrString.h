@@ -99,24 +99,31 @@ public:
 
 	//! Default constructor
 	string()
-	: array(0), allocated(1), used(1)
+	: array(sso), allocated(SSO_SIZE), used(1)
 	{
-		array = allocator.allocate(1); // new T[1];
 		array[0] = 0;
 	}
 
 
 	//! Constructor
 	string(const string<T,TAlloc>& other)
-	: array(0), allocated(0), used(0)
+	: array(sso), allocated(SSO_SIZE), used(0)
 	{
 		*this = other;
 	}
 
+	//! Move constructor
+	/** Takes over the memory of the other string, which is empty afterwards. */
+	string(string<T,TAlloc>&& other)
+	: array(sso), allocated(SSO_SIZE), used(0)
+	{
+		*this = std::move(other);
+	}
+
 	//! Constructor from other string types
 	template <class B, class A>
 	string(const string<B, A>& other)
-	: array(0), allocated(0), used(0)
+	: array(sso), allocated(SSO_SIZE), used(0)
 	{
 		*this = other;
 	}
@@ -124,7 +131,7 @@ public:
 
 	//! Constructs a string from a float
 	explicit string(const double number)
-	: array(0), allocated(0), used(0)
+	: array(sso), allocated(SSO_SIZE), used(0)
 	{
 		c8 tmpbuf[255];
 		snprintf_irr(tmpbuf, 255, "%0.6f", number);
@@ -134,7 +141,7 @@ public:
 
 	//! Constructs a string from an int
 	explicit string(int number)
-	: array(0), allocated(0), used(0)
+	: array(sso), allocated(SSO_SIZE), used(0)
 	{
 		// store if negative and make positive
 
@@ -182,7 +189,7 @@ public:
 
 	//! Constructs a string from an unsigned int
 	explicit string(unsigned int number)
-	: array(0), allocated(0), used(0)
+	: array(sso), allocated(SSO_SIZE), used(0)
 	{
 		// temporary buffer for 16 numbers
 
@@ -213,7 +220,7 @@ public:
 
 	//! Constructs a string from a long
 	explicit string(long number)
-	: array(0), allocated(0), used(0)
+	: array(sso), allocated(SSO_SIZE), used(0)
 	{
 		// store if negative and make positive
 
@@ -261,7 +268,7 @@ public:
 
 	//! Constructs a string from an unsigned long
 	explicit string(unsigned long number)
-	: array(0), allocated(0), used(0)
+	: array(sso), allocated(SSO_SIZE), used(0)
 	{
 		// temporary buffer for 16 numbers
 
@@ -293,7 +300,7 @@ public:
 	//! Constructor for copying a string from a pointer with a given length
 	template <class B>
 	string(const B* const c, u32 length)
-	: array(0), allocated(0), used(0)
+	: array(sso), allocated(SSO_SIZE), used(0)
 	{
 		if (!c)
 		{
@@ -302,8 +309,12 @@ public:
 			return;
 		}
 
-		allocated = used = length+1;
-		array = allocator.allocate(used); // new T[used];
+		used = length+1;
+		if (used>allocated)
+		{
+			allocated = used;
+			array = allocator.allocate(used); // new T[used];
+		}
 
 		for (u32 l = 0; l<length; ++l)
 			array[l] = (T)c[l];
@@ -315,7 +326,7 @@ public:
 	//! Constructor for Unicode and ASCII strings
 	template <class B>
 	string(const B* const c)
-	: array(0), allocated(0), used(0)
+	: array(sso), allocated(SSO_SIZE), used(0)
 	{
 		*this = c;
 	}
@@ -324,7 +335,7 @@ public:
 	//! Destructor
 	~string()
 	{
-		allocator.deallocate(array); // delete [] array;
+		release(array);
 	}
 
 
@@ -337,7 +348,7 @@ public:
 		used = other.size()+1;
 		if (used>allocated)
 		{
-			allocator.deallocate(array); // delete [] array;
+			release(array);
 			allocated = used;
 			array = allocator.allocate(used); //new T[used];
 		}
@@ -349,6 +360,29 @@ public:
 		return *this;
 	}
 
+	//! Move assignment operator
+	/** Takes over the memory of the other string, which is empty afterwards. */
+	string<T,TAlloc>& operator=(string<T,TAlloc>&& other)
+	{
+		if (this == &other)
+			return *this;
+
+		// short strings are stored in the other object and have to be copied
+		if (other.array == other.sso)
+			return *this = other;
+
+		release(array);
+		array = other.array;
+		allocated = other.allocated;
+		used = other.used;
+
+		other.array = other.sso;
+		other.allocated = SSO_SIZE;
+		other.used = 1;
+		other.sso[0] = 0;
+		return *this;
+	}
+
 	//! Assignment operator for other string types
 	template <class B, class A>
 	string<T,TAlloc>& operator=(const string<B,A>& other)
@@ -364,11 +398,6 @@ public:
 	{
 		if (!c)
 		{
-			if (!array)
-			{
-				array = allocator.allocate(1); //new T[1];
-				allocated = 1;
-			}
 			used = 1;
 			array[0] = 0x0;
 			return *this;
@@ -399,7 +428,7 @@ public:
 			array[l] = (T)c[l];
 
 		if (oldArray != array)
-			allocator.deallocate(oldArray); // delete [] oldArray;
+			release(oldArray);
 
 		return *this;
 	}
@@ -1432,25 +1461,50 @@ private:
 	{
 		T* old_array = array;
 
-		array = allocator.allocate(new_size); //new T[new_size];
-		allocated = new_size;
+		if (new_size <= SSO_SIZE)
+		{
+			array = sso;
+			allocated = SSO_SIZE;
+		}
+		else
+		{
+			array = allocator.allocate(new_size); //new T[new_size];
+			allocated = new_size;
+		}
 
-		const u32 amount = used < new_size ? used : new_size;
-		for (u32 i=0; i<amount; ++i)
-			array[i] = old_array[i];
+		if (array != old_array)
+		{
+			const u32 amount = used < new_size ? used : new_size;
+			for (u32 i=0; i<amount; ++i)
+				array[i] = old_array[i];
+		}
 
-		if (allocated < used)
-			used = allocated;
+		if (new_size < used)
+			used = new_size;
 
-		allocator.deallocate(old_array); // delete [] old_array;
+		if (array != old_array)
+			release(old_array);
 	}
 
+	//! Frees memory of the array, unless it's the small string buffer
+	void release(T* p)
+	{
+		if (p != sso)
+			allocator.deallocate(p); // delete [] p;
+	}
+
+	//! Characters which fit into the small string buffer
+	enum { SSO_SIZE = sizeof(T) < 16 ? 16 / sizeof(T) : 1 };
+
 	//--- member variables
 
 	T* array;
 	u32 allocated;
 	u32 used;
 	TAlloc allocator;
+
+	//! Small string buffer, used instead of allocated memory for short strings
+	T sso[SSO_SIZE];
 };
 
 
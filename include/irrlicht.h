@@ -59,8 +59,10 @@
 #include "IAttributeExchangingObject.h"
 #include "IAttributes.h"
 #include "IBillboardSceneNode.h"
+#include "IBillboardGroupSceneNode.h"
 #include "IBoneSceneNode.h"
 #include "ICameraSceneNode.h"
+#include "IClusteredLightManager.h"
 #include "IContextManager.h"
 #include "ICursorControl.h"
 #include "IDummyTransformationSceneNode.h"
@@ -114,6 +116,8 @@
 #include "IReadFile.h"
 #include "IReferenceCounted.h"
 #include "irrArray.h"
+#include "irrFrameArena.h"
+#include "irrHashMap.h"
 #include "IRandomizer.h"
 #include "IRenderTarget.h"
 #include "IrrlichtDevice.h"
@@ -131,6 +135,7 @@
 #include "ISceneUserDataSerializer.h"
 #include "IShaderConstantSetCallBack.h"
 #include "ISkinnedMesh.h"
+#include "ITerrainSceneNode.h"
 #include "ITexture.h"
 #include "ITimer.h"
 #include "IVertexBuffer.h"
@@ -153,6 +158,7 @@
 #include "SIrrCreationParameters.h"
 #include "SKeyMap.h"
 #include "SLight.h"
+#include "SLODMesh.h"
 #include "SMaterial.h"
 #include "SMesh.h"
 #include "SMeshBuffer.h"
@@ -247,6 +247,9 @@ void CAnimatedMeshSceneNode::OnAnimate(u32 timeMs)
 	}
 	LastTimeMs = timeMs;
 
+	// counted again each frame, also when the node didn't register again
+	PassCount = 0;
+
 	IAnimatedMeshSceneNode::OnAnimate(timeMs);
 }
 
@@ -642,6 +645,7 @@ void CAnimatedMeshSceneNode::setAnimationEndCallback(IAnimationEndCallBack* call
 void CAnimatedMeshSceneNode::setReadOnlyMaterials(bool readonly)
 {
 	ReadOnlyMaterials = readonly;
+	markChanged();
 }
 
 
@@ -736,6 +740,8 @@ void CAnimatedMeshSceneNode::setMesh(IAnimatedMesh* mesh)
 		}
 	}
 
+	markChanged();
+
 	// clean up joint nodes
 	if (JointsUsed)
 	{
@@ -939,6 +945,7 @@ ISceneNode* CAnimatedMeshSceneNode::clone(ISceneNode* newParent, ISceneManager*
 	newNode->cloneMembers(this, newManager);
 
 	newNode->Materials = Materials;
+	newNode->markChanged();
 	newNode->Box = Box;
 	newNode->Mesh = Mesh;
 	newNode->StartFrame = StartFrame;
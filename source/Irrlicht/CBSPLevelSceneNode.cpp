@@ -0,0 +1,287 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+
+#ifdef _IRR_COMPILE_WITH_BSP_LEVEL_SCENENODE_
+
+#include "CBSPLevelSceneNode.h"
+#include "ISceneManager.h"
+#include "IVideoDriver.h"
+#include "ICameraSceneNode.h"
+
+namespace irr
+{
+namespace scene
+{
+
+namespace
+{
+	//! false if the box is completely outside of one of the frustum planes
+	bool isBoxInFrustum(const core::aabbox3d<f32>& box, const SViewFrustum& frustum)
+	{
+		for (u32 i=0; i!=SViewFrustum::VF_PLANE_COUNT; ++i)
+		{
+			if (box.classifyPlaneRelation(frustum.planes[i]) == core::ISREL3D_FRONT)
+				return false;
+		}
+		return true;
+	}
+}
+
+
+//! constructor
+CBSPLevelSceneNode::CBSPLevelSceneNode(IQ3LevelMesh* mesh, ISceneNode* parent,
+		ISceneManager* mgr, s32 id)
+	: IBSPLevelSceneNode(parent, mgr, id), LevelMesh(mesh), Mesh(0),
+	Frame(0), VisibleFaceCount(0), PassCount(0)
+{
+	#ifdef _DEBUG
+	setDebugName("CBSPLevelSceneNode");
+	#endif
+
+	if (LevelMesh)
+	{
+		LevelMesh->grab();
+		Mesh = LevelMesh->getMesh(quake3::E_Q3_MESH_GEOMETRY);
+		Tree = LevelMesh->getBSPTree();
+	}
+
+	if (Mesh)
+	{
+		Box = Mesh->getBoundingBox();
+
+		Materials.reallocate(Mesh->getMeshBufferCount());
+		Ranges.reallocate(Mesh->getMeshBufferCount());
+		for (u32 i=0; i<Mesh->getMeshBufferCount(); ++i)
+		{
+			Materials.push_back(Mesh->getMeshBuffer(i)->getMaterial());
+			Ranges.push_back(core::array<video::SIndexRange>());
+		}
+	}
+
+	FaceFrame.set_used(Tree.Faces.size());
+	for (u32 i=0; i<FaceFrame.size(); ++i)
+		FaceFrame[i] = 0;
+}
+
+
+//! destructor
+CBSPLevelSceneNode::~CBSPLevelSceneNode()
+{
+	if (LevelMesh)
+		LevelMesh->drop();
+}
+
+
+void CBSPLevelSceneNode::OnRegisterSceneNode()
+{
+	if (IsVisible && Mesh)
+	{
+		video::IVideoDriver* driver = SceneManager->getVideoDriver();
+
+		PassCount = 0;
+		u32 transparentCount = 0;
+		u32 solidCount = 0;
+
+		// count transparent and solid materials in this scene node
+		for (u32 i=0; i<Materials.size(); ++i)
+		{
+			if (driver->needsTransparentRenderPass(Materials[i]))
+				++transparentCount;
+			else
+				++solidCount;
+
+			if (solidCount && transparentCount)
+				break;
+		}
+
+		if (solidCount)
+			SceneManager->registerNodeForRendering(this, scene::ESNRP_SOLID);
+
+		if (transparentCount)
+			SceneManager->registerNodeForRendering(this, scene::ESNRP_TRANSPARENT);
+	}
+
+	ISceneNode::OnRegisterSceneNode();
+}
+
+
+//! OnAnimate() is called just before rendering the whole scene.
+void CBSPLevelSceneNode::OnAnimate(u32 timeMs)
+{
+	// the render passes are counted again each frame, also when the node
+	// didn't register again because the scene manager kept its render lists
+	PassCount = 0;
+
+	ISceneNode::OnAnimate(timeMs);
+}
+
+
+//! renders the node.
+void CBSPLevelSceneNode::render()
+{
+	video::IVideoDriver* driver = SceneManager->getVideoDriver();
+	ICameraSceneNode* camera = SceneManager->getActiveCamera();
+
+	if (!driver || !camera || !Mesh)
+		return;
+
+	const bool isTransparentPass =
+		SceneManager->getSceneNodeRenderPass() == scene::ESNRP_TRANSPARENT;
+
+	// the visible faces don't change between the solid and the transparent pass
+	++PassCount;
+	if (PassCount == 1)
+		calculateVisibleFaces(camera->getAbsolutePosition(), *camera->getViewFrustum());
+
+	driver->setTransform(video::ETS_WORLD, AbsoluteTransformation);
+
+	for (u32 i=0; i<Ranges.size(); ++i)
+	{
+		if (Ranges[i].empty())
+			continue;
+
+		// only render transparent buffer if this is the transparent render pass
+		// and solid only in solid pass
+		if (driver->needsTransparentRenderPass(Materials[i]) != isTransparentPass)
+			continue;
+
+		driver->setMaterial(Materials[i]);
+		driver->drawMeshBufferRanges(Mesh->getMeshBuffer(i), Ranges[i].const_pointer(), Ranges[i].size());
+	}
+
+	// for debug purposes only
+	if (DebugDataVisible & scene::EDS_BBOX && PassCount == 1)
+	{
+		video::SMaterial m;
+		m.Lighting = false;
+		driver->setMaterial(m);
+		driver->draw3DBox(Box, video::SColor(255,255,255,255));
+	}
+}
+
+
+//! Collects the faces visible from a camera
+u32 CBSPLevelSceneNode::calculateVisibleFaces(const core::vector3df& cameraPosition,
+		const SViewFrustum& frustum)
+{
+	VisibleFaceCount = 0;
+	for (u32 i=0; i<Ranges.size(); ++i)
+		Ranges[i].set_used(0);
+
+	if (!Mesh)
+		return 0;
+
+	// without tree, everything is visible
+	if (Tree.Nodes.empty())
+	{
+		for (u32 i=0; i<Tree.Faces.size(); ++i)
+			addFace(Tree.Faces[i]);
+		return VisibleFaceCount;
+	}
+
+	// the tree is in object space
+	core::vector3df pos(cameraPosition);
+	SViewFrustum frust(frustum);
+	if (!AbsoluteTransformation.isIdentity())
+	{
+		core::matrix4 invTrans(AbsoluteTransformation, core::matrix4::EM4CONST_INVERSE);
+		invTrans.transformVect(pos);
+		frust.transform(invTrans);
+	}
+
+	++Frame;
+	if (!Frame)
+	{
+		for (u32 i=0; i<FaceFrame.size(); ++i)
+			FaceFrame[i] = 0;
+		Frame = 1;
+	}
+
+	const s32 leaf = Tree.findLeaf(pos);
+	const s32 cluster = leaf >= 0 ? Tree.Leafs[leaf].Cluster : -1;
+
+	// mark the faces of the visible leafs
+	for (u32 i=0; i<Tree.Leafs.size(); ++i)
+	{
+		const quake3::SBSPLeaf& l = Tree.Leafs[i];
+		if (!l.FaceCount || !Tree.isClusterVisible(cluster, l.Cluster) ||
+			!isBoxInFrustum(l.Box, frust))
+			continue;
+
+		for (u32 f=l.FirstFace; f<l.FirstFace+l.FaceCount; ++f)
+		{
+			const s32 face = Tree.LeafFaces[f];
+			if (face >= 0)
+				FaceFrame[face] = Frame;
+		}
+	}
+
+	// faces in the order of the file, so that neighbouring faces of
+	// a mesh buffer are merged into one range
+	for (u32 i=0; i<Tree.Faces.size(); ++i)
+	{
+		if (FaceFrame[i] == Frame)
+			addFace(Tree.Faces[i]);
+	}
+
+	return VisibleFaceCount;
+}
+
+
+void CBSPLevelSceneNode::addFace(const quake3::SBSPFace& face)
+{
+	if (face.MeshBuffer < 0 || (u32)face.MeshBuffer >= Ranges.size())
+		return;
+
+	++VisibleFaceCount;
+
+	core::array<video::SIndexRange>& ranges = Ranges[face.MeshBuffer];
+	if (!ranges.empty() &&
+		ranges.getLast().Start + ranges.getLast().Count == face.Indices.Start)
+	{
+		ranges.getLast().Count += face.Indices.Count;
+	}
+	else
+		ranges.push_back(face.Indices);
+}
+
+
+//! Returns the number of faces found by the last calculateVisibleFaces() call
+u32 CBSPLevelSceneNode::getVisibleFaceCount() const
+{
+	return VisibleFaceCount;
+}
+
+
+//! returns the axis aligned bounding box of this node
+const core::aabbox3d<f32>& CBSPLevelSceneNode::getBoundingBox() const
+{
+	return Box;
+}
+
+
+//! returns the material based on the zero based index i.
+video::SMaterial& CBSPLevelSceneNode::getMaterial(u32 i)
+{
+	if (i >= Materials.size())
+		return ISceneNode::getMaterial(i);
+
+	return Materials[i];
+}
+
+
+//! returns amount of materials used by this scene node.
+u32 CBSPLevelSceneNode::getMaterialCount() const
+{
+	return Materials.size();
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_BSP_LEVEL_SCENENODE_
+
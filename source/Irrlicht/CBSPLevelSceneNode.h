@@ -0,0 +1,79 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_BSP_LEVEL_SCENE_NODE_H_INCLUDED__
+#define __C_BSP_LEVEL_SCENE_NODE_H_INCLUDED__
+
+#include "IBSPLevelSceneNode.h"
+#include "IQ3LevelMesh.h"
+
+namespace irr
+{
+namespace scene
+{
+
+//! Scene node drawing the visible faces of a quake3 level
+class CBSPLevelSceneNode : public IBSPLevelSceneNode
+{
+public:
+
+	//! constructor
+	CBSPLevelSceneNode(IQ3LevelMesh* mesh, ISceneNode* parent, ISceneManager* mgr, s32 id);
+
+	//! destructor
+	virtual ~CBSPLevelSceneNode();
+
+	virtual void OnRegisterSceneNode() _IRR_OVERRIDE_;
+
+	//! OnAnimate() is called just before rendering the whole scene.
+	virtual void OnAnimate(u32 timeMs) _IRR_OVERRIDE_;
+
+	//! renders the node.
+	virtual void render() _IRR_OVERRIDE_;
+
+	//! returns the axis aligned bounding box of this node
+	virtual const core::aabbox3d<f32>& getBoundingBox() const _IRR_OVERRIDE_;
+
+	//! returns the material based on the zero based index i.
+	virtual video::SMaterial& getMaterial(u32 i) _IRR_OVERRIDE_;
+
+	//! returns amount of materials used by this scene node.
+	virtual u32 getMaterialCount() const _IRR_OVERRIDE_;
+
+	//! Returns type of the scene node
+	virtual ESCENE_NODE_TYPE getType() const _IRR_OVERRIDE_ { return ESNT_BSP_LEVEL; }
+
+	//! Collects the faces visible from a camera
+	virtual u32 calculateVisibleFaces(const core::vector3df& cameraPosition,
+			const SViewFrustum& frustum) _IRR_OVERRIDE_;
+
+	//! Returns the number of faces found by the last calculateVisibleFaces() call
+	virtual u32 getVisibleFaceCount() const _IRR_OVERRIDE_;
+
+private:
+
+	void addFace(const quake3::SBSPFace& face);
+
+	IQ3LevelMesh* LevelMesh;
+	IMesh* Mesh;
+	quake3::SBSPTree Tree;
+	core::aabbox3d<f32> Box;
+	core::array<video::SMaterial> Materials;
+
+	//! visible index ranges of each mesh buffer
+	core::array<core::array<video::SIndexRange> > Ranges;
+
+	//! last frame in which a face was found, as faces can be in several leafs
+	core::array<u32> FaceFrame;
+	u32 Frame;
+
+	u32 VisibleFaceCount;
+	s32 PassCount;
+};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
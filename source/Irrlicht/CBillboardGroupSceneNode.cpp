@@ -0,0 +1,568 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+#ifdef _IRR_COMPILE_WITH_BILLBOARD_SCENENODE_
+#include "CBillboardGroupSceneNode.h"
+#include "IVideoDriver.h"
+#include "ISceneManager.h"
+#include "ICameraSceneNode.h"
+#include "irrFrameArena.h"
+#include "heapsort.h"
+#include "irrSIMD.h"
+
+namespace irr
+{
+namespace scene
+{
+
+namespace
+{
+	//! The billboards for which quads are built
+	struct SQuadSource
+	{
+		const core::vector3df* Positions;
+		const core::dimension2d<f32>* Sizes;
+		const video::SColor* Colors;
+		const core::rect<f32>* TexCoords;
+
+		//! Indices of the billboards in drawing order, 0 for their own order
+		const u32* Order;
+	};
+
+	//! Camera facing axes of the quads, in the space of the node
+	struct SQuadAxes
+	{
+		//! Points to the right
+		core::vector3df Horizontal;
+
+		//! Points down
+		core::vector3df Vertical;
+
+		//! Points to the camera
+		core::vector3df Normal;
+	};
+
+	//! Writes 4 vertices per billboard
+	typedef void (*QuadBuilder)(const SQuadSource& source, u32 count,
+		const SQuadAxes& axes, video::S3DVertex* vertices);
+
+	//! Texture coordinates of the vertices, which are:
+	/*
+	2--1
+	|\ |
+	| \|
+	3--0
+	*/
+	inline void setQuadTexCoords(video::S3DVertex* v, const core::rect<f32>& tc)
+	{
+		v[0].TCoords.set(tc.LowerRightCorner.X, tc.LowerRightCorner.Y);
+		v[1].TCoords.set(tc.LowerRightCorner.X, tc.UpperLeftCorner.Y);
+		v[2].TCoords.set(tc.UpperLeftCorner.X, tc.UpperLeftCorner.Y);
+		v[3].TCoords.set(tc.UpperLeftCorner.X, tc.LowerRightCorner.Y);
+	}
+
+	void buildQuads(const SQuadSource& source, u32 count,
+		const SQuadAxes& axes, video::S3DVertex* v)
+	{
+		for (u32 k=0; k<count; ++k, v+=4)
+		{
+			const u32 i = source.Order ? source.Order[k] : k;
+			const core::vector3df& pos = source.Positions[i];
+			const core::vector3df horizontal = axes.Horizontal * (0.5f * source.Sizes[i].Width);
+			const core::vector3df vertical = axes.Vertical * (0.5f * source.Sizes[i].Height);
+
+			v[0].Pos = pos + horizontal + vertical;
+			v[1].Pos = pos + horizontal - vertical;
+			v[2].Pos = pos - horizontal - vertical;
+			v[3].Pos = pos - horizontal + vertical;
+
+			for (u32 j=0; j<4; ++j)
+			{
+				v[j].Normal = axes.Normal;
+				v[j].Color = source.Colors[i];
+			}
+			setQuadTexCoords(v, source.TexCoords[i]);
+		}
+	}
+
+	// The kernels below work on one billboard at a time, with x, y and z in
+	// the lanes of a vector. Vectors are stored with 4 lanes, the fourth lane
+	// of Pos lands on Normal and the one of Normal on Color, which are
+	// written afterwards.
+#if defined(_IRR_SIMD_X86_) || defined(_IRR_SIMD_NEON_)
+	static_assert(sizeof(video::S3DVertex) == 36, "The quad kernels need Pos, Normal, Color and TCoords packed");
+#endif
+
+#ifdef _IRR_SIMD_X86_
+
+	_IRR_SIMD_TARGET_("sse2")
+	inline __m128 load3_SSE2(const core::vector3df& v)
+	{
+		return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd((const double*)&v.X)), _mm_load_ss(&v.Z));
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	void buildQuads_SSE2(const SQuadSource& source, u32 count,
+		const SQuadAxes& axes, video::S3DVertex* v)
+	{
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 horizontalAxis = _mm_mul_ps(load3_SSE2(axes.Horizontal), half);
+		const __m128 verticalAxis = _mm_mul_ps(load3_SSE2(axes.Vertical), half);
+		const __m128 normal = load3_SSE2(axes.Normal);
+
+		for (u32 k=0; k<count; ++k, v+=4)
+		{
+			const u32 i = source.Order ? source.Order[k] : k;
+			const __m128 pos = load3_SSE2(source.Positions[i]);
+			const __m128 horizontal = _mm_mul_ps(horizontalAxis, _mm_set1_ps(source.Sizes[i].Width));
+			const __m128 vertical = _mm_mul_ps(verticalAxis, _mm_set1_ps(source.Sizes[i].Height));
+			const __m128 right = _mm_add_ps(pos, horizontal);
+			const __m128 left = _mm_sub_ps(pos, horizontal);
+
+			_mm_storeu_ps(&v[0].Pos.X, _mm_add_ps(right, vertical));
+			_mm_storeu_ps(&v[1].Pos.X, _mm_sub_ps(right, vertical));
+			_mm_storeu_ps(&v[2].Pos.X, _mm_sub_ps(left, vertical));
+			_mm_storeu_ps(&v[3].Pos.X, _mm_add_ps(left, vertical));
+
+			for (u32 j=0; j<4; ++j)
+			{
+				_mm_storeu_ps(&v[j].Normal.X, normal);
+				v[j].Color = source.Colors[i];
+			}
+			setQuadTexCoords(v, source.TexCoords[i]);
+		}
+	}
+
+#endif // _IRR_SIMD_X86_
+
+#ifdef _IRR_SIMD_NEON_
+
+	inline float32x4_t load3_NEON(const core::vector3df& v)
+	{
+		return vcombine_f32(vld1_f32(&v.X), vld1_lane_f32(&v.Z, vdup_n_f32(0.f), 0));
+	}
+
+	void buildQuads_NEON(const SQuadSource& source, u32 count,
+		const SQuadAxes& axes, video::S3DVertex* v)
+	{
+		const float32x4_t horizontalAxis = vmulq_n_f32(load3_NEON(axes.Horizontal), 0.5f);
+		const float32x4_t verticalAxis = vmulq_n_f32(load3_NEON(axes.Vertical), 0.5f);
+		const float32x4_t normal = load3_NEON(axes.Normal);
+
+		for (u32 k=0; k<count; ++k, v+=4)
+		{
+			const u32 i = source.Order ? source.Order[k] : k;
+			const float32x4_t pos = load3_NEON(source.Positions[i]);
+			const float32x4_t horizontal = vmulq_n_f32(horizontalAxis, source.Sizes[i].Width);
+			const float32x4_t vertical = vmulq_n_f32(verticalAxis, source.Sizes[i].Height);
+			const float32x4_t right = vaddq_f32(pos, horizontal);
+			const float32x4_t left = vsubq_f32(pos, horizontal);
+
+			vst1q_f32(&v[0].Pos.X, vaddq_f32(right, vertical));
+			vst1q_f32(&v[1].Pos.X, vsubq_f32(right, vertical));
+			vst1q_f32(&v[2].Pos.X, vsubq_f32(left, vertical));
+			vst1q_f32(&v[3].Pos.X, vaddq_f32(left, vertical));
+
+			for (u32 j=0; j<4; ++j)
+			{
+				vst1q_f32(&v[j].Normal.X, normal);
+				v[j].Color = source.Colors[i];
+			}
+			setQuadTexCoords(v, source.TexCoords[i]);
+		}
+	}
+
+#endif // _IRR_SIMD_NEON_
+
+	QuadBuilder selectQuadBuilder()
+	{
+#if defined(_IRR_SIMD_X86_)
+		if (os::getX86Features() & os::EXF_SSE2)
+			return buildQuads_SSE2;
+#elif defined(_IRR_SIMD_NEON_)
+		return buildQuads_NEON;
+#endif
+		return buildQuads;
+	}
+
+	QuadBuilder getQuadBuilder()
+	{
+		// selected once, the initialization is thread safe
+		static const QuadBuilder builder = selectQuadBuilder();
+		return builder;
+	}
+
+	//! Billboard and its distance along the view direction
+	struct SDepthEntry
+	{
+		f32 Depth;
+		u32 Index;
+
+		//! sorts far billboards first
+		bool operator<(const SDepthEntry& other) const
+		{
+			return Depth > other.Depth;
+		}
+	};
+
+	//! Two triangles per quad, as in CBillboardSceneNode
+	template <class T>
+	void writeQuadIndices(T* indices, u32 count)
+	{
+		for (u32 i=0; i<count; ++i, indices+=6)
+		{
+			const u32 v = i * 4;
+			indices[0] = (T)v;
+			indices[1] = (T)(v + 2);
+			indices[2] = (T)(v + 1);
+			indices[3] = (T)v;
+			indices[4] = (T)(v + 3);
+			indices[5] = (T)(v + 2);
+		}
+	}
+}
+
+
+//! constructor
+CBillboardGroupSceneNode::CBillboardGroupSceneNode(ISceneNode* parent, ISceneManager* mgr, s32 id,
+			const core::vector3df& position)
+	: IBillboardGroupSceneNode(parent, mgr, id, position)
+	, BoxDirty(true), DepthSorting(false)
+	, Buffer(new CDynamicMeshBuffer(video::EVT_STANDARD, video::EIT_16BIT))
+{
+	#ifdef _DEBUG
+	setDebugName("CBillboardGroupSceneNode");
+	#endif
+
+	// the quads change every frame, the indices only with the number of billboards
+	Buffer->setHardwareMappingHint(EHM_STREAM, EBT_VERTEX);
+	Buffer->setHardwareMappingHint(EHM_STATIC, EBT_INDEX);
+}
+
+
+CBillboardGroupSceneNode::~CBillboardGroupSceneNode()
+{
+	Buffer->drop();
+}
+
+
+//! pre render event
+void CBillboardGroupSceneNode::OnRegisterSceneNode()
+{
+	if (IsVisible && Positions.size())
+		SceneManager->registerNodeForRendering(this);
+
+	ISceneNode::OnRegisterSceneNode();
+}
+
+
+//! render
+void CBillboardGroupSceneNode::render()
+{
+	video::IVideoDriver* driver = SceneManager->getVideoDriver();
+	ICameraSceneNode* camera = SceneManager->getActiveCamera();
+
+	if (!camera || !driver || !Positions.size())
+		return;
+
+	// make the billboards look to the camera
+	updateMesh(camera);
+
+	driver->setTransform(video::ETS_WORLD, AbsoluteTransformation);
+	driver->setMaterial(Buffer->Material);
+	driver->drawMeshBuffer(Buffer);
+
+	if (DebugDataVisible & scene::EDS_BBOX)
+	{
+		video::SMaterial m;
+		m.Lighting = false;
+		driver->setMaterial(m);
+		driver->draw3DBox(getBoundingBox(), video::SColor(0,208,195,152));
+	}
+}
+
+
+void CBillboardGroupSceneNode::updateMesh(const ICameraSceneNode* camera)
+{
+	updateIndices();
+
+	// same axes as those of CBillboardSceneNode, moved into the space of the node
+	core::vector3df view = camera->getTarget() - camera->getAbsolutePosition();
+	view.normalize();
+
+	const core::vector3df up = camera->getUpVector();
+	core::vector3df horizontal = up.crossProduct(view);
+	if ( horizontal.getLength() == 0 )
+	{
+		horizontal.set(up.Y,up.X,up.Z);
+	}
+	horizontal.normalize();
+
+	// pointing down!
+	core::vector3df vertical = horizontal.crossProduct(view);
+
+	core::matrix4 toNode;
+	AbsoluteTransformation.getInverse(toNode);
+
+	SQuadAxes axes;
+	toNode.rotateVect(axes.Horizontal, horizontal);
+	toNode.rotateVect(axes.Vertical, vertical);
+	toNode.rotateVect(axes.Normal, -view);
+	axes.Horizontal.normalize();
+	axes.Vertical.normalize();
+	axes.Normal.normalize();
+
+	const u32 count = Positions.size();
+
+	SQuadSource source;
+	source.Positions = Positions.const_pointer();
+	source.Sizes = Sizes.const_pointer();
+	source.Colors = Colors.const_pointer();
+	source.TexCoords = TexCoords.const_pointer();
+	source.Order = 0;
+
+	if (DepthSorting)
+	{
+		// sorted by the distance along the view direction, which is the
+		// same for all billboards up to the distance of the camera itself
+		core::frame_arena* arena = SceneManager->getVideoDriver()->getFrameArena();
+		SDepthEntry* entries = arena->allocate_array<SDepthEntry>(count);
+		u32* order = arena->allocate_array<u32>(count);
+
+		const core::vector3df toFar = -axes.Normal;
+		for (u32 i=0; i<count; ++i)
+		{
+			entries[i].Depth = Positions[i].dotProduct(toFar);
+			entries[i].Index = i;
+		}
+
+		core::heapsort(entries, (s32)count);
+
+		for (u32 i=0; i<count; ++i)
+			order[i] = entries[i].Index;
+		source.Order = order;
+	}
+
+	IVertexBuffer& vertices = Buffer->getVertexBuffer();
+	vertices.set_used(count * 4);
+	getQuadBuilder()(source, count, axes, vertices.pointer());
+
+	Buffer->setDirty(EBT_VERTEX);
+	Buffer->setBoundingBox(getBoundingBox());
+}
+
+
+void CBillboardGroupSceneNode::updateIndices()
+{
+	const u32 count = Positions.size();
+	IIndexBuffer& indices = Buffer->getIndexBuffer();
+	if (indices.size() == count * 6)
+		return;
+
+	const video::E_INDEX_TYPE type = count * 4 > 65536 ? video::EIT_32BIT : video::EIT_16BIT;
+	if (indices.getType() != type)
+		indices.setType(type);
+
+	indices.set_used(count * 6);
+	if (type == video::EIT_32BIT)
+		writeQuadIndices((u32*)indices.pointer(), count);
+	else
+		writeQuadIndices((u16*)indices.pointer(), count);
+
+	Buffer->setDirty(EBT_INDEX);
+}
+
+
+//! returns the axis aligned bounding box of this node
+const core::aabbox3d<f32>& CBillboardGroupSceneNode::getBoundingBox() const
+{
+	if (BoxDirty)
+	{
+		// large enough for each billboard in any direction
+		Box.reset(0,0,0);
+		for (u32 i=0; i<Positions.size(); ++i)
+		{
+			const f32 radius = 0.5f * sqrtf(Sizes[i].Width * Sizes[i].Width + Sizes[i].Height * Sizes[i].Height);
+			const core::aabbox3d<f32> box(Positions[i] - core::vector3df(radius), Positions[i] + core::vector3df(radius));
+			if (i == 0)
+				Box = box;
+			else
+				Box.addInternalBox(box);
+		}
+		BoxDirty = false;
+	}
+
+	return Box;
+}
+
+
+video::SMaterial& CBillboardGroupSceneNode::getMaterial(u32 i)
+{
+	return Buffer->Material;
+}
+
+
+//! returns amount of materials used by this scene node.
+u32 CBillboardGroupSceneNode::getMaterialCount() const
+{
+	return 1;
+}
+
+
+//! adds a billboard to the group
+u32 CBillboardGroupSceneNode::addBillboard(const core::vector3df& position,
+		const core::dimension2d<f32>& size, video::SColor color,
+		const core::rect<f32>& texCoords)
+{
+	Positions.push_back(position);
+	Sizes.push_back(size);
+	Colors.push_back(color);
+	TexCoords.push_back(texCoords);
+	BoxDirty = true;
+
+	// registers from the first billboard on
+	if (Positions.size() == 1)
+		markChanged();
+
+	return Positions.size() - 1;
+}
+
+
+//! removes a billboard, the last billboard takes its index
+void CBillboardGroupSceneNode::removeBillboard(u32 index)
+{
+	if (index >= Positions.size())
+		return;
+
+	const u32 last = Positions.size() - 1;
+	Positions[index] = Positions[last];
+	Sizes[index] = Sizes[last];
+	Colors[index] = Colors[last];
+	TexCoords[index] = TexCoords[last];
+
+	Positions.set_used(last);
+	Sizes.set_used(last);
+	Colors.set_used(last);
+	TexCoords.set_used(last);
+	BoxDirty = true;
+
+	if (!last)
+		markChanged();
+}
+
+
+//! removes all billboards
+void CBillboardGroupSceneNode::removeAllBillboards()
+{
+	Positions.set_used(0);
+	Sizes.set_used(0);
+	Colors.set_used(0);
+	TexCoords.set_used(0);
+	BoxDirty = true;
+	markChanged();
+}
+
+
+//! returns the number of billboards
+u32 CBillboardGroupSceneNode::getBillboardCount() const
+{
+	return Positions.size();
+}
+
+
+void CBillboardGroupSceneNode::setBillboardPosition(u32 index, const core::vector3df& position)
+{
+	Positions[index] = position;
+	BoxDirty = true;
+}
+
+
+const core::vector3df& CBillboardGroupSceneNode::getBillboardPosition(u32 index) const
+{
+	return Positions[index];
+}
+
+
+void CBillboardGroupSceneNode::setBillboardSize(u32 index, const core::dimension2d<f32>& size)
+{
+	Sizes[index] = size;
+	BoxDirty = true;
+}
+
+
+const core::dimension2d<f32>& CBillboardGroupSceneNode::getBillboardSize(u32 index) const
+{
+	return Sizes[index];
+}
+
+
+void CBillboardGroupSceneNode::setBillboardColor(u32 index, video::SColor color)
+{
+	Colors[index] = color;
+}
+
+
+video::SColor CBillboardGroupSceneNode::getBillboardColor(u32 index) const
+{
+	return Colors[index];
+}
+
+
+void CBillboardGroupSceneNode::setBillboardTexCoords(u32 index, const core::rect<f32>& texCoords)
+{
+	TexCoords[index] = texCoords;
+}
+
+
+const core::rect<f32>& CBillboardGroupSceneNode::getBillboardTexCoords(u32 index) const
+{
+	return TexCoords[index];
+}
+
+
+//! sets if the billboards are drawn from back to front
+void CBillboardGroupSceneNode::setDepthSorting(bool sort)
+{
+	DepthSorting = sort;
+}
+
+
+//! returns if the billboards are drawn from back to front
+bool CBillboardGroupSceneNode::getDepthSorting() const
+{
+	return DepthSorting;
+}
+
+
+//! Creates a clone of this scene node and its children.
+ISceneNode* CBillboardGroupSceneNode::clone(ISceneNode* newParent, ISceneManager* newManager)
+{
+	if (!newParent)
+		newParent = Parent;
+	if (!newManager)
+		newManager = SceneManager;
+
+	CBillboardGroupSceneNode* nb = new CBillboardGroupSceneNode(newParent,
+		newManager, ID, RelativeTranslation);
+
+	nb->cloneMembers(this, newManager);
+	nb->Buffer->Material = Buffer->Material;
+	nb->markChanged();
+	nb->Positions = Positions;
+	nb->Sizes = Sizes;
+	nb->Colors = Colors;
+	nb->TexCoords = TexCoords;
+	nb->DepthSorting = DepthSorting;
+
+	if ( newParent )
+		nb->drop();
+	return nb;
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_BILLBOARD_SCENENODE_
@@ -0,0 +1,108 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_BILLBOARD_GROUP_SCENE_NODE_H_INCLUDED__
+#define __C_BILLBOARD_GROUP_SCENE_NODE_H_INCLUDED__
+
+#include "IBillboardGroupSceneNode.h"
+#include "CDynamicMeshBuffer.h"
+
+namespace irr
+{
+namespace scene
+{
+	class ICameraSceneNode;
+
+//! Scene node drawing the camera facing quads of many billboards in one mesh buffer
+class CBillboardGroupSceneNode : public IBillboardGroupSceneNode
+{
+public:
+
+	//! constructor
+	CBillboardGroupSceneNode(ISceneNode* parent, ISceneManager* mgr, s32 id,
+		const core::vector3df& position);
+
+	virtual ~CBillboardGroupSceneNode();
+
+	//! pre render event
+	virtual void OnRegisterSceneNode() _IRR_OVERRIDE_;
+
+	//! render
+	virtual void render() _IRR_OVERRIDE_;
+
+	//! returns the axis aligned bounding box of this node
+	virtual const core::aabbox3d<f32>& getBoundingBox() const _IRR_OVERRIDE_;
+
+	virtual video::SMaterial& getMaterial(u32 i) _IRR_OVERRIDE_;
+
+	//! returns amount of materials used by this scene node.
+	virtual u32 getMaterialCount() const _IRR_OVERRIDE_;
+
+	//! adds a billboard to the group
+	virtual u32 addBillboard(const core::vector3df& position,
+		const core::dimension2d<f32>& size, video::SColor color,
+		const core::rect<f32>& texCoords) _IRR_OVERRIDE_;
+
+	//! removes a billboard, the last billboard takes its index
+	virtual void removeBillboard(u32 index) _IRR_OVERRIDE_;
+
+	//! removes all billboards
+	virtual void removeAllBillboards() _IRR_OVERRIDE_;
+
+	//! returns the number of billboards
+	virtual u32 getBillboardCount() const _IRR_OVERRIDE_;
+
+	virtual void setBillboardPosition(u32 index, const core::vector3df& position) _IRR_OVERRIDE_;
+	virtual const core::vector3df& getBillboardPosition(u32 index) const _IRR_OVERRIDE_;
+
+	virtual void setBillboardSize(u32 index, const core::dimension2d<f32>& size) _IRR_OVERRIDE_;
+	virtual const core::dimension2d<f32>& getBillboardSize(u32 index) const _IRR_OVERRIDE_;
+
+	virtual void setBillboardColor(u32 index, video::SColor color) _IRR_OVERRIDE_;
+	virtual video::SColor getBillboardColor(u32 index) const _IRR_OVERRIDE_;
+
+	virtual void setBillboardTexCoords(u32 index, const core::rect<f32>& texCoords) _IRR_OVERRIDE_;
+	virtual const core::rect<f32>& getBillboardTexCoords(u32 index) const _IRR_OVERRIDE_;
+
+	//! sets if the billboards are drawn from back to front
+	virtual void setDepthSorting(bool sort) _IRR_OVERRIDE_;
+
+	//! returns if the billboards are drawn from back to front
+	virtual bool getDepthSorting() const _IRR_OVERRIDE_;
+
+	//! Returns type of the scene node
+	virtual ESCENE_NODE_TYPE getType() const _IRR_OVERRIDE_ { return ESNT_BILLBOARD_GROUP; }
+
+	//! Creates a clone of this scene node and its children.
+	virtual ISceneNode* clone(ISceneNode* newParent=0, ISceneManager* newManager=0) _IRR_OVERRIDE_;
+
+private:
+
+	//! writes the quads of all billboards into the vertex buffer
+	void updateMesh(const ICameraSceneNode* camera);
+
+	//! makes the index buffer fit the number of billboards
+	void updateIndices();
+
+	// The billboards, each attribute in an array of its own
+	core::array<core::vector3df> Positions;
+	core::array<core::dimension2d<f32> > Sizes;
+	core::array<video::SColor> Colors;
+	core::array<core::rect<f32> > TexCoords;
+
+	//! Box around all billboards independent of the camera, recalculated when needed
+	mutable core::aabbox3d<f32> Box;
+	mutable bool BoxDirty;
+
+	bool DepthSorting;
+
+	CDynamicMeshBuffer* Buffer;
+};
+
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
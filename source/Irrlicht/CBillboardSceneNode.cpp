@@ -302,6 +302,7 @@ ISceneNode* CBillboardSceneNode::clone(ISceneNode* newParent, ISceneManager* new
 
 	nb->cloneMembers(this, newManager);
 	nb->Buffer->Material = Buffer->Material;
+	nb->markChanged();
 	nb->Size = Size;
 	nb->TopEdgeWidth = this->TopEdgeWidth;
 
@@ -0,0 +1,718 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CClusteredLightManager.h"
+#include "ISceneManager.h"
+#include "ICameraSceneNode.h"
+#include "ILightSceneNode.h"
+#include "IVideoDriver.h"
+#include "irrFrameArena.h"
+#include "irrSIMD.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace irr
+{
+namespace scene
+{
+
+namespace
+{
+	//! Most tiles or slices along one axis, so the clusters of a row fit a mask
+	const u32 MAX_GRID_SIZE = 64;
+
+	//! Lights one more thread has to get at least to be worth starting
+	const u32 LIGHTS_PER_THREAD = 64;
+
+	//! Light and its squared distance to the camera
+	struct SLightDistance
+	{
+		bool operator<(const SLightDistance& other) const
+		{
+			return Distance < other.Distance;
+		}
+
+		f32 Distance;
+		ISceneNode* Node;
+	};
+
+	//! Tests a sphere against the boxes of a row of clusters
+	/** \param boxes 6 arrays of stride values, min x, y, z and max x, y, z.
+	At least 3 values after the row must be readable.
+	\return Bit i is set if the sphere touches cluster first + i. */
+	typedef u64 (*ClusterTester)(const f32* boxes, u32 stride, u32 first, u32 count,
+		const core::vector3df& center, f32 radiusSQ);
+
+	inline u64 getRowMask(u32 count)
+	{
+		return count < 64 ? ((u64)1 << count) - 1 : ~(u64)0;
+	}
+
+	u64 testClusters(const f32* boxes, u32 stride, u32 first, u32 count,
+		const core::vector3df& center, f32 radiusSQ)
+	{
+		u64 mask = 0;
+		for (u32 i=0; i<count; ++i)
+		{
+			const u32 c = first + i;
+			const f32 dx = core::max_(boxes[c] - center.X, center.X - boxes[3 * stride + c], 0.f);
+			const f32 dy = core::max_(boxes[stride + c] - center.Y, center.Y - boxes[4 * stride + c], 0.f);
+			const f32 dz = core::max_(boxes[2 * stride + c] - center.Z, center.Z - boxes[5 * stride + c], 0.f);
+			if (dx * dx + dy * dy + dz * dz <= radiusSQ)
+				mask |= (u64)1 << i;
+		}
+		return mask;
+	}
+
+	// The kernels below test 4 clusters at once, reading up to 3 boxes past
+	// the row, whose bits are masked off.
+#ifdef _IRR_SIMD_X86_
+
+	_IRR_SIMD_TARGET_("sse2")
+	inline __m128 getAxisDistance_SSE2(const f32* minEdge, const f32* maxEdge, __m128 center)
+	{
+		const __m128 below = _mm_sub_ps(_mm_loadu_ps(minEdge), center);
+		const __m128 above = _mm_sub_ps(center, _mm_loadu_ps(maxEdge));
+		return _mm_max_ps(_mm_max_ps(below, above), _mm_setzero_ps());
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	u64 testClusters_SSE2(const f32* boxes, u32 stride, u32 first, u32 count,
+		const core::vector3df& center, f32 radiusSQ)
+	{
+		const __m128 cx = _mm_set1_ps(center.X);
+		const __m128 cy = _mm_set1_ps(center.Y);
+		const __m128 cz = _mm_set1_ps(center.Z);
+		const __m128 r2 = _mm_set1_ps(radiusSQ);
+
+		u64 mask = 0;
+		for (u32 i=0; i<count; i+=4)
+		{
+			const u32 c = first + i;
+			const __m128 dx = getAxisDistance_SSE2(boxes + c, boxes + 3 * stride + c, cx);
+			const __m128 dy = getAxisDistance_SSE2(boxes + stride + c, boxes + 4 * stride + c, cy);
+			const __m128 dz = getAxisDistance_SSE2(boxes + 2 * stride + c, boxes + 5 * stride + c, cz);
+			const __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			mask |= (u64)_mm_movemask_ps(_mm_cmple_ps(d2, r2)) << i;
+		}
+		return mask & getRowMask(count);
+	}
+
+#endif // _IRR_SIMD_X86_
+
+#ifdef _IRR_SIMD_NEON_
+
+	inline float32x4_t getAxisDistance_NEON(const f32* minEdge, const f32* maxEdge, float32x4_t center)
+	{
+		const float32x4_t below = vsubq_f32(vld1q_f32(minEdge), center);
+		const float32x4_t above = vsubq_f32(center, vld1q_f32(maxEdge));
+		return vmaxq_f32(vmaxq_f32(below, above), vdupq_n_f32(0.f));
+	}
+
+	u64 testClusters_NEON(const f32* boxes, u32 stride, u32 first, u32 count,
+		const core::vector3df& center, f32 radiusSQ)
+	{
+		const float32x4_t cx = vdupq_n_f32(center.X);
+		const float32x4_t cy = vdupq_n_f32(center.Y);
+		const float32x4_t cz = vdupq_n_f32(center.Z);
+		const float32x4_t r2 = vdupq_n_f32(radiusSQ);
+		static const u32 laneBits[4] = { 1, 2, 4, 8 };
+		const uint32x4_t bits = vld1q_u32(laneBits);
+
+		u64 mask = 0;
+		for (u32 i=0; i<count; i+=4)
+		{
+			const u32 c = first + i;
+			const float32x4_t dx = getAxisDistance_NEON(boxes + c, boxes + 3 * stride + c, cx);
+			const float32x4_t dy = getAxisDistance_NEON(boxes + stride + c, boxes + 4 * stride + c, cy);
+			const float32x4_t dz = getAxisDistance_NEON(boxes + 2 * stride + c, boxes + 5 * stride + c, cz);
+			const float32x4_t d2 = vmlaq_f32(vmlaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz);
+			const uint32x4_t hit = vandq_u32(vcleq_f32(d2, r2), bits);
+			const uint32x2_t sum = vadd_u32(vget_low_u32(hit), vget_high_u32(hit));
+			mask |= (u64)vget_lane_u32(vpadd_u32(sum, sum), 0) << i;
+		}
+		return mask & getRowMask(count);
+	}
+
+#endif // _IRR_SIMD_NEON_
+
+	ClusterTester selectClusterTester()
+	{
+#if defined(_IRR_SIMD_X86_)
+		if (os::getX86Features() & os::EXF_SSE2)
+			return testClusters_SSE2;
+#elif defined(_IRR_SIMD_NEON_)
+		return testClusters_NEON;
+#endif
+		return testClusters;
+	}
+
+	ClusterTester getClusterTester()
+	{
+		// selected once, the initialization is thread safe
+		static const ClusterTester tester = selectClusterTester();
+		return tester;
+	}
+}
+
+
+//! Threads kept between the frames to assign the lights
+/** The threads wait until a frame hands out work and go back to waiting when
+no slice is left, so no thread is started per frame. */
+struct CClusteredLightManager::SAssignPool
+{
+	SAssignPool(CClusteredLightManager* manager)
+		: Manager(manager), Threads(0), ThreadCount(0), Generation(0), Quit(false),
+		Bounds(0), LightCount(0), Active(0), Busy(0), Next(0), Slices(0) {}
+
+	~SAssignPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			Quit = true;
+		}
+		Start.notify_all();
+
+		for (u32 i = 0; i < ThreadCount; ++i)
+			Threads[i].join();
+		delete [] Threads;
+	}
+
+	//! starts more threads if less than count are waiting
+	void reserve(u32 count)
+	{
+		if (count <= ThreadCount)
+			return;
+
+		// the waiting threads only know their index, so they can be moved
+		std::thread* threads = new std::thread[count];
+		for (u32 i = 0; i < ThreadCount; ++i)
+			threads[i] = std::move(Threads[i]);
+		for (u32 i = ThreadCount; i < count; ++i)
+			threads[i] = std::thread(run, this, i);
+
+		delete [] Threads;
+		Threads = threads;
+		ThreadCount = count;
+	}
+
+	//! assigns the slices with the calling thread and the first threads of the pool
+	void assign(const SLightBounds* bounds, u32 count, u32 slices, u32 threads)
+	{
+		reserve(threads);
+
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			Bounds = bounds;
+			LightCount = count;
+			Slices = slices;
+			Next.store(0, std::memory_order_relaxed);
+			Active = threads;
+			Busy = threads;
+			++Generation;
+		}
+		Start.notify_all();
+
+		// the calling thread is one of the assigning threads
+		Manager->assignSlices(bounds, count);
+
+		std::unique_lock<std::mutex> lock(Mutex);
+		Done.wait(lock, [this] { return Busy == 0; });
+	}
+
+	static void run(SAssignPool* pool, u32 index)
+	{
+		u32 generation = 0;
+		std::unique_lock<std::mutex> lock(pool->Mutex);
+		for (;;)
+		{
+			pool->Start.wait(lock, [pool, generation] { return pool->Quit || pool->Generation != generation; });
+			if (pool->Quit)
+				return;
+
+			generation = pool->Generation;
+			if (index >= pool->Active)
+				continue;
+
+			const SLightBounds* bounds = pool->Bounds;
+			const u32 count = pool->LightCount;
+			lock.unlock();
+			pool->Manager->assignSlices(bounds, count);
+			lock.lock();
+
+			if (--pool->Busy == 0)
+				pool->Done.notify_one();
+		}
+	}
+
+	CClusteredLightManager* Manager;
+
+	std::thread* Threads;
+	u32 ThreadCount;
+
+	std::mutex Mutex;
+	std::condition_variable Start;
+	std::condition_variable Done;
+
+	//! Counted up for each frame handing out work
+	u32 Generation;
+	bool Quit;
+
+	//! Work of the current frame, Active threads of the pool help, Busy didn't finish yet
+	const SLightBounds* Bounds;
+	u32 LightCount;
+	u32 Active;
+	u32 Busy;
+
+	//! Next slice which no thread took yet
+	std::atomic<u32> Next;
+	u32 Slices;
+};
+
+
+//! constructor
+CClusteredLightManager::CClusteredLightManager(ISceneManager* smgr)
+	: SceneManager(smgr), TilesX(16), TilesY(8), Slices(24),
+	MaxLightsPerCluster(64), ThreadCount(0),
+	GridNear(0.f), GridFar(0.f), GridDirty(true),
+	Near(1.f), Far(1.f), SliceScale(0.f), BoxStride(0),
+	DirectionalLightCount(0), Pool(0)
+{
+	#ifdef _DEBUG
+	setDebugName("CClusteredLightManager");
+	#endif
+}
+
+
+//! destructor
+CClusteredLightManager::~CClusteredLightManager()
+{
+	delete Pool;
+}
+
+
+//! Sorts the lights and assigns them to the clusters
+void CClusteredLightManager::OnPreRender(core::array<ISceneNode*>& lightList)
+{
+	update(lightList, SceneManager->getActiveCamera(),
+		SceneManager->getVideoDriver()->getFrameArena());
+}
+
+
+void CClusteredLightManager::update(core::array<ISceneNode*>& lightList,
+	const ICameraSceneNode* camera, core::frame_arena* arena)
+{
+	Lights.set_used(0);
+	LightNodes.set_used(0);
+	DirectionalLightCount = 0;
+	Ranges.set_used(0);
+	Indices.set_used(0);
+
+	if (!camera)
+		return;
+
+	updateGrid(camera);
+	View = camera->getViewMatrix();
+
+	const core::vector3df cameraPosition = camera->getAbsolutePosition();
+
+	// nearest lights first, for the fixed function lights of the driver and
+	// so crowded clusters keep their nearest lights
+	core::array<SLightDistance> sorted;
+	arena->bind(sorted, lightList.size());
+	for (u32 i=0; i<lightList.size(); ++i)
+	{
+		SLightDistance entry;
+		entry.Node = lightList[i];
+		entry.Distance = entry.Node->getAbsolutePosition().getDistanceFromSQ(cameraPosition);
+		sorted.push_back(entry);
+	}
+	sorted.sort();
+	for (u32 i=0; i<sorted.size(); ++i)
+		lightList[i] = sorted[i].Node;
+
+	// directional lights first, they aren't in the clusters
+	for (u32 i=0; i<lightList.size(); ++i)
+	{
+		if (lightList[i]->getType() != ESNT_LIGHT)
+			continue;
+
+		ILightSceneNode* node = static_cast<ILightSceneNode*>(lightList[i]);
+		const video::SLight& data = node->getLightData();
+		if (data.Type != video::ELT_DIRECTIONAL)
+			continue;
+
+		SClusteredLight light;
+		light.Position.set(0.f, 0.f, 0.f);
+		light.Radius = 0.f;
+		light.DiffuseColor = data.DiffuseColor;
+		View.rotateVect(light.Direction, data.Direction);
+		light.Direction.normalize();
+		light.CosOuterCone = -1.f;
+		Lights.push_back(light);
+		LightNodes.push_back(node);
+	}
+	DirectionalLightCount = Lights.size();
+
+	SLightBounds* bounds = arena->allocate_array<SLightBounds>(lightList.size());
+	u32 boundsCount = 0;
+
+	for (u32 i=0; i<lightList.size() && Lights.size() < 0xffff; ++i)
+	{
+		if (lightList[i]->getType() != ESNT_LIGHT)
+			continue;
+
+		ILightSceneNode* node = static_cast<ILightSceneNode*>(lightList[i]);
+		const video::SLight& data = node->getLightData();
+		if (data.Type == video::ELT_DIRECTIONAL)
+			continue;
+
+		core::vector3df center;
+		View.transformVect(center, data.Position);
+		const f32 radius = data.Radius;
+		if (radius <= 0.f || center.Z + radius < Near || center.Z - radius > Far)
+			continue;
+
+		SLightBounds& b = bounds[boundsCount];
+		b.Center = center;
+		b.RadiusSQ = radius * radius;
+		b.MinSlice = (u8)getSlice(center.Z - radius);
+		b.MaxSlice = (u8)getSlice(center.Z + radius);
+
+		// The planes between the tiles cross at the camera, so near it the
+		// ranges aren't reliable and only the boxes of the clusters are tested.
+		if (center.Z - radius <= Near)
+		{
+			b.MinX = 0;
+			b.MaxX = (u8)(TilesX - 1);
+			b.MinY = 0;
+			b.MaxY = (u8)(TilesY - 1);
+		}
+		else if (!getTileRange(BoundariesX, center.X, center.Z, radius, b.MinX, b.MaxX) ||
+			!getTileRange(BoundariesY, center.Y, center.Z, radius, b.MinY, b.MaxY))
+		{
+			continue;
+		}
+
+		b.Light = (u16)Lights.size();
+		++boundsCount;
+
+		SClusteredLight light;
+		light.Position = center;
+		light.Radius = radius;
+		light.DiffuseColor = data.DiffuseColor;
+		if (data.Type == video::ELT_SPOT)
+		{
+			View.rotateVect(light.Direction, data.Direction);
+			light.Direction.normalize();
+			light.CosOuterCone = cosf(data.OuterCone * core::DEGTORAD);
+		}
+		else
+		{
+			light.Direction.set(0.f, 0.f, 1.f);
+			light.CosOuterCone = -1.f;
+		}
+		Lights.push_back(light);
+		LightNodes.push_back(node);
+	}
+
+	assignLights(bounds, boundsCount);
+}
+
+
+void CClusteredLightManager::updateGrid(const ICameraSceneNode* camera)
+{
+	const core::matrix4& projection = camera->getProjectionMatrix();
+	const f32 cameraFar = camera->getFarValue();
+	// logarithmic slices need a near plane in front of the camera
+	const f32 cameraNear = core::max_(camera->getNearValue(), cameraFar * 0.0001f, 0.0001f);
+
+	if (!GridDirty && projection == GridProjection && cameraNear == GridNear && cameraFar == GridFar)
+		return;
+
+	GridProjection = projection;
+	GridNear = cameraNear;
+	GridFar = cameraFar;
+	GridDirty = false;
+
+	Near = cameraNear;
+	Far = core::max_(cameraFar, Near * 1.001f);
+	SliceScale = Slices / logf(Far / Near);
+
+	// Tile boundaries where the projected coordinate is n, with
+	// clip = p.X * M[0] + p.Z * M[8] + M[12] and w = p.Z * M[11] + M[15],
+	// for perspective and orthogonal projections.
+	const f32* m = projection.pointer();
+	for (u32 axis=0; axis<2; ++axis)
+	{
+		core::array<STileBoundary>& boundaries = axis ? BoundariesY : BoundariesX;
+		const u32 tiles = axis ? TilesY : TilesX;
+		const f32 scale = m[axis * 5];
+		const f32 zScale = m[8 + axis];
+		const f32 offset = m[12 + axis];
+
+		boundaries.set_used(tiles + 1);
+		for (u32 i=0; i<=tiles; ++i)
+		{
+			const f32 n = -1.f + 2.f * i / tiles;
+			STileBoundary& b = boundaries[i];
+			b.Offset = (n * m[15] - offset) / scale;
+			b.Slope = (n * m[11] - zScale) / scale;
+			b.InvLength = core::reciprocal_squareroot(1.f + b.Slope * b.Slope);
+		}
+	}
+
+	const u32 clusters = getClusterCount();
+	BoxStride = clusters + 3;
+	Boxes.set_used(6 * BoxStride);
+	for (u32 i=0; i<Boxes.size(); ++i)
+		Boxes[i] = 0.f;
+
+	for (u32 k=0; k<Slices; ++k)
+	{
+		const f32 z0 = Near * powf(Far / Near, (f32)k / Slices);
+		const f32 z1 = Near * powf(Far / Near, (f32)(k + 1) / Slices);
+
+		for (u32 j=0; j<TilesY; ++j)
+		{
+			const STileBoundary& bottom = BoundariesY[j];
+			const STileBoundary& top = BoundariesY[j + 1];
+
+			for (u32 i=0; i<TilesX; ++i)
+			{
+				const STileBoundary& left = BoundariesX[i];
+				const STileBoundary& right = BoundariesX[i + 1];
+				const u32 c = (k * TilesY + j) * TilesX + i;
+
+				Boxes[c] = core::min_(left.at(z0), left.at(z1));
+				Boxes[BoxStride + c] = core::min_(bottom.at(z0), bottom.at(z1));
+				Boxes[2 * BoxStride + c] = z0;
+				Boxes[3 * BoxStride + c] = core::max_(right.at(z0), right.at(z1));
+				Boxes[4 * BoxStride + c] = core::max_(top.at(z0), top.at(z1));
+				Boxes[5 * BoxStride + c] = z1;
+			}
+		}
+	}
+}
+
+
+bool CClusteredLightManager::getTileRange(const core::array<STileBoundary>& boundaries,
+	f32 pos, f32 z, f32 radius, u8& outMin, u8& outMax) const
+{
+	// tile i lies between the boundaries i and i + 1, which are ordered
+	// from the negative to the positive side in front of the camera
+	const u32 tiles = boundaries.size() - 1;
+
+	u32 first = 0;
+	while (first < tiles && boundaries[first + 1].getDistance(pos, z) > radius)
+		++first;
+
+	u32 last = tiles;
+	while (last > first && boundaries[last - 1].getDistance(pos, z) < -radius)
+		--last;
+
+	if (first >= last)
+		return false;
+
+	outMin = (u8)first;
+	outMax = (u8)(last - 1);
+	return true;
+}
+
+
+u32 CClusteredLightManager::getSlice(f32 z) const
+{
+	if (z <= Near)
+		return 0;
+
+	return core::min_((u32)(logf(z / Near) * SliceScale), Slices - 1);
+}
+
+
+void CClusteredLightManager::assignLights(const SLightBounds* bounds, u32 count)
+{
+	const u32 clusters = getClusterCount();
+	BinCounts.set_used(clusters);
+	Bins.set_used(clusters * MaxLightsPerCluster);
+
+	u32 threadCount = ThreadCount ? ThreadCount : std::thread::hardware_concurrency();
+	threadCount = core::clamp(threadCount, 1u, core::min_(Slices, 1 + count / LIGHTS_PER_THREAD));
+
+	if (threadCount == 1)
+	{
+		for (u32 k=0; k<Slices; ++k)
+			assignSlice(bounds, count, k);
+	}
+	else
+	{
+		if (!Pool)
+			Pool = new SAssignPool(this);
+		Pool->assign(bounds, count, Slices, threadCount - 1);
+	}
+
+	// pack the lists of the clusters one after the other
+	Ranges.set_used(clusters * 2);
+	u32 total = 0;
+	for (u32 c=0; c<clusters; ++c)
+	{
+		Ranges[c * 2] = total;
+		Ranges[c * 2 + 1] = BinCounts[c];
+		total += BinCounts[c];
+	}
+
+	Indices.set_used(total);
+	for (u32 c=0; c<clusters; ++c)
+	{
+		if (BinCounts[c])
+			memcpy(&Indices[Ranges[c * 2]], &Bins[c * MaxLightsPerCluster], BinCounts[c] * sizeof(u16));
+	}
+}
+
+
+void CClusteredLightManager::assignSlices(const SLightBounds* bounds, u32 count)
+{
+	u32 k;
+	while ((k = Pool->Next.fetch_add(1, std::memory_order_relaxed)) < Pool->Slices)
+		assignSlice(bounds, count, k);
+}
+
+
+void CClusteredLightManager::assignSlice(const SLightBounds* bounds, u32 count, u32 slice)
+{
+	const ClusterTester tester = getClusterTester();
+	const u32 sliceStart = slice * TilesY * TilesX;
+
+	// each slice is only written by the thread which took it
+	u32* binCounts = BinCounts.pointer() + sliceStart;
+	for (u32 c=0; c<TilesY * TilesX; ++c)
+		binCounts[c] = 0;
+
+	for (u32 l=0; l<count; ++l)
+	{
+		const SLightBounds& b = bounds[l];
+		if (slice < b.MinSlice || slice > b.MaxSlice)
+			continue;
+
+		for (u32 j=b.MinY; j<=b.MaxY; ++j)
+		{
+			const u32 first = sliceStart + j * TilesX + b.MinX;
+			u64 mask = tester(Boxes.const_pointer(), BoxStride, first,
+				b.MaxX - b.MinX + 1, b.Center, b.RadiusSQ);
+
+			for (u32 c=first; mask; ++c, mask >>= 1)
+			{
+				if (!(mask & 1))
+					continue;
+
+				u32& binCount = BinCounts[c];
+				if (binCount < MaxLightsPerCluster)
+					Bins[c * MaxLightsPerCluster + binCount++] = b.Light;
+			}
+		}
+	}
+}
+
+
+void CClusteredLightManager::setGridSize(u32 tilesX, u32 tilesY, u32 slices)
+{
+	TilesX = core::clamp(tilesX, 1u, MAX_GRID_SIZE);
+	TilesY = core::clamp(tilesY, 1u, MAX_GRID_SIZE);
+	Slices = core::clamp(slices, 1u, MAX_GRID_SIZE);
+	GridDirty = true;
+}
+
+
+core::vector3d<u32> CClusteredLightManager::getGridSize() const
+{
+	return core::vector3d<u32>(TilesX, TilesY, Slices);
+}
+
+
+u32 CClusteredLightManager::getClusterCount() const
+{
+	return TilesX * TilesY * Slices;
+}
+
+
+void CClusteredLightManager::setMaxLightsPerCluster(u32 count)
+{
+	MaxLightsPerCluster = core::clamp(count, 1u, 0xffffu);
+}
+
+
+u32 CClusteredLightManager::getMaxLightsPerCluster() const
+{
+	return MaxLightsPerCluster;
+}
+
+
+void CClusteredLightManager::setThreadCount(u32 count)
+{
+	ThreadCount = count;
+}
+
+
+s32 CClusteredLightManager::getClusterIndex(const core::vector3df& viewPosition) const
+{
+	if (GridDirty || viewPosition.Z < Near || viewPosition.Z > Far)
+		return -1;
+
+	const f32* m = GridProjection.pointer();
+	const f32 w = viewPosition.Z * m[11] + m[15];
+	const f32 x = (viewPosition.X * m[0] + viewPosition.Z * m[8] + m[12]) / w;
+	const f32 y = (viewPosition.Y * m[5] + viewPosition.Z * m[9] + m[13]) / w;
+	if (x < -1.f || x > 1.f || y < -1.f || y > 1.f)
+		return -1;
+
+	const u32 tileX = core::min_((u32)((x + 1.f) * 0.5f * TilesX), TilesX - 1);
+	const u32 tileY = core::min_((u32)((y + 1.f) * 0.5f * TilesY), TilesY - 1);
+	return (getSlice(viewPosition.Z) * TilesY + tileY) * TilesX + tileX;
+}
+
+
+u32 CClusteredLightManager::getLightCount() const
+{
+	return Lights.size();
+}
+
+
+u32 CClusteredLightManager::getDirectionalLightCount() const
+{
+	return DirectionalLightCount;
+}
+
+
+const SClusteredLight* CClusteredLightManager::getLights() const
+{
+	return Lights.const_pointer();
+}
+
+
+ILightSceneNode* CClusteredLightManager::getLightNode(u32 index) const
+{
+	return index < LightNodes.size() ? LightNodes[index] : 0;
+}
+
+
+const u32* CClusteredLightManager::getClusterLightRanges() const
+{
+	return Ranges.const_pointer();
+}
+
+
+const u16* CClusteredLightManager::getLightIndices() const
+{
+	return Indices.const_pointer();
+}
+
+
+u32 CClusteredLightManager::getLightIndexCount() const
+{
+	return Indices.size();
+}
+
+
+} // end namespace scene
+} // end namespace irr
@@ -0,0 +1,161 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_CLUSTERED_LIGHT_MANAGER_H_INCLUDED__
+#define __C_CLUSTERED_LIGHT_MANAGER_H_INCLUDED__
+
+#include "IClusteredLightManager.h"
+#include "matrix4.h"
+
+namespace irr
+{
+namespace core
+{
+	class frame_arena;
+} // end namespace core
+
+namespace scene
+{
+	class ISceneManager;
+	class ICameraSceneNode;
+
+	//! Assigns the lights to the clusters of the view frustum of the active camera
+	class CClusteredLightManager : public IClusteredLightManager
+	{
+	public:
+
+		//! constructor
+		/** The scene manager isn't grabbed, it holds the light manager. */
+		CClusteredLightManager(ISceneManager* smgr);
+
+		//! destructor, stops the assigning threads
+		virtual ~CClusteredLightManager();
+
+		//! Sorts the lights and assigns them to the clusters
+		virtual void OnPreRender(core::array<ISceneNode*>& lightList) _IRR_OVERRIDE_;
+
+		virtual void OnPostRender(void) _IRR_OVERRIDE_ {}
+		virtual void OnRenderPassPreRender(E_SCENE_NODE_RENDER_PASS renderPass) _IRR_OVERRIDE_ {}
+		virtual void OnRenderPassPostRender(E_SCENE_NODE_RENDER_PASS renderPass) _IRR_OVERRIDE_ {}
+		virtual void OnNodePreRender(ISceneNode* node) _IRR_OVERRIDE_ {}
+		virtual void OnNodePostRender(ISceneNode* node) _IRR_OVERRIDE_ {}
+
+		virtual void setGridSize(u32 tilesX, u32 tilesY, u32 slices) _IRR_OVERRIDE_;
+		virtual core::vector3d<u32> getGridSize() const _IRR_OVERRIDE_;
+		virtual u32 getClusterCount() const _IRR_OVERRIDE_;
+
+		virtual void setMaxLightsPerCluster(u32 count) _IRR_OVERRIDE_;
+		virtual u32 getMaxLightsPerCluster() const _IRR_OVERRIDE_;
+
+		virtual void setThreadCount(u32 count) _IRR_OVERRIDE_;
+
+		virtual s32 getClusterIndex(const core::vector3df& viewPosition) const _IRR_OVERRIDE_;
+
+		virtual u32 getLightCount() const _IRR_OVERRIDE_;
+		virtual u32 getDirectionalLightCount() const _IRR_OVERRIDE_;
+		virtual const SClusteredLight* getLights() const _IRR_OVERRIDE_;
+		virtual ILightSceneNode* getLightNode(u32 index) const _IRR_OVERRIDE_;
+
+		virtual const u32* getClusterLightRanges() const _IRR_OVERRIDE_;
+		virtual const u16* getLightIndices() const _IRR_OVERRIDE_;
+		virtual u32 getLightIndexCount() const _IRR_OVERRIDE_;
+
+	private:
+
+		//! A plane between two columns or rows of tiles
+		/** At depth z, the plane is at Offset + Slope * z. */
+		struct STileBoundary
+		{
+			f32 Offset;
+			f32 Slope;
+
+			//! 1 / length of the plane normal (1, -Slope)
+			f32 InvLength;
+
+			f32 at(f32 z) const { return Offset + Slope * z; }
+			f32 getDistance(f32 pos, f32 z) const { return (pos - at(z)) * InvLength; }
+		};
+
+		//! A clustered light and the range of clusters which may touch it
+		struct SLightBounds
+		{
+			core::vector3df Center;
+			f32 RadiusSQ;
+			u16 Light;
+			u8 MinX, MaxX, MinY, MaxY, MinSlice, MaxSlice;
+		};
+
+		//! sorts the lights of the scene and assigns them to the clusters of a camera
+		void update(core::array<ISceneNode*>& lightList, const ICameraSceneNode* camera,
+			core::frame_arena* arena);
+
+		//! recalculates the tile boundaries and cluster boxes for a projection
+		void updateGrid(const ICameraSceneNode* camera);
+
+		//! calculates the tiles of a sphere along one axis
+		bool getTileRange(const core::array<STileBoundary>& boundaries,
+			f32 pos, f32 z, f32 radius, u8& outMin, u8& outMax) const;
+
+		//! returns the slice of a depth, which is clamped to the slices
+		u32 getSlice(f32 z) const;
+
+		//! assigns the lights to the clusters of all slices, on several threads
+		void assignLights(const SLightBounds* bounds, u32 count);
+
+		//! assigns the lights to the clusters of one slice
+		void assignSlice(const SLightBounds* bounds, u32 count, u32 slice);
+
+		//! assigns the slices which no other thread took yet
+		void assignSlices(const SLightBounds* bounds, u32 count);
+
+		//! Threads kept between the frames to assign the lights
+		struct SAssignPool;
+
+		ISceneManager* SceneManager;
+
+		u32 TilesX;
+		u32 TilesY;
+		u32 Slices;
+		u32 MaxLightsPerCluster;
+		u32 ThreadCount;
+
+		//! Projection and depth range the grid was calculated for
+		core::matrix4 GridProjection;
+		f32 GridNear;
+		f32 GridFar;
+		bool GridDirty;
+
+		//! Depth range of the slices and Slices / log(Far / Near)
+		f32 Near;
+		f32 Far;
+		f32 SliceScale;
+
+		core::array<STileBoundary> BoundariesX;
+		core::array<STileBoundary> BoundariesY;
+
+		//! View space boxes of the clusters, as 6 arrays of BoxStride values:
+		//! min x, min y, min z, max x, max y, max z
+		core::array<f32> Boxes;
+		u32 BoxStride;
+
+		core::matrix4 View;
+
+		core::array<SClusteredLight> Lights;
+		core::array<ILightSceneNode*> LightNodes;
+		u32 DirectionalLightCount;
+
+		//! Lights of each cluster while assigning, MaxLightsPerCluster per cluster
+		core::array<u16> Bins;
+		core::array<u32> BinCounts;
+
+		core::array<u32> Ranges;
+		core::array<u16> Indices;
+
+		//! Created when more than one thread assigns the lights
+		SAssignPool* Pool;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
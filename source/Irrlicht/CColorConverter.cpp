@@ -6,12 +6,825 @@
 #include "SColor.h"
 #include "os.h"
 #include "irrString.h"
+#include "irrSIMD.h"
 
 namespace irr
 {
 namespace video
 {
 
+namespace
+{
+	//! Converts the start of a span of pixels, returns how many were converted
+	/** Kernels only convert whole vectors, the scalar code converts the rest. */
+	typedef s32 (*SIMDConverter)(const void* sP, s32 sN, void* dP);
+
+#ifdef _IRR_SIMD_X86_
+
+	//! 16 bit lanes of A8R8G8B8 colors from A1R5G5B5 colors, green and blue in gb, alpha and red in ar
+	_IRR_SIMD_TARGET_("sse2")
+	inline void A1R5G5B5toA8R8G8B8_SSE2(__m128i c, __m128i& gb, __m128i& ar)
+	{
+		// low bits are filled up with the high bits, as in A1R5G5B5toA8R8G8B8
+		const __m128i m5 = _mm_set1_epi16(0xf8);
+		const __m128i m3 = _mm_set1_epi16(0x07);
+		const __m128i b = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(c, 3), m5), _mm_and_si128(_mm_srli_epi16(c, 2), m3));
+		const __m128i g = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(c, 2), m5), _mm_and_si128(_mm_srli_epi16(c, 7), m3));
+		const __m128i r = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(c, 7), m5), _mm_and_si128(_mm_srli_epi16(c, 12), m3));
+		const __m128i a = _mm_slli_epi16(_mm_srai_epi16(c, 15), 8);
+		gb = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+		ar = _mm_or_si128(r, a);
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	s32 convert_A1R5G5B5toA8R8G8B8_SSE2(const void* sP, s32 sN, void* dP)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			__m128i gb, ar;
+			A1R5G5B5toA8R8G8B8_SSE2(_mm_loadu_si128(sB++), gb, ar);
+			_mm_storeu_si128(dB++, _mm_unpacklo_epi16(gb, ar));
+			_mm_storeu_si128(dB++, _mm_unpackhi_epi16(gb, ar));
+		}
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	s32 convert_A1R5G5B5toR5G6B5_SSE2(const void* sP, s32 sN, void* dP)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+		const __m128i rg = _mm_set1_epi16(0x7fe0);
+		const __m128i b = _mm_set1_epi16(0x1f);
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			const __m128i c = _mm_loadu_si128(sB++);
+			_mm_storeu_si128(dB++, _mm_or_si128(_mm_slli_epi16(_mm_and_si128(c, rg), 1), _mm_and_si128(c, b)));
+		}
+		return n;
+	}
+
+	//! 32 bit colors packed into 16 bit colors, keeping all bits of the low halves
+	_IRR_SIMD_TARGET_("sse2")
+	inline __m128i pack32to16_SSE2(__m128i lo, __m128i hi)
+	{
+		// sign extending avoids the signed saturation
+		return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16), _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	inline __m128i A8R8G8B8toA1R5G5B5_SSE2(__m128i c)
+	{
+		return _mm_or_si128(
+			_mm_or_si128(_mm_and_si128(_mm_srli_epi32(c, 16), _mm_set1_epi32(0x8000)), _mm_and_si128(_mm_srli_epi32(c, 9), _mm_set1_epi32(0x7c00))),
+			_mm_or_si128(_mm_and_si128(_mm_srli_epi32(c, 6), _mm_set1_epi32(0x03e0)), _mm_and_si128(_mm_srli_epi32(c, 3), _mm_set1_epi32(0x001f))));
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	s32 convert_A8R8G8B8toA1R5G5B5_SSE2(const void* sP, s32 sN, void* dP)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			const __m128i lo = A8R8G8B8toA1R5G5B5_SSE2(_mm_loadu_si128(sB++));
+			const __m128i hi = A8R8G8B8toA1R5G5B5_SSE2(_mm_loadu_si128(sB++));
+			_mm_storeu_si128(dB++, pack32to16_SSE2(lo, hi));
+		}
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	inline __m128i A8R8G8B8toR5G6B5_SSE2(__m128i c)
+	{
+		return _mm_or_si128(_mm_and_si128(_mm_srli_epi32(c, 8), _mm_set1_epi32(0xf800)),
+			_mm_or_si128(_mm_and_si128(_mm_srli_epi32(c, 5), _mm_set1_epi32(0x07e0)), _mm_and_si128(_mm_srli_epi32(c, 3), _mm_set1_epi32(0x001f))));
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	s32 convert_A8R8G8B8toR5G6B5_SSE2(const void* sP, s32 sN, void* dP)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			const __m128i lo = A8R8G8B8toR5G6B5_SSE2(_mm_loadu_si128(sB++));
+			const __m128i hi = A8R8G8B8toR5G6B5_SSE2(_mm_loadu_si128(sB++));
+			_mm_storeu_si128(dB++, pack32to16_SSE2(lo, hi));
+		}
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	s32 convert_A8R8G8B8toR8G8B8A8_SSE2(const void* sP, s32 sN, void* dP)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+
+		const s32 n = sN & ~3;
+		for (s32 x = 0; x < n; x += 4)
+		{
+			const __m128i c = _mm_loadu_si128(sB++);
+			_mm_storeu_si128(dB++, _mm_or_si128(_mm_slli_epi32(c, 8), _mm_srli_epi32(c, 24)));
+		}
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	s32 convert_A8R8G8B8toA8B8G8R8_SSE2(const void* sP, s32 sN, void* dP)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+		const __m128i ag = _mm_set1_epi32((s32)0xff00ff00);
+		const __m128i b = _mm_set1_epi32(0x000000ff);
+
+		const s32 n = sN & ~3;
+		for (s32 x = 0; x < n; x += 4)
+		{
+			const __m128i c = _mm_loadu_si128(sB++);
+			const __m128i rb = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(c, 16), b), _mm_slli_epi32(_mm_and_si128(c, b), 16));
+			_mm_storeu_si128(dB++, _mm_or_si128(_mm_and_si128(c, ag), rb));
+		}
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	s32 convert_B8G8R8A8toA8R8G8B8_SSE2(const void* sP, s32 sN, void* dP)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+		const __m128i m = _mm_set1_epi32(0x00ff00ff);
+
+		const s32 n = sN & ~3;
+		for (s32 x = 0; x < n; x += 4)
+		{
+			// swap the 16 bit halves, then the bytes in them
+			const __m128i c = _mm_loadu_si128(sB++);
+			const __m128i h = _mm_or_si128(_mm_slli_epi32(c, 16), _mm_srli_epi32(c, 16));
+			_mm_storeu_si128(dB++, _mm_or_si128(_mm_slli_epi16(_mm_and_si128(h, m), 8), _mm_and_si128(_mm_srli_epi16(h, 8), m)));
+		}
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	inline void R5G6B5toA8R8G8B8_SSE2(__m128i c, __m128i& gb, __m128i& ar)
+	{
+		// without filling up the low bits, as in R5G6B5toA8R8G8B8
+		const __m128i b = _mm_and_si128(_mm_slli_epi16(c, 3), _mm_set1_epi16(0xf8));
+		const __m128i g = _mm_and_si128(_mm_srli_epi16(c, 3), _mm_set1_epi16(0xfc));
+		const __m128i r = _mm_srli_epi16(c, 11);
+		gb = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+		ar = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_set1_epi16((s16)0xff00));
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	s32 convert_R5G6B5toA8R8G8B8_SSE2(const void* sP, s32 sN, void* dP)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			__m128i gb, ar;
+			R5G6B5toA8R8G8B8_SSE2(_mm_loadu_si128(sB++), gb, ar);
+			_mm_storeu_si128(dB++, _mm_unpacklo_epi16(gb, ar));
+			_mm_storeu_si128(dB++, _mm_unpackhi_epi16(gb, ar));
+		}
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	s32 convert_R5G6B5toA1R5G5B5_SSE2(const void* sP, s32 sN, void* dP)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+		const __m128i rg = _mm_set1_epi16((s16)0xffc0);
+		const __m128i b = _mm_set1_epi16(0x1f);
+		const __m128i a = _mm_set1_epi16((s16)0x8000);
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			const __m128i c = _mm_loadu_si128(sB++);
+			_mm_storeu_si128(dB++, _mm_or_si128(_mm_or_si128(_mm_srli_epi16(_mm_and_si128(c, rg), 1), _mm_and_si128(c, b)), a));
+		}
+		return n;
+	}
+
+	//! Reorders the bytes of each 32 bit color
+	_IRR_SIMD_TARGET_("ssse3")
+	inline s32 shuffle32to32_SSSE3(const void* sP, s32 sN, void* dP, __m128i mask)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+
+		const s32 n = sN & ~3;
+		for (s32 x = 0; x < n; x += 4)
+			_mm_storeu_si128(dB++, _mm_shuffle_epi8(_mm_loadu_si128(sB++), mask));
+		return n;
+	}
+
+	//! Expands 24 bit colors to 32 bit colors with the bytes in mask order and full alpha
+	_IRR_SIMD_TARGET_("ssse3")
+	inline s32 shuffle24to32_SSSE3(const void* sP, s32 sN, void* dP, __m128i mask)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+		const __m128i alpha = _mm_set1_epi32((s32)0xff000000);
+
+		// 16 pixels are 3 vectors of 24 bit colors
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const __m128i a = _mm_loadu_si128(sB++);
+			const __m128i b = _mm_loadu_si128(sB++);
+			const __m128i c = _mm_loadu_si128(sB++);
+			_mm_storeu_si128(dB++, _mm_or_si128(_mm_shuffle_epi8(a, mask), alpha));
+			_mm_storeu_si128(dB++, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), mask), alpha));
+			_mm_storeu_si128(dB++, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), mask), alpha));
+			_mm_storeu_si128(dB++, _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(c, 4), mask), alpha));
+		}
+		return n;
+	}
+
+	//! Drops the alpha of 32 bit colors, mask puts the 12 color bytes of a vector first
+	_IRR_SIMD_TARGET_("ssse3")
+	inline s32 shuffle32to24_SSSE3(const void* sP, s32 sN, void* dP, __m128i mask)
+	{
+		const __m128i* sB = (const __m128i*)sP;
+		__m128i* dB = (__m128i*)dP;
+
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(sB++), mask);
+			const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(sB++), mask);
+			const __m128i c = _mm_shuffle_epi8(_mm_loadu_si128(sB++), mask);
+			const __m128i d = _mm_shuffle_epi8(_mm_loadu_si128(sB++), mask);
+			_mm_storeu_si128(dB++, _mm_or_si128(a, _mm_slli_si128(b, 12)));
+			_mm_storeu_si128(dB++, _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+			_mm_storeu_si128(dB++, _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+		}
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("ssse3")
+	s32 convert_A8R8G8B8toR8G8B8_SSSE3(const void* sP, s32 sN, void* dP)
+	{
+		return shuffle32to24_SSSE3(sP, sN, dP, _mm_setr_epi8(2,1,0, 6,5,4, 10,9,8, 14,13,12, -1,-1,-1,-1));
+	}
+
+	_IRR_SIMD_TARGET_("ssse3")
+	s32 convert_A8R8G8B8toB8G8R8_SSSE3(const void* sP, s32 sN, void* dP)
+	{
+		return shuffle32to24_SSSE3(sP, sN, dP, _mm_setr_epi8(0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1));
+	}
+
+	_IRR_SIMD_TARGET_("ssse3")
+	s32 convert_A8R8G8B8toA8B8G8R8_SSSE3(const void* sP, s32 sN, void* dP)
+	{
+		return shuffle32to32_SSSE3(sP, sN, dP, _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15));
+	}
+
+	_IRR_SIMD_TARGET_("ssse3")
+	s32 convert_B8G8R8A8toA8R8G8B8_SSSE3(const void* sP, s32 sN, void* dP)
+	{
+		return shuffle32to32_SSSE3(sP, sN, dP, _mm_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12));
+	}
+
+	_IRR_SIMD_TARGET_("ssse3")
+	s32 convert_R8G8B8toA8R8G8B8_SSSE3(const void* sP, s32 sN, void* dP)
+	{
+		return shuffle24to32_SSSE3(sP, sN, dP, _mm_setr_epi8(2,1,0,-1, 5,4,3,-1, 8,7,6,-1, 11,10,9,-1));
+	}
+
+	_IRR_SIMD_TARGET_("ssse3")
+	s32 convert_B8G8R8toA8R8G8B8_SSSE3(const void* sP, s32 sN, void* dP)
+	{
+		return shuffle24to32_SSSE3(sP, sN, dP, _mm_setr_epi8(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1));
+	}
+
+	_IRR_SIMD_TARGET_("avx2")
+	s32 convert_A1R5G5B5toA8R8G8B8_AVX2(const void* sP, s32 sN, void* dP)
+	{
+		const __m256i* sB = (const __m256i*)sP;
+		__m256i* dB = (__m256i*)dP;
+		const __m256i m5 = _mm256_set1_epi16(0xf8);
+		const __m256i m3 = _mm256_set1_epi16(0x07);
+
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const __m256i c = _mm256_loadu_si256(sB++);
+			const __m256i b = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(c, 3), m5), _mm256_and_si256(_mm256_srli_epi16(c, 2), m3));
+			const __m256i g = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(c, 2), m5), _mm256_and_si256(_mm256_srli_epi16(c, 7), m3));
+			const __m256i r = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(c, 7), m5), _mm256_and_si256(_mm256_srli_epi16(c, 12), m3));
+			const __m256i gb = _mm256_or_si256(b, _mm256_slli_epi16(g, 8));
+			const __m256i ar = _mm256_or_si256(r, _mm256_slli_epi16(_mm256_srai_epi16(c, 15), 8));
+
+			// unpacking works in 128 bit lanes
+			const __m256i lo = _mm256_unpacklo_epi16(gb, ar);
+			const __m256i hi = _mm256_unpackhi_epi16(gb, ar);
+			_mm256_storeu_si256(dB++, _mm256_permute2x128_si256(lo, hi, 0x20));
+			_mm256_storeu_si256(dB++, _mm256_permute2x128_si256(lo, hi, 0x31));
+		}
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("avx2")
+	s32 convert_R5G6B5toA8R8G8B8_AVX2(const void* sP, s32 sN, void* dP)
+	{
+		const __m256i* sB = (const __m256i*)sP;
+		__m256i* dB = (__m256i*)dP;
+
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const __m256i c = _mm256_loadu_si256(sB++);
+			const __m256i b = _mm256_and_si256(_mm256_slli_epi16(c, 3), _mm256_set1_epi16(0xf8));
+			const __m256i g = _mm256_and_si256(_mm256_srli_epi16(c, 3), _mm256_set1_epi16(0xfc));
+			const __m256i gb = _mm256_or_si256(b, _mm256_slli_epi16(g, 8));
+			const __m256i ar = _mm256_or_si256(_mm256_slli_epi16(_mm256_srli_epi16(c, 11), 3), _mm256_set1_epi16((s16)0xff00));
+
+			const __m256i lo = _mm256_unpacklo_epi16(gb, ar);
+			const __m256i hi = _mm256_unpackhi_epi16(gb, ar);
+			_mm256_storeu_si256(dB++, _mm256_permute2x128_si256(lo, hi, 0x20));
+			_mm256_storeu_si256(dB++, _mm256_permute2x128_si256(lo, hi, 0x31));
+		}
+		return n;
+	}
+
+	//! 32 bit colors packed into 16 bit colors, keeping all bits of the low halves
+	_IRR_SIMD_TARGET_("avx2")
+	inline __m256i pack32to16_AVX2(__m256i lo, __m256i hi)
+	{
+		const __m256i p = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_slli_epi32(lo, 16), 16), _mm256_srai_epi32(_mm256_slli_epi32(hi, 16), 16));
+		// packing works in 128 bit lanes
+		return _mm256_permute4x64_epi64(p, 0xd8);
+	}
+
+	_IRR_SIMD_TARGET_("avx2")
+	inline __m256i A8R8G8B8toA1R5G5B5_AVX2(__m256i c)
+	{
+		return _mm256_or_si256(
+			_mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(c, 16), _mm256_set1_epi32(0x8000)), _mm256_and_si256(_mm256_srli_epi32(c, 9), _mm256_set1_epi32(0x7c00))),
+			_mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(c, 6), _mm256_set1_epi32(0x03e0)), _mm256_and_si256(_mm256_srli_epi32(c, 3), _mm256_set1_epi32(0x001f))));
+	}
+
+	_IRR_SIMD_TARGET_("avx2")
+	s32 convert_A8R8G8B8toA1R5G5B5_AVX2(const void* sP, s32 sN, void* dP)
+	{
+		const __m256i* sB = (const __m256i*)sP;
+		__m256i* dB = (__m256i*)dP;
+
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const __m256i lo = A8R8G8B8toA1R5G5B5_AVX2(_mm256_loadu_si256(sB++));
+			const __m256i hi = A8R8G8B8toA1R5G5B5_AVX2(_mm256_loadu_si256(sB++));
+			_mm256_storeu_si256(dB++, pack32to16_AVX2(lo, hi));
+		}
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("avx2")
+	inline __m256i A8R8G8B8toR5G6B5_AVX2(__m256i c)
+	{
+		return _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(c, 8), _mm256_set1_epi32(0xf800)),
+			_mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(c, 5), _mm256_set1_epi32(0x07e0)), _mm256_and_si256(_mm256_srli_epi32(c, 3), _mm256_set1_epi32(0x001f))));
+	}
+
+	_IRR_SIMD_TARGET_("avx2")
+	s32 convert_A8R8G8B8toR5G6B5_AVX2(const void* sP, s32 sN, void* dP)
+	{
+		const __m256i* sB = (const __m256i*)sP;
+		__m256i* dB = (__m256i*)dP;
+
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const __m256i lo = A8R8G8B8toR5G6B5_AVX2(_mm256_loadu_si256(sB++));
+			const __m256i hi = A8R8G8B8toR5G6B5_AVX2(_mm256_loadu_si256(sB++));
+			_mm256_storeu_si256(dB++, pack32to16_AVX2(lo, hi));
+		}
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("avx2")
+	s32 convert_A8R8G8B8toR8G8B8A8_AVX2(const void* sP, s32 sN, void* dP)
+	{
+		const __m256i* sB = (const __m256i*)sP;
+		__m256i* dB = (__m256i*)dP;
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			const __m256i c = _mm256_loadu_si256(sB++);
+			_mm256_storeu_si256(dB++, _mm256_or_si256(_mm256_slli_epi32(c, 8), _mm256_srli_epi32(c, 24)));
+		}
+		return n;
+	}
+
+	//! Reorders the bytes of each 32 bit color
+	_IRR_SIMD_TARGET_("avx2")
+	inline s32 shuffle32to32_AVX2(const void* sP, s32 sN, void* dP, __m128i mask)
+	{
+		const __m256i* sB = (const __m256i*)sP;
+		__m256i* dB = (__m256i*)dP;
+		// colors don't cross the 128 bit lanes of the shuffle
+		const __m256i mask2 = _mm256_broadcastsi128_si256(mask);
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+			_mm256_storeu_si256(dB++, _mm256_shuffle_epi8(_mm256_loadu_si256(sB++), mask2));
+		return n;
+	}
+
+	_IRR_SIMD_TARGET_("avx2")
+	s32 convert_A8R8G8B8toA8B8G8R8_AVX2(const void* sP, s32 sN, void* dP)
+	{
+		return shuffle32to32_AVX2(sP, sN, dP, _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15));
+	}
+
+	_IRR_SIMD_TARGET_("avx2")
+	s32 convert_B8G8R8A8toA8R8G8B8_AVX2(const void* sP, s32 sN, void* dP)
+	{
+		return shuffle32to32_AVX2(sP, sN, dP, _mm_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12));
+	}
+
+#endif // _IRR_SIMD_X86_
+
+#ifdef _IRR_SIMD_NEON_
+
+	//! Channels of 8 A1R5G5B5 colors, low bits filled up with the high bits as in A1R5G5B5toA8R8G8B8
+	inline uint8x8x4_t A1R5G5B5toA8R8G8B8_NEON(uint16x8_t c)
+	{
+		const uint16x8_t r = vandq_u16(vshrq_n_u16(c, 10), vdupq_n_u16(0x1f));
+		const uint16x8_t g = vandq_u16(vshrq_n_u16(c, 5), vdupq_n_u16(0x1f));
+		const uint16x8_t b = vandq_u16(c, vdupq_n_u16(0x1f));
+
+		uint8x8x4_t v;
+		v.val[0] = vmovn_u16(vorrq_u16(vshlq_n_u16(b, 3), vshrq_n_u16(b, 2)));
+		v.val[1] = vmovn_u16(vorrq_u16(vshlq_n_u16(g, 3), vshrq_n_u16(g, 2)));
+		v.val[2] = vmovn_u16(vorrq_u16(vshlq_n_u16(r, 3), vshrq_n_u16(r, 2)));
+		v.val[3] = vmovn_u16(vtstq_u16(c, vdupq_n_u16(0x8000)));
+		return v;
+	}
+
+	s32 convert_A1R5G5B5toA8R8G8B8_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u16* sB = (const u16*)sP;
+		u8* dB = (u8*)dP;
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			vst4_u8(dB, A1R5G5B5toA8R8G8B8_NEON(vld1q_u16(sB)));
+			sB += 8;
+			dB += 32;
+		}
+		return n;
+	}
+
+	s32 convert_A1R5G5B5toR5G6B5_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u16* sB = (const u16*)sP;
+		u16* dB = (u16*)dP;
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			const uint16x8_t c = vld1q_u16(sB);
+			vst1q_u16(dB, vorrq_u16(vshlq_n_u16(vandq_u16(c, vdupq_n_u16(0x7fe0)), 1), vandq_u16(c, vdupq_n_u16(0x1f))));
+			sB += 8;
+			dB += 8;
+		}
+		return n;
+	}
+
+	s32 convert_A8R8G8B8toR8G8B8_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u8* sB = (const u8*)sP;
+		u8* dB = (u8*)dP;
+
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const uint8x16x4_t c = vld4q_u8(sB);
+			uint8x16x3_t v;
+			v.val[0] = c.val[2];
+			v.val[1] = c.val[1];
+			v.val[2] = c.val[0];
+			vst3q_u8(dB, v);
+			sB += 64;
+			dB += 48;
+		}
+		return n;
+	}
+
+	s32 convert_A8R8G8B8toB8G8R8_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u8* sB = (const u8*)sP;
+		u8* dB = (u8*)dP;
+
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const uint8x16x4_t c = vld4q_u8(sB);
+			uint8x16x3_t v;
+			v.val[0] = c.val[0];
+			v.val[1] = c.val[1];
+			v.val[2] = c.val[2];
+			vst3q_u8(dB, v);
+			sB += 64;
+			dB += 48;
+		}
+		return n;
+	}
+
+	//! 8 A8R8G8B8 colors widened to 16 bit channels b, g, r, a
+	inline uint8x8x4_t loadA8R8G8B8_NEON(const u8* sB, uint16x8_t& b, uint16x8_t& g, uint16x8_t& r)
+	{
+		const uint8x8x4_t c = vld4_u8(sB);
+		b = vmovl_u8(c.val[0]);
+		g = vmovl_u8(c.val[1]);
+		r = vmovl_u8(c.val[2]);
+		return c;
+	}
+
+	s32 convert_A8R8G8B8toA1R5G5B5_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u8* sB = (const u8*)sP;
+		u16* dB = (u16*)dP;
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			uint16x8_t b, g, r;
+			const uint8x8x4_t c = loadA8R8G8B8_NEON(sB, b, g, r);
+			const uint16x8_t a = vshlq_n_u16(vshrq_n_u16(vmovl_u8(c.val[3]), 7), 15);
+			const uint16x8_t rg = vorrq_u16(vshlq_n_u16(vshrq_n_u16(r, 3), 10), vshlq_n_u16(vshrq_n_u16(g, 3), 5));
+			vst1q_u16(dB, vorrq_u16(vorrq_u16(a, rg), vshrq_n_u16(b, 3)));
+			sB += 32;
+			dB += 8;
+		}
+		return n;
+	}
+
+	s32 convert_A8R8G8B8toR5G6B5_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u8* sB = (const u8*)sP;
+		u16* dB = (u16*)dP;
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			uint16x8_t b, g, r;
+			loadA8R8G8B8_NEON(sB, b, g, r);
+			const uint16x8_t rg = vorrq_u16(vshlq_n_u16(vshrq_n_u16(r, 3), 11), vshlq_n_u16(vshrq_n_u16(g, 2), 5));
+			vst1q_u16(dB, vorrq_u16(rg, vshrq_n_u16(b, 3)));
+			sB += 32;
+			dB += 8;
+		}
+		return n;
+	}
+
+	//! Stores 16 colors with the channels in the given order
+	inline void store4_NEON(u8* dB, uint8x16_t v0, uint8x16_t v1, uint8x16_t v2, uint8x16_t v3)
+	{
+		uint8x16x4_t v;
+		v.val[0] = v0;
+		v.val[1] = v1;
+		v.val[2] = v2;
+		v.val[3] = v3;
+		vst4q_u8(dB, v);
+	}
+
+	s32 convert_A8R8G8B8toR8G8B8A8_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u8* sB = (const u8*)sP;
+		u8* dB = (u8*)dP;
+
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const uint8x16x4_t c = vld4q_u8(sB);
+			store4_NEON(dB, c.val[3], c.val[0], c.val[1], c.val[2]);
+			sB += 64;
+			dB += 64;
+		}
+		return n;
+	}
+
+	s32 convert_A8R8G8B8toA8B8G8R8_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u8* sB = (const u8*)sP;
+		u8* dB = (u8*)dP;
+
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const uint8x16x4_t c = vld4q_u8(sB);
+			store4_NEON(dB, c.val[2], c.val[1], c.val[0], c.val[3]);
+			sB += 64;
+			dB += 64;
+		}
+		return n;
+	}
+
+	s32 convert_R8G8B8toA8R8G8B8_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u8* sB = (const u8*)sP;
+		u8* dB = (u8*)dP;
+
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const uint8x16x3_t c = vld3q_u8(sB);
+			store4_NEON(dB, c.val[2], c.val[1], c.val[0], vdupq_n_u8(0xff));
+			sB += 48;
+			dB += 64;
+		}
+		return n;
+	}
+
+	s32 convert_B8G8R8toA8R8G8B8_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u8* sB = (const u8*)sP;
+		u8* dB = (u8*)dP;
+
+		const s32 n = sN & ~15;
+		for (s32 x = 0; x < n; x += 16)
+		{
+			const uint8x16x3_t c = vld3q_u8(sB);
+			store4_NEON(dB, c.val[0], c.val[1], c.val[2], vdupq_n_u8(0xff));
+			sB += 48;
+			dB += 64;
+		}
+		return n;
+	}
+
+	s32 convert_B8G8R8A8toA8R8G8B8_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u8* sB = (const u8*)sP;
+		u8* dB = (u8*)dP;
+
+		const s32 n = sN & ~3;
+		for (s32 x = 0; x < n; x += 4)
+		{
+			vst1q_u8(dB, vrev32q_u8(vld1q_u8(sB)));
+			sB += 16;
+			dB += 16;
+		}
+		return n;
+	}
+
+	s32 convert_R5G6B5toA8R8G8B8_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u16* sB = (const u16*)sP;
+		u8* dB = (u8*)dP;
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			// without filling up the low bits, as in R5G6B5toA8R8G8B8
+			const uint16x8_t c = vld1q_u16(sB);
+			uint8x8x4_t v;
+			v.val[0] = vshl_n_u8(vmovn_u16(c), 3);
+			v.val[1] = vmovn_u16(vandq_u16(vshrq_n_u16(c, 3), vdupq_n_u16(0xfc)));
+			v.val[2] = vmovn_u16(vandq_u16(vshrq_n_u16(c, 8), vdupq_n_u16(0xf8)));
+			v.val[3] = vdup_n_u8(0xff);
+			vst4_u8(dB, v);
+			sB += 8;
+			dB += 32;
+		}
+		return n;
+	}
+
+	s32 convert_R5G6B5toA1R5G5B5_NEON(const void* sP, s32 sN, void* dP)
+	{
+		const u16* sB = (const u16*)sP;
+		u16* dB = (u16*)dP;
+
+		const s32 n = sN & ~7;
+		for (s32 x = 0; x < n; x += 8)
+		{
+			const uint16x8_t c = vld1q_u16(sB);
+			const uint16x8_t rg = vshrq_n_u16(vandq_u16(c, vdupq_n_u16(0xffc0)), 1);
+			vst1q_u16(dB, vorrq_u16(vorrq_u16(rg, vandq_u16(c, vdupq_n_u16(0x1f))), vdupq_n_u16(0x8000)));
+			sB += 8;
+			dB += 8;
+		}
+		return n;
+	}
+
+#endif // _IRR_SIMD_NEON_
+
+	//! The fastest kernels for the cpu, 0 where there's only the scalar code
+	struct SSIMDConverters
+	{
+		SIMDConverter A1R5G5B5toA8R8G8B8;
+		SIMDConverter A1R5G5B5toR5G6B5;
+		SIMDConverter A8R8G8B8toR8G8B8;
+		SIMDConverter A8R8G8B8toB8G8R8;
+		SIMDConverter A8R8G8B8toA1R5G5B5;
+		SIMDConverter A8R8G8B8toR5G6B5;
+		SIMDConverter A8R8G8B8toR8G8B8A8;
+		SIMDConverter A8R8G8B8toA8B8G8R8;
+		SIMDConverter R8G8B8toA8R8G8B8;
+		SIMDConverter B8G8R8toA8R8G8B8;
+		SIMDConverter B8G8R8A8toA8R8G8B8;
+		SIMDConverter R5G6B5toA8R8G8B8;
+		SIMDConverter R5G6B5toA1R5G5B5;
+	};
+
+	SSIMDConverters selectSIMDConverters()
+	{
+		SSIMDConverters c;
+		memset(&c, 0, sizeof(SSIMDConverters));
+
+#ifdef _IRR_SIMD_X86_
+		const u32 features = os::getX86Features();
+		if (features & os::EXF_SSE2)
+		{
+			c.A1R5G5B5toA8R8G8B8 = convert_A1R5G5B5toA8R8G8B8_SSE2;
+			c.A1R5G5B5toR5G6B5 = convert_A1R5G5B5toR5G6B5_SSE2;
+			c.A8R8G8B8toA1R5G5B5 = convert_A8R8G8B8toA1R5G5B5_SSE2;
+			c.A8R8G8B8toR5G6B5 = convert_A8R8G8B8toR5G6B5_SSE2;
+			c.A8R8G8B8toR8G8B8A8 = convert_A8R8G8B8toR8G8B8A8_SSE2;
+			c.A8R8G8B8toA8B8G8R8 = convert_A8R8G8B8toA8B8G8R8_SSE2;
+			c.B8G8R8A8toA8R8G8B8 = convert_B8G8R8A8toA8R8G8B8_SSE2;
+			c.R5G6B5toA8R8G8B8 = convert_R5G6B5toA8R8G8B8_SSE2;
+			c.R5G6B5toA1R5G5B5 = convert_R5G6B5toA1R5G5B5_SSE2;
+		}
+		if (features & os::EXF_SSSE3)
+		{
+			c.A8R8G8B8toR8G8B8 = convert_A8R8G8B8toR8G8B8_SSSE3;
+			c.A8R8G8B8toB8G8R8 = convert_A8R8G8B8toB8G8R8_SSSE3;
+			c.A8R8G8B8toA8B8G8R8 = convert_A8R8G8B8toA8B8G8R8_SSSE3;
+			c.R8G8B8toA8R8G8B8 = convert_R8G8B8toA8R8G8B8_SSSE3;
+			c.B8G8R8toA8R8G8B8 = convert_B8G8R8toA8R8G8B8_SSSE3;
+			c.B8G8R8A8toA8R8G8B8 = convert_B8G8R8A8toA8R8G8B8_SSSE3;
+		}
+		if (features & os::EXF_AVX2)
+		{
+			c.A1R5G5B5toA8R8G8B8 = convert_A1R5G5B5toA8R8G8B8_AVX2;
+			c.A8R8G8B8toA1R5G5B5 = convert_A8R8G8B8toA1R5G5B5_AVX2;
+			c.A8R8G8B8toR5G6B5 = convert_A8R8G8B8toR5G6B5_AVX2;
+			c.A8R8G8B8toR8G8B8A8 = convert_A8R8G8B8toR8G8B8A8_AVX2;
+			c.A8R8G8B8toA8B8G8R8 = convert_A8R8G8B8toA8B8G8R8_AVX2;
+			c.B8G8R8A8toA8R8G8B8 = convert_B8G8R8A8toA8R8G8B8_AVX2;
+			c.R5G6B5toA8R8G8B8 = convert_R5G6B5toA8R8G8B8_AVX2;
+		}
+#endif
+
+#ifdef _IRR_SIMD_NEON_
+		c.A1R5G5B5toA8R8G8B8 = convert_A1R5G5B5toA8R8G8B8_NEON;
+		c.A1R5G5B5toR5G6B5 = convert_A1R5G5B5toR5G6B5_NEON;
+		c.A8R8G8B8toR8G8B8 = convert_A8R8G8B8toR8G8B8_NEON;
+		c.A8R8G8B8toB8G8R8 = convert_A8R8G8B8toB8G8R8_NEON;
+		c.A8R8G8B8toA1R5G5B5 = convert_A8R8G8B8toA1R5G5B5_NEON;
+		c.A8R8G8B8toR5G6B5 = convert_A8R8G8B8toR5G6B5_NEON;
+		c.A8R8G8B8toR8G8B8A8 = convert_A8R8G8B8toR8G8B8A8_NEON;
+		c.A8R8G8B8toA8B8G8R8 = convert_A8R8G8B8toA8B8G8R8_NEON;
+		c.R8G8B8toA8R8G8B8 = convert_R8G8B8toA8R8G8B8_NEON;
+		c.B8G8R8toA8R8G8B8 = convert_B8G8R8toA8R8G8B8_NEON;
+		c.B8G8R8A8toA8R8G8B8 = convert_B8G8R8A8toA8R8G8B8_NEON;
+		c.R5G6B5toA8R8G8B8 = convert_R5G6B5toA8R8G8B8_NEON;
+		c.R5G6B5toA1R5G5B5 = convert_R5G6B5toA1R5G5B5_NEON;
+#endif
+
+		return c;
+	}
+
+	const SSIMDConverters& getSIMDConverters()
+	{
+		// selected once, the initialization is thread safe
+		static const SSIMDConverters converters = selectSIMDConverters();
+		return converters;
+	}
+
+	//! Runs the kernel if there is one, returns the number of converted pixels
+	inline s32 convertSIMD(SIMDConverter converter, const void* sP, s32 sN, void* dP)
+	{
+		if (!converter || sN <= 0)
+			return 0;
+		return converter(sP, sN, dP);
+	}
+}
+
+
 //! converts a monochrome bitmap to A1R5G5B5 data
 void CColorConverter::convert1BitTo16Bit(const u8* in, s16* out, s32 width, s32 height, s32 linepad, bool flip)
 {
@@ -372,10 +1185,11 @@ void CColorConverter::convert_A1R5G5B5toR5G5B5A1(const void* sP, s32 sN, void* d
 
 void CColorConverter::convert_A1R5G5B5toA8R8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u16* sB = (u16*)sP;
-	u32* dB = (u32*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().A1R5G5B5toA8R8G8B8, sP, sN, dP);
+	u16* sB = (u16*)sP + done;
+	u32* dB = (u32*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 		*dB++ = A1R5G5B5toA8R8G8B8(*sB++);
 }
 
@@ -386,19 +1200,21 @@ void CColorConverter::convert_A1R5G5B5toA1R5G5B5(const void* sP, s32 sN, void* d
 
 void CColorConverter::convert_A1R5G5B5toR5G6B5(const void* sP, s32 sN, void* dP)
 {
-	u16* sB = (u16*)sP;
-	u16* dB = (u16*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().A1R5G5B5toR5G6B5, sP, sN, dP);
+	u16* sB = (u16*)sP + done;
+	u16* dB = (u16*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 		*dB++ = A1R5G5B5toR5G6B5(*sB++);
 }
 
 void CColorConverter::convert_A8R8G8B8toR8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u8* sB = (u8*)sP;
-	u8* dB = (u8*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().A8R8G8B8toR8G8B8, sP, sN, dP);
+	u8* sB = (u8*)sP + done * 4;
+	u8* dB = (u8*)dP + done * 3;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		// sB[3] is alpha
 		dB[0] = sB[2];
@@ -412,10 +1228,11 @@ void CColorConverter::convert_A8R8G8B8toR8G8B8(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_A8R8G8B8toB8G8R8(const void* sP, s32 sN, void* dP)
 {
-	u8* sB = (u8*)sP;
-	u8* dB = (u8*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().A8R8G8B8toB8G8R8, sP, sN, dP);
+	u8* sB = (u8*)sP + done * 4;
+	u8* dB = (u8*)dP + done * 3;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		// sB[3] is alpha
 		dB[0] = sB[0];
@@ -434,10 +1251,11 @@ void CColorConverter::convert_A8R8G8B8toA8R8G8B8(const void* sP, s32 sN, void* d
 
 void CColorConverter::convert_A8R8G8B8toA1R5G5B5(const void* sP, s32 sN, void* dP)
 {
-	u32* sB = (u32*)sP;
-	u16* dB = (u16*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().A8R8G8B8toA1R5G5B5, sP, sN, dP);
+	u32* sB = (u32*)sP + done;
+	u16* dB = (u16*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 		*dB++ = A8R8G8B8toA1R5G5B5(*sB++);
 }
 
@@ -462,10 +1280,11 @@ void CColorConverter::convert_A8R8G8B8toA1B5G5R5(const void* sP, s32 sN, void* d
 
 void CColorConverter::convert_A8R8G8B8toR5G6B5(const void* sP, s32 sN, void* dP)
 {
-	u8 * sB = (u8 *)sP;
-	u16* dB = (u16*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().A8R8G8B8toR5G6B5, sP, sN, dP);
+	u8 * sB = (u8 *)sP + done * 4;
+	u16* dB = (u16*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		s32 r = sB[2] >> 3;
 		s32 g = sB[1] >> 2;
@@ -503,10 +1322,11 @@ void CColorConverter::convert_R8G8B8toR8G8B8(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_R8G8B8toA8R8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u8*  sB = (u8* )sP;
-	u32* dB = (u32*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().R8G8B8toA8R8G8B8, sP, sN, dP);
+	u8*  sB = (u8* )sP + done * 3;
+	u32* dB = (u32*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		*dB = 0xff000000 | (sB[0]<<16) | (sB[1]<<8) | sB[2];
 
@@ -535,10 +1355,11 @@ void CColorConverter::convert_R8G8B8toA1R5G5B5(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_B8G8R8toA8R8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u8*  sB = (u8* )sP;
-	u32* dB = (u32*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().B8G8R8toA8R8G8B8, sP, sN, dP);
+	u8*  sB = (u8* )sP + done * 3;
+	u32* dB = (u32*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		*dB = 0xff000000 | (sB[2]<<16) | (sB[1]<<8) | sB[0];
 
@@ -549,10 +1370,11 @@ void CColorConverter::convert_B8G8R8toA8R8G8B8(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_A8R8G8B8toR8G8B8A8(const void* sP, s32 sN, void* dP)
 {
-	const u32* sB = (const u32*)sP;
-	u32* dB = (u32*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().A8R8G8B8toR8G8B8A8, sP, sN, dP);
+	const u32* sB = (const u32*)sP + done;
+	u32* dB = (u32*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		*dB++ = (*sB<<8) | (*sB>>24);
 		++sB;
@@ -561,10 +1383,11 @@ void CColorConverter::convert_A8R8G8B8toR8G8B8A8(const void* sP, s32 sN, void* d
 
 void CColorConverter::convert_A8R8G8B8toA8B8G8R8(const void* sP, s32 sN, void* dP)
 {
-	const u32* sB = (const u32*)sP;
-	u32* dB = (u32*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().A8R8G8B8toA8B8G8R8, sP, sN, dP);
+	const u32* sB = (const u32*)sP + done;
+	u32* dB = (u32*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		*dB++ = (*sB&0xff00ff00)|((*sB&0x00ff0000)>>16)|((*sB&0x000000ff)<<16);
 		++sB;
@@ -573,10 +1396,11 @@ void CColorConverter::convert_A8R8G8B8toA8B8G8R8(const void* sP, s32 sN, void* d
 
 void CColorConverter::convert_B8G8R8A8toA8R8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u8* sB = (u8*)sP;
-	u8* dB = (u8*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().B8G8R8A8toA8R8G8B8, sP, sN, dP);
+	u8* sB = (u8*)sP + done * 4;
+	u8* dB = (u8*)dP + done * 4;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		dB[0] = sB[3];
 		dB[1] = sB[2];
@@ -662,19 +1486,21 @@ void CColorConverter::convert_R5G6B5toB8G8R8(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_R5G6B5toA8R8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u16* sB = (u16*)sP;
-	u32* dB = (u32*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().R5G6B5toA8R8G8B8, sP, sN, dP);
+	u16* sB = (u16*)sP + done;
+	u32* dB = (u32*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 		*dB++ = R5G6B5toA8R8G8B8(*sB++);
 }
 
 void CColorConverter::convert_R5G6B5toA1R5G5B5(const void* sP, s32 sN, void* dP)
 {
-	u16* sB = (u16*)sP;
-	u16* dB = (u16*)dP;
+	const s32 done = convertSIMD(getSIMDConverters().R5G6B5toA1R5G5B5, sP, sN, dP);
+	u16* sB = (u16*)sP + done;
+	u16* dB = (u16*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 		*dB++ = R5G6B5toA1R5G5B5(*sB++);
 }
 
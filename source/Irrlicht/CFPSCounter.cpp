@@ -48,21 +48,21 @@ u32 CFPSCounter::getPrimitiveTotal() const
 
 
 //! to be called every frame
-void CFPSCounter::registerFrame(u32 now, u32 primitivesDrawn)
+void CFPSCounter::registerFrame(u64 now, u32 primitivesDrawn)
 {
 	++FramesCounted;
 	PrimitiveTotal += primitivesDrawn;
 	PrimitivesCounted += primitivesDrawn;
 	Primitive = primitivesDrawn;
 
-	const u32 milliseconds = now - StartTime;
+	const u64 microseconds = now - StartTime;
 
-	if (milliseconds >= 1500 )
+	if (microseconds >= 1500000 )
 	{
-		const f32 invMilli = core::reciprocal ( (f32) milliseconds );
+		const f32 invSeconds = (f32)(1000000.0 / microseconds);
 
-		FPS = core::ceil32 ( ( 1000 * FramesCounted ) * invMilli );
-		PrimitiveAverage = core::ceil32 ( ( 1000 * PrimitivesCounted ) * invMilli );
+		FPS = core::ceil32 ( FramesCounted * invSeconds );
+		PrimitiveAverage = core::ceil32 ( PrimitivesCounted * invSeconds );
 
 		FramesCounted = 0;
 		PrimitivesCounted = 0;
@@ -31,13 +31,14 @@ public:
 	u32 getPrimitiveTotal() const;
 
 	//! to be called every frame
-	void registerFrame(u32 now, u32 primitive);
+	/** \param now Real time in microseconds. */
+	void registerFrame(u64 now, u32 primitive);
 
 private:
 
 	s32 FPS;
 	u32 Primitive;
-	u32 StartTime;
+	u64 StartTime;
 
 	u32 FramesCounted;
 	u32 PrimitivesCounted;
@@ -158,6 +158,13 @@ const io::path& CFileList::getPath() const
 }
 
 
+//! Check if names are compared without their path
+bool CFileList::isIgnorePaths() const
+{
+	return IgnorePaths;
+}
+
+
 } // end namespace irr
 } // end namespace io
 
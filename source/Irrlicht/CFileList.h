@@ -114,6 +114,9 @@ public:
 	//! Returns the base path of the file list
 	virtual const io::path& getPath() const _IRR_OVERRIDE_;
 
+	//! Check if names are compared without their path
+	virtual bool isIgnorePaths() const _IRR_OVERRIDE_;
+
 protected:
 
 	//! Ignore paths when adding or searching for files
@@ -20,6 +20,8 @@
 #include "CLimitReadFile.h"
 #include "CWriteFile.h"
 #include "irrList.h"
+#include "EProfileIDs.h"
+#include "IProfiler.h"
 
 #if defined (__STRICT_ANSI__)
     #error Compiling with __STRICT_ANSI__ not supported. g++ does set this when compiling with -std=c++11 or -std=c++0x. Use instead -std=gnu++11 or -std=gnu++0x. Or use -U__STRICT_ANSI__ to disable strict ansi.
@@ -49,13 +51,52 @@ namespace irr
 namespace io
 {
 
+namespace
+{
+
+//! Case folded FNV-1a hash of a file name
+inline u32 fileIndexHash(const fschar_t* name)
+{
+	u32 hash = 2166136261u;
+	for (; *name; ++name)
+	{
+		hash ^= core::locale_lower((u32)*name);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+//! Compares a name in a file list with a searched name
+/** Like SFileListEntry, which file lists use for searching, this ignores case. */
+inline bool fileIndexNameEquals(const io::path& listName, const fschar_t* name)
+{
+	for (const fschar_t* s = listName.c_str(); *s; ++s, ++name)
+	{
+		if (core::locale_lower((u32)*s) != core::locale_lower((u32)*name))
+			return false;
+	}
+	return *name == 0;
+}
+
+} // end anonymous namespace
+
 //! constructor
 CFileSystem::CFileSystem()
+: FileIndexIgnorePaths(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CFileSystem");
 	#endif
 
+	IRR_PROFILE(
+		static bool initProfile = false;
+		if (!initProfile )
+		{
+			initProfile = true;
+			getProfiler().add(EPID_FS_ADD_ARCHIVE, L"addArchive", L"Irrlicht io");
+		}
+	)
+
 	setFileListSystem(FILESYSTEM_NATIVE);
 	//! reset current working directory
 	getWorkingDirectory();
@@ -113,13 +154,40 @@ IReadFile* CFileSystem::createAndOpenFile(const io::path& filename)
 	IReadFile* file = 0;
 	u32 i;
 
-	for (i=0; i< FileArchives.size(); ++i)
+	// directories are not in the index
+	const fschar_t last = filename.lastChar();
+	const bool isDirectory = last == '/' || last == '\\';
+
+	u32 fileIndex = 0;
+	const u32 found = isDirectory ? FileArchives.size() : findIndexedFile(filename, fileIndex);
+
+	// archives which are not in the index are still asked in priority order
+	for (i=0; i < found; ++i)
 	{
+		if (!isDirectory && (FileIndexArchives[i] & EFIF_INDEXED))
+			continue;
+
 		file = FileArchives[i]->createAndOpenFile(filename);
 		if (file)
 			return file;
 	}
 
+	if (found < FileArchives.size())
+	{
+		file = FileArchives[found]->createAndOpenFile(fileIndex);
+		if (file)
+			return file;
+
+		// the file was removed after the archive listed it,
+		// the archives with lower priority might still have it
+		for (i=found+1; i < FileArchives.size(); ++i)
+		{
+			file = FileArchives[i]->createAndOpenFile(filename);
+			if (file)
+				return file;
+		}
+	}
+
 	// Create the file using an absolute path so that it matches
 	// the scheme used by CNullDriver::getTexture().
 	return CReadFile::createReadFile(getAbsolutePath(filename));
@@ -210,6 +278,8 @@ bool CFileSystem::moveFileArchive(u32 sourceIndex, s32 relative)
 		FileArchives[s] = t;
 		r = true;
 	}
+	if (r)
+		updateFileIndex();
 	return r;
 }
 
@@ -220,6 +290,8 @@ bool CFileSystem::addFileArchive(const io::path& filename, bool ignoreCase,
 			  const core::stringc& password,
 			  IFileArchive** retArchive)
 {
+	IRR_PROFILE(CProfileScope p1(EPID_FS_ADD_ARCHIVE);)
+
 	IFileArchive* archive = 0;
 	bool ret = false;
 
@@ -307,6 +379,7 @@ bool CFileSystem::addFileArchive(const io::path& filename, bool ignoreCase,
 	if (archive)
 	{
 		FileArchives.push_back(archive);
+		updateFileIndex();
 		if (password.size())
 			archive->Password=password;
 		if (retArchive)
@@ -352,6 +425,8 @@ bool CFileSystem::addFileArchive(IReadFile* file, bool ignoreCase,
 	if (!file || archiveType == EFAT_FOLDER)
 		return false;
 
+	IRR_PROFILE(CProfileScope p1(EPID_FS_ADD_ARCHIVE);)
+
 	if (file)
 	{
 		if (changeArchivePassword(file->getFileName(), password, retArchive))
@@ -412,6 +487,7 @@ bool CFileSystem::addFileArchive(IReadFile* file, bool ignoreCase,
 		if (archive)
 		{
 			FileArchives.push_back(archive);
+			updateFileIndex();
 			if (password.size())
 				archive->Password=password;
 			if (retArchive)
@@ -441,6 +517,7 @@ bool CFileSystem::addFileArchive(IFileArchive* archive)
 			}
 		}
 		FileArchives.push_back(archive);
+		updateFileIndex();
 		archive->grab();
 
 		return true;
@@ -458,6 +535,7 @@ bool CFileSystem::removeFileArchive(u32 index)
 	{
 		FileArchives[index]->drop();
 		FileArchives.erase(index);
+		updateFileIndex();
 		ret = true;
 	}
 	return ret;
@@ -504,6 +582,149 @@ IFileArchive* CFileSystem::getFileArchive(u32 index)
 }
 
 
+//! Rebuilds the file index after archives were added, removed or moved
+void CFileSystem::updateFileIndex()
+{
+	// Only archives known to list all their files can answer from the index.
+	// Others, like the Android assets, open files which are not in their list.
+	u32 fileCount = 0;
+	FileIndexIgnorePaths = 0;
+	FileIndexArchives.set_used(FileArchives.size());
+	for (u32 i=0; i < FileArchives.size(); ++i)
+	{
+		u8 flags = 0;
+		switch (FileArchives[i]->getType())
+		{
+		case EFAT_ZIP:
+		case EFAT_GZIP:
+		case EFAT_TAR:
+		case EFAT_FOLDER:
+		{
+			const IFileList* list = FileArchives[i]->getFileList();
+			flags = EFIF_INDEXED;
+			if (list->isIgnorePaths())
+			{
+				flags |= EFIF_IGNORE_PATHS;
+				++FileIndexIgnorePaths;
+			}
+			fileCount += list->getFileCount();
+		}
+		break;
+		default:
+			break;
+		}
+		FileIndexArchives[i] = flags;
+	}
+
+	FileIndex.clear();
+	FileIndexBuckets.clear();
+	if (!fileCount)
+		return;
+
+	u32 bucketCount = 16;
+	while (bucketCount < fileCount)
+		bucketCount <<= 1;
+
+	FileIndexBuckets.set_used(bucketCount);
+	for (u32 i=0; i < bucketCount; ++i)
+		FileIndexBuckets[i] = 0;
+	FileIndex.reallocate(fileCount);
+
+	// Add the lowest priority archive first. Each entry becomes the head of its
+	// bucket, so every chain is sorted by archive index.
+	for (s32 i=(s32)FileArchives.size()-1; i >= 0; --i)
+	{
+		if (!(FileIndexArchives[i] & EFIF_INDEXED))
+			continue;
+
+		const IFileList* list = FileArchives[i]->getFileList();
+		for (u32 f=0; f < list->getFileCount(); ++f)
+		{
+			if (list->isDirectory(f))
+				continue;
+
+			SFileIndexEntry entry;
+			entry.Hash = fileIndexHash(list->getFullFileName(f).c_str());
+			entry.Archive = (u32)i;
+			entry.File = f;
+
+			u32& head = FileIndexBuckets[entry.Hash & (bucketCount-1)];
+			entry.Next = head;
+			FileIndex.push_back(entry);
+			head = FileIndex.size();
+		}
+	}
+}
+
+
+//! Searches a file in all indexed archives
+u32 CFileSystem::findIndexedFile(const io::path& filename, u32& fileIndex) const
+{
+	u32 found = FileArchives.size();
+	if (FileIndex.empty())
+		return found;
+
+	// same separators as in the file lists
+	io::path normalized;
+	const fschar_t* name = filename.c_str();
+	if (filename.findFirst('\\') >= 0)
+	{
+		normalized = filename;
+		normalized.replace('\\', '/');
+		name = normalized.c_str();
+	}
+
+	const u32 mask = FileIndexBuckets.size() - 1;
+
+	// The full name, then the name without path for archives ignoring paths
+	for (u32 pass=0; pass < 2; ++pass)
+	{
+		const fschar_t* key = name;
+		if (pass == 1)
+		{
+			if (!FileIndexIgnorePaths)
+				break;
+
+			// like core::deletePathFromFilename
+			const fschar_t* slash = name;
+			for (const fschar_t* c = name; *c; ++c)
+			{
+				if (*c == '/')
+					slash = c;
+			}
+			if (slash != name)
+				key = slash + 1;
+		}
+
+		const u8 pathFlag = pass ? EFIF_IGNORE_PATHS : 0;
+		const u32 hash = fileIndexHash(key);
+
+		for (u32 e = FileIndexBuckets[hash & mask]; e; e = FileIndex[e-1].Next)
+		{
+			const SFileIndexEntry& entry = FileIndex[e-1];
+
+			// the rest of the chain is in archives with lower priority
+			if (entry.Archive >= found)
+				break;
+
+			const u8 flags = FileIndexArchives[entry.Archive];
+			if (entry.Hash != hash || (flags & EFIF_IGNORE_PATHS) != pathFlag)
+				continue;
+
+			const io::path& listName = FileArchives[entry.Archive]->getFileList()->getFullFileName(entry.File);
+			if (fileIndexNameEquals(listName, key))
+			{
+				found = entry.Archive;
+				fileIndex = entry.File;
+				break;
+			}
+		}
+	}
+
+	return found;
+}
+
+
 //! Returns the string of the current working directory
 const io::path& CFileSystem::getWorkingDirectory()
 {
@@ -1073,9 +1294,23 @@ IFileList* CFileSystem::createEmptyFileList(const io::path& path, bool ignoreCas
 //! determines if a file exists and would be able to be opened.
 bool CFileSystem::existFile(const io::path& filename) const
 {
+	// directories are not in the index
+	const fschar_t last = filename.lastChar();
+	const bool isDirectory = last == '/' || last == '\\';
+
+	u32 fileIndex = 0;
+	const u32 found = isDirectory ? FileArchives.size() : findIndexedFile(filename, fileIndex);
+	if (found < FileArchives.size())
+		return true;
+
 	for (u32 i=0; i < FileArchives.size(); ++i)
+	{
+		if (!isDirectory && (FileIndexArchives[i] & EFIF_INDEXED))
+			continue;
+
 		if (FileArchives[i]->getFileList()->findFile(filename)!=-1)
 			return true;
+	}
 
 #if defined(_MSC_VER)
 	#if defined(_IRR_WCHAR_FILESYSTEM)
@@ -166,6 +166,39 @@ private:
 			const core::stringc& password,
 			IFileArchive** archive = 0);
 
+	//! Rebuilds the file index after archives were added, removed or moved
+	/** Called by the functions changing the archives, so lookups only read the index. */
+	void updateFileIndex();
+
+	//! Searches a file in all indexed archives
+	/** \param filename Name of the file, not of a directory
+	\param fileIndex Receives the index of the file in the archive's file list
+	\return Index of the archive with the highest priority containing
+	the file, or FileArchives.size() if no indexed archive has it. */
+	u32 findIndexedFile(const io::path& filename, u32& fileIndex) const;
+
+	//! Flags of the archives in the file index
+	enum E_FILE_INDEX_FLAGS
+	{
+		//! The archive's file list is complete and in the index
+		EFIF_INDEXED = 1,
+		//! The names in the archive's file list have no path
+		EFIF_IGNORE_PATHS = 2
+	};
+
+	//! A file in the index of all mounted archives
+	struct SFileIndexEntry
+	{
+		//! Case folded hash of the name in the archive's file list
+		u32 Hash;
+		//! Next entry in the same bucket plus one, 0 ends the chain
+		u32 Next;
+		//! Index of the archive in FileArchives
+		u32 Archive;
+		//! Index of the file in the archive's file list
+		u32 File;
+	};
+
 	//! Currently used FileSystemType
 	EFileSystemType FileSystemType;
 	//! WorkingDirectory for Native and Virtual filesystems
@@ -174,6 +207,15 @@ private:
 	core::array<IArchiveLoader*> ArchiveLoader;
 	//! currently attached Archives
 	core::array<IFileArchive*> FileArchives;
+
+	//! Files of all indexed archives, chains ordered by archive priority
+	core::array<SFileIndexEntry> FileIndex;
+	//! First entry of each hash bucket plus one, power of two sized
+	core::array<u32> FileIndexBuckets;
+	//! E_FILE_INDEX_FLAGS for each entry in FileArchives
+	core::array<u8> FileIndexArchives;
+	//! Indexed archives which were created with ignorePaths
+	u32 FileIndexIgnorePaths;
 };
 
 
@@ -171,7 +171,9 @@ void CGUIEditBox::updateAbsolutePosition()
 	if ( oldAbsoluteRect != AbsoluteRect )
 	{
 		calculateFrameRect();
-		breakText();
+		// line breaks only depend on the width and only when wrapping words
+		if (WordWrap && oldAbsoluteRect.getWidth() != AbsoluteRect.getWidth())
+			breakText();
 		calculateScrollPos();
 	}
 }
@@ -207,7 +209,8 @@ void CGUIEditBox::setPasswordBox(bool passwordBox, wchar_t passwordChar)
 		PasswordChar = passwordChar;
 		setMultiLine(false);
 		setWordWrap(false);
-		BrokenText.clear();
+		BrokenTextPositions.clear();
+		BrokenTextLengths.clear();
 	}
 }
 
@@ -274,6 +277,11 @@ bool CGUIEditBox::processKey(const SEvent& event)
 	s32 newMarkBegin = MarkBegin;
 	s32 newMarkEnd = MarkEnd;
 
+	// changed range of the text, to break only the affected lines again
+	const s32 oldTextSize = Text.size();
+	s32 editPos = CursorPos;
+	s32 editRemoved = 0;
+
 	// control shortcut handling
 
 	if (event.KeyInput.Control)
@@ -325,6 +333,8 @@ bool CGUIEditBox::processKey(const SEvent& event)
 					Text = s;
 
 					CursorPos = realmbgn;
+					editPos = realmbgn;
+					editRemoved = realmend - realmbgn;
 					newMarkBegin = 0;
 					newMarkEnd = 0;
 					textChanged = true;
@@ -365,6 +375,8 @@ bool CGUIEditBox::processKey(const SEvent& event)
 					else
 					{
 						// replace text
+						editPos = realmbgn;
+						editRemoved = realmend - realmbgn;
 
 						core::stringw s = Text.subString(0, realmbgn);
 						s.append(widep);
@@ -429,7 +441,7 @@ bool CGUIEditBox::processKey(const SEvent& event)
 				if (WordWrap || MultiLine)
 				{
 					p = getLineFromPos(CursorPos);
-					p = BrokenTextPositions[p] + (s32)BrokenText[p].size();
+					p = BrokenTextPositions[p] + BrokenTextLengths[p];
 					if (p > 0 && (Text[p-1] == L'\r' || Text[p-1] == L'\n' ))
 						p-=1;
 				}
@@ -518,15 +530,15 @@ bool CGUIEditBox::processKey(const SEvent& event)
 			BlinkStartTime = os::Timer::getTime();
 			break;
 		case KEY_UP:
-			if (MultiLine || (WordWrap && BrokenText.size() > 1) )
+			if (MultiLine || (WordWrap && BrokenTextPositions.size() > 1) )
 			{
 				s32 lineNo = getLineFromPos(CursorPos);
 				s32 mb = (MarkBegin == MarkEnd) ? CursorPos : (MarkBegin > MarkEnd ? MarkBegin : MarkEnd);
 				if (lineNo > 0)
 				{
 					s32 cp = CursorPos - BrokenTextPositions[lineNo];
-					if ((s32)BrokenText[lineNo-1].size() < cp)
-						CursorPos = BrokenTextPositions[lineNo-1] + core::max_((u32)1, BrokenText[lineNo-1].size())-1;
+					if (BrokenTextLengths[lineNo-1] < cp)
+						CursorPos = BrokenTextPositions[lineNo-1] + core::max_(1, BrokenTextLengths[lineNo-1])-1;
 					else
 						CursorPos = BrokenTextPositions[lineNo-1] + cp;
 				}
@@ -549,15 +561,15 @@ bool CGUIEditBox::processKey(const SEvent& event)
 			}
 			break;
 		case KEY_DOWN:
-			if (MultiLine || (WordWrap && BrokenText.size() > 1) )
+			if (MultiLine || (WordWrap && BrokenTextPositions.size() > 1) )
 			{
 				s32 lineNo = getLineFromPos(CursorPos);
 				s32 mb = (MarkBegin == MarkEnd) ? CursorPos : (MarkBegin < MarkEnd ? MarkBegin : MarkEnd);
-				if (lineNo < (s32)BrokenText.size()-1)
+				if (lineNo < (s32)BrokenTextPositions.size()-1)
 				{
 					s32 cp = CursorPos - BrokenTextPositions[lineNo];
-					if ((s32)BrokenText[lineNo+1].size() < cp)
-						CursorPos = BrokenTextPositions[lineNo+1] + core::max_((u32)1, BrokenText[lineNo+1].size())-1;
+					if (BrokenTextLengths[lineNo+1] < cp)
+						CursorPos = BrokenTextPositions[lineNo+1] + core::max_(1, BrokenTextLengths[lineNo+1])-1;
 					else
 						CursorPos = BrokenTextPositions[lineNo+1] + cp;
 				}
@@ -592,6 +604,8 @@ bool CGUIEditBox::processKey(const SEvent& event)
 			if (keyDelete())
 			{
 				BlinkStartTime = os::Timer::getTime();
+				editPos = CursorPos;
+				editRemoved = oldTextSize - (s32)Text.size();
 				newMarkBegin = 0;
 				newMarkEnd = 0;
 				textChanged = true;
@@ -653,6 +667,8 @@ bool CGUIEditBox::processKey(const SEvent& event)
 				if (CursorPos < 0)
 					CursorPos = 0;
 				BlinkStartTime = os::Timer::getTime();
+				editPos = CursorPos;
+				editRemoved = oldTextSize - (s32)Text.size();
 				newMarkBegin = 0;
 				newMarkEnd = 0;
 				textChanged = true;
@@ -672,6 +688,8 @@ bool CGUIEditBox::processKey(const SEvent& event)
 				if (keyDelete())
 				{
 					BlinkStartTime = os::Timer::getTime();
+					editPos = CursorPos;
+					editRemoved = oldTextSize - (s32)Text.size();
 					newMarkBegin = 0;
 					newMarkEnd = 0;
 					textChanged = true;
@@ -726,7 +744,7 @@ bool CGUIEditBox::processKey(const SEvent& event)
 	// break the text if it has changed
 	if (textChanged)
 	{
-		breakText();
+		updateBrokenText(editPos, editRemoved, (s32)Text.size() - oldTextSize + editRemoved);
 		calculateScrollPos();
 		sendGuiEvent(EGET_EDITBOX_CHANGED);
 	}
@@ -824,7 +842,7 @@ void CGUIEditBox::draw()
 		core::stringw *txtLine = &Text;
 		s32 startPos = 0;
 
-		core::stringw s, s2;
+		core::stringw s, s2, lineText;
 
 		// get mark position
 		const bool ml = (!PasswordBox && (WordWrap || MultiLine));
@@ -832,7 +850,22 @@ void CGUIEditBox::draw()
 		const s32 realmend = MarkBegin < MarkEnd ? MarkEnd : MarkBegin;
 		const s32 hlineStart = ml ? getLineFromPos(realmbgn) : 0;
 		const s32 hlineCount = ml ? getLineFromPos(realmend) - hlineStart + 1 : 1;
-		const s32 lineCount = ml ? BrokenText.size() : 1;
+		const s32 lineCount = ml ? BrokenTextPositions.size() : 1;
+
+		// only lines inside the clipping area are drawn, so the costs don't
+		// grow with the amount of text
+		s32 firstLine = 0;
+		s32 lastLine = lineCount;
+		if (ml && lineCount > 1)
+		{
+			setTextRect(0);
+			const s32 lineHeight = CurrentTextRect.getHeight();
+			if (lineHeight > 0)
+			{
+				firstLine = core::max_(0, (localClipRect.UpperLeftCorner.Y - CurrentTextRect.UpperLeftCorner.Y) / lineHeight - 1);
+				lastLine = core::min_(lineCount, (localClipRect.LowerRightCorner.Y - CurrentTextRect.UpperLeftCorner.Y) / lineHeight + 2);
+			}
+		}
 
 		// Save the override color information.
 		// Then, alter it if the edit box is disabled.
@@ -847,7 +880,7 @@ void CGUIEditBox::draw()
 				OverrideColor = skin->getColor(EGDC_GRAY_TEXT);
 			}
 
-			for (s32 i=0; i < lineCount; ++i)
+			for (s32 i=firstLine; i < lastLine; ++i)
 			{
 				setTextRect(i);
 
@@ -860,26 +893,27 @@ void CGUIEditBox::draw()
 				// get current line
 				if (PasswordBox)
 				{
-					if (BrokenText.size() != 1)
+					if (lineText.size() != Text.size())
 					{
-						BrokenText.clear();
-						BrokenText.push_back(core::stringw());
-					}
-					if (BrokenText[0].size() != Text.size())
-					{
-						BrokenText[0] = Text;
+						lineText = Text;
 						for (u32 q = 0; q < Text.size(); ++q)
 						{
-							BrokenText[0] [q] = PasswordChar;
+							lineText[q] = PasswordChar;
 						}
 					}
-					txtLine = &BrokenText[0];
+					txtLine = &lineText;
 					startPos = 0;
 				}
+				else if (ml)
+				{
+					lineText = getLineText(i);
+					txtLine = &lineText;
+					startPos = BrokenTextPositions[i];
+				}
 				else
 				{
-					txtLine = ml ? &BrokenText[i] : &Text;
-					startPos = ml ? BrokenTextPositions[i] : 0;
+					txtLine = &Text;
+					startPos = 0;
 				}
 
 
@@ -946,7 +980,8 @@ void CGUIEditBox::draw()
 			if (WordWrap || MultiLine)
 			{
 				cursorLine = getLineFromPos(CursorPos);
-				txtLine = &BrokenText[cursorLine];
+				lineText = getLineText(cursorLine);
+				txtLine = &lineText;
 				startPos = BrokenTextPositions[cursorLine];
 			}
 			s = txtLine->subString(0,CursorPos-startPos);
@@ -1022,7 +1057,7 @@ core::dimension2du CGUIEditBox::getTextDimension()
 	setTextRect(0);
 	ret = CurrentTextRect;
 
-	for (u32 i=1; i < BrokenText.size(); ++i)
+	for (u32 i=1; i < BrokenTextPositions.size(); ++i)
 	{
 		setTextRect(i);
 		ret.addInternalPoint(CurrentTextRect.UpperLeftCorner);
@@ -1148,36 +1183,32 @@ s32 CGUIEditBox::getCursorPos(s32 x, s32 y)
 {
 	IGUIFont* font = getActiveFont();
 
-	const u32 lineCount = (WordWrap || MultiLine) ? BrokenText.size() : 1;
+	const bool ml = WordWrap || MultiLine;
+	const s32 lineCount = ml ? BrokenTextPositions.size() : 1;
+	if (lineCount == 0)
+		return 0;
 
-	core::stringw *txtLine=0;
-	s32 startPos=0;
 	x+=3;
 
-	for (u32 i=0; i < lineCount; ++i)
+	// all lines have the same height, so the clicked line can be calculated
+	// instead of testing the area of each line
+	s32 line = 0;
+	if (lineCount > 1)
 	{
-		setTextRect(i);
-		if (i == 0 && y < CurrentTextRect.UpperLeftCorner.Y)
-			y = CurrentTextRect.UpperLeftCorner.Y;
-		if (i == lineCount - 1 && y > CurrentTextRect.LowerRightCorner.Y )
-			y = CurrentTextRect.LowerRightCorner.Y;
-
-		// is it inside this region?
-		if (y >= CurrentTextRect.UpperLeftCorner.Y && y <= CurrentTextRect.LowerRightCorner.Y)
-		{
-			// we've found the clicked line
-			txtLine = (WordWrap || MultiLine) ? &BrokenText[i] : &Text;
-			startPos = (WordWrap || MultiLine) ? BrokenTextPositions[i] : 0;
-			break;
-		}
+		setTextRect(0);
+		const s32 lineHeight = CurrentTextRect.getHeight();
+		if (lineHeight > 0)
+			line = core::clamp((y - CurrentTextRect.UpperLeftCorner.Y) / lineHeight, 0, lineCount - 1);
 	}
+	setTextRect(line);
+
+	const core::stringw lineText = ml ? getLineText(line) : core::stringw();
+	const core::stringw *txtLine = ml ? &lineText : &Text;
+	const s32 startPos = ml ? BrokenTextPositions[line] : 0;
 
 	if (x < CurrentTextRect.UpperLeftCorner.X)
 		x = CurrentTextRect.UpperLeftCorner.X;
 
-	if ( !txtLine )
-		return 0;
-
 	s32 idx = font->getCharacterFromPos(txtLine->c_str(), x - CurrentTextRect.UpperLeftCorner.X);
 
 	// click was on or left of the line
@@ -1195,8 +1226,8 @@ void CGUIEditBox::breakText()
 	if ((!WordWrap && !MultiLine))
 		return;
 
-	BrokenText.clear(); // need to reallocate :/
 	BrokenTextPositions.set_used(0);
+	BrokenTextLengths.set_used(0);
 
 	IGUIFont* font = getActiveFont();
 	if (!font)
@@ -1204,16 +1235,121 @@ void CGUIEditBox::breakText()
 
 	LastBreakFont = font;
 
-	core::stringw line;
+	s32 end = Text.size();
+	breakTextRange(font, 0, end, BrokenTextPositions, BrokenTextLengths);
+}
+
+
+//! Breaks the text again around an edited range.
+void CGUIEditBox::updateBrokenText(s32 pos, s32 removed, s32 inserted)
+{
+	if (!WordWrap && !MultiLine)
+		return;
+
+	// Without line breaks the whole text is one paragraph in which an edit
+	// can move all following words.
+	IGUIFont* font = getActiveFont();
+	if (!MultiLine || !font || font != LastBreakFont || BrokenTextPositions.empty())
+	{
+		breakText();
+		return;
+	}
+
+	const s32 size = Text.size();
+	const s32 oldSize = size - inserted + removed;
+
+	// Words never wrap over a line break, so start at the first line of
+	// the paragraph containing the edit. Characters in front of pos are
+	// unchanged, so the old line positions are still valid there.
+	s32 firstLine = getLineFromPos(pos);
+	while (firstLine > 0)
+	{
+		const s32 p = BrokenTextPositions[firstLine];
+		const wchar_t c = Text[p-1];
+		if ((c == L'\r' && (p >= size || Text[p] != L'\n')) || c == L'\n')
+			break;
+		--firstLine;
+	}
+
+	// and end behind the line break of the paragraph containing the end of the edit
+	s32 end = core::min_(pos + inserted, size);
+	while (end < size && Text[end] != L'\r' && Text[end] != L'\n')
+		++end;
+	if (end < size)
+	{
+		if (Text[end] == L'\r' && end+1 < size && Text[end+1] == L'\n')
+			++end;
+		++end;
+	}
+
+	// the old lines to replace, all following lines are kept
+	s32 nextLine = BrokenTextPositions.size();
+	if (end < size)
+	{
+		const s32 oldEnd = end - inserted + removed;
+		nextLine = getLineFromPos(oldEnd);
+		if (nextLine <= firstLine || BrokenTextPositions[nextLine] != oldEnd)
+		{
+			// line index doesn't match the text anymore
+			breakText();
+			return;
+		}
+	}
+
+	core::array<s32> positions;
+	core::array<s32> lengths;
+	breakTextRange(font, BrokenTextPositions[firstLine], end, positions, lengths);
+
+	// replace the lines and move the following ones
+	const s32 shift = (s32)Text.size() - oldSize;
+	const s32 oldCount = nextLine - firstLine;
+	const s32 newCount = positions.size();
+	const s32 tailCount = (s32)BrokenTextPositions.size() - nextLine;
+	const s32 lineCount = firstLine + newCount + tailCount;
+
+	if (newCount > oldCount)
+	{
+		BrokenTextPositions.set_used(lineCount);
+		BrokenTextLengths.set_used(lineCount);
+		for (s32 i=tailCount-1; i >= 0; --i)
+		{
+			BrokenTextPositions[firstLine+newCount+i] = BrokenTextPositions[nextLine+i] + shift;
+			BrokenTextLengths[firstLine+newCount+i] = BrokenTextLengths[nextLine+i];
+		}
+	}
+	else if (newCount < oldCount || shift != 0)
+	{
+		for (s32 i=0; i < tailCount; ++i)
+		{
+			BrokenTextPositions[firstLine+newCount+i] = BrokenTextPositions[nextLine+i] + shift;
+			BrokenTextLengths[firstLine+newCount+i] = BrokenTextLengths[nextLine+i];
+		}
+		BrokenTextPositions.set_used(lineCount);
+		BrokenTextLengths.set_used(lineCount);
+	}
+
+	for (s32 i=0; i < newCount; ++i)
+	{
+		BrokenTextPositions[firstLine+i] = positions[i];
+		BrokenTextLengths[firstLine+i] = lengths[i];
+	}
+}
+
+
+//! Breaks the text from begin to end and appends the lines found.
+void CGUIEditBox::breakTextRange(IGUIFont* font, s32 begin, s32& end,
+	core::array<s32>& positions, core::array<s32>& lengths)
+{
 	core::stringw word;
 	core::stringw whitespace;
-	s32 lastLineStart = 0;
+	s32 lastLineStart = begin;
+	s32 lineLength = 0;
 	s32 size = Text.size();
 	s32 length = 0;
 	s32 elWidth = RelativeRect.getWidth() - 6;
 	wchar_t c;
 
-	for (s32 i=0; i<size; ++i)
+	for (s32 i=begin; i<end; ++i)
 	{
 		c = Text[i];
 		bool lineBreak = false;
@@ -1229,6 +1365,7 @@ void CGUIEditBox::breakText()
 				// branch as users might already expect this behavior).
 				Text.erase(i+1);
 				--size;
+				--end;
 				if ( CursorPos > i )
 					--CursorPos;
 			}
@@ -1251,20 +1388,19 @@ void CGUIEditBox::breakText()
 			s32 whitelgth = font->getDimension(whitespace.c_str()).Width;
 			s32 worldlgth = font->getDimension(word.c_str()).Width;
 
-			if (WordWrap && length + worldlgth + whitelgth > elWidth && line.size() > 0)
+			if (WordWrap && length + worldlgth + whitelgth > elWidth && lineLength > 0)
 			{
 				// break to next line
 				length = worldlgth;
-				BrokenText.push_back(line);
-				BrokenTextPositions.push_back(lastLineStart);
+				positions.push_back(lastLineStart);
+				lengths.push_back(lineLength);
 				lastLineStart = i - (s32)word.size();
-				line = word;
+				lineLength = word.size();
 			}
 			else
 			{
 				// add word to line
-				line += whitespace;
-				line += word;
+				lineLength += whitespace.size() + word.size();
 				length += whitelgth + worldlgth;
 			}
 
@@ -1278,14 +1414,10 @@ void CGUIEditBox::breakText()
 			// compute line break
 			if (lineBreak)
 			{
-				line += whitespace;
-				line += word;
-				BrokenText.push_back(line);
-				BrokenTextPositions.push_back(lastLineStart);
+				positions.push_back(lastLineStart);
+				lengths.push_back(lineLength);
 				lastLineStart = i+1;
-				line = L"";
-				word = L"";
-				whitespace = L"";
+				lineLength = 0;
 				length = 0;
 			}
 		}
@@ -1296,10 +1428,20 @@ void CGUIEditBox::breakText()
 		}
 	}
 
-	line += whitespace;
-	line += word;
-	BrokenText.push_back(line);
-	BrokenTextPositions.push_back(lastLineStart);
+	// the last line of the text is added even when it's empty
+	if (end == size)
+	{
+		lineLength += whitespace.size() + word.size();
+		positions.push_back(lastLineStart);
+		lengths.push_back(lineLength);
+	}
+}
+
+
+//! returns the text of the given broken line
+core::stringw CGUIEditBox::getLineText(s32 line) const
+{
+	return Text.subString(BrokenTextPositions[line], BrokenTextLengths[line]);
 }
 
 // TODO: that function does interpret VAlign according to line-index (indexed line is placed on top-center-bottom)
@@ -1318,10 +1460,10 @@ void CGUIEditBox::setTextRect(s32 line)
 	core::dimension2du d;
 
 	// get text dimension
-	const u32 lineCount = (WordWrap || MultiLine) ? BrokenText.size() : 1;
+	const u32 lineCount = (WordWrap || MultiLine) ? BrokenTextPositions.size() : 1;
 	if (WordWrap || MultiLine)
 	{
-		d = font->getDimension(BrokenText[line].c_str());
+		d = font->getDimension(getLineText(line).c_str());
 	}
 	else
 	{
@@ -1383,14 +1525,18 @@ s32 CGUIEditBox::getLineFromPos(s32 pos)
 	if (!WordWrap && !MultiLine)
 		return 0;
 
-	s32 i=0;
-	while (i < (s32)BrokenTextPositions.size())
+	// binary search for the first line starting behind pos
+	s32 low = 0;
+	s32 high = BrokenTextPositions.size();
+	while (low < high)
 	{
-		if (BrokenTextPositions[i] > pos)
-			return i-1;
-		++i;
+		const s32 mid = (low + high) / 2;
+		if (BrokenTextPositions[mid] > pos)
+			high = mid;
+		else
+			low = mid + 1;
 	}
-	return (s32)BrokenTextPositions.size() - 1;
+	return low - 1;
 }
 
 
@@ -1410,6 +1556,11 @@ void CGUIEditBox::inputString(const core::stringw &str)
 	core::stringw s;
 	u32 len = str.size();
 
+	// changed range of the text, to break only the affected lines again
+	const s32 oldTextSize = Text.size();
+	s32 editPos = CursorPos;
+	s32 editRemoved = 0;
+
 	if (MarkBegin != MarkEnd)
 	{
 		// replace marked text
@@ -1421,6 +1572,8 @@ void CGUIEditBox::inputString(const core::stringw &str)
 		s.append( Text.subString(realmend, Text.size()-realmend) );
 		Text = s;
 		CursorPos = realmbgn+len;
+		editPos = realmbgn;
+		editRemoved = realmend - realmbgn;
 	}
 	else if ( OverwriteMode )
 	{
@@ -1447,11 +1600,13 @@ void CGUIEditBox::inputString(const core::stringw &str)
 					//just keep appending to the current line
 					//This follows the behavior of other gui libraries behaviors
 					s.append( Text.subString(EOLPos, Text.size()-EOLPos) );
+					editRemoved = EOLPos - CursorPos;
 				}
 				else
 				{
 					//replace the next character
 					s.append( Text.subString(CursorPos + len,Text.size() - CursorPos - len));
+					editRemoved = len;
 				}
 				Text = s;
 				CursorPos+=len;
@@ -1463,6 +1618,7 @@ void CGUIEditBox::inputString(const core::stringw &str)
 			s = Text.subString(0, CursorPos);
 			s.append(str);
 			s.append( Text.subString(CursorPos+len, Text.size()-CursorPos-len) );
+			editRemoved = oldTextSize - CursorPos;
 			Text = s;
 			CursorPos+=len;
 		}
@@ -1480,7 +1636,7 @@ void CGUIEditBox::inputString(const core::stringw &str)
 	BlinkStartTime = os::Timer::getTime();
 	setTextMarkers(0, 0);
 
-	breakText();
+	updateBrokenText(editPos, editRemoved, (s32)Text.size() - oldTextSize + editRemoved);
 	calculateScrollPos();
 	sendGuiEvent(EGET_EDITBOX_CHANGED);
 }
@@ -1507,7 +1663,8 @@ void CGUIEditBox::calculateScrollPos()
 		// get cursor position
 		// get cursor area
 		irr::u32 cursorWidth = font->getDimension(CursorChar.c_str()).Width;
-		core::stringw *txtLine = hasBrokenText ? &BrokenText[cursLine] : &Text;
+		const core::stringw lineText = hasBrokenText ? getLineText(cursLine) : core::stringw();
+		const core::stringw *txtLine = hasBrokenText ? &lineText : &Text;
 		s32 cPos = hasBrokenText ? CursorPos - BrokenTextPositions[cursLine] : CursorPos;	// column
 		s32 cStart = font->getDimension(txtLine->subString(0, cPos).c_str()).Width;		// pixels from text-start
 		s32 cEnd = cStart + cursorWidth;
@@ -152,6 +152,21 @@ namespace gui
 	protected:
 		//! Breaks the single text line.
 		void breakText();
+		//! Breaks the text again around an edited range.
+		/** Only the paragraphs touched by the edit are broken again, the
+		positions of all following lines are just moved.
+		\param pos First changed character.
+		\param removed Amount of characters removed at pos from the old text.
+		\param inserted Amount of characters inserted at pos into the new text. */
+		void updateBrokenText(s32 pos, s32 removed, s32 inserted);
+		//! Breaks the text from begin to end and appends the lines found.
+		/** The range must start at the beginning of a line and either end
+		behind a line break or at the end of the text. Windows line breaks
+		are converted, so end is updated accordingly. */
+		void breakTextRange(IGUIFont* font, s32 begin, s32& end,
+			core::array<s32>& positions, core::array<s32>& lengths);
+		//! returns the text of the given broken line
+		core::stringw getLineText(s32 line) const;
 		//! sets the area of the given line
 		void setTextRect(s32 line);
 		//! returns the line number that the cursor is on
@@ -198,8 +213,8 @@ namespace gui
 		wchar_t PasswordChar;
 		EGUI_ALIGNMENT HAlign, VAlign;
 
-		core::array< core::stringw > BrokenText;
 		core::array< s32 > BrokenTextPositions;
+		core::array< s32 > BrokenTextLengths;
 
 		core::rect<s32> CurrentTextRect, FrameRect; // temporary values
 	};
@@ -435,7 +435,7 @@ u32 CGUIFont::getSpriteNoFromChar(const wchar_t *c) const
 
 s32 CGUIFont::getAreaFromCharacter(const wchar_t c) const
 {
-	core::map<wchar_t, s32>::Node* n = CharacterMap.find(c);
+	const core::hash_map<wchar_t, s32>::Node* n = CharacterMap.find(c);
 	if (n)
 		return n->getValue();
 	else
@@ -518,8 +518,12 @@ void CGUIFont::draw(const core::stringw& text, const core::rect<s32>& position,
 			return;
 	}
 
-	core::array<u32> indices(text.size());
-	core::array<core::position2di> offsets(text.size());
+	// one sprite per character at most, taken from the frame's scratch memory
+	core::array<u32> indices;
+	core::array<core::position2di> offsets;
+	core::frame_arena* arena = Driver->getFrameArena();
+	arena->bind(indices, text.size());
+	arena->bind(offsets, text.size());
 
 	for(u32 i = 0;i < text.size();i++)
 	{
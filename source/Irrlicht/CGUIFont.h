@@ -10,7 +10,7 @@
 
 #include "IGUIFontBitmap.h"
 #include "irrString.h"
-#include "irrMap.h"
+#include "irrHashMap.h"
 #include "IReadFile.h"
 #include "irrArray.h"
 
@@ -97,7 +97,7 @@ private:
 	void popTextureCreationFlags(const bool(&flags)[3]);
 
 	core::array<SFontArea>		Areas;
-	core::map<wchar_t, s32>		CharacterMap;
+	core::hash_map<wchar_t, s32>	CharacterMap;
 	video::IVideoDriver*		Driver;
 	IGUISpriteBank*			SpriteBank;
 	IGUIEnvironment*		Environment;
@@ -187,14 +187,18 @@ void CGUISpriteBank::draw2DSpriteBatch(	const core::array<u32>& indices,
 {
 	const irr::u32 drawCount = core::min_<u32>(indices.size(), pos.size());
 
-	if (!getTextureCount())
+	if (!Driver || !getTextureCount())
 		return;
-	core::array<SDrawBatch> drawBatches(getTextureCount());
+	// the batches only live during this call, so they use the frame's scratch memory
+	core::frame_arena* arena = Driver->getFrameArena();
+	core::array<SDrawBatch, core::irrFrameAllocator<SDrawBatch> > drawBatches(
+		(core::irrFrameAllocator<SDrawBatch>(arena)));
+	drawBatches.reallocate(getTextureCount());
 	for (u32 i=0; i < Textures.size(); ++i)
 	{
 		drawBatches.push_back(SDrawBatch());
-		drawBatches[i].positions.reallocate(drawCount);
-		drawBatches[i].sourceRects.reallocate(drawCount);
+		arena->bind(drawBatches[i].positions, drawCount);
+		arena->bind(drawBatches[i].sourceRects, drawCount);
 	}
 
 	for (u32 i = 0; i < drawCount; ++i)
@@ -186,7 +186,7 @@ namespace gui
 
 		struct Cell
 		{
-			Cell() : IsOverrideColor(false), Data(0) {}
+			Cell() : IsOverrideColor(false), Color(0), Data(0) {}
 
 			core::stringw Text;
 			core::stringw BrokenText;
@@ -5,6 +5,8 @@
 #include "CImage.h"
 #include "irrString.h"
 #include "CColorConverter.h"
+#include "CImageResampler.h"
+#include "CImageCompressor.h"
 #include "CBlit.h"
 #include "os.h"
 #include "SoftwareDriver2_helper.h"
@@ -216,6 +218,23 @@ void CImage::copyToScaling(void* target, u32 width, u32 height, ECOLOR_FORMAT fo
 		}
 	}
 
+	if (Size.Width==width && Size.Height==height && CColorConverter::canConvertFormat(Format, format))
+	{
+		// only the color format changes, so whole scanlines are converted at once
+		u8* tgtpos = (u8*) target;
+		const u8* srcpos = Data;
+		const u32 bwidth = width*bpp;
+		for (u32 y=0; y<height; ++y)
+		{
+			CColorConverter::convert_viaFormat(srcpos, Format, width, tgtpos, format);
+			if (pitch > bwidth)
+				memset(tgtpos+bwidth, 0, pitch-bwidth);
+			tgtpos += pitch;
+			srcpos += Pitch;
+		}
+		return;
+	}
+
 	// NOTE: Scaling is coded to keep the border pixels intact.
 	// Alternatively we could for example work with first pixel being taken at half step-size.
 	// Then we have one more step here and it would be:
@@ -293,6 +312,10 @@ void CImage::copyToScalingBoxFilter(IImage* target, s32 bias, bool blend)
 		return;
 	}
 
+	// the plain average without bias is what the resampler's box filter does, row by row
+	if (bias == 0 && !blend && copyToResampled(target, EIF_BOX))
+		return;
+
 	const core::dimension2d<u32> destSize = target->getDimension();
 
 	const f32 sourceXStep = (f32) Size.Width / (f32) destSize.Width;
@@ -320,6 +343,50 @@ void CImage::copyToScalingBoxFilter(IImage* target, s32 bias, bool blend)
 }
 
 
+//! copies this surface into another, resampling it with a filter to fit
+bool CImage::copyToResampled(IImage* target, E_IMAGE_FILTER filter, u32 threadCount)
+{
+	if (!target)
+		return false;
+
+	return CImageResampler::resample(Data, Size, Pitch, Format,
+		target->getData(), target->getDimension(), target->getPitch(), target->getColorFormat(),
+		filter, threadCount);
+}
+
+
+//! replaces the mipmaps data with mipmaps created from the image
+bool CImage::createMipMaps(E_IMAGE_FILTER filter, u32 threadCount)
+{
+	if (!CImageResampler::canResample(Format))
+		return false;
+
+	u8* mipMaps = Allocator.allocate(CImageResampler::getMipMapsDataSize(Format, Size));
+	CImageResampler::createMipMaps(this, filter, mipMaps, threadCount);
+	setMipMapsData(mipMaps, true, true);
+	return true;
+}
+
+
+//! compresses the image into the blocks of the target
+bool CImage::copyToCompressed(IImage* target, u32 threadCount)
+{
+	if (!target || target->getDimension() != Size || !CImageCompressor::canCompress(target->getColorFormat()))
+		return false;
+
+	if (Format == ECF_A8R8G8B8)
+		return CImageCompressor::compress(Data, Size, Pitch, target->getColorFormat(), target->getData(), threadCount);
+
+	// the encoders read A8R8G8B8
+	if (!CColorConverter::canConvertFormat(Format, ECF_A8R8G8B8))
+		return false;
+
+	CImage converted(ECF_A8R8G8B8, Size);
+	copyTo(&converted);
+	return CImageCompressor::compress(converted.getData(), Size, converted.getPitch(), target->getColorFormat(), target->getData(), threadCount);
+}
+
+
 //! fills the surface with given color
 void CImage::fill(const SColor &color)
 {
@@ -55,6 +55,15 @@ public:
 	//! copies this surface into another, scaling it to fit, applying a box filter
 	virtual void copyToScalingBoxFilter(IImage* target, s32 bias = 0, bool blend = false) _IRR_OVERRIDE_;
 
+	//! copies this surface into another, resampling it with a filter to fit
+	virtual bool copyToResampled(IImage* target, E_IMAGE_FILTER filter = EIF_TRIANGLE, u32 threadCount = 1) _IRR_OVERRIDE_;
+
+	//! replaces the mipmaps data with mipmaps created from the image
+	virtual bool createMipMaps(E_IMAGE_FILTER filter = EIF_BOX, u32 threadCount = 1) _IRR_OVERRIDE_;
+
+	//! compresses the image into the blocks of the target
+	virtual bool copyToCompressed(IImage* target, u32 threadCount = 1) _IRR_OVERRIDE_;
+
 	//! fills the surface with given color
 	virtual void fill(const SColor &color) _IRR_OVERRIDE_;
 
@@ -0,0 +1,724 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CImageCompressor.h"
+#include "CImage.h"
+#include "CImageResampler.h"
+#include "CColorConverter.h"
+#include "irrArray.h"
+#include "irrMath.h"
+#include <thread>
+
+namespace irr
+{
+namespace video
+{
+
+namespace
+{
+	//! Block rows a thread gets at least, fewer aren't worth starting it
+	const u32 MIN_BLOCK_ROWS_PER_THREAD = 4;
+
+	//! Modifiers of the ETC1/ETC2 color tables, for the pixel indices 0 to 3
+	const s32 ETC_MODIFIERS[8][4] =
+	{
+		{ 2, 8, -2, -8 },
+		{ 5, 17, -5, -17 },
+		{ 9, 29, -9, -29 },
+		{ 13, 42, -13, -42 },
+		{ 18, 60, -18, -60 },
+		{ 24, 80, -24, -80 },
+		{ 33, 106, -33, -106 },
+		{ 47, 183, -47, -183 }
+	};
+
+	//! Modifiers of the EAC alpha tables, for the pixel indices 0 to 7
+	const s32 EAC_MODIFIERS[16][8] =
+	{
+		{ -3, -6, -9, -15, 2, 5, 8, 14 },
+		{ -3, -7, -10, -13, 2, 6, 9, 12 },
+		{ -2, -5, -8, -13, 1, 4, 7, 12 },
+		{ -2, -4, -6, -13, 1, 3, 5, 12 },
+		{ -3, -6, -8, -12, 2, 5, 7, 11 },
+		{ -3, -7, -9, -11, 2, 6, 8, 10 },
+		{ -4, -7, -8, -11, 3, 6, 7, 10 },
+		{ -3, -5, -8, -11, 2, 4, 7, 10 },
+		{ -2, -6, -8, -10, 1, 5, 7, 9 },
+		{ -2, -5, -8, -10, 1, 4, 7, 9 },
+		{ -2, -4, -8, -10, 1, 3, 7, 9 },
+		{ -2, -5, -7, -10, 1, 4, 6, 9 },
+		{ -3, -4, -7, -10, 2, 3, 6, 9 },
+		{ -1, -2, -3, -10, 0, 1, 2, 9 },
+		{ -4, -6, -8, -9, 3, 5, 7, 8 },
+		{ -3, -5, -7, -9, 2, 4, 6, 8 }
+	};
+
+	//! EAC table with a modifier of 0, for blocks of a single alpha value
+	const u32 EAC_CONSTANT_TABLE = 13;
+
+	//! A block of 4x4 pixels, row by row
+	struct SBlock
+	{
+		//! Red, green, blue and alpha of each pixel
+		s32 Pixels[16][4];
+	};
+
+	//! reads a block of A8R8G8B8 pixels, repeating the edge pixels outside of the image
+	void loadBlock(const u8* source, const core::dimension2du& size, u32 pitch, u32 bx, u32 by, SBlock& block)
+	{
+		for (u32 y = 0; y < 4; ++y)
+		{
+			const u32* row = reinterpret_cast<const u32*>(source + core::min_(by * 4 + y, size.Height - 1) * pitch);
+			for (u32 x = 0; x < 4; ++x)
+			{
+				const u32 c = row[core::min_(bx * 4 + x, size.Width - 1)];
+				s32* p = block.Pixels[y * 4 + x];
+				p[0] = (c >> 16) & 0xff;
+				p[1] = (c >> 8) & 0xff;
+				p[2] = c & 0xff;
+				p[3] = c >> 24;
+			}
+		}
+	}
+
+	s32 getColorDistance(const s32* a, const s32* b)
+	{
+		const s32 r = a[0] - b[0];
+		const s32 g = a[1] - b[1];
+		const s32 bl = a[2] - b[2];
+		return r * r + g * g + bl * bl;
+	}
+
+	u16 packR5G6B5(const f32* color)
+	{
+		const s32 r = core::clamp(core::round32(color[0] * 31.f / 255.f), 0, 31);
+		const s32 g = core::clamp(core::round32(color[1] * 63.f / 255.f), 0, 63);
+		const s32 b = core::clamp(core::round32(color[2] * 31.f / 255.f), 0, 31);
+		return (u16)((r << 11) | (g << 5) | b);
+	}
+
+	void unpackR5G6B5(u16 c, s32* color)
+	{
+		const s32 r = (c >> 11) & 0x1f;
+		const s32 g = (c >> 5) & 0x3f;
+		const s32 b = c & 0x1f;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	//! picks the nearest of the four BC1 colors for each pixel, returns the squared error
+	u32 findIndicesBC1(const SBlock& block, u16 c0, u16 c1, u32& indices)
+	{
+		s32 palette[4][3];
+		unpackR5G6B5(c0, palette[0]);
+		unpackR5G6B5(c1, palette[1]);
+		for (u32 c = 0; c < 3; ++c)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+
+		u32 error = 0;
+		indices = 0;
+		for (u32 i = 0; i < 16; ++i)
+		{
+			s32 best = getColorDistance(block.Pixels[i], palette[0]);
+			u32 index = 0;
+			for (u32 k = 1; k < 4; ++k)
+			{
+				const s32 d = getColorDistance(block.Pixels[i], palette[k]);
+				if (d < best)
+				{
+					best = d;
+					index = k;
+				}
+			}
+			indices |= index << (i * 2);
+			error += (u32)best;
+		}
+		return error;
+	}
+
+	//! fits the end points to the pixels by least squares, keeping the indices
+	bool refineEndPointsBC1(const SBlock& block, u32 indices, u16& c0, u16& c1)
+	{
+		// share of c0 in the color of each index
+		const f32 weights[4] = { 1.f, 0.f, 2.f / 3.f, 1.f / 3.f };
+
+		f32 aa = 0.f, bb = 0.f, ab = 0.f;
+		f32 ax[3] = { 0.f, 0.f, 0.f };
+		f32 bx[3] = { 0.f, 0.f, 0.f };
+		for (u32 i = 0; i < 16; ++i)
+		{
+			const f32 a = weights[(indices >> (i * 2)) & 3];
+			const f32 b = 1.f - a;
+			aa += a * a;
+			bb += b * b;
+			ab += a * b;
+			for (u32 c = 0; c < 3; ++c)
+			{
+				ax[c] += a * block.Pixels[i][c];
+				bx[c] += b * block.Pixels[i][c];
+			}
+		}
+
+		const f32 det = aa * bb - ab * ab;
+		if (core::iszero(det))
+			return false;
+
+		f32 e0[3], e1[3];
+		for (u32 c = 0; c < 3; ++c)
+		{
+			e0[c] = (ax[c] * bb - bx[c] * ab) / det;
+			e1[c] = (bx[c] * aa - ax[c] * ab) / det;
+		}
+		c0 = packR5G6B5(e0);
+		c1 = packR5G6B5(e1);
+		return true;
+	}
+
+	//! encodes the colors of a block into 8 bytes of BC1
+	void encodeColorBlockBC1(const SBlock& block, u8* out)
+	{
+		f32 mean[3] = { 0.f, 0.f, 0.f };
+		for (u32 i = 0; i < 16; ++i)
+			for (u32 c = 0; c < 3; ++c)
+				mean[c] += block.Pixels[i][c];
+		for (u32 c = 0; c < 3; ++c)
+			mean[c] /= 16.f;
+
+		// covariance, rr rg rb gg gb bb
+		f32 cov[6] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+		for (u32 i = 0; i < 16; ++i)
+		{
+			const f32 r = block.Pixels[i][0] - mean[0];
+			const f32 g = block.Pixels[i][1] - mean[1];
+			const f32 b = block.Pixels[i][2] - mean[2];
+			cov[0] += r * r;
+			cov[1] += r * g;
+			cov[2] += r * b;
+			cov[3] += g * g;
+			cov[4] += g * b;
+			cov[5] += b * b;
+		}
+
+		// the principal axis by power iteration, the end points are the extremes along it
+		f32 axis[3] = { cov[0] + cov[1] + cov[2], cov[1] + cov[3] + cov[4], cov[2] + cov[4] + cov[5] };
+		for (u32 k = 0; k < 4; ++k)
+		{
+			const f32 r = axis[0] * cov[0] + axis[1] * cov[1] + axis[2] * cov[2];
+			const f32 g = axis[0] * cov[1] + axis[1] * cov[3] + axis[2] * cov[4];
+			const f32 b = axis[0] * cov[2] + axis[1] * cov[4] + axis[2] * cov[5];
+			const f32 length = core::max_(fabsf(r), fabsf(g), fabsf(b));
+			if (length < 1e-6f)
+				break;
+			axis[0] = r / length;
+			axis[1] = g / length;
+			axis[2] = b / length;
+		}
+
+		u32 minPixel = 0, maxPixel = 0;
+		f32 minDot = FLT_MAX, maxDot = -FLT_MAX;
+		for (u32 i = 0; i < 16; ++i)
+		{
+			const f32 d = block.Pixels[i][0] * axis[0] + block.Pixels[i][1] * axis[1] + block.Pixels[i][2] * axis[2];
+			if (d < minDot)
+			{
+				minDot = d;
+				minPixel = i;
+			}
+			if (d > maxDot)
+			{
+				maxDot = d;
+				maxPixel = i;
+			}
+		}
+
+		f32 e0[3], e1[3];
+		for (u32 c = 0; c < 3; ++c)
+		{
+			e0[c] = (f32)block.Pixels[maxPixel][c];
+			e1[c] = (f32)block.Pixels[minPixel][c];
+		}
+
+		u16 c0 = packR5G6B5(e0);
+		u16 c1 = packR5G6B5(e1);
+		u32 indices;
+		u32 error = findIndicesBC1(block, c0, c1, indices);
+
+		for (u32 k = 0; k < 2 && error; ++k)
+		{
+			u16 r0, r1;
+			if (!refineEndPointsBC1(block, indices, r0, r1))
+				break;
+
+			u32 refinedIndices;
+			const u32 refinedError = findIndicesBC1(block, r0, r1, refinedIndices);
+			if (refinedError >= error)
+				break;
+
+			c0 = r0;
+			c1 = r1;
+			indices = refinedIndices;
+			error = refinedError;
+		}
+
+		// c0 > c1 selects the four color mode, c0 == c1 would be the mode with transparency
+		if (c0 < c1)
+		{
+			core::swap(c0, c1);
+			indices ^= 0x55555555;
+		}
+		else if (c0 == c1)
+		{
+			indices = 0;
+		}
+
+		out[0] = (u8)c0;
+		out[1] = (u8)(c0 >> 8);
+		out[2] = (u8)c1;
+		out[3] = (u8)(c1 >> 8);
+		out[4] = (u8)indices;
+		out[5] = (u8)(indices >> 8);
+		out[6] = (u8)(indices >> 16);
+		out[7] = (u8)(indices >> 24);
+	}
+
+	//! encodes the alpha values of a block into 8 bytes of BC3
+	void encodeAlphaBlockBC3(const SBlock& block, u8* out)
+	{
+		s32 minAlpha = 255, maxAlpha = 0;
+		for (u32 i = 0; i < 16; ++i)
+		{
+			minAlpha = core::min_(minAlpha, block.Pixels[i][3]);
+			maxAlpha = core::max_(maxAlpha, block.Pixels[i][3]);
+		}
+
+		// a0 > a1 selects the mode with six interpolated values
+		s32 palette[8];
+		palette[0] = maxAlpha;
+		palette[1] = minAlpha;
+		for (s32 k = 2; k < 8; ++k)
+			palette[k] = ((8 - k) * maxAlpha + (k - 1) * minAlpha) / 7;
+
+		u64 indices = 0;
+		if (maxAlpha != minAlpha)
+		{
+			for (u32 i = 0; i < 16; ++i)
+			{
+				const s32 a = block.Pixels[i][3];
+				s32 best = abs(a - palette[0]);
+				u64 index = 0;
+				for (u32 k = 1; k < 8; ++k)
+				{
+					const s32 d = abs(a - palette[k]);
+					if (d < best)
+					{
+						best = d;
+						index = k;
+					}
+				}
+				indices |= index << (i * 3);
+			}
+		}
+
+		out[0] = (u8)maxAlpha;
+		out[1] = (u8)minAlpha;
+		for (u32 k = 0; k < 6; ++k)
+			out[2 + k] = (u8)(indices >> (k * 8));
+	}
+
+	//! finds the best table and modifiers for the pixels of an ETC sub block
+	/** \param indices Receives the pixel index bits of the sub block.
+	\return Squared error of the sub block. */
+	u32 encodeSubBlockETC(const SBlock& block, const s32* base, bool flip, u32 half, u32& table, u32& indices)
+	{
+		u32 bestError = 0xffffffff;
+		for (u32 t = 0; t < 8; ++t)
+		{
+			s32 colors[4][3];
+			for (u32 k = 0; k < 4; ++k)
+				for (u32 c = 0; c < 3; ++c)
+					colors[k][c] = core::clamp(base[c] + ETC_MODIFIERS[t][k], 0, 255);
+
+			u32 error = 0;
+			u32 tableIndices = 0;
+			for (u32 j = 0; j < 8 && error < bestError; ++j)
+			{
+				// flipped sub blocks are 4x2 on top of each other, else 2x4 side by side
+				const u32 x = flip ? (j & 3) : half * 2 + (j & 1);
+				const u32 y = flip ? half * 2 + (j >> 2) : (j >> 1);
+				const s32* p = block.Pixels[y * 4 + x];
+
+				s32 best = getColorDistance(p, colors[0]);
+				u32 index = 0;
+				for (u32 k = 1; k < 4; ++k)
+				{
+					const s32 d = getColorDistance(p, colors[k]);
+					if (d < best)
+					{
+						best = d;
+						index = k;
+					}
+				}
+
+				// the pixels are numbered column by column, the index is split in two bit planes
+				const u32 i = x * 4 + y;
+				tableIndices |= ((index >> 1) << (16 + i)) | ((index & 1) << i);
+				error += (u32)best;
+			}
+
+			if (error < bestError)
+			{
+				bestError = error;
+				table = t;
+				indices = tableIndices;
+			}
+		}
+		return bestError;
+	}
+
+	//! encodes the colors of a block into 8 bytes of ETC2, using the modes shared with ETC1
+	void encodeColorBlockETC(const SBlock& block, u8* out)
+	{
+		u32 bestError = 0xffffffff;
+
+		for (u32 flip = 0; flip < 2; ++flip)
+		{
+			f32 average[2][3];
+			for (u32 half = 0; half < 2; ++half)
+			{
+				s32 sum[3] = { 0, 0, 0 };
+				for (u32 j = 0; j < 8; ++j)
+				{
+					const u32 x = flip ? (j & 3) : half * 2 + (j & 1);
+					const u32 y = flip ? half * 2 + (j >> 2) : (j >> 1);
+					for (u32 c = 0; c < 3; ++c)
+						sum[c] += block.Pixels[y * 4 + x][c];
+				}
+				for (u32 c = 0; c < 3; ++c)
+					average[half][c] = sum[c] / 8.f;
+			}
+
+			for (u32 diff = 0; diff < 2; ++diff)
+			{
+				// the differential mode stores 5 bit colors, the second as a 3 bit delta
+				const s32 maxValue = diff ? 31 : 15;
+				s32 quantized[2][3];
+				s32 base[2][3];
+				bool valid = true;
+				for (u32 half = 0; half < 2; ++half)
+				{
+					for (u32 c = 0; c < 3; ++c)
+					{
+						const s32 q = core::clamp(core::round32(average[half][c] * maxValue / 255.f), 0, maxValue);
+						quantized[half][c] = q;
+						base[half][c] = diff ? (q << 3) | (q >> 2) : (q << 4) | q;
+					}
+				}
+				if (diff)
+				{
+					for (u32 c = 0; c < 3; ++c)
+					{
+						const s32 delta = quantized[1][c] - quantized[0][c];
+						valid &= delta >= -4 && delta <= 3;
+					}
+				}
+				if (!valid)
+					continue;
+
+				u32 table[2];
+				u32 indices[2];
+				const u32 error = encodeSubBlockETC(block, base[0], flip != 0, 0, table[0], indices[0]) +
+					encodeSubBlockETC(block, base[1], flip != 0, 1, table[1], indices[1]);
+				if (error >= bestError)
+					continue;
+
+				bestError = error;
+				for (u32 c = 0; c < 3; ++c)
+				{
+					if (diff)
+						out[c] = (u8)((quantized[0][c] << 3) | ((quantized[1][c] - quantized[0][c]) & 7));
+					else
+						out[c] = (u8)((quantized[0][c] << 4) | quantized[1][c]);
+				}
+				out[3] = (u8)((table[0] << 5) | (table[1] << 2) | (diff << 1) | flip);
+
+				const u32 pixelIndices = indices[0] | indices[1];
+				out[4] = (u8)(pixelIndices >> 24);
+				out[5] = (u8)(pixelIndices >> 16);
+				out[6] = (u8)(pixelIndices >> 8);
+				out[7] = (u8)pixelIndices;
+			}
+		}
+	}
+
+	//! encodes the alpha values of a block into 8 bytes of EAC
+	void encodeAlphaBlockEAC(const SBlock& block, u8* out)
+	{
+		s32 minAlpha = 255, maxAlpha = 0;
+		for (u32 i = 0; i < 16; ++i)
+		{
+			minAlpha = core::min_(minAlpha, block.Pixels[i][3]);
+			maxAlpha = core::max_(maxAlpha, block.Pixels[i][3]);
+		}
+
+		s32 bestBase = minAlpha;
+		s32 bestMultiplier = 1;
+		u32 bestTable = EAC_CONSTANT_TABLE;
+		u64 bestIndices = 0;
+
+		if (minAlpha == maxAlpha)
+		{
+			// all pixels use the modifier 0
+			for (u32 i = 0; i < 16; ++i)
+				bestIndices |= (u64)4 << (45 - i * 3);
+		}
+		else
+		{
+			u32 bestError = 0xffffffff;
+			for (u32 t = 0; t < 16 && bestError; ++t)
+			{
+				// the most negative and the largest modifier span the range of the block
+				const s32 span = EAC_MODIFIERS[t][7] - EAC_MODIFIERS[t][3];
+				const s32 multiplier = core::clamp(core::round32((f32)(maxAlpha - minAlpha) / span), 1, 15);
+
+				for (s32 m = core::max_(multiplier - 1, 1); m <= core::min_(multiplier + 1, 15); ++m)
+				{
+					const s32 base = core::clamp(core::round32((minAlpha + maxAlpha) * 0.5f -
+						(EAC_MODIFIERS[t][3] + EAC_MODIFIERS[t][7]) * m * 0.5f), 0, 255);
+
+					s32 values[8];
+					for (u32 k = 0; k < 8; ++k)
+						values[k] = core::clamp(base + EAC_MODIFIERS[t][k] * m, 0, 255);
+
+					u32 error = 0;
+					u64 indices = 0;
+					for (u32 j = 0; j < 16 && error < bestError; ++j)
+					{
+						// the pixels are numbered column by column
+						const s32 a = block.Pixels[(j & 3) * 4 + (j >> 2)][3];
+						s32 best = abs(a - values[0]);
+						u64 index = 0;
+						for (u32 k = 1; k < 8; ++k)
+						{
+							const s32 d = abs(a - values[k]);
+							if (d < best)
+							{
+								best = d;
+								index = k;
+							}
+						}
+						indices |= index << (45 - j * 3);
+						error += (u32)(best * best);
+					}
+
+					if (error < bestError)
+					{
+						bestError = error;
+						bestBase = base;
+						bestMultiplier = m;
+						bestTable = t;
+						bestIndices = indices;
+					}
+				}
+			}
+		}
+
+		out[0] = (u8)bestBase;
+		out[1] = (u8)((bestMultiplier << 4) | bestTable);
+		for (u32 k = 0; k < 6; ++k)
+			out[2 + k] = (u8)(bestIndices >> (40 - k * 8));
+	}
+
+	//! Everything the threads of one compress call share
+	struct SCompressJob
+	{
+		const u8* Source;
+		core::dimension2du Size;
+		u32 Pitch;
+		ECOLOR_FORMAT Format;
+		u8* Target;
+		u32 BlocksPerRow;
+		u32 BlockSize;
+	};
+
+	//! compresses the block rows [firstRow, endRow)
+	void compressRows(const SCompressJob* job, u32 firstRow, u32 endRow)
+	{
+		SBlock block;
+		for (u32 by = firstRow; by < endRow; ++by)
+		{
+			u8* out = job->Target + by * job->BlocksPerRow * job->BlockSize;
+			for (u32 bx = 0; bx < job->BlocksPerRow; ++bx, out += job->BlockSize)
+			{
+				loadBlock(job->Source, job->Size, job->Pitch, bx, by, block);
+
+				switch (job->Format)
+				{
+				case ECF_DXT1:
+					encodeColorBlockBC1(block, out);
+					break;
+				case ECF_DXT5:
+					encodeAlphaBlockBC3(block, out);
+					encodeColorBlockBC1(block, out + 8);
+					break;
+				case ECF_ETC2_RGB:
+					encodeColorBlockETC(block, out);
+					break;
+				case ECF_ETC2_ARGB:
+					encodeAlphaBlockEAC(block, out);
+					encodeColorBlockETC(block, out + 8);
+					break;
+				default:
+					break;
+				}
+			}
+		}
+	}
+}
+
+
+//! returns if images can be compressed into the color format
+bool CImageCompressor::canCompress(ECOLOR_FORMAT format)
+{
+	switch (format)
+	{
+	case ECF_DXT1:
+	case ECF_DXT5:
+	case ECF_ETC2_RGB:
+	case ECF_ETC2_ARGB:
+		return true;
+	default:
+		return false;
+	}
+}
+
+
+//! compresses A8R8G8B8 pixels into blocks of the color format
+bool CImageCompressor::compress(const void* source, const core::dimension2du& size, u32 pitch,
+	ECOLOR_FORMAT format, void* target, u32 threadCount)
+{
+	if (!canCompress(format))
+		return false;
+
+	if (size.Width == 0 || size.Height == 0)
+		return true;
+
+	SCompressJob job;
+	job.Source = static_cast<const u8*>(source);
+	job.Size = size;
+	job.Pitch = pitch;
+	job.Format = format;
+	job.Target = static_cast<u8*>(target);
+	job.BlocksPerRow = (size.Width + 3) / 4;
+	job.BlockSize = IImage::getDataSizeFromFormat(format, 4, 4);
+
+	const u32 blockRows = (size.Height + 3) / 4;
+
+	if (threadCount == 0)
+		threadCount = std::thread::hardware_concurrency();
+	threadCount = core::clamp(threadCount, 1u, core::max_(blockRows / MIN_BLOCK_ROWS_PER_THREAD, 1u));
+
+	// each thread works on its own block rows, the calling thread takes the first
+	const u32 rowsPerThread = (blockRows + threadCount - 1) / threadCount;
+
+	std::thread* threads = new std::thread[threadCount - 1];
+	for (u32 i = 1; i < threadCount; ++i)
+	{
+		const u32 firstRow = core::min_(i * rowsPerThread, blockRows);
+		const u32 endRow = core::min_(firstRow + rowsPerThread, blockRows);
+		threads[i - 1] = std::thread(compressRows, &job, firstRow, endRow);
+	}
+
+	compressRows(&job, 0, core::min_(rowsPerThread, blockRows));
+
+	for (u32 i = 0; i < threadCount - 1; ++i)
+		threads[i].join();
+	delete [] threads;
+
+	return true;
+}
+
+
+//! creates a compressed copy of an image
+IImage* CImageCompressor::createCompressedImage(const IImage* image, ECOLOR_FORMAT opaqueFormat,
+	ECOLOR_FORMAT alphaFormat, bool mipMaps, u32 threadCount)
+{
+	if (!canCompress(opaqueFormat) || !canCompress(alphaFormat))
+		return 0;
+
+	const core::dimension2du& size = image->getDimension();
+	if (size.Width == 0 || size.Height == 0)
+		return 0;
+
+	// the encoders read A8R8G8B8
+	const u8* pixels = static_cast<const u8*>(image->getData());
+	u32 pitch = image->getPitch();
+
+	core::array<u8> converted;
+	if (image->getColorFormat() != ECF_A8R8G8B8)
+	{
+		if (!CColorConverter::canConvertFormat(image->getColorFormat(), ECF_A8R8G8B8))
+			return 0;
+
+		converted.set_used(size.getArea() * 4);
+		for (u32 y = 0; y < size.Height; ++y)
+			CColorConverter::convert_viaFormat(pixels + y * pitch, image->getColorFormat(), size.Width,
+				converted.pointer() + y * size.Width * 4, ECF_A8R8G8B8);
+
+		pixels = converted.const_pointer();
+		pitch = size.Width * 4;
+	}
+
+	bool alpha = false;
+	for (u32 y = 0; y < size.Height && !alpha; ++y)
+	{
+		const u32* row = reinterpret_cast<const u32*>(pixels + y * pitch);
+		for (u32 x = 0; x < size.Width; ++x)
+			alpha |= (row[x] >> 24) != 0xff;
+	}
+	const ECOLOR_FORMAT format = alpha ? alphaFormat : opaqueFormat;
+
+	u8* data = new u8[IImage::getDataSizeFromFormat(format, size.Width, size.Height)];
+	compress(pixels, size, pitch, format, data, threadCount);
+	IImage* result = new CImage(format, size, data, true, true);
+
+	if (mipMaps)
+	{
+		// the levels are downscaled from the uncompressed pixels
+		CImage source(ECF_A8R8G8B8, size, const_cast<u8*>(pixels), true, false);
+		core::array<u8> levels;
+		levels.set_used(CImageResampler::getMipMapsDataSize(ECF_A8R8G8B8, size));
+		CImageResampler::createMipMaps(&source, EIF_BOX, levels.pointer(), threadCount);
+
+		core::array<u8> compressedLevels;
+		compressedLevels.set_used(CImageResampler::getMipMapsDataSize(format, size));
+
+		const u8* level = levels.const_pointer();
+		u8* compressedLevel = compressedLevels.pointer();
+		core::dimension2du levelSize(size);
+		do
+		{
+			if (levelSize.Width > 1)
+				levelSize.Width >>= 1;
+
+			if (levelSize.Height > 1)
+				levelSize.Height >>= 1;
+
+			compress(level, levelSize, levelSize.Width * 4, format, compressedLevel, threadCount);
+			level += levelSize.getArea() * 4;
+			compressedLevel += IImage::getDataSizeFromFormat(format, levelSize.Width, levelSize.Height);
+		} while (levelSize.Width != 1 || levelSize.Height != 1);
+
+		result->setMipMapsData(compressedLevels.pointer(), false, true);
+	}
+
+	return result;
+}
+
+
+} // end namespace video
+} // end namespace irr
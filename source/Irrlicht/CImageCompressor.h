@@ -0,0 +1,49 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_IMAGE_COMPRESSOR_H_INCLUDED__
+#define __C_IMAGE_COMPRESSOR_H_INCLUDED__
+
+#include "irrTypes.h"
+#include "IImage.h"
+
+namespace irr
+{
+namespace video
+{
+
+//! Block compression of images on the cpu
+/** Encodes ECF_DXT1, ECF_DXT5, ECF_ETC2_RGB and ECF_ETC2_ARGB. DXT1 blocks
+only use the opaque four color mode. ETC2 blocks use the individual and
+differential modes, which are shared with ETC1, ETC2_ARGB adds an EAC alpha
+block. */
+class CImageCompressor
+{
+public:
+
+	//! returns if images can be compressed into the color format
+	static bool canCompress(ECOLOR_FORMAT format);
+
+	//! compresses A8R8G8B8 pixels into blocks of the color format
+	/** Blocks at the right and bottom border repeat the edge pixels.
+	\param target Receives IImage::getDataSizeFromFormat bytes.
+	\param threadCount Number of threads sharing the block rows, 0 uses one
+	per hardware thread. */
+	static bool compress(const void* source, const core::dimension2du& size, u32 pitch,
+		ECOLOR_FORMAT format, void* target, u32 threadCount = 1);
+
+	//! creates a compressed copy of an image
+	/** \param opaqueFormat Format used when all pixels are opaque.
+	\param alphaFormat Format used when some pixels are translucent.
+	\param mipMaps Also creates and compresses all mipmap levels.
+	\return The new image, or 0 if the formats aren't supported. */
+	static IImage* createCompressedImage(const IImage* image, ECOLOR_FORMAT opaqueFormat,
+		ECOLOR_FORMAT alphaFormat, bool mipMaps, u32 threadCount = 1);
+};
+
+
+} // end namespace video
+} // end namespace irr
+
+#endif
@@ -16,11 +16,6 @@ namespace irr
 namespace video
 {
 
-#ifdef _IRR_COMPILE_WITH_LIBJPEG_
-// Static members
-io::path CImageLoaderJPG::Filename;
-#endif
-
 //! constructor
 CImageLoaderJPG::CImageLoaderJPG()
 {
@@ -56,6 +51,9 @@ bool CImageLoaderJPG::isALoadableFileExtension(const io::path& filename) const
 
         // for longjmp, to return to caller on a fatal error
         jmp_buf setjmp_buffer;
+
+        // name of the file for error-messages, kept here so loading is re-entrant
+        const io::path* filename;
     };
 
 void CImageLoaderJPG::init_source (j_decompress_ptr cinfo)
@@ -112,8 +110,12 @@ void CImageLoaderJPG::output_message(j_common_ptr cinfo)
 	// display the error message.
 	c8 temp1[JMSG_LENGTH_MAX];
 	(*cinfo->err->format_message)(cinfo, temp1);
+
+	// cinfo->err really points to a irr_error_mgr struct
+	irr_jpeg_error_mgr *myerr = (irr_jpeg_error_mgr*) cinfo->err;
+
 	core::stringc errMsg("JPEG FATAL ERROR in ");
-	errMsg += core::stringc(Filename);
+	errMsg += core::stringc(*myerr->filename);
 	os::Printer::log(errMsg.c_str(),temp1, ELL_ERROR);
 }
 #endif // _IRR_COMPILE_WITH_LIBJPEG_
@@ -144,11 +146,20 @@ IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
 	if (!file)
 		return 0;
 
-	Filename = file->getFileName();
-
 	u8 **rowPtr=0;
-	u8* input = new u8[file->getSize()];
-	file->read(input, file->getSize());
+
+	// decode straight from the file's memory if it has some
+	const long inputSize = file->getSize() - file->getPos();
+	const u8* input = (const u8*)file->getBuffer();
+	u8* inputCopy = 0;
+	if (input)
+		input += file->getPos();
+	else
+	{
+		inputCopy = new u8[inputSize];
+		file->read(inputCopy, inputSize);
+		input = inputCopy;
+	}
 
 	// allocate and initialize JPEG decompression object
 	struct jpeg_decompress_struct cinfo;
@@ -162,6 +173,7 @@ IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
 	cinfo.err = jpeg_std_error(&jerr.pub);
 	cinfo.err->error_exit = error_exit;
 	cinfo.err->output_message = output_message;
+	jerr.filename = &file->getFileName();
 
 	// compatibility fudge:
 	// we need to use setjmp/longjmp for error handling as gcc-linux
@@ -173,7 +185,7 @@ IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
 
 		jpeg_destroy_decompress(&cinfo);
 
-		delete [] input;
+		delete [] inputCopy;
 		delete [] rowPtr;
 
 		// return null pointer
@@ -187,8 +199,8 @@ IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
 	jpeg_source_mgr jsrc;
 
 	// Set up data pointer
-	jsrc.bytes_in_buffer = file->getSize();
-	jsrc.next_input_byte = (JOCTET*)input;
+	jsrc.bytes_in_buffer = inputSize;
+	jsrc.next_input_byte = (const JOCTET*)input;
 	cinfo.src = &jsrc;
 
 	jsrc.init_source = init_source;
@@ -280,7 +292,7 @@ IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
 		image = new CImage(ECF_R8G8B8,
 				core::dimension2d<u32>(width, height), output);
 
-	delete [] input;
+	delete [] inputCopy;
 
 	return image;
 
@@ -0,0 +1,240 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CImageLoaderKTX.h"
+
+#ifdef _IRR_COMPILE_WITH_KTX_LOADER_
+
+#include "IReadFile.h"
+#include "CImage.h"
+#include "os.h"
+#include "irrString.h"
+#include <string.h>
+
+namespace irr
+{
+namespace video
+{
+
+namespace
+{
+	//! Largest width or height of a loaded texture
+	const u32 KTX_MAX_SIZE = 16384;
+
+	//! returns the color format of a compressed glInternalFormat
+	ECOLOR_FORMAT getColorFormatFromKTX(u32 glInternalFormat)
+	{
+		switch (glInternalFormat)
+		{
+		case 0x83F0: // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+		case 0x83F1: // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+			return ECF_DXT1;
+		case 0x83F2: // GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+			return ECF_DXT3;
+		case 0x83F3: // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+			return ECF_DXT5;
+		case 0x8D64: // GL_ETC1_RGB8_OES
+			return ECF_ETC1;
+		case 0x9274: // GL_COMPRESSED_RGB8_ETC2
+			return ECF_ETC2_RGB;
+		case 0x9278: // GL_COMPRESSED_RGBA8_ETC2_EAC
+			return ECF_ETC2_ARGB;
+		default:
+			return ECF_UNKNOWN;
+		}
+	}
+
+	//! returns the size of the data of a level, the supported formats all have 4x4 blocks
+	/** Calculated in 64 bit, IImage::getDataSizeFromFormat wraps for large images. */
+	u64 getLevelDataSize(ECOLOR_FORMAT format, u32 width, u32 height)
+	{
+		const u64 blockSize = IImage::getDataSizeFromFormat(format, 4, 4);
+		return (u64)((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+	}
+
+	//! reads the size of the next mipmap level and skips to its data
+	bool readImageSize(io::IReadFile* file, bool swap, u32 expectedSize)
+	{
+		u32 imageSize = 0;
+		if (file->read(&imageSize, sizeof(u32)) != sizeof(u32))
+			return false;
+
+		if (swap)
+			imageSize = os::Byteswap::byteswap(imageSize);
+
+		return imageSize == expectedSize;
+	}
+}
+
+
+//! constructor
+CImageLoaderKTX::CImageLoaderKTX()
+{
+	#ifdef _DEBUG
+	setDebugName("CImageLoaderKTX");
+	#endif
+}
+
+
+//! returns true if the file maybe is able to be loaded by this class
+//! based on the file extension (e.g. ".tga")
+bool CImageLoaderKTX::isALoadableFileExtension(const io::path& filename) const
+{
+	return core::hasFileExtension ( filename, "ktx" );
+}
+
+
+//! returns true if the file maybe is able to be loaded by this class
+bool CImageLoaderKTX::isALoadableFileFormat(io::IReadFile* file) const
+{
+	u8 identifier[12];
+	return file->read(identifier, sizeof(identifier)) == sizeof(identifier) &&
+		!memcmp(identifier, KTX_IDENTIFIER, sizeof(identifier));
+}
+
+
+//! creates a surface from the file
+IImage* CImageLoaderKTX::loadImage(io::IReadFile* file) const
+{
+	SKTXHeader header;
+
+	if (file->read(&header, sizeof(header)) != sizeof(header) ||
+		memcmp(header.Identifier, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)))
+		return 0;
+
+	// the file is in the byte order of the machine which wrote it
+	const bool swap = header.Endianness != KTX_ENDIANNESS;
+	if (swap)
+	{
+		header.Endianness = os::Byteswap::byteswap(header.Endianness);
+		header.GlType = os::Byteswap::byteswap(header.GlType);
+		header.GlTypeSize = os::Byteswap::byteswap(header.GlTypeSize);
+		header.GlFormat = os::Byteswap::byteswap(header.GlFormat);
+		header.GlInternalFormat = os::Byteswap::byteswap(header.GlInternalFormat);
+		header.GlBaseInternalFormat = os::Byteswap::byteswap(header.GlBaseInternalFormat);
+		header.PixelWidth = os::Byteswap::byteswap(header.PixelWidth);
+		header.PixelHeight = os::Byteswap::byteswap(header.PixelHeight);
+		header.PixelDepth = os::Byteswap::byteswap(header.PixelDepth);
+		header.NumberOfArrayElements = os::Byteswap::byteswap(header.NumberOfArrayElements);
+		header.NumberOfFaces = os::Byteswap::byteswap(header.NumberOfFaces);
+		header.NumberOfMipmapLevels = os::Byteswap::byteswap(header.NumberOfMipmapLevels);
+		header.BytesOfKeyValueData = os::Byteswap::byteswap(header.BytesOfKeyValueData);
+
+		if (header.Endianness != KTX_ENDIANNESS)
+			return 0;
+	}
+
+	const ECOLOR_FORMAT format = getColorFormatFromKTX(header.GlInternalFormat);
+	if (header.GlType != 0 || format == ECF_UNKNOWN)
+	{
+		os::Printer::log("KTX: Only block compressed formats are supported", file->getFileName(), ELL_ERROR);
+		return 0;
+	}
+
+	if (header.PixelWidth == 0 || header.PixelHeight == 0 || header.PixelDepth > 1 ||
+		header.NumberOfArrayElements > 1 || header.NumberOfFaces != 1)
+	{
+		os::Printer::log("KTX: Only 2d textures are supported", file->getFileName(), ELL_ERROR);
+		return 0;
+	}
+
+	if (header.PixelWidth > KTX_MAX_SIZE || header.PixelHeight > KTX_MAX_SIZE)
+	{
+		os::Printer::log("KTX: Image is too large", file->getFileName(), ELL_ERROR);
+		return 0;
+	}
+
+	if (!file->seek(header.BytesOfKeyValueData, true))
+		return 0;
+
+	const core::dimension2d<u32> dim(header.PixelWidth, header.PixelHeight);
+
+	// block sizes are multiples of 4, so there is no padding after a level
+	const u64 dataSize64 = getLevelDataSize(format, dim.Width, dim.Height);
+	if (dataSize64 > 0xffffffff)
+	{
+		os::Printer::log("KTX: Image is too large", file->getFileName(), ELL_ERROR);
+		return 0;
+	}
+
+	const u32 dataSize = (u32)dataSize64;
+	if (!readImageSize(file, swap, dataSize))
+	{
+		os::Printer::log("KTX: Image size doesn't match the format", file->getFileName(), ELL_ERROR);
+		return 0;
+	}
+
+	u8* data = new u8[dataSize];
+	if (file->read(data, dataSize) != dataSize)
+	{
+		os::Printer::log("KTX: File is too short", file->getFileName(), ELL_ERROR);
+		delete [] data;
+		return 0;
+	}
+
+	IImage* image = new CImage(format, dim, data, true, true);
+
+	// mipmaps data holds all levels down to 1x1, shorter chains are dropped
+	core::dimension2d<u32> levelSize(dim);
+	u32 levelCount = 1;
+	while (levelSize.Width != 1 || levelSize.Height != 1)
+	{
+		if (levelSize.Width > 1)
+			levelSize.Width >>= 1;
+
+		if (levelSize.Height > 1)
+			levelSize.Height >>= 1;
+
+		++levelCount;
+	}
+
+	if (header.NumberOfMipmapLevels == levelCount)
+	{
+		core::array<u8> mipMaps;
+		levelSize = dim;
+		for (u32 i = 1; i < levelCount; ++i)
+		{
+			if (levelSize.Width > 1)
+				levelSize.Width >>= 1;
+
+			if (levelSize.Height > 1)
+				levelSize.Height >>= 1;
+
+			// smaller than level 0, so it fits in 32 bit
+			const u32 levelDataSize = (u32)getLevelDataSize(format, levelSize.Width, levelSize.Height);
+			const u32 offset = mipMaps.size();
+			mipMaps.set_used(offset + levelDataSize);
+
+			if (!readImageSize(file, swap, levelDataSize) || file->read(mipMaps.pointer() + offset, levelDataSize) != levelDataSize)
+			{
+				os::Printer::log("KTX: Mipmap levels are broken, dropped them", file->getFileName(), ELL_WARNING);
+				mipMaps.clear();
+				break;
+			}
+		}
+
+		if (mipMaps.size())
+			image->setMipMapsData(mipMaps.pointer(), false, true);
+	}
+	else if (header.NumberOfMipmapLevels > 1)
+	{
+		os::Printer::log("KTX: Incomplete mipmap chain dropped", file->getFileName(), ELL_WARNING);
+	}
+
+	return image;
+}
+
+
+//! creates a loader which is able to load KTX images
+IImageLoader* createImageLoaderKTX()
+{
+	return new CImageLoaderKTX;
+}
+
+
+} // end namespace video
+} // end namespace irr
+
+#endif
+
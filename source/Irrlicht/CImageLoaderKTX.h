@@ -0,0 +1,82 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_IMAGE_LOADER_KTX_H_INCLUDED__
+#define __C_IMAGE_LOADER_KTX_H_INCLUDED__
+
+#include "IrrCompileConfig.h"
+
+#include "IImageLoader.h"
+
+
+namespace irr
+{
+namespace video
+{
+
+#if defined(_IRR_COMPILE_WITH_KTX_LOADER_) || defined(_IRR_COMPILE_WITH_KTX_WRITER_)
+
+	//! First bytes of every KTX 1.1 file
+	const u8 KTX_IDENTIFIER[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+	//! Endianness field as written by the machine which wrote the file
+	const u32 KTX_ENDIANNESS = 0x04030201;
+
+// byte-align structures
+#include "irrpack.h"
+
+	struct SKTXHeader
+	{
+		u8 Identifier[12];
+		u32 Endianness;
+		u32 GlType;					// 0 for compressed textures
+		u32 GlTypeSize;
+		u32 GlFormat;				// 0 for compressed textures
+		u32 GlInternalFormat;
+		u32 GlBaseInternalFormat;
+		u32 PixelWidth;
+		u32 PixelHeight;
+		u32 PixelDepth;
+		u32 NumberOfArrayElements;
+		u32 NumberOfFaces;
+		u32 NumberOfMipmapLevels;
+		u32 BytesOfKeyValueData;
+	} PACK_STRUCT;
+
+// Default alignment
+#include "irrunpack.h"
+
+#endif // defined with loader or writer
+
+#ifdef _IRR_COMPILE_WITH_KTX_LOADER_
+
+/*!
+	Surface Loader for Khronos KTX 1.1 files with block compressed images
+*/
+class CImageLoaderKTX : public IImageLoader
+{
+public:
+
+	//! constructor
+	CImageLoaderKTX();
+
+	//! returns true if the file maybe is able to be loaded by this class
+	//! based on the file extension (e.g. ".tga")
+	virtual bool isALoadableFileExtension(const io::path& filename) const _IRR_OVERRIDE_;
+
+	//! returns true if the file maybe is able to be loaded by this class
+	virtual bool isALoadableFileFormat(io::IReadFile* file) const _IRR_OVERRIDE_;
+
+	//! creates a surface from the file
+	virtual IImage* loadImage(io::IReadFile* file) const _IRR_OVERRIDE_;
+};
+
+
+#endif // compiled with loader
+
+} // end namespace video
+} // end namespace irr
+
+#endif
+
@@ -21,16 +21,23 @@ namespace video
 
 #ifdef _IRR_COMPILE_WITH_LIBPNG_
 // PNG function for error handling
+// the error pointer is the file which is loaded, so several files can be loaded at once
 static void png_cpexcept_error(png_structp png_ptr, png_const_charp msg)
 {
-	os::Printer::log("PNG fatal error", msg, ELL_ERROR);
+	io::IReadFile* file=(io::IReadFile*)png_get_error_ptr(png_ptr);
+	core::stringc errMsg("PNG fatal error in ");
+	errMsg += core::stringc(file->getFileName());
+	os::Printer::log(errMsg.c_str(), msg, ELL_ERROR);
 	longjmp(png_jmpbuf(png_ptr), 1);
 }
 
 // PNG function for warning handling
 static void png_cpexcept_warn(png_structp png_ptr, png_const_charp msg)
 {
-	os::Printer::log("PNG warning", msg, ELL_WARNING);
+	io::IReadFile* file=(io::IReadFile*)png_get_error_ptr(png_ptr);
+	core::stringc warnMsg("PNG warning in ");
+	warnMsg += core::stringc(file->getFileName());
+	os::Printer::log(warnMsg.c_str(), msg, ELL_WARNING);
 }
 
 // PNG function for file reading
@@ -108,7 +115,7 @@ IImage* CImageLoaderPng::loadImage(io::IReadFile* file) const
 
 	// Allocate the png read struct
 	png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING,
-		NULL, (png_error_ptr)png_cpexcept_error, (png_error_ptr)png_cpexcept_warn);
+		file, (png_error_ptr)png_cpexcept_error, (png_error_ptr)png_cpexcept_warn);
 	if (!png_ptr)
 	{
 		os::Printer::log("LOAD PNG: Internal PNG create read struct failure\n", file->getFileName(), ELL_ERROR);
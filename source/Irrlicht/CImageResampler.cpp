@@ -0,0 +1,393 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CImageResampler.h"
+#include "CColorConverter.h"
+#include "irrArray.h"
+#include "irrMath.h"
+#include <math.h>
+#include <thread>
+
+namespace irr
+{
+namespace video
+{
+
+namespace
+{
+	//! Target pixels a thread gets at least, fewer aren't worth starting it
+	const u32 MIN_PIXELS_PER_THREAD = 64 * 1024;
+
+	//! Source pixels and weights of one target pixel
+	struct SContribution
+	{
+		//! First source pixel
+		s32 First;
+		//! Number of source pixels
+		s32 Count;
+		//! Index of the first weight in SFilterAxis::Weights
+		u32 Weights;
+	};
+
+	//! Precomputed weights of the filter along one axis
+	struct SFilterAxis
+	{
+		core::array<SContribution> Pixels;
+		core::array<f32> Weights;
+		//! Largest Count of all Pixels
+		s32 MaxCount;
+	};
+
+	//! Radius of the filter in source pixels when not downscaling
+	f32 getFilterSupport(E_IMAGE_FILTER filter)
+	{
+		switch (filter)
+		{
+		case EIF_BOX:
+			return 0.5f;
+		case EIF_TRIANGLE:
+			return 1.f;
+		default:
+			return 3.f;
+		}
+	}
+
+	f32 sinc(f32 x)
+	{
+		if (core::iszero(x))
+			return 1.f;
+		x *= core::PI;
+		return sinf(x) / x;
+	}
+
+	f32 getFilterWeight(E_IMAGE_FILTER filter, f32 x)
+	{
+		x = fabsf(x);
+		switch (filter)
+		{
+		case EIF_BOX:
+			return x <= 0.5f ? 1.f : 0.f;
+		case EIF_TRIANGLE:
+			return x < 1.f ? 1.f - x : 0.f;
+		default:
+			return x < 3.f ? sinc(x) * sinc(x / 3.f) : 0.f;
+		}
+	}
+
+	//! computes the weights of all target pixels along one axis
+	void createFilterAxis(SFilterAxis& axis, u32 sourceLength, u32 targetLength, E_IMAGE_FILTER filter)
+	{
+		const f32 scale = (f32)sourceLength / (f32)targetLength;
+
+		// widened when downscaling, so every source pixel contributes
+		const f32 filterScale = core::max_(scale, 1.f);
+		const f32 support = getFilterSupport(filter) * filterScale;
+
+		axis.Pixels.set_used(targetLength);
+		axis.Weights.reallocate(targetLength * (core::ceil32(support) * 2 + 1));
+		axis.Weights.set_used(0);
+		axis.MaxCount = 1;
+
+		core::array<f32> weights;
+		for (u32 i = 0; i < targetLength; ++i)
+		{
+			// pixel centers are at integer positions
+			const f32 center = ((f32)i + 0.5f) * scale - 0.5f;
+			const s32 left = (s32)ceilf(center - support);
+			const s32 right = (s32)floorf(center + support);
+
+			// pixels outside of the source repeat the edge pixels
+			const s32 first = core::clamp(left, 0, (s32)sourceLength - 1);
+			const s32 last = core::clamp(right, 0, (s32)sourceLength - 1);
+			weights.set_used(last - first + 1);
+			for (u32 k = 0; k < weights.size(); ++k)
+				weights[k] = 0.f;
+
+			f32 sum = 0.f;
+			for (s32 j = left; j <= right; ++j)
+			{
+				const f32 w = getFilterWeight(filter, ((f32)j - center) / filterScale);
+				weights[core::clamp(j, first, last) - first] += w;
+				sum += w;
+			}
+
+			SContribution& c = axis.Pixels[i];
+			c.First = first;
+			c.Count = (s32)weights.size();
+
+			if (core::iszero(sum))
+			{
+				// only happens for filters without overlap, take the nearest pixel
+				c.First = core::clamp(core::round32(center), 0, (s32)sourceLength - 1);
+				c.Count = 1;
+				weights.set_used(1);
+				weights[0] = sum = 1.f;
+			}
+
+			// skip the pixels which don't contribute at the ends
+			u32 start = 0;
+			while (c.Count > 1 && core::iszero(weights[start]))
+			{
+				++start;
+				++c.First;
+				--c.Count;
+			}
+			while (c.Count > 1 && core::iszero(weights[start + c.Count - 1]))
+				--c.Count;
+
+			c.Weights = axis.Weights.size();
+			for (s32 k = 0; k < c.Count; ++k)
+				axis.Weights.push_back(weights[start + k] / sum);
+
+			axis.MaxCount = core::max_(axis.MaxCount, c.Count);
+		}
+	}
+
+	//! Everything the threads of one resample call share
+	struct SResampleJob
+	{
+		const u8* Source;
+		core::dimension2du SourceSize;
+		u32 SourcePitch;
+		ECOLOR_FORMAT SourceFormat;
+
+		u8* Target;
+		core::dimension2du TargetSize;
+		u32 TargetPitch;
+		ECOLOR_FORMAT TargetFormat;
+
+		SFilterAxis Horizontal;
+		SFilterAxis Vertical;
+	};
+
+	//! filters one A8R8G8B8 row horizontally into floats
+	void filterRow(const SFilterAxis& axis, const u8* in, f32* out)
+	{
+		for (u32 i = 0; i < axis.Pixels.size(); ++i, out += 4)
+		{
+			const SContribution& c = axis.Pixels[i];
+			const f32* w = axis.Weights.const_pointer() + c.Weights;
+			const u8* p = in + c.First * 4;
+
+			f32 b = 0.f, g = 0.f, r = 0.f, a = 0.f;
+			for (s32 k = 0; k < c.Count; ++k, p += 4)
+			{
+				b += w[k] * p[0];
+				g += w[k] * p[1];
+				r += w[k] * p[2];
+				a += w[k] * p[3];
+			}
+			out[0] = b;
+			out[1] = g;
+			out[2] = r;
+			out[3] = a;
+		}
+	}
+
+	//! resamples the target rows [firstRow, endRow)
+	/** Keeps the horizontally filtered source rows in a ring, the rows
+	needed by consecutive target rows overlap. */
+	void resampleRows(const SResampleJob* job, u32 firstRow, u32 endRow)
+	{
+		const u32 sourceWidth = job->SourceSize.Width;
+		const u32 rowSize = job->TargetSize.Width * 4;
+		const u32 ringSize = (u32)job->Vertical.MaxCount;
+
+		core::array<f32> ring;
+		ring.set_used(ringSize * rowSize);
+		core::array<s32> ringRows;
+		ringRows.set_used(ringSize);
+		for (u32 i = 0; i < ringSize; ++i)
+			ringRows[i] = -1;
+
+		core::array<f32> sum;
+		sum.set_used(rowSize);
+
+		// rows of other formats are converted to and from A8R8G8B8
+		core::array<u8> sourceRow;
+		if (job->SourceFormat != ECF_A8R8G8B8)
+			sourceRow.set_used(sourceWidth * 4);
+		core::array<u8> targetRow;
+		if (job->TargetFormat != ECF_A8R8G8B8)
+			targetRow.set_used(rowSize);
+
+		for (u32 y = firstRow; y < endRow; ++y)
+		{
+			const SContribution& c = job->Vertical.Pixels[y];
+			const f32* w = job->Vertical.Weights.const_pointer() + c.Weights;
+
+			for (s32 k = 0; k < c.Count; ++k)
+			{
+				const s32 sourceY = c.First + k;
+				const u32 slot = (u32)sourceY % ringSize;
+				f32* row = ring.pointer() + slot * rowSize;
+
+				if (ringRows[slot] != sourceY)
+				{
+					const u8* in = job->Source + sourceY * job->SourcePitch;
+					if (job->SourceFormat != ECF_A8R8G8B8)
+					{
+						CColorConverter::convert_viaFormat(in, job->SourceFormat, sourceWidth, sourceRow.pointer(), ECF_A8R8G8B8);
+						in = sourceRow.const_pointer();
+					}
+					filterRow(job->Horizontal, in, row);
+					ringRows[slot] = sourceY;
+				}
+
+				f32* s = sum.pointer();
+				const f32 weight = w[k];
+				if (k == 0)
+				{
+					for (u32 i = 0; i < rowSize; ++i)
+						s[i] = weight * row[i];
+				}
+				else
+				{
+					for (u32 i = 0; i < rowSize; ++i)
+						s[i] += weight * row[i];
+				}
+			}
+
+			u8* out = job->Target + y * job->TargetPitch;
+			u8* dest = job->TargetFormat != ECF_A8R8G8B8 ? targetRow.pointer() : out;
+
+			// negative lobes of the filter may leave the range
+			const f32* s = sum.const_pointer();
+			for (u32 i = 0; i < rowSize; ++i)
+				dest[i] = (u8)core::clamp(s[i] + 0.5f, 0.f, 255.f);
+
+			if (job->TargetFormat != ECF_A8R8G8B8)
+				CColorConverter::convert_viaFormat(dest, ECF_A8R8G8B8, job->TargetSize.Width, out, job->TargetFormat);
+		}
+	}
+}
+
+
+//! returns if pixels of the color format can be resampled
+bool CImageResampler::canResample(ECOLOR_FORMAT format)
+{
+	switch (format)
+	{
+	case ECF_A1R5G5B5:
+	case ECF_R5G6B5:
+	case ECF_R8G8B8:
+	case ECF_A8R8G8B8:
+		return true;
+	default:
+		return false;
+	}
+}
+
+
+//! resamples the source pixels into the target pixels
+bool CImageResampler::resample(const void* source, const core::dimension2du& sourceSize, u32 sourcePitch, ECOLOR_FORMAT sourceFormat,
+	void* target, const core::dimension2du& targetSize, u32 targetPitch, ECOLOR_FORMAT targetFormat,
+	E_IMAGE_FILTER filter, u32 threadCount)
+{
+	if (!canResample(sourceFormat) || !canResample(targetFormat))
+		return false;
+
+	if (sourceSize.Width == 0 || sourceSize.Height == 0 || targetSize.Width == 0 || targetSize.Height == 0)
+		return true;
+
+	SResampleJob job;
+	job.Source = static_cast<const u8*>(source);
+	job.SourceSize = sourceSize;
+	job.SourcePitch = sourcePitch;
+	job.SourceFormat = sourceFormat;
+	job.Target = static_cast<u8*>(target);
+	job.TargetSize = targetSize;
+	job.TargetPitch = targetPitch;
+	job.TargetFormat = targetFormat;
+
+	createFilterAxis(job.Horizontal, sourceSize.Width, targetSize.Width, filter);
+	createFilterAxis(job.Vertical, sourceSize.Height, targetSize.Height, filter);
+
+	if (threadCount == 0)
+		threadCount = std::thread::hardware_concurrency();
+	// small images, like most texture resizes and mipmap levels, stay on the calling thread
+	const u32 maxThreads = core::min_(targetSize.Height, targetSize.getArea() / MIN_PIXELS_PER_THREAD);
+	threadCount = core::clamp(threadCount, 1u, core::max_(maxThreads, 1u));
+
+	// each thread works on its own block of target rows, the calling thread takes the first
+	const u32 rowsPerThread = (targetSize.Height + threadCount - 1) / threadCount;
+
+	std::thread* threads = new std::thread[threadCount - 1];
+	for (u32 i = 1; i < threadCount; ++i)
+	{
+		const u32 firstRow = core::min_(i * rowsPerThread, targetSize.Height);
+		const u32 endRow = core::min_(firstRow + rowsPerThread, targetSize.Height);
+		threads[i - 1] = std::thread(resampleRows, &job, firstRow, endRow);
+	}
+
+	resampleRows(&job, 0, core::min_(rowsPerThread, targetSize.Height));
+
+	for (u32 i = 0; i < threadCount - 1; ++i)
+		threads[i].join();
+	delete [] threads;
+
+	return true;
+}
+
+
+//! returns the size of the mipmaps data of an image, see IImage::setMipMapsData
+u32 CImageResampler::getMipMapsDataSize(ECOLOR_FORMAT format, const core::dimension2du& size)
+{
+	u32 dataSize = 0;
+	u32 width = size.Width;
+	u32 height = size.Height;
+
+	do
+	{
+		if (width > 1)
+			width >>= 1;
+
+		if (height > 1)
+			height >>= 1;
+
+		dataSize += IImage::getDataSizeFromFormat(format, width, height);
+	} while (width != 1 || height != 1);
+
+	return dataSize;
+}
+
+
+//! creates the mipmaps data of an image in the layout of IImage::setMipMapsData
+bool CImageResampler::createMipMaps(const IImage* image, E_IMAGE_FILTER filter, u8* mipMaps, u32 threadCount)
+{
+	const ECOLOR_FORMAT format = image->getColorFormat();
+	if (!canResample(format))
+		return false;
+
+	const u32 bytesPerPixel = image->getBytesPerPixel();
+
+	const u8* source = static_cast<const u8*>(image->getData());
+	core::dimension2du sourceSize = image->getDimension();
+	u32 sourcePitch = image->getPitch();
+
+	u8* target = mipMaps;
+	do
+	{
+		core::dimension2du targetSize(sourceSize);
+		if (targetSize.Width > 1)
+			targetSize.Width >>= 1;
+
+		if (targetSize.Height > 1)
+			targetSize.Height >>= 1;
+
+		const u32 targetPitch = targetSize.Width * bytesPerPixel;
+		resample(source, sourceSize, sourcePitch, format, target, targetSize, targetPitch, format, filter, threadCount);
+
+		source = target;
+		sourceSize = targetSize;
+		sourcePitch = targetPitch;
+		target += IImage::getDataSizeFromFormat(format, targetSize.Width, targetSize.Height);
+	} while (sourceSize.Width != 1 || sourceSize.Height != 1);
+
+	return true;
+}
+
+
+} // end namespace video
+} // end namespace irr
@@ -0,0 +1,50 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_IMAGE_RESAMPLER_H_INCLUDED__
+#define __C_IMAGE_RESAMPLER_H_INCLUDED__
+
+#include "irrTypes.h"
+#include "IImage.h"
+
+namespace irr
+{
+namespace video
+{
+
+//! Separable image resampling on raw pixel rows
+/** The source rows are filtered horizontally into float rows first, the
+target rows are then filtered vertically from those. The filter weights are
+computed once per axis. Pixels are filtered as A8R8G8B8, other formats are
+converted row by row. */
+class CImageResampler
+{
+public:
+
+	//! returns if pixels of the color format can be resampled
+	static bool canResample(ECOLOR_FORMAT format);
+
+	//! resamples the source pixels into the target pixels
+	/** \param threadCount Number of threads sharing the target rows, 0 uses
+	one per hardware thread. Small targets are resampled without threads.
+	\return False if one of the color formats isn't supported. */
+	static bool resample(const void* source, const core::dimension2du& sourceSize, u32 sourcePitch, ECOLOR_FORMAT sourceFormat,
+		void* target, const core::dimension2du& targetSize, u32 targetPitch, ECOLOR_FORMAT targetFormat,
+		E_IMAGE_FILTER filter, u32 threadCount = 1);
+
+	//! returns the size of the mipmaps data of an image, see IImage::setMipMapsData
+	static u32 getMipMapsDataSize(ECOLOR_FORMAT format, const core::dimension2du& size);
+
+	//! creates the mipmaps data of an image in the layout of IImage::setMipMapsData
+	/** Each level is downscaled from the level above it.
+	\param mipMaps Receives getMipMapsDataSize bytes.
+	\return False if the color format isn't supported. */
+	static bool createMipMaps(const IImage* image, E_IMAGE_FILTER filter, u8* mipMaps, u32 threadCount = 1);
+};
+
+
+} // end namespace video
+} // end namespace irr
+
+#endif
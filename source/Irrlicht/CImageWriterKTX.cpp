@@ -0,0 +1,134 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CImageWriterKTX.h"
+
+#ifdef _IRR_COMPILE_WITH_KTX_WRITER_
+
+#include "CImageLoaderKTX.h"
+#include "IWriteFile.h"
+#include "irrString.h"
+#include <string.h>
+
+namespace irr
+{
+namespace video
+{
+
+IImageWriter* createImageWriterKTX()
+{
+	return new CImageWriterKTX;
+}
+
+CImageWriterKTX::CImageWriterKTX()
+{
+#ifdef _DEBUG
+	setDebugName("CImageWriterKTX");
+#endif
+}
+
+bool CImageWriterKTX::isAWriteableFileExtension(const io::path& filename) const
+{
+	return core::hasFileExtension ( filename, "ktx" );
+}
+
+bool CImageWriterKTX::writeImage(io::IWriteFile* file, IImage* image, u32 param) const
+{
+	if (!file || !image)
+		return false;
+
+	SKTXHeader header;
+	memset(&header, 0, sizeof(header));
+
+	switch (image->getColorFormat())
+	{
+	case ECF_DXT1:
+		header.GlInternalFormat = 0x83F1; // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+		header.GlBaseInternalFormat = 0x1908; // GL_RGBA
+		break;
+	case ECF_DXT3:
+		header.GlInternalFormat = 0x83F2; // GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+		header.GlBaseInternalFormat = 0x1908;
+		break;
+	case ECF_DXT5:
+		header.GlInternalFormat = 0x83F3; // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+		header.GlBaseInternalFormat = 0x1908;
+		break;
+	case ECF_ETC1:
+		header.GlInternalFormat = 0x8D64; // GL_ETC1_RGB8_OES
+		header.GlBaseInternalFormat = 0x1907; // GL_RGB
+		break;
+	case ECF_ETC2_RGB:
+		header.GlInternalFormat = 0x9274; // GL_COMPRESSED_RGB8_ETC2
+		header.GlBaseInternalFormat = 0x1907;
+		break;
+	case ECF_ETC2_ARGB:
+		header.GlInternalFormat = 0x9278; // GL_COMPRESSED_RGBA8_ETC2_EAC
+		header.GlBaseInternalFormat = 0x1908;
+		break;
+	default:
+		return false;
+	}
+
+	const core::dimension2d<u32>& dim = image->getDimension();
+	const u8* mipMaps = static_cast<const u8*>(image->getMipMapsData());
+
+	// the file is written in the byte order of this machine
+	memcpy(header.Identifier, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER));
+	header.Endianness = KTX_ENDIANNESS;
+	header.GlTypeSize = 1;
+	header.PixelWidth = dim.Width;
+	header.PixelHeight = dim.Height;
+	header.NumberOfFaces = 1;
+	header.NumberOfMipmapLevels = 1;
+
+	core::dimension2d<u32> levelSize(dim);
+	if (mipMaps)
+	{
+		while (levelSize.Width != 1 || levelSize.Height != 1)
+		{
+			if (levelSize.Width > 1)
+				levelSize.Width >>= 1;
+
+			if (levelSize.Height > 1)
+				levelSize.Height >>= 1;
+
+			++header.NumberOfMipmapLevels;
+		}
+	}
+
+	if (file->write(&header, sizeof(header)) != sizeof(header))
+		return false;
+
+	// block sizes are multiples of 4, so the levels need no padding
+	u32 imageSize = image->getImageDataSizeInBytes();
+	if (file->write(&imageSize, sizeof(u32)) != sizeof(u32) ||
+		file->write(image->getData(), imageSize) != imageSize)
+		return false;
+
+	levelSize = dim;
+	for (u32 i = 1; i < header.NumberOfMipmapLevels; ++i)
+	{
+		if (levelSize.Width > 1)
+			levelSize.Width >>= 1;
+
+		if (levelSize.Height > 1)
+			levelSize.Height >>= 1;
+
+		imageSize = IImage::getDataSizeFromFormat(image->getColorFormat(), levelSize.Width, levelSize.Height);
+		if (file->write(&imageSize, sizeof(u32)) != sizeof(u32) ||
+			file->write(mipMaps, imageSize) != imageSize)
+			return false;
+
+		mipMaps += imageSize;
+	}
+
+	return true;
+}
+
+} // namespace video
+} // namespace irr
+
+#endif
+
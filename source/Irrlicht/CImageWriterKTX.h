@@ -0,0 +1,39 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef _C_IMAGE_WRITER_KTX_H_INCLUDED__
+#define _C_IMAGE_WRITER_KTX_H_INCLUDED__
+
+#include "IrrCompileConfig.h"
+
+#ifdef _IRR_COMPILE_WITH_KTX_WRITER_
+
+#include "IImageWriter.h"
+
+namespace irr
+{
+namespace video
+{
+
+class CImageWriterKTX : public IImageWriter
+{
+public:
+	//! constructor
+	CImageWriterKTX();
+
+	//! return true if this writer can write a file with the given extension
+	virtual bool isAWriteableFileExtension(const io::path& filename) const _IRR_OVERRIDE_;
+
+	//! write image to file
+	/** Only block compressed images are written, together with all of
+	their mipmap levels. */
+	virtual bool writeImage(io::IWriteFile *file, IImage *image, u32 param) const _IRR_OVERRIDE_;
+};
+
+} // namespace video
+} // namespace irr
+
+#endif // _C_IMAGE_WRITER_KTX_H_INCLUDED__
+#endif
+
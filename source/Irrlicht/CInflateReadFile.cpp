@@ -0,0 +1,239 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CInflateReadFile.h"
+
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+
+#include "os.h"
+
+namespace irr
+{
+namespace io
+{
+
+namespace
+{
+	//! Amount of deflated data read at once
+	const u32 INPUT_SIZE = 16 * 1024;
+
+	//! Size of the blocks which are inflated at once
+	const u32 BLOCK_SIZE = 64 * 1024;
+
+	//! Distance of the checkpoints in the inflated data, a multiple of BLOCK_SIZE
+	const u32 CHECKPOINT_DISTANCE = 4 * 1024 * 1024;
+}
+
+
+CInflateReadFile::CInflateReadFile(IReadFile* compressedFile, long pos,
+		long compressedSize, long uncompressedSize, const io::path& name)
+	: Filename(name), File(compressedFile), AreaStart(pos),
+	CompressedSize(compressedSize), Size(uncompressedSize), Pos(0),
+	CompressedPos(0), BlockStart(0), Initialized(false), Failed(false)
+{
+	#ifdef _DEBUG
+	setDebugName("CInflateReadFile");
+	#endif
+
+	memset(&Stream, 0, sizeof(z_stream));
+
+	if (File)
+	{
+		File->grab();
+
+		Input.set_used(core::max_(1u, core::min_(INPUT_SIZE, (u32)CompressedSize)));
+		Block.reallocate(core::min_(BLOCK_SIZE, (u32)Size));
+
+		// wbits < 0 indicates no zlib header inside the data.
+		Initialized = inflateInit2(&Stream, -MAX_WBITS) == Z_OK;
+	}
+}
+
+
+CInflateReadFile::~CInflateReadFile()
+{
+	for (u32 i=0; i<Checkpoints.size(); ++i)
+	{
+		inflateEnd(&Checkpoints[i]->Stream);
+		delete Checkpoints[i];
+	}
+
+	if (Initialized)
+		inflateEnd(&Stream);
+
+	if (File)
+		File->drop();
+}
+
+
+//! returns how much was read
+size_t CInflateReadFile::read(void* buffer, size_t sizeToRead)
+{
+	if (!Initialized)
+		return 0;
+
+	c8* out = (c8*)buffer;
+	size_t done = 0;
+
+	while (done < sizeToRead && Pos < Size)
+	{
+		const long blockEnd = BlockStart + (long)Block.size();
+
+		if (Pos >= BlockStart && Pos < blockEnd)
+		{
+			const size_t amount = core::min_((size_t)(blockEnd - Pos), sizeToRead - done);
+			memcpy(out + done, Block.const_pointer() + (Pos - BlockStart), amount);
+			done += amount;
+			Pos += (long)amount;
+			continue;
+		}
+
+		// behind the block, or ahead of it with a checkpoint in between
+		const long checkpoint = (long)core::min_((u32)(Pos / CHECKPOINT_DISTANCE), Checkpoints.size()) * CHECKPOINT_DISTANCE;
+		if (Pos < BlockStart || checkpoint > blockEnd)
+		{
+			if (!restart(Pos))
+				break;
+		}
+		else if (!inflateBlock())
+			break;
+	}
+
+	return done;
+}
+
+
+//! changes position in file, returns true if successful
+bool CInflateReadFile::seek(long finalPos, bool relativeMovement)
+{
+	// the data is inflated on the next read
+	if (relativeMovement)
+		finalPos += Pos;
+
+	if (finalPos < 0 || finalPos > Size)
+		return false;
+
+	Pos = finalPos;
+	return true;
+}
+
+
+//! returns size of file
+long CInflateReadFile::getSize() const
+{
+	return Size;
+}
+
+
+//! returns where in the file we are.
+long CInflateReadFile::getPos() const
+{
+	return Pos;
+}
+
+
+//! returns name of file
+const io::path& CInflateReadFile::getFileName() const
+{
+	return Filename;
+}
+
+
+//! continues inflating at the closest checkpoint before pos
+bool CInflateReadFile::restart(long pos)
+{
+	if (Failed)
+		return false;
+
+	const u32 index = core::min_((u32)(pos / CHECKPOINT_DISTANCE), Checkpoints.size());
+	if (index)
+	{
+		SCheckpoint* checkpoint = Checkpoints[index-1];
+		inflateEnd(&Stream);
+		if (inflateCopy(&Stream, &checkpoint->Stream) != Z_OK)
+		{
+			// Stream has no state anymore
+			Initialized = false;
+			return false;
+		}
+		CompressedPos = checkpoint->CompressedPos;
+	}
+	else
+	{
+		if (inflateReset(&Stream) != Z_OK)
+			return false;
+		CompressedPos = 0;
+	}
+
+	Stream.next_in = 0;
+	Stream.avail_in = 0;
+	BlockStart = (long)index * CHECKPOINT_DISTANCE;
+	Block.set_used(0);
+	return true;
+}
+
+
+//! inflates the block after the current block
+bool CInflateReadFile::inflateBlock()
+{
+	if (Failed)
+		return false;
+
+	const long start = BlockStart + (long)Block.size();
+	if (start >= Size)
+		return false;
+
+	// blocks are full until the end, so each checkpoint starts a block
+	if (start % CHECKPOINT_DISTANCE == 0 && start / CHECKPOINT_DISTANCE == (long)Checkpoints.size() + 1)
+	{
+		SCheckpoint* checkpoint = new SCheckpoint;
+		if (inflateCopy(&checkpoint->Stream, &Stream) == Z_OK)
+		{
+			checkpoint->CompressedPos = CompressedPos - (long)Stream.avail_in;
+			Checkpoints.push_back(checkpoint);
+		}
+		else
+			delete checkpoint;
+	}
+
+	const u32 blockSize = (u32)core::min_((long)BLOCK_SIZE, Size - start);
+	Block.set_used(blockSize);
+	BlockStart = start;
+
+	Stream.next_out = (Bytef*)Block.pointer();
+	Stream.avail_out = blockSize;
+
+	while (Stream.avail_out)
+	{
+		if (!Stream.avail_in && CompressedPos < CompressedSize)
+		{
+			const size_t amount = core::min_((size_t)(CompressedSize - CompressedPos), (size_t)Input.size());
+			const size_t r = File->readAt(AreaStart + CompressedPos, Input.pointer(), amount);
+			CompressedPos += (long)r;
+			Stream.next_in = (Bytef*)Input.pointer();
+			Stream.avail_in = (uInt)r;
+		}
+
+		const s32 err = inflate(&Stream, Z_NO_FLUSH);
+		if (err == Z_STREAM_END)
+			break;
+
+		// Z_BUF_ERROR means no progress was possible, so the input ended early
+		if (err != Z_OK)
+		{
+			os::Printer::log("Error decompressing", Filename, ELL_ERROR);
+			Failed = true;
+			break;
+		}
+	}
+
+	Block.set_used(blockSize - Stream.avail_out);
+	return Block.size() != 0;
+}
+
+
+} // end namespace io
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_ZLIB_
@@ -0,0 +1,116 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_INFLATE_READ_FILE_H_INCLUDED__
+#define __C_INFLATE_READ_FILE_H_INCLUDED__
+
+#include "IrrCompileConfig.h"
+
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+
+#include "IReadFile.h"
+#include "irrArray.h"
+#include <zlib.h> // use system lib
+
+namespace irr
+{
+namespace io
+{
+
+	/*! A read file which inflates raw deflate data, as stored in zip
+		files, while it is being read. Only one block of the inflated data
+		is kept in memory. Seeking backwards restarts inflating from the
+		closest checkpoint before the new position. Checkpoints are taken
+		in regular distances while the file is read.
+	!*/
+	class CInflateReadFile : public IReadFile
+	{
+	public:
+
+		//! Constructor
+		/** \param compressedFile File which holds the deflated data, read with readAt.
+		\param pos Start of the deflated data in compressedFile.
+		\param compressedSize Size of the deflated data.
+		\param uncompressedSize Size of the inflated data.
+		\param name Name of the file. */
+		CInflateReadFile(IReadFile* compressedFile, long pos, long compressedSize,
+				long uncompressedSize, const io::path& name);
+
+		virtual ~CInflateReadFile();
+
+		//! returns how much was read
+		virtual size_t read(void* buffer, size_t sizeToRead) _IRR_OVERRIDE_;
+
+		//! changes position in file, returns true if successful
+		//! if relativeMovement==true, the pos is changed relative to current pos,
+		//! otherwise from begin of file
+		virtual bool seek(long finalPos, bool relativeMovement = false) _IRR_OVERRIDE_;
+
+		//! returns size of file
+		virtual long getSize() const _IRR_OVERRIDE_;
+
+		//! returns where in the file we are.
+		virtual long getPos() const _IRR_OVERRIDE_;
+
+		//! returns name of file
+		virtual const io::path& getFileName() const _IRR_OVERRIDE_;
+
+		//! Get the type of the class implementing this interface
+		virtual EREAD_FILE_TYPE getType() const _IRR_OVERRIDE_
+		{
+			return ERFT_INFLATE_READ_FILE;
+		}
+
+		//! returns if the inflate stream could be set up
+		bool isOpen() const
+		{
+			return Initialized;
+		}
+
+	private:
+
+		//! Inflate state at a multiple of CHECKPOINT_DISTANCE
+		/** Allocated on its own, zlib's state keeps a pointer to its z_stream. */
+		struct SCheckpoint
+		{
+			z_stream Stream;
+			//! Position in the deflated data up to which Stream consumed the input
+			long CompressedPos;
+		};
+
+		//! continues inflating at the closest checkpoint before pos
+		bool restart(long pos);
+
+		//! inflates the block after the current block
+		bool inflateBlock();
+
+		io::path Filename;
+		IReadFile* File;
+		long AreaStart;
+		long CompressedSize;
+		long Size;
+		long Pos;
+
+		z_stream Stream;
+		//! Position in the deflated data up to which input was passed to Stream
+		long CompressedPos;
+		core::array<u8> Input;
+
+		//! Inflated data from BlockStart to BlockStart + Block.size()
+		core::array<u8> Block;
+		long BlockStart;
+
+		//! Checkpoint i is at (i+1) * CHECKPOINT_DISTANCE
+		core::array<SCheckpoint*> Checkpoints;
+
+		bool Initialized;
+		bool Failed;
+	};
+
+} // end namespace io
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_ZLIB_
+
+#endif
@@ -146,6 +146,13 @@ ITimer* CIrrDeviceStub::getTimer()
 }
 
 
+//! Returns the arena for scratch memory of the current frame.
+core::frame_arena* CIrrDeviceStub::getFrameArena()
+{
+	return VideoDriver ? VideoDriver->getFrameArena() : 0;
+}
+
+
 //! Returns the version of the engine.
 const char* CIrrDeviceStub::getVersion() const
 {
@@ -83,6 +83,9 @@ namespace irr
 		//! Returns a pointer to the ITimer object. With it the current Time can be received.
 		virtual ITimer* getTimer() _IRR_OVERRIDE_;
 
+		//! Returns the arena for scratch memory of the current frame.
+		virtual core::frame_arena* getFrameArena() _IRR_OVERRIDE_;
+
 		//! Returns the version of the engine.
 		virtual const char* getVersion() const _IRR_OVERRIDE_;
 
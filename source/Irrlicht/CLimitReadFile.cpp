@@ -43,12 +43,8 @@ size_t CLimitReadFile::read(void* buffer, size_t sizeToRead)
 		return 0;
 
 #if 1
-	long r = AreaStart + Pos;
-	long toRead = core::min_(AreaEnd, r + (long)sizeToRead) - core::max_(AreaStart, r);
-	if (toRead < 0)
-		return 0;
-	File->seek(r);
-	r = (long)File->read(buffer, toRead);
+	// positional, so streams sharing the archive file don't disturb each other
+	const long r = (long)readAt(Pos, buffer, sizeToRead);
 	Pos += r;
 	return r;
 #else
@@ -65,6 +61,21 @@ size_t CLimitReadFile::read(void* buffer, size_t sizeToRead)
 }
 
 
+//! returns how much was read from a position, without changing the position
+size_t CLimitReadFile::readAt(long pos, void* buffer, size_t sizeToRead)
+{
+	if (0 == File || pos < 0)
+		return 0;
+
+	const long r = AreaStart + pos;
+	const long toRead = core::min_(AreaEnd, r + (long)sizeToRead) - core::max_(AreaStart, r);
+	if (toRead <= 0)
+		return 0;
+
+	return File->readAt(r, buffer, toRead);
+}
+
+
 //! changes position in file, returns true if successful
 bool CLimitReadFile::seek(long finalPos, bool relativeMovement)
 {
@@ -116,6 +127,20 @@ const io::path& CLimitReadFile::getFileName() const
 }
 
 
+//! returns the area of the contents of the outer file, if it has them in memory
+const void* CLimitReadFile::getBuffer() const
+{
+	const c8* buffer = File ? (const c8*)File->getBuffer() : 0;
+
+	// broken archive headers may describe an area past the end of the outer
+	// file, then the callers fall back to read(), which clamps the area
+	if (!buffer || AreaStart < 0 || AreaEnd > File->getSize())
+		return 0;
+
+	return buffer + AreaStart;
+}
+
+
 IReadFile* createLimitReadFile(const io::path& fileName, IReadFile* alreadyOpenedFile, long pos, long areaSize)
 {
 	return new CLimitReadFile(alreadyOpenedFile, pos, areaSize, fileName);
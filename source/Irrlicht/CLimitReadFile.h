@@ -32,6 +32,9 @@ namespace io
 		//! returns how much was read
 		virtual size_t read(void* buffer, size_t sizeToRead) _IRR_OVERRIDE_;
 
+		//! returns how much was read from a position, without changing the position
+		virtual size_t readAt(long pos, void* buffer, size_t sizeToRead) _IRR_OVERRIDE_;
+
 		//! changes position in file, returns true if successful
 		//! if relativeMovement==true, the pos is changed relative to current pos,
 		//! otherwise from begin of file
@@ -52,6 +55,9 @@ namespace io
 			return ERFT_LIMIT_READ_FILE;
 		}
 
+		//! returns the area of the contents of the outer file, if it has them in memory
+		virtual const void* getBuffer() const _IRR_OVERRIDE_;
+
 	private:
 
 		io::path Filename;
@@ -45,6 +45,21 @@ size_t CMemoryReadFile::read(void* buffer, size_t sizeToRead)
 	return static_cast<size_t>(amount);
 }
 
+//! returns how much was read from a position, without changing the position
+size_t CMemoryReadFile::readAt(long pos, void* buffer, size_t sizeToRead)
+{
+	if (pos < 0 || pos >= Len)
+		return 0;
+
+	long amount = core::min_(static_cast<long>(sizeToRead), Len - pos);
+	if (amount <= 0)
+		return 0;
+
+	memcpy(buffer, (const c8*)Buffer + pos, amount);
+
+	return static_cast<size_t>(amount);
+}
+
 //! changes position in file, returns true if successful
 //! if relativeMovement==true, the pos is changed relative to current pos,
 //! otherwise from begin of file
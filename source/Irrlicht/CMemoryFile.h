@@ -31,6 +31,9 @@ namespace io
 		//! returns how much was read
 		virtual size_t read(void* buffer, size_t sizeToRead) _IRR_OVERRIDE_;
 
+		//! returns how much was read from a position, without changing the position
+		virtual size_t readAt(long pos, void* buffer, size_t sizeToRead) _IRR_OVERRIDE_;
+
 		//! changes position in file, returns true if successful
 		virtual bool seek(long finalPos, bool relativeMovement = false) _IRR_OVERRIDE_;
 
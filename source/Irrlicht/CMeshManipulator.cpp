@@ -6,6 +6,7 @@
 #include "SMesh.h"
 #include "CMeshBuffer.h"
 #include "SAnimatedMesh.h"
+#include "SLODMesh.h"
 #include "os.h"
 #include "irrMap.h"
 #include "triangle3d.h"
@@ -2113,6 +2114,655 @@ IMesh* CMeshManipulator::createForsythOptimizedMesh(const IMesh *mesh) const
 	return newmesh;
 }
 
+
+namespace
+{
+
+// squared distances to a set of weighted planes, a symmetric 4x4 matrix
+struct SQuadric
+{
+	SQuadric()
+	{
+		for (u32 i=0; i<10; ++i)
+			M[i] = 0.0;
+	}
+
+	void addPlane(const core::vector3d<f64>& normal, f64 d, f64 weight)
+	{
+		const f64 a = normal.X, b = normal.Y, c = normal.Z;
+		M[0] += weight*a*a; M[1] += weight*a*b; M[2] += weight*a*c; M[3] += weight*a*d;
+		M[4] += weight*b*b; M[5] += weight*b*c; M[6] += weight*b*d;
+		M[7] += weight*c*c; M[8] += weight*c*d;
+		M[9] += weight*d*d;
+	}
+
+	SQuadric& operator+=(const SQuadric& other)
+	{
+		for (u32 i=0; i<10; ++i)
+			M[i] += other.M[i];
+		return *this;
+	}
+
+	f64 evaluate(const core::vector3df& p) const
+	{
+		const f64 x = p.X, y = p.Y, z = p.Z;
+		return M[0]*x*x + M[4]*y*y + M[7]*z*z + M[9] +
+			2.0*(M[1]*x*y + M[2]*x*z + M[5]*y*z + M[3]*x + M[6]*y + M[8]*z);
+	}
+
+	f64 M[10];
+};
+
+// collapse of the edge From-To moving vertex From onto vertex To
+struct SEdgeCollapse
+{
+	f64 Cost;
+	// changes of the vertices since the cost was computed
+	u32 FromStamp;
+	u32 ToStamp;
+	u16 From;
+	u16 To;
+};
+
+// binary heap of edge collapses, cheapest first
+class CEdgeCollapseHeap
+{
+public:
+	bool empty() const
+	{
+		return Items.empty();
+	}
+
+	void push(const SEdgeCollapse& item)
+	{
+		u32 i = Items.size();
+		Items.push_back(item);
+		while (i > 0)
+		{
+			const u32 parent = (i-1) / 2;
+			if (Items[parent].Cost <= item.Cost)
+				break;
+			Items[i] = Items[parent];
+			i = parent;
+		}
+		Items[i] = item;
+	}
+
+	SEdgeCollapse pop()
+	{
+		const SEdgeCollapse top = Items[0];
+		const SEdgeCollapse last = Items.getLast();
+		Items.erase(Items.size()-1);
+
+		const u32 size = Items.size();
+		if (size)
+		{
+			u32 i = 0;
+			for (;;)
+			{
+				u32 child = 2*i + 1;
+				if (child >= size)
+					break;
+				if (child+1 < size && Items[child+1].Cost < Items[child].Cost)
+					++child;
+				if (last.Cost <= Items[child].Cost)
+					break;
+				Items[i] = Items[child];
+				i = child;
+			}
+			Items[i] = last;
+		}
+		return top;
+	}
+
+private:
+	core::array<SEdgeCollapse> Items;
+};
+
+// position of a vertex, sorted to find vertices sharing a position
+struct SPositionIndex
+{
+	core::vector3df Position;
+	u16 Index;
+
+	bool operator<(const SPositionIndex& other) const
+	{
+		if (Position.X != other.Position.X)
+			return Position.X < other.Position.X;
+		if (Position.Y != other.Position.Y)
+			return Position.Y < other.Position.Y;
+		return Position.Z < other.Position.Z;
+	}
+};
+
+// Reduces the triangles of a mesh buffer with 16 bit indices by half edge
+// collapses in the order of the quadric error metric of Garland and Heckbert.
+// Vertices are only removed, never moved, so the remaining triangles index
+// the vertices of the original buffer and keep all their attributes.
+class CQuadricSimplifier
+{
+public:
+	CQuadricSimplifier(const IMeshBuffer* mb) : TriangleCount(0), MarkCounter(0)
+	{
+		const u32 vcount = mb->getVertexCount();
+		const u32 icount = mb->getIndexCount() - mb->getIndexCount() % 3;
+		const u16* indices = mb->getIndices();
+
+		Positions.set_used(vcount);
+		Quadrics.reallocate(vcount);
+		VertexTriangles.reallocate(vcount);
+		Stamps.set_used(vcount);
+		Marks.set_used(vcount);
+		Locked.set_used(vcount);
+		Removed.set_used(vcount);
+		for (u32 i=0; i<vcount; ++i)
+		{
+			Positions[i] = mb->getPosition(i);
+			Quadrics.push_back(SQuadric());
+			VertexTriangles.push_back(core::array<u32>());
+			Stamps[i] = 0;
+			Marks[i] = 0;
+			Locked[i] = false;
+			Removed[i] = false;
+		}
+
+		Triangles.set_used(icount);
+		TriangleRemoved.set_used(icount / 3);
+		for (u32 t=0; t<icount/3; ++t)
+		{
+			const u16 a = indices[3*t];
+			const u16 b = indices[3*t+1];
+			const u16 c = indices[3*t+2];
+			Triangles[3*t] = a;
+			Triangles[3*t+1] = b;
+			Triangles[3*t+2] = c;
+
+			// degenerated triangles are dropped right away
+			TriangleRemoved[t] = a == b || b == c || c == a || a >= vcount || b >= vcount || c >= vcount;
+			if (TriangleRemoved[t])
+				continue;
+
+			VertexTriangles[a].push_back(t);
+			VertexTriangles[b].push_back(t);
+			VertexTriangles[c].push_back(t);
+			++TriangleCount;
+		}
+
+		lockSeams();
+		computeQuadrics();
+
+		for (u32 i=0; i<vcount; ++i)
+		{
+			gatherNeighbors((u16)i);
+			for (u32 n=0; n<Neighbors.size(); ++n)
+			{
+				if (i < Neighbors[n])
+					pushEdge((u16)i, Neighbors[n]);
+			}
+		}
+	}
+
+	u32 getTriangleCount() const
+	{
+		return TriangleCount;
+	}
+
+	// collapses edges until at most targetCount triangles are left,
+	// or no edge can be collapsed anymore
+	void simplify(u32 targetCount)
+	{
+		while (TriangleCount > targetCount && !Heap.empty())
+		{
+			const SEdgeCollapse c = Heap.pop();
+
+			if (Removed[c.From] || Removed[c.To] ||
+				Stamps[c.From] != c.FromStamp || Stamps[c.To] != c.ToStamp)
+				continue;
+
+			if (canCollapse(c.From, c.To))
+				collapse(c.From, c.To);
+		}
+	}
+
+	// indices of the remaining triangles
+	void getIndices(core::array<u16>& indices) const
+	{
+		indices.set_used(0);
+		indices.reallocate(TriangleCount * 3);
+		for (u32 t=0; t<TriangleRemoved.size(); ++t)
+		{
+			if (TriangleRemoved[t])
+				continue;
+			indices.push_back(Triangles[3*t]);
+			indices.push_back(Triangles[3*t+1]);
+			indices.push_back(Triangles[3*t+2]);
+		}
+	}
+
+private:
+
+	// weight of the planes keeping open borders in place, relative to the surface
+	static const f64 BORDER_WEIGHT;
+
+	// vertices with the same position as another vertex are on a seam of
+	// normals or texture coordinates, moving them would tear the surface
+	void lockSeams()
+	{
+		core::array<SPositionIndex> sorted;
+		sorted.set_used(Positions.size());
+		for (u32 i=0; i<Positions.size(); ++i)
+		{
+			sorted[i].Position = Positions[i];
+			sorted[i].Index = (u16)i;
+		}
+		sorted.sort();
+
+		for (u32 i=1; i<sorted.size(); ++i)
+		{
+			if (sorted[i].Position == sorted[i-1].Position)
+			{
+				Locked[sorted[i].Index] = true;
+				Locked[sorted[i-1].Index] = true;
+			}
+		}
+	}
+
+	void computeQuadrics()
+	{
+		for (u32 t=0; t<TriangleRemoved.size(); ++t)
+		{
+			if (TriangleRemoved[t])
+				continue;
+
+			core::vector3d<f64> normal;
+			if (!getNormal(t, normal))
+				continue;
+
+			// planes weighted by the area of the triangle
+			const f64 length = sqrt(normal.getLengthSQ());
+			normal /= length;
+			const f64 area = length * 0.5;
+			const core::vector3d<f64> p0(Positions[Triangles[3*t]].X, Positions[Triangles[3*t]].Y, Positions[Triangles[3*t]].Z);
+			const f64 d = -normal.dotProduct(p0);
+
+			for (u32 k=0; k<3; ++k)
+			{
+				const u16 a = Triangles[3*t+k];
+				const u16 b = Triangles[3*t+(k+1)%3];
+				Quadrics[a].addPlane(normal, d, area);
+
+				if (countEdgeTriangles(a, b) != 1)
+					continue;
+
+				// open border, add a plane through the edge perpendicular to the triangle
+				const core::vector3d<f64> pa(Positions[a].X, Positions[a].Y, Positions[a].Z);
+				const core::vector3d<f64> pb(Positions[b].X, Positions[b].Y, Positions[b].Z);
+				const core::vector3d<f64> edge = pb - pa;
+				core::vector3d<f64> borderNormal = edge.crossProduct(normal);
+				const f64 length = sqrt(borderNormal.getLengthSQ());
+				if (length == 0.0)
+					continue;
+				borderNormal /= length;
+				const f64 borderD = -borderNormal.dotProduct(pa);
+				const f64 weight = BORDER_WEIGHT * edge.getLengthSQ();
+				Quadrics[a].addPlane(borderNormal, borderD, weight);
+				Quadrics[b].addPlane(borderNormal, borderD, weight);
+			}
+		}
+	}
+
+	// not normalized normal of a triangle, false if it has no area
+	bool getNormal(u32 t, core::vector3d<f64>& normal) const
+	{
+		const core::vector3df& p0 = Positions[Triangles[3*t]];
+		const core::vector3df& p1 = Positions[Triangles[3*t+1]];
+		const core::vector3df& p2 = Positions[Triangles[3*t+2]];
+		const core::vector3d<f64> e1(p1.X-p0.X, p1.Y-p0.Y, p1.Z-p0.Z);
+		const core::vector3d<f64> e2(p2.X-p0.X, p2.Y-p0.Y, p2.Z-p0.Z);
+		normal = e1.crossProduct(e2);
+		return normal.getLengthSQ() > 0.0;
+	}
+
+	bool hasVertex(u32 t, u16 v) const
+	{
+		return Triangles[3*t] == v || Triangles[3*t+1] == v || Triangles[3*t+2] == v;
+	}
+
+	u32 countEdgeTriangles(u16 a, u16 b) const
+	{
+		u32 count = 0;
+		const core::array<u32>& tris = VertexTriangles[a];
+		for (u32 i=0; i<tris.size(); ++i)
+		{
+			if (hasVertex(tris[i], b))
+				++count;
+		}
+		return count;
+	}
+
+	// fills Neighbors with the vertices sharing a triangle with v, each once
+	void gatherNeighbors(u16 v)
+	{
+		Neighbors.set_used(0);
+		++MarkCounter;
+		Marks[v] = MarkCounter;
+
+		const core::array<u32>& tris = VertexTriangles[v];
+		for (u32 i=0; i<tris.size(); ++i)
+		{
+			for (u32 k=0; k<3; ++k)
+			{
+				const u16 n = Triangles[3*tris[i]+k];
+				if (Marks[n] != MarkCounter)
+				{
+					Marks[n] = MarkCounter;
+					Neighbors.push_back(n);
+				}
+			}
+		}
+	}
+
+	void pushCollapse(u16 from, u16 to)
+	{
+		if (Locked[from])
+			return;
+
+		SEdgeCollapse c;
+		c.Cost = Quadrics[from].evaluate(Positions[to]) + Quadrics[to].evaluate(Positions[to]);
+		c.FromStamp = Stamps[from];
+		c.ToStamp = Stamps[to];
+		c.From = from;
+		c.To = to;
+		Heap.push(c);
+	}
+
+	void pushEdge(u16 a, u16 b)
+	{
+		pushCollapse(a, b);
+		pushCollapse(b, a);
+	}
+
+	bool canCollapse(u16 from, u16 to)
+	{
+		// the edge has to stay manifold: the vertices may only share the
+		// neighbors on the triangles of the edge, otherwise the collapse
+		// would fold the surface onto itself
+		const u32 edgeTriangles = countEdgeTriangles(from, to);
+		if (edgeTriangles == 0)
+			return false;
+
+		gatherNeighbors(from);
+		u32 common = 0;
+		const core::array<u32>& toTris = VertexTriangles[to];
+		const u32 mark = MarkCounter;
+		++MarkCounter;
+		for (u32 i=0; i<toTris.size(); ++i)
+		{
+			for (u32 k=0; k<3; ++k)
+			{
+				const u16 n = Triangles[3*toTris[i]+k];
+				if (Marks[n] == mark && n != from && n != to)
+				{
+					// count each common neighbor once
+					Marks[n] = MarkCounter;
+					++common;
+				}
+			}
+		}
+		if (common > edgeTriangles)
+			return false;
+
+		// reject collapses flipping or degenerating the moved triangles
+		const core::array<u32>& fromTris = VertexTriangles[from];
+		for (u32 i=0; i<fromTris.size(); ++i)
+		{
+			const u32 t = fromTris[i];
+			if (hasVertex(t, to))
+				continue;
+
+			core::vector3d<f64> oldNormal;
+			getNormal(t, oldNormal);
+
+			const core::vector3df p = Positions[from];
+			Positions[from] = Positions[to];
+			core::vector3d<f64> newNormal;
+			const bool valid = getNormal(t, newNormal);
+			Positions[from] = p;
+
+			if (!valid || oldNormal.dotProduct(newNormal) <= 0.2 * sqrt(oldNormal.getLengthSQ() * newNormal.getLengthSQ()))
+				return false;
+		}
+
+		return true;
+	}
+
+	void collapse(u16 from, u16 to)
+	{
+		core::array<u32>& fromTris = VertexTriangles[from];
+		for (u32 i=0; i<fromTris.size(); ++i)
+		{
+			const u32 t = fromTris[i];
+			if (hasVertex(t, to))
+			{
+				// triangles on the edge vanish
+				TriangleRemoved[t] = true;
+				--TriangleCount;
+				for (u32 k=0; k<3; ++k)
+				{
+					const u16 v = Triangles[3*t+k];
+					if (v != from)
+						removeVertexTriangle(v, t);
+				}
+			}
+			else
+			{
+				for (u32 k=0; k<3; ++k)
+				{
+					if (Triangles[3*t+k] == from)
+						Triangles[3*t+k] = to;
+				}
+				VertexTriangles[to].push_back(t);
+			}
+		}
+		fromTris.clear();
+		Removed[from] = true;
+
+		Quadrics[to] += Quadrics[from];
+		++Stamps[to];
+
+		// the costs of all edges of the kept vertex changed
+		gatherNeighbors(to);
+		for (u32 n=0; n<Neighbors.size(); ++n)
+		{
+			if (Neighbors[n] != to)
+				pushEdge(to, Neighbors[n]);
+		}
+	}
+
+	void removeVertexTriangle(u16 v, u32 t)
+	{
+		core::array<u32>& tris = VertexTriangles[v];
+		for (u32 i=0; i<tris.size(); ++i)
+		{
+			if (tris[i] == t)
+			{
+				tris[i] = tris.getLast();
+				tris.erase(tris.size()-1);
+				return;
+			}
+		}
+	}
+
+	core::array<core::vector3df> Positions;
+	core::array<SQuadric> Quadrics;
+	core::array<core::array<u32> > VertexTriangles;
+	core::array<u32> Stamps;
+	core::array<u32> Marks;
+	core::array<bool> Locked;
+	core::array<bool> Removed;
+
+	core::array<u16> Triangles;
+	core::array<bool> TriangleRemoved;
+	u32 TriangleCount;
+
+	CEdgeCollapseHeap Heap;
+	core::array<u16> Neighbors;
+	u32 MarkCounter;
+};
+
+const f64 CQuadricSimplifier::BORDER_WEIGHT = 100.0;
+
+// copies the vertices used by the indices into a new buffer
+template <class T>
+IMeshBuffer* createIndexedCopy(const IMeshBuffer* mb, const core::array<u16>& indices)
+{
+	CMeshBuffer<T>* buffer = new CMeshBuffer<T>();
+	buffer->Material = mb->getMaterial();
+	buffer->setHardwareMappingHint(mb->getHardwareMappingHint_Vertex(), EBT_VERTEX);
+	buffer->setHardwareMappingHint(mb->getHardwareMappingHint_Index(), EBT_INDEX);
+
+	const T* vertices = static_cast<const T*>(mb->getVertices());
+	core::array<u32> newIndex;
+	newIndex.set_used(mb->getVertexCount());
+	for (u32 i=0; i<newIndex.size(); ++i)
+		newIndex[i] = 0xffffffff;
+
+	// vertices in the order of their first use
+	buffer->Indices.reallocate(indices.size());
+	for (u32 i=0; i<indices.size(); ++i)
+	{
+		const u16 index = indices[i];
+		if (newIndex[index] == 0xffffffff)
+		{
+			newIndex[index] = buffer->Vertices.size();
+			buffer->Vertices.push_back(vertices[index]);
+		}
+		buffer->Indices.push_back((u16)newIndex[index]);
+	}
+
+	buffer->recalculateBoundingBox();
+	return buffer;
+}
+
+// simplifies all mesh buffers of a mesh to each of the ratios of their triangles,
+// the ratios have to decrease. Returns false if the mesh has 32 bit indices.
+bool createSimplifiedMeshes(IMesh* mesh, const core::array<f32>& ratios, core::array<SMesh*>& levels)
+{
+	const u32 meshBufferCount = mesh->getMeshBufferCount();
+	for (u32 b=0; b<meshBufferCount; ++b)
+	{
+		if (mesh->getMeshBuffer(b)->getIndexType() != video::EIT_16BIT)
+		{
+			os::Printer::log("Cannot simplify a mesh with 32bit indices", ELL_ERROR);
+			return false;
+		}
+	}
+
+	levels.set_used(ratios.size());
+	for (u32 l=0; l<levels.size(); ++l)
+		levels[l] = new SMesh();
+
+	core::array<u16> indices;
+	for (u32 b=0; b<meshBufferCount; ++b)
+	{
+		const IMeshBuffer* mb = mesh->getMeshBuffer(b);
+
+		// one run collapsing towards each ratio in turn
+		CQuadricSimplifier simplifier(mb);
+		const u32 triangleCount = simplifier.getTriangleCount();
+
+		for (u32 l=0; l<levels.size(); ++l)
+		{
+			const f32 ratio = core::clamp(ratios[l], 0.f, 1.f);
+			simplifier.simplify(core::max_(1u, (u32)(triangleCount * ratio)));
+			simplifier.getIndices(indices);
+
+			IMeshBuffer* buffer = 0;
+			switch(mb->getVertexType())
+			{
+			case video::EVT_STANDARD:
+				buffer = createIndexedCopy<video::S3DVertex>(mb, indices);
+				break;
+			case video::EVT_2TCOORDS:
+				buffer = createIndexedCopy<video::S3DVertex2TCoords>(mb, indices);
+				break;
+			case video::EVT_TANGENTS:
+				buffer = createIndexedCopy<video::S3DVertexTangents>(mb, indices);
+				break;
+			}
+			levels[l]->addMeshBuffer(buffer);
+			buffer->drop();
+		}
+	}
+
+	for (u32 l=0; l<levels.size(); ++l)
+		levels[l]->recalculateBoundingBox();
+
+	return true;
+}
+
+} // end anonymous namespace
+
+
+//! Creates a copy of a mesh with fewer triangles
+SMesh* CMeshManipulator::createSimplifiedMesh(IMesh* mesh, f32 ratio) const
+{
+	if (!mesh)
+		return 0;
+
+	core::array<f32> ratios;
+	ratios.push_back(ratio);
+	core::array<SMesh*> levels;
+	if (!createSimplifiedMeshes(mesh, ratios, levels))
+		return 0;
+
+	return levels[0];
+}
+
+
+//! Creates a level of detail chain of a mesh
+SLODMesh* CMeshManipulator::createLODMesh(IMesh* mesh, u32 levelCount, f32 ratio) const
+{
+	if (!mesh)
+		return 0;
+
+	SLODMesh* lod = new SLODMesh();
+	lod->addLevel(mesh, 0.5f);
+
+	// a level thresholded at size 0 would hide all levels after it
+	if (!(ratio > 0.f && ratio < 1.f))
+		return lod;
+
+	core::array<f32> ratios;
+	f32 levelRatio = 1.f;
+	for (u32 l=1; l<levelCount; ++l)
+	{
+		levelRatio *= ratio;
+		ratios.push_back(levelRatio);
+	}
+
+	core::array<SMesh*> levels;
+	if (!ratios.empty() && createSimplifiedMeshes(mesh, ratios, levels))
+	{
+		s32 polyCount = getPolyCount(mesh);
+		f32 minScreenSize = 0.5f;
+		for (u32 l=0; l<levels.size(); ++l)
+		{
+			// stop once the mesh can't be reduced any further
+			const s32 levelPolyCount = getPolyCount(levels[l]);
+			if (levelPolyCount < polyCount)
+			{
+				minScreenSize *= ratio;
+				lod->addLevel(levels[l], minScreenSize);
+				polyCount = levelPolyCount;
+			}
+			levels[l]->drop();
+		}
+	}
+
+	return lod;
+}
+
 } // end namespace scene
 } // end namespace irr
 
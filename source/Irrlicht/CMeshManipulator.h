@@ -87,6 +87,12 @@ public:
 	//! create a mesh optimized for the vertex cache
 	virtual IMesh* createForsythOptimizedMesh(const scene::IMesh *mesh) const _IRR_OVERRIDE_;
 
+	//! Creates a copy of a mesh with fewer triangles
+	virtual SMesh* createSimplifiedMesh(IMesh* mesh, f32 ratio) const _IRR_OVERRIDE_;
+
+	//! Creates a level of detail chain of a mesh
+	virtual SLODMesh* createLODMesh(IMesh* mesh, u32 levelCount=4, f32 ratio=0.5f) const _IRR_OVERRIDE_;
+
 	//! Optimizes the mesh using an algorithm tuned for heightmaps
 	virtual void heightmapOptimizeMesh(IMesh * const m, const f32 tolerance = core::ROUNDING_ERROR_f32) const _IRR_OVERRIDE_;
 
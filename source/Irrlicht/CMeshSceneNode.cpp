@@ -9,6 +9,7 @@
 #include "ICameraSceneNode.h"
 #include "IMeshCache.h"
 #include "IAnimatedMesh.h"
+#include "SLODMesh.h"
 #include "IMaterialRenderer.h"
 #include "IFileSystem.h"
 #ifdef _IRR_COMPILE_WITH_SHADOW_VOLUME_SCENENODE_
@@ -28,8 +29,8 @@ namespace scene
 CMeshSceneNode::CMeshSceneNode(IMesh* mesh, ISceneNode* parent, ISceneManager* mgr, s32 id,
 			const core::vector3df& position, const core::vector3df& rotation,
 			const core::vector3df& scale)
-: IMeshSceneNode(parent, mgr, id, position, rotation, scale), Mesh(0), Shadow(0),
-	PassCount(0), ReadOnlyMaterials(false)
+: IMeshSceneNode(parent, mgr, id, position, rotation, scale), Mesh(0), LODMesh(0),
+	Shadow(0), LODLevel(0), PassCount(0), ReadOnlyMaterials(false)
 {
 	#ifdef _DEBUG
 	setDebugName("CMeshSceneNode");
@@ -61,6 +62,9 @@ void CMeshSceneNode::OnRegisterSceneNode()
 
 		video::IVideoDriver* driver = SceneManager->getVideoDriver();
 
+		if (LODMesh)
+			selectLODLevel();
+
 		PassCount = 0;
 		int transparentCount = 0;
 		int solidCount = 0;
@@ -93,6 +97,17 @@ void CMeshSceneNode::OnRegisterSceneNode()
 }
 
 
+//! OnAnimate() is called just before rendering the whole scene.
+void CMeshSceneNode::OnAnimate(u32 timeMs)
+{
+	// the render passes are counted again each frame, also when the node
+	// didn't register again because the scene manager kept its render lists
+	PassCount = 0;
+
+	ISceneNode::OnAnimate(timeMs);
+}
+
+
 //! renders the node.
 void CMeshSceneNode::render()
 {
@@ -101,6 +116,11 @@ void CMeshSceneNode::render()
 	if (!Mesh || !driver)
 		return;
 
+	// the level of detail selected in OnRegisterSceneNode
+	IMesh* mesh = Mesh;
+	if (LODMesh && LODLevel < LODMesh->Levels.size())
+		mesh = LODMesh->Levels[LODLevel];
+
 	const bool isTransparentPass =
 		SceneManager->getSceneNodeRenderPass() == scene::ESNRP_TRANSPARENT;
 
@@ -121,12 +141,12 @@ void CMeshSceneNode::render()
 		// overwrite half transparency
 		if (DebugDataVisible & scene::EDS_HALF_TRANSPARENCY)
 		{
-			for (u32 g=0; g<Mesh->getMeshBufferCount(); ++g)
+			for (u32 g=0; g<mesh->getMeshBufferCount(); ++g)
 			{
 				mat = Materials[g];
 				mat.MaterialType = video::EMT_TRANSPARENT_ADD_COLOR;
 				driver->setMaterial(mat);
-				driver->drawMeshBuffer(Mesh->getMeshBuffer(g));
+				driver->drawMeshBuffer(mesh->getMeshBuffer(g));
 			}
 			renderMeshes = false;
 		}
@@ -135,9 +155,9 @@ void CMeshSceneNode::render()
 	// render original meshes
 	if (renderMeshes)
 	{
-		for (u32 i=0; i<Mesh->getMeshBufferCount(); ++i)
+		for (u32 i=0; i<mesh->getMeshBufferCount(); ++i)
 		{
-			scene::IMeshBuffer* mb = Mesh->getMeshBuffer(i);
+			scene::IMeshBuffer* mb = mesh->getMeshBuffer(i);
 			if (mb)
 			{
 				const video::SMaterial& material = ReadOnlyMaterials ? mb->getMaterial() : Materials[i];
@@ -169,10 +189,10 @@ void CMeshSceneNode::render()
 		}
 		if (DebugDataVisible & scene::EDS_BBOX_BUFFERS)
 		{
-			for (u32 g=0; g<Mesh->getMeshBufferCount(); ++g)
+			for (u32 g=0; g<mesh->getMeshBufferCount(); ++g)
 			{
 				driver->draw3DBox(
-					Mesh->getMeshBuffer(g)->getBoundingBox(),
+					mesh->getMeshBuffer(g)->getBoundingBox(),
 					video::SColor(255,190,128,128));
 			}
 		}
@@ -182,11 +202,11 @@ void CMeshSceneNode::render()
 			// draw normals
 			const f32 debugNormalLength = SceneManager->getParameters()->getAttributeAsFloat(DEBUG_NORMAL_LENGTH);
 			const video::SColor debugNormalColor = SceneManager->getParameters()->getAttributeAsColor(DEBUG_NORMAL_COLOR);
-			const u32 count = Mesh->getMeshBufferCount();
+			const u32 count = mesh->getMeshBufferCount();
 
 			for (u32 i=0; i != count; ++i)
 			{
-				driver->drawMeshBufferNormals(Mesh->getMeshBuffer(i), debugNormalLength, debugNormalColor);
+				driver->drawMeshBufferNormals(mesh->getMeshBuffer(i), debugNormalLength, debugNormalColor);
 			}
 		}
 
@@ -196,15 +216,43 @@ void CMeshSceneNode::render()
 			m.Wireframe = true;
 			driver->setMaterial(m);
 
-			for (u32 g=0; g<Mesh->getMeshBufferCount(); ++g)
+			for (u32 g=0; g<mesh->getMeshBufferCount(); ++g)
 			{
-				driver->drawMeshBuffer(Mesh->getMeshBuffer(g));
+				driver->drawMeshBuffer(mesh->getMeshBuffer(g));
 			}
 		}
 	}
 }
 
 
+//! Selects the level of detail of an SLODMesh from the size of the node on the screen
+void CMeshSceneNode::selectLODLevel()
+{
+	const ICameraSceneNode* camera = SceneManager->getActiveCamera();
+	if (!camera)
+		return;
+
+	// bounding sphere in world space
+	const core::aabbox3d<f32> box = getTransformedBoundingBox();
+	const f32 radius = box.getExtent().getLength() * 0.5f;
+
+	// diameter on the screen as fraction of the viewport height,
+	// the projection matrix scales y by the inverse of the half view height
+	const f32 projectionScale = camera->getProjectionMatrix()[5];
+	f32 screenSize = FLT_MAX;
+	if (camera->isOrthogonal())
+		screenSize = radius * projectionScale;
+	else
+	{
+		const f32 distance = camera->getAbsolutePosition().getDistanceFrom(box.getCenter());
+		if (distance > radius)
+			screenSize = radius * projectionScale / distance;
+	}
+
+	LODLevel = LODMesh->getLevel(screenSize, LODLevel);
+}
+
+
 //! Removes a child from this scene node.
 //! Implemented here, to be able to remove the shadow properly, if there is one,
 //! or to remove attached childs.
@@ -267,7 +315,12 @@ void CMeshSceneNode::setMesh(IMesh* mesh)
 			Mesh->drop();
 
 		Mesh = mesh;
+		LODMesh = 0;
+		LODLevel = 0;
+		if (mesh->getMeshType() == EAMT_LOD)
+			LODMesh = static_cast<SLODMesh*>(mesh);
 		copyMaterials();
+		markChanged();
 	}
 }
 
@@ -345,8 +398,9 @@ void CMeshSceneNode::deserializeAttributes(io::IAttributes* in, io::SAttributeRe
 		IMesh* newMesh = 0;
 		IAnimatedMesh* newAnimatedMesh = SceneManager->getMesh(newMeshStr.c_str());
 
+		// keep all levels of a level of detail chain
 		if (newAnimatedMesh)
-			newMesh = newAnimatedMesh->getMesh(0);
+			newMesh = newAnimatedMesh->getMeshType() == EAMT_LOD ? newAnimatedMesh : newAnimatedMesh->getMesh(0);
 
 		if (newMesh)
 			setMesh(newMesh);
@@ -390,6 +444,7 @@ referencing this mesh to change too. */
 void CMeshSceneNode::setReadOnlyMaterials(bool readonly)
 {
 	ReadOnlyMaterials = readonly;
+	markChanged();
 }
 
 
@@ -414,6 +469,7 @@ ISceneNode* CMeshSceneNode::clone(ISceneNode* newParent, ISceneManager* newManag
 	nb->cloneMembers(this, newManager);
 	nb->ReadOnlyMaterials = ReadOnlyMaterials;
 	nb->Materials = Materials;
+	nb->markChanged();
 	nb->Shadow = Shadow;
 	if ( nb->Shadow )
 		nb->Shadow->grab();
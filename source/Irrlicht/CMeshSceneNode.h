@@ -12,6 +12,7 @@ namespace irr
 {
 namespace scene
 {
+	struct SLODMesh;
 
 	class CMeshSceneNode : public IMeshSceneNode
 	{
@@ -29,6 +30,9 @@ namespace scene
 		//! frame
 		virtual void OnRegisterSceneNode() _IRR_OVERRIDE_;
 
+		//! OnAnimate() is called just before rendering the whole scene.
+		virtual void OnAnimate(u32 timeMs) _IRR_OVERRIDE_;
+
 		//! renders the node.
 		virtual void render() _IRR_OVERRIDE_;
 
@@ -84,14 +88,20 @@ namespace scene
 	protected:
 
 		void copyMaterials();
+		void selectLODLevel();
 
 		core::array<video::SMaterial> Materials;
 		core::aabbox3d<f32> Box;
 		video::SMaterial ReadOnlyMaterial;
 
 		IMesh* Mesh;
+		// Mesh, if it is an SLODMesh
+		SLODMesh* LODMesh;
 		IShadowVolumeSceneNode* Shadow;
 
+		// level of detail drawn in this frame
+		u32 LODLevel;
+
 		s32 PassCount;
 		bool ReadOnlyMaterials;
 	};
@@ -14,8 +14,14 @@
 #include "IAnimatedMeshSceneNode.h"
 #include "CMeshManipulator.h"
 #include "CColorConverter.h"
+#include "CImageCompressor.h"
 #include "IAttributeExchangingObject.h"
 #include "IRenderTarget.h"
+#include "EProfileIDs.h"
+#include "IProfiler.h"
+#include <atomic>
+#include <thread>
+#include <stdio.h>
 
 
 namespace irr
@@ -62,6 +68,9 @@ IImageLoader* createImageLoaderPPM();
 //! creates a loader which is able to load rgb images
 IImageLoader* createImageLoaderRGB();
 
+//! creates a loader which is able to load ktx images
+IImageLoader* createImageLoaderKTX();
+
 
 //! creates a writer which is able to save bmp images
 IImageWriter* createImageWriterBMP();
@@ -84,10 +93,14 @@ IImageWriter* createImageWriterPNG();
 //! creates a writer which is able to save ppm images
 IImageWriter* createImageWriterPPM();
 
+//! creates a writer which is able to save ktx images
+IImageWriter* createImageWriterKTX();
+
 //! constructor
 CNullDriver::CNullDriver(io::IFileSystem* io, const core::dimension2d<u32>& screenSize)
 	: SharedRenderTarget(0), CurrentRenderTarget(0), CurrentRenderTargetSize(0, 0), FileSystem(io), MeshManipulator(0),
-	ViewPort(0, 0, 0, 0), ScreenSize(screenSize), PrimitivesDrawn(0), MinVertexCountForVBO(500),
+	ViewPort(0, 0, 0, 0), ScreenSize(screenSize), PrimitivesDrawn(0),
+	IndexBytesUploaded(0), LastIndexBytesUploaded(0), MinVertexCountForVBO(500),
 	TextureCreationFlags(0), OverrideMaterial2DEnabled(false), AllowZWriteOnTransparent(false)
 {
 	#ifdef _DEBUG
@@ -119,6 +132,18 @@ CNullDriver::CNullDriver(io::IFileSystem* io, const core::dimension2d<u32>& scre
 
 	ViewPort = core::rect<s32>(core::position2d<s32>(0,0), core::dimension2di(screenSize));
 
+	IRR_PROFILE(
+		static bool initProfile = false;
+		if (!initProfile )
+		{
+			initProfile = true;
+			getProfiler().add(EPID_VD_LOAD_IMAGE, L"loadImage", L"Irrlicht video");
+			getProfiler().add(EPID_VD_LOAD_IMAGES, L"loadImages", L"Irrlicht video");
+			getProfiler().add(EPID_VD_CREATE_TEXTURE, L"createTexture", L"Irrlicht video");
+			getProfiler().add(EPID_VD_UPLOAD_TEXTURE, L"uploadTexture", L"Irrlicht video");
+		}
+	)
+
 	// create manipulator
 	MeshManipulator = new scene::CMeshManipulator();
 
@@ -164,6 +189,9 @@ CNullDriver::CNullDriver(io::IFileSystem* io, const core::dimension2d<u32>& scre
 #ifdef _IRR_COMPILE_WITH_BMP_LOADER_
 	SurfaceLoader.push_back(video::createImageLoaderBMP());
 #endif
+#ifdef _IRR_COMPILE_WITH_KTX_LOADER_
+	SurfaceLoader.push_back(video::createImageLoaderKTX());
+#endif
 
 
 #ifdef _IRR_COMPILE_WITH_PPM_WRITER_
@@ -187,6 +215,9 @@ CNullDriver::CNullDriver(io::IFileSystem* io, const core::dimension2d<u32>& scre
 #ifdef _IRR_COMPILE_WITH_BMP_WRITER_
 	SurfaceWriter.push_back(video::createImageWriterBMP());
 #endif
+#ifdef _IRR_COMPILE_WITH_KTX_WRITER_
+	SurfaceWriter.push_back(video::createImageWriterKTX());
+#endif
 
 
 	// set ExposedData to 0
@@ -320,14 +351,18 @@ void CNullDriver::deleteAllTextures()
 bool CNullDriver::beginScene(u16 clearFlag, SColor clearColor, f32 clearDepth, u8 clearStencil, const SExposedVideoData& videoData, core::rect<s32>* sourceRect)
 {
 	PrimitivesDrawn = 0;
+	FrameArena.reset();
 	return true;
 }
 
 bool CNullDriver::endScene()
 {
-	FPSCounter.registerFrame(os::Timer::getRealTime(), PrimitivesDrawn);
+	FPSCounter.registerFrame(os::Timer::getRealTimeUs(), PrimitivesDrawn);
+	LastIndexBytesUploaded = IndexBytesUploaded;
+	IndexBytesUploaded = 0;
 	updateAllHardwareBuffers();
-	updateAllOcclusionQueries();
+	// only collect the results which arrived, waiting would stall the pipeline
+	updateAllOcclusionQueries(false);
 	return true;
 }
 
@@ -446,6 +481,7 @@ ITexture* CNullDriver::addTexture(const core::dimension2d<u32>& size, const io::
 
 	if (checkImage(imageArray))
 	{
+		IRR_PROFILE(CProfileScope p1(EPID_VD_CREATE_TEXTURE);)
 		t = createDeviceDependentTexture(name, image);
 	}
 
@@ -478,6 +514,7 @@ ITexture* CNullDriver::addTexture(const io::path& name, IImage* image)
 
 	if (checkImage(imageArray))
 	{
+		IRR_PROFILE(CProfileScope p1(EPID_VD_CREATE_TEXTURE);)
 		t = createDeviceDependentTexture(name, image);
 	}
 
@@ -647,6 +684,122 @@ ITexture* CNullDriver::getTexture(io::IReadFile* file)
 }
 
 
+namespace
+{
+	//! 64 bit FNV-1a hash of the whole contents of a file
+	u64 hashFileContents(io::IReadFile* file, u64 hash)
+	{
+		const u64 prime = 0x100000001b3ULL;
+		const long size = file->getSize();
+
+		const u8* buffer = static_cast<const u8*>(file->getBuffer());
+		if (buffer)
+		{
+			for (long i = 0; i < size; ++i)
+				hash = (hash ^ buffer[i]) * prime;
+			return hash;
+		}
+
+		u8 chunk[16384];
+		for (long pos = 0; pos < size; )
+		{
+			const size_t r = file->readAt(pos, chunk, sizeof(chunk));
+			if (r == 0)
+				break;
+
+			for (size_t i = 0; i < r; ++i)
+				hash = (hash ^ chunk[i]) * prime;
+			pos += (long)r;
+		}
+		return hash;
+	}
+}
+
+
+//! loads the images of a texture file, block compressed through the compressed texture cache
+core::array<IImage*> CNullDriver::createBlockCompressedImages(io::IReadFile* file, E_TEXTURE_TYPE* type)
+{
+	ECOLOR_FORMAT opaqueFormat;
+	ECOLOR_FORMAT alphaFormat;
+
+	if (queryFeature(EVDF_TEXTURE_COMPRESSED_DXT))
+	{
+		opaqueFormat = ECF_DXT1;
+		alphaFormat = ECF_DXT5;
+	}
+	else if (queryFeature(EVDF_TEXTURE_COMPRESSED_ETC2))
+	{
+		opaqueFormat = ECF_ETC2_RGB;
+		alphaFormat = ECF_ETC2_ARGB;
+	}
+	else
+	{
+		return createImagesFromFile(file, type);
+	}
+
+	if (getTextureCreationFlag(ETCF_NO_ALPHA_CHANNEL))
+		alphaFormat = opaqueFormat;
+
+	const bool mipMaps = getTextureCreationFlag(ETCF_CREATE_MIP_MAPS);
+
+	// the name depends on everything which changes the compressed image
+	io::path cacheName;
+	if (CompressedTextureCache.size())
+	{
+		u64 hash = 0xcbf29ce484222325ULL;
+		hash = (hash ^ (opaqueFormat | alphaFormat << 8 | (u32)mipMaps << 16)) * 0x100000001b3ULL;
+		hash = hashFileContents(file, hash);
+
+		c8 name[32];
+		snprintf(name, sizeof(name), "%016llx.ktx", (unsigned long long)hash);
+
+		cacheName = CompressedTextureCache;
+		if (cacheName.lastChar() != '/')
+			cacheName += '/';
+		cacheName += name;
+
+		if (FileSystem->existFile(cacheName))
+		{
+			core::array<IImage*> imageArray = createImagesFromFile(cacheName, type);
+			if (imageArray.size() == 1 && imageArray[0])
+				return imageArray;
+
+			for (u32 i = 0; i < imageArray.size(); ++i)
+			{
+				if (imageArray[i])
+					imageArray[i]->drop();
+			}
+			os::Printer::log("Could not load compressed texture from the cache", cacheName, ELL_WARNING);
+		}
+	}
+
+	core::array<IImage*> imageArray = createImagesFromFile(file, type);
+
+	if (imageArray.size() != 1 || !imageArray[0] || (type && *type != ETT_2D) ||
+		IImage::isCompressedFormat(imageArray[0]->getColorFormat()))
+		return imageArray;
+
+	// sizes the driver would rescale are left uncompressed, compressed images can't be scaled
+	const core::dimension2du& size = imageArray[0]->getDimension();
+	const s32 maxTextureSize = DriverAttributes->getAttributeAsInt("MaxTextureSize");
+	if (size.getOptimalSize(!queryFeature(EVDF_TEXTURE_NPOT), !queryFeature(EVDF_TEXTURE_NSQUARE), true,
+		maxTextureSize > 0 ? (u32)maxTextureSize : 0) != size)
+		return imageArray;
+
+	IImage* compressed = CImageCompressor::createCompressedImage(imageArray[0], opaqueFormat, alphaFormat, mipMaps, 0);
+	if (!compressed)
+		return imageArray;
+
+	imageArray[0]->drop();
+	imageArray[0] = compressed;
+
+	if (cacheName.size() && !writeImageToFile(compressed, cacheName))
+		os::Printer::log("Could not write compressed texture to the cache", cacheName, ELL_WARNING);
+
+	return imageArray;
+}
+
+
 //! opens the file and loads it into the surface
 video::ITexture* CNullDriver::loadTextureFromFile(io::IReadFile* file, const io::path& hashName )
 {
@@ -654,10 +807,13 @@ video::ITexture* CNullDriver::loadTextureFromFile(io::IReadFile* file, const io:
 
 	E_TEXTURE_TYPE type = ETT_2D;
 
-	core::array<IImage*> imageArray = createImagesFromFile(file, &type);
+	core::array<IImage*> imageArray = getTextureCreationFlag(ETCF_BLOCK_COMPRESSION) ?
+		createBlockCompressedImages(file, &type) : createImagesFromFile(file, &type);
 
 	if (checkImage(imageArray))
 	{
+		IRR_PROFILE(CProfileScope p1(EPID_VD_CREATE_TEXTURE);)
+
 		switch (type)
 		{
 		case ETT_2D:
@@ -1053,6 +1209,13 @@ u32 CNullDriver::getPrimitiveCountDrawn( u32 param ) const
 }
 
 
+//! Returns the size of the index data uploaded to hardware buffers in the last frame.
+u32 CNullDriver::getIndexBytesUploaded() const
+{
+	return LastIndexBytesUploaded;
+}
+
+
 
 //! Sets the dynamic ambient light color. The default color is
 //! (0,0,0,0) which means it is dark.
@@ -1545,6 +1708,20 @@ bool CNullDriver::getTextureCreationFlag(E_TEXTURE_CREATION_FLAG flag) const
 	return (TextureCreationFlags & flag)!=0;
 }
 
+
+//! Sets the directory in which block compressed textures are cached.
+void CNullDriver::setCompressedTextureCache(const io::path& directory)
+{
+	CompressedTextureCache = directory;
+}
+
+
+//! Returns the directory in which block compressed textures are cached.
+const io::path& CNullDriver::getCompressedTextureCache() const
+{
+	return CompressedTextureCache;
+}
+
 core::array<IImage*> CNullDriver::createImagesFromFile(const io::path& filename, E_TEXTURE_TYPE* type)
 {
 	// TO-DO -> use 'move' feature from C++11 standard.
@@ -1567,62 +1744,174 @@ core::array<IImage*> CNullDriver::createImagesFromFile(const io::path& filename,
 	return imageArray;
 }
 
-core::array<IImage*> CNullDriver::createImagesFromFile(io::IReadFile* file, E_TEXTURE_TYPE* type)
+namespace
 {
-	// TO-DO -> use 'move' feature from C++11 standard.
-
-	core::array<IImage*> imageArray;
-
-	if (file)
+	//! Loads the images of a file with the first loader which succeeds
+	/** Only uses the loaders and the file, so it can run on several threads at once. */
+	core::array<IImage*> loadImages(const core::array<IImageLoader*>& loaders, io::IReadFile* file, E_TEXTURE_TYPE* type)
 	{
-		s32 i;
+		// TO-DO -> use 'move' feature from C++11 standard.
 
-		// try to load file based on file extension
-		for (i = SurfaceLoader.size() - 1; i >= 0; --i)
+		core::array<IImage*> imageArray;
+
+		if (file)
 		{
-			if (SurfaceLoader[i]->isALoadableFileExtension(file->getFileName()))
-			{
-				// reset file position which might have changed due to previous loadImage calls
-				file->seek(0);
-				imageArray = SurfaceLoader[i]->loadImages(file, type);
+			s32 i;
 
-				if (imageArray.size() == 0)
+			// try to load file based on file extension
+			for (i = loaders.size() - 1; i >= 0; --i)
+			{
+				if (loaders[i]->isALoadableFileExtension(file->getFileName()))
 				{
+					// reset file position which might have changed due to previous loadImage calls
 					file->seek(0);
-					IImage* image = SurfaceLoader[i]->loadImage(file);
+					imageArray = loaders[i]->loadImages(file, type);
 
-					if (image)
-						imageArray.push_back(image);
-				}
+					if (imageArray.size() == 0)
+					{
+						file->seek(0);
+						IImage* image = loaders[i]->loadImage(file);
+
+						if (image)
+							imageArray.push_back(image);
+					}
 
-				if (imageArray.size() > 0)
-					return imageArray;
+					if (imageArray.size() > 0)
+						return imageArray;
+				}
 			}
-		}
 
-		// try to load file based on what is in it
-		for (i = SurfaceLoader.size() - 1; i >= 0; --i)
-		{
-			// dito
-			file->seek(0);
-			if (SurfaceLoader[i]->isALoadableFileFormat(file))
+			// try to load file based on what is in it
+			for (i = loaders.size() - 1; i >= 0; --i)
 			{
+				// dito
 				file->seek(0);
-				imageArray = SurfaceLoader[i]->loadImages(file, type);
-
-				if (imageArray.size() == 0)
+				if (loaders[i]->isALoadableFileFormat(file))
 				{
 					file->seek(0);
-					IImage* image = SurfaceLoader[i]->loadImage(file);
+					imageArray = loaders[i]->loadImages(file, type);
 
-					if (image)
-						imageArray.push_back(image);
-				}
+					if (imageArray.size() == 0)
+					{
+						file->seek(0);
+						IImage* image = loaders[i]->loadImage(file);
+
+						if (image)
+							imageArray.push_back(image);
+					}
 
-				if (imageArray.size() > 0)
-					return imageArray;
+					if (imageArray.size() > 0)
+						return imageArray;
+				}
 			}
 		}
+
+		return imageArray;
+	}
+
+	//! A batch of files decoded by several threads
+	struct SImageDecodeBatch
+	{
+		SImageDecodeBatch(const core::array<IImageLoader*>& loaders,
+				const core::array<io::IReadFile*>& files, core::array<IImage*>& images)
+			: Loaders(loaders), Files(files), Images(images), Messages(files.size()), Next(0)
+		{
+			for (u32 i = 0; i < files.size(); ++i)
+				Messages.push_back(core::array<os::Printer::SMessage>());
+		}
+
+		const core::array<IImageLoader*>& Loaders;
+		const core::array<io::IReadFile*>& Files;
+		//! Each thread only writes the entries of the files it took
+		core::array<IImage*>& Images;
+		//! Messages of the loaders for each file, logged by the calling thread
+		core::array<core::array<os::Printer::SMessage> > Messages;
+		//! Index of the next file which no thread took yet
+		std::atomic<u32> Next;
+	};
+
+	//! Decodes files of the batch until all are taken
+	void decodeImages(SImageDecodeBatch* batch)
+	{
+		u32 i;
+		while ((i = batch->Next.fetch_add(1, std::memory_order_relaxed)) < batch->Files.size())
+		{
+			// CProfileScope would touch the profile data of the main thread
+			IRR_PROFILE(CProfileTraceScope p1(EPID_VD_LOAD_IMAGE);)
+
+			os::Printer::setThreadMessages(&batch->Messages[i]);
+			core::array<IImage*> imageArray = loadImages(batch->Loaders, batch->Files[i], 0);
+			os::Printer::setThreadMessages(0);
+
+			for (u32 j = 1; j < imageArray.size(); ++j)
+				imageArray[j]->drop();
+
+			batch->Images[i] = (imageArray.size() > 0) ? imageArray[0] : 0;
+		}
+	}
+}
+
+core::array<IImage*> CNullDriver::createImagesFromFile(io::IReadFile* file, E_TEXTURE_TYPE* type)
+{
+	IRR_PROFILE(CProfileScope p1(EPID_VD_LOAD_IMAGE);)
+
+	return loadImages(SurfaceLoader, file, type);
+}
+
+core::array<IImage*> CNullDriver::createImagesFromFiles(const core::array<io::path>& filenames, u32 threadCount)
+{
+	// the file system is not thread safe, so only the decoding runs in parallel
+	core::array<io::IReadFile*> files(filenames.size());
+	for (u32 i = 0; i < filenames.size(); ++i)
+	{
+		io::IReadFile* file = FileSystem->createAndOpenFile(filenames[i]);
+		if (!file)
+			os::Printer::log("Could not open file of image", filenames[i], ELL_WARNING);
+		files.push_back(file);
+	}
+
+	core::array<IImage*> imageArray = createImagesFromFiles(files, threadCount);
+
+	for (u32 i = 0; i < files.size(); ++i)
+	{
+		if (files[i])
+			files[i]->drop();
+	}
+
+	return imageArray;
+}
+
+core::array<IImage*> CNullDriver::createImagesFromFiles(const core::array<io::IReadFile*>& files, u32 threadCount)
+{
+	IRR_PROFILE(CProfileScope p1(EPID_VD_LOAD_IMAGES);)
+
+	core::array<IImage*> imageArray;
+	imageArray.set_used(files.size());
+	for (u32 i = 0; i < imageArray.size(); ++i)
+		imageArray[i] = 0;
+
+	if (threadCount == 0)
+		threadCount = std::thread::hardware_concurrency();
+	threadCount = core::clamp(threadCount, 1u, core::max_(files.size(), 1u));
+
+	SImageDecodeBatch batch(SurfaceLoader, files, imageArray);
+
+	// the calling thread is one of the decoding threads
+	std::thread* threads = new std::thread[threadCount - 1];
+	for (u32 i = 0; i < threadCount - 1; ++i)
+		threads[i] = std::thread(decodeImages, &batch);
+
+	decodeImages(&batch);
+
+	for (u32 i = 0; i < threadCount - 1; ++i)
+		threads[i].join();
+	delete [] threads;
+
+	for (u32 i = 0; i < files.size(); ++i)
+	{
+		os::Printer::logMessages(batch.Messages[i]);
+		if (files[i] && !imageArray[i])
+			os::Printer::log("Could not load image", files[i]->getFileName(), ELL_WARNING);
 	}
 
 	return imageArray;
@@ -1781,6 +2070,42 @@ void CNullDriver::drawMeshBuffer(const scene::IMeshBuffer* mb)
 }
 
 
+//! Draws parts of the index list of a mesh buffer
+void CNullDriver::drawMeshBufferRanges(const scene::IMeshBuffer* mb, const SIndexRange* ranges, u32 rangeCount)
+{
+	if (!mb || !rangeCount)
+		return;
+
+	SHWBufferLink *HWBuffer=getBufferLink(mb);
+
+	if (HWBuffer)
+		drawHardwareBufferRanges(HWBuffer, ranges, rangeCount);
+	else
+		drawIndexRanges(mb, ranges, rangeCount);
+}
+
+
+//! Draw parts of the indices of a hardware buffer, as triangle lists
+void CNullDriver::drawHardwareBufferRanges(SHWBufferLink *HWBuffer, const SIndexRange* ranges, u32 rangeCount)
+{
+	drawIndexRanges(HWBuffer->MeshBuffer, ranges, rangeCount);
+}
+
+
+//! Draws the ranges from the indices in memory, one draw call per range
+void CNullDriver::drawIndexRanges(const scene::IMeshBuffer* mb, const SIndexRange* ranges, u32 rangeCount)
+{
+	const u32 indexSize = (mb->getIndexType() == EIT_16BIT) ? sizeof(u16) : sizeof(u32);
+
+	for (u32 i=0; i<rangeCount; ++i)
+	{
+		drawVertexPrimitiveList(mb->getVertices(), mb->getVertexCount(),
+			(const u8*)mb->getIndices() + ranges[i].Start * indexSize, ranges[i].Count / 3,
+			mb->getVertexType(), scene::EPT_TRIANGLES, mb->getIndexType());
+	}
+}
+
+
 //! Draws the normals of a mesh buffer
 void CNullDriver::drawMeshBufferNormals(const scene::IMeshBuffer* mb, f32 length, SColor color)
 {
@@ -1805,7 +2130,7 @@ CNullDriver::SHWBufferLink *CNullDriver::getBufferLink(const scene::IMeshBuffer*
 		return 0;
 
 	//search for hardware links
-	core::map< const scene::IMeshBuffer*,SHWBufferLink* >::Node* node = HWBufferMap.find(mb);
+	core::hash_map< const scene::IMeshBuffer*,SHWBufferLink* >::Node* node = HWBufferMap.find(mb);
 	if (node)
 		return node->getValue();
 
@@ -1816,7 +2141,9 @@ CNullDriver::SHWBufferLink *CNullDriver::getBufferLink(const scene::IMeshBuffer*
 //! Update all hardware buffers, remove unused ones
 void CNullDriver::updateAllHardwareBuffers()
 {
-	core::map<const scene::IMeshBuffer*,SHWBufferLink*>::ParentFirstIterator Iterator=HWBufferMap.getParentFirstIterator();
+	// deleting changes the map, so the unused links are collected first
+	core::array<SHWBufferLink*> unused;
+	core::hash_map<const scene::IMeshBuffer*,SHWBufferLink*>::Iterator Iterator=HWBufferMap.getIterator();
 
 	for (;!Iterator.atEnd();Iterator++)
 	{
@@ -1824,13 +2151,11 @@ void CNullDriver::updateAllHardwareBuffers()
 
 		Link->LastUsed++;
 		if (Link->LastUsed>20000)
-		{
-			deleteHardwareBuffer(Link);
-
-			// todo: needs better fix
-			Iterator = HWBufferMap.getParentFirstIterator();
-		}
+			unused.push_back(Link);
 	}
+
+	for (u32 i=0; i<unused.size(); ++i)
+		deleteHardwareBuffer(unused[i]);
 }
 
 
@@ -1846,7 +2171,7 @@ void CNullDriver::deleteHardwareBuffer(SHWBufferLink *HWBuffer)
 //! Remove hardware buffer
 void CNullDriver::removeHardwareBuffer(const scene::IMeshBuffer* mb)
 {
-	core::map<const scene::IMeshBuffer*,SHWBufferLink*>::Node* node = HWBufferMap.find(mb);
+	core::hash_map<const scene::IMeshBuffer*,SHWBufferLink*>::Node* node = HWBufferMap.find(mb);
 	if (node)
 		deleteHardwareBuffer(node->getValue());
 }
@@ -1855,8 +2180,13 @@ void CNullDriver::removeHardwareBuffer(const scene::IMeshBuffer* mb)
 //! Remove all hardware buffers
 void CNullDriver::removeAllHardwareBuffers()
 {
-	while (HWBufferMap.size())
-		deleteHardwareBuffer(HWBufferMap.getRoot()->getValue());
+	core::array<SHWBufferLink*> links(HWBufferMap.size());
+	core::hash_map<const scene::IMeshBuffer*,SHWBufferLink*>::Iterator Iterator=HWBufferMap.getIterator();
+	for (;!Iterator.atEnd();Iterator++)
+		links.push_back(Iterator.getNode()->getValue());
+
+	for (u32 i=0; i<links.size(); ++i)
+		deleteHardwareBuffer(links[i]);
 }
 
 
@@ -1891,7 +2221,7 @@ void CNullDriver::addOcclusionQuery(scene::ISceneNode* node, const scene::IMesh*
 	}
 
 	//search for query
-	s32 index = OcclusionQueries.linear_search(SOccQuery(node));
+	s32 index = findOcclusionQuery(node);
 	if (index != -1)
 	{
 		if (OcclusionQueries[index].Mesh != mesh)
@@ -1904,6 +2234,7 @@ void CNullDriver::addOcclusionQuery(scene::ISceneNode* node, const scene::IMesh*
 	else
 	{
 		OcclusionQueries.push_back(SOccQuery(node, mesh));
+		OcclusionQueryIndices.insert(node, OcclusionQueries.size()-1);
 		node->setAutomaticCulling(node->getAutomaticCulling() | scene::EAC_OCC_QUERY);
 	}
 }
@@ -1913,15 +2244,28 @@ void CNullDriver::addOcclusionQuery(scene::ISceneNode* node, const scene::IMesh*
 void CNullDriver::removeOcclusionQuery(scene::ISceneNode* node)
 {
 	//search for query
-	s32 index = OcclusionQueries.linear_search(SOccQuery(node));
+	s32 index = findOcclusionQuery(node);
 	if (index != -1)
 	{
 		node->setAutomaticCulling(node->getAutomaticCulling() & ~scene::EAC_OCC_QUERY);
+		OcclusionQueryIndices.remove(node);
 		OcclusionQueries.erase(index);
+
+		// the following queries moved down by one
+		for (u32 i=index; i<OcclusionQueries.size(); ++i)
+			OcclusionQueryIndices.find(OcclusionQueries[i].Node)->setValue(i);
 	}
 }
 
 
+//! Returns the index of the occlusion query of a node in OcclusionQueries, or -1
+s32 CNullDriver::findOcclusionQuery(const scene::ISceneNode* node) const
+{
+	const core::hash_map<const scene::ISceneNode*, u32>::Node* n = OcclusionQueryIndices.find(node);
+	return n ? (s32)n->getValue() : -1;
+}
+
+
 //! Remove all occlusion queries.
 void CNullDriver::removeAllOcclusionQueries()
 {
@@ -1939,10 +2283,12 @@ void CNullDriver::runOcclusionQuery(scene::ISceneNode* node, bool visible)
 {
 	if(!node)
 		return;
-	s32 index = OcclusionQueries.linear_search(SOccQuery(node));
+	s32 index = findOcclusionQuery(node);
 	if (index==-1)
 		return;
 	OcclusionQueries[index].Run=0;
+	// unknown until the new result arrived
+	OcclusionQueries[index].Result=~0u;
 	if (!visible)
 	{
 		SMaterial mat;
@@ -2663,6 +3009,13 @@ scene::IMeshManipulator* CNullDriver::getMeshManipulator()
 }
 
 
+//! Returns the arena for scratch memory of the current frame.
+core::frame_arena* CNullDriver::getFrameArena()
+{
+	return &FrameArena;
+}
+
+
 //! Returns an image created from the last rendered frame.
 IImage* CNullDriver::createScreenShot(video::ECOLOR_FORMAT format, video::E_RENDER_TARGET target)
 {
@@ -11,7 +11,7 @@
 #include "IGPUProgrammingServices.h"
 #include "irrArray.h"
 #include "irrString.h"
-#include "irrMap.h"
+#include "irrHashMap.h"
 #include "IAttributes.h"
 #include "IMesh.h"
 #include "IMeshBuffer.h"
@@ -253,6 +253,9 @@ namespace video
 		//! very useful method for statistics.
 		virtual u32 getPrimitiveCountDrawn( u32 param = 0 ) const _IRR_OVERRIDE_;
 
+		//! Returns the size of the index data uploaded to hardware buffers in the last frame.
+		virtual u32 getIndexBytesUploaded() const _IRR_OVERRIDE_;
+
 		//! deletes all dynamic lights there are
 		virtual void deleteAllDynamicLights() _IRR_OVERRIDE_;
 
@@ -350,10 +353,20 @@ namespace video
 		//! Returns if a texture creation flag is enabled or disabled.
 		virtual bool getTextureCreationFlag(E_TEXTURE_CREATION_FLAG flag) const _IRR_OVERRIDE_;
 
+		//! Sets the directory in which block compressed textures are cached.
+		virtual void setCompressedTextureCache(const io::path& directory) _IRR_OVERRIDE_;
+
+		//! Returns the directory in which block compressed textures are cached.
+		virtual const io::path& getCompressedTextureCache() const _IRR_OVERRIDE_;
+
 		virtual core::array<IImage*> createImagesFromFile(const io::path& filename, E_TEXTURE_TYPE* type = 0) _IRR_OVERRIDE_;
 
 		virtual core::array<IImage*> createImagesFromFile(io::IReadFile* file, E_TEXTURE_TYPE* type = 0) _IRR_OVERRIDE_;
 
+		virtual core::array<IImage*> createImagesFromFiles(const core::array<io::path>& filenames, u32 threadCount = 0) _IRR_OVERRIDE_;
+
+		virtual core::array<IImage*> createImagesFromFiles(const core::array<io::IReadFile*>& files, u32 threadCount = 0) _IRR_OVERRIDE_;
+
 		//! Creates a software image from a byte array.
 		/** \param useForeignMemory: If true, the image will use the data pointer
 		directly and own it from now on, which means it will also try to delete [] the
@@ -381,6 +394,10 @@ namespace video
 		//! Draws a mesh buffer
 		virtual void drawMeshBuffer(const scene::IMeshBuffer* mb) _IRR_OVERRIDE_;
 
+		//! Draws parts of the index list of a mesh buffer
+		virtual void drawMeshBufferRanges(const scene::IMeshBuffer* mb,
+			const SIndexRange* ranges, u32 rangeCount) _IRR_OVERRIDE_;
+
 		//! Draws the normals of a mesh buffer
 		virtual void drawMeshBufferNormals(const scene::IMeshBuffer* mb, f32 length=10.f,
 			SColor color=0xffffffff) _IRR_OVERRIDE_;
@@ -426,12 +443,22 @@ namespace video
 		//! Draw hardware buffer (only some drivers can)
 		virtual void drawHardwareBuffer(SHWBufferLink *HWBuffer) {}
 
+		//! Draw parts of the indices of a hardware buffer, as triangle lists
+		/** Drivers which can't draw hardware buffers draw the ranges from the mesh buffer. */
+		virtual void drawHardwareBufferRanges(SHWBufferLink *HWBuffer, const SIndexRange* ranges, u32 rangeCount);
+
+		//! Draws the ranges from the indices in memory, one draw call per range
+		void drawIndexRanges(const scene::IMeshBuffer* mb, const SIndexRange* ranges, u32 rangeCount);
+
 		//! Delete hardware buffer
 		virtual void deleteHardwareBuffer(SHWBufferLink *HWBuffer);
 
 		//! Create hardware buffer from mesh (only some drivers can)
 		virtual SHWBufferLink *createHardwareBuffer(const scene::IMeshBuffer* mb) {return 0;}
 
+		//! Returns the index of the occlusion query of a node in OcclusionQueries, or -1
+		s32 findOcclusionQuery(const scene::ISceneNode* node) const;
+
 	public:
 		//! Remove hardware buffer
 		virtual void removeHardwareBuffer(const scene::IMeshBuffer* mb) _IRR_OVERRIDE_;
@@ -604,6 +631,9 @@ namespace video
 		//! Returns a pointer to the mesh manipulator.
 		virtual scene::IMeshManipulator* getMeshManipulator() _IRR_OVERRIDE_;
 
+		//! Returns the arena for scratch memory of the current frame.
+		virtual core::frame_arena* getFrameArena() _IRR_OVERRIDE_;
+
 		virtual void clearBuffers(u16 flag, SColor color = SColor(255,0,0,0), f32 depth = 1.f, u8 stencil = 0) _IRR_OVERRIDE_;
 
 		//! Returns an image created from the last rendered frame.
@@ -699,6 +729,9 @@ namespace video
 		//! opens the file and loads it into the surface
 		ITexture* loadTextureFromFile(io::IReadFile* file, const io::path& hashName = "");
 
+		//! loads the images of a texture file, block compressed through the compressed texture cache
+		core::array<IImage*> createBlockCompressedImages(io::IReadFile* file, E_TEXTURE_TYPE* type);
+
 		//! adds a surface, not loaded or created by the Irrlicht Engine
 		void addTexture(ITexture* surface);
 		
@@ -819,15 +852,20 @@ namespace video
 
 			SOccQuery& operator=(const SOccQuery& other)
 			{
+				// grab first in case other holds the same node or mesh
+				if (other.Node)
+					other.Node->grab();
+				if (other.Mesh)
+					other.Mesh->grab();
+				if (Node)
+					Node->drop();
+				if (Mesh)
+					Mesh->drop();
 				Node=other.Node;
 				Mesh=other.Mesh;
 				PID=other.PID;
 				Result=other.Result;
 				Run=other.Run;
-				if (Node)
-					Node->grab();
-				if (Mesh)
-					Mesh->grab();
 				return *this;
 			}
 
@@ -847,6 +885,7 @@ namespace video
 			u32 Run;
 		};
 		core::array<SOccQuery> OcclusionQueries;
+		core::hash_map<const scene::ISceneNode*, u32> OcclusionQueryIndices;
 
 		core::array<IRenderTarget*> RenderTargets;
 
@@ -863,7 +902,7 @@ namespace video
 		core::array<SMaterialRenderer> MaterialRenderers;
 
 		//core::array<SHWBufferLink*> HWBufferLinks;
-		core::map< const scene::IMeshBuffer* , SHWBufferLink* > HWBufferMap;
+		core::hash_map< const scene::IMeshBuffer* , SHWBufferLink* > HWBufferMap;
 
 		io::IFileSystem* FileSystem;
 
@@ -876,10 +915,18 @@ namespace video
 
 		CFPSCounter FPSCounter;
 
+		//! scratch memory, reset by beginScene
+		core::frame_arena FrameArena;
+
 		u32 PrimitivesDrawn;
+
+		//! index bytes uploaded since the last endScene, and in the last frame
+		u32 IndexBytesUploaded;
+		u32 LastIndexBytesUploaded;
 		u32 MinVertexCountForVBO;
 
 		u32 TextureCreationFlags;
+		io::path CompressedTextureCache;
 
 		f32 FogStart;
 		f32 FogEnd;
@@ -66,8 +66,9 @@ IAnimatedMesh* COBJMeshFileLoader::createMesh(io::IReadFile* file)
 	if (!file)
 		return 0;
 
-	const long filesize = file->getSize();
-	if (!filesize)
+	// the mesh starts at the current position of the file
+	const long filesize = file->getSize() - file->getPos();
+	if (filesize <= 0)
 		return 0;
 
 	const u32 WORD_BUFFER_LENGTH = 512;
@@ -83,9 +84,18 @@ IAnimatedMesh* COBJMeshFileLoader::createMesh(io::IReadFile* file)
 	const io::path fullName = file->getFileName();
 	const io::path relPath = FileSystem->getFileDir(fullName)+"/";
 
-	c8* buf = new c8[filesize];
-	memset(buf, 0, filesize);
-	file->read((void*)buf, filesize);
+	// parse straight from the file's memory if it has some
+	const c8* buf = (const c8*)file->getBuffer();
+	c8* bufCopy = 0;
+	if (buf)
+		buf += file->getPos();
+	else
+	{
+		bufCopy = new c8[filesize];
+		memset(bufCopy, 0, filesize);
+		file->read((void*)bufCopy, filesize);
+		buf = bufCopy;
+	}
 	const c8* const bufEnd = buf+filesize;
 
 	// Process obj information
@@ -236,7 +246,7 @@ IAnimatedMesh* COBJMeshFileLoader::createMesh(io::IReadFile* file)
 				else
 				{
 					os::Printer::log("Invalid vertex index in this line:", wordBuffer.c_str(), ELL_ERROR);
-					delete [] buf;
+					delete [] bufCopy;
 					return 0;
 				}
 				if ( -1 != Idx[1] && Idx[1] < (irr::s32)textureCoordBuffer.size() )
@@ -343,7 +353,7 @@ IAnimatedMesh* COBJMeshFileLoader::createMesh(io::IReadFile* file)
 	}
 
 	// Clean up the allocate obj file contents
-	delete [] buf;
+	delete [] bufCopy;
 	// more cleaning up
 	cleanUp();
 	mesh->drop();
@@ -40,7 +40,7 @@ COGLES2Driver::COGLES2Driver(const SIrrlichtCreationParameters& params, io::IFil
 	MaterialRenderer2DActive(0), MaterialRenderer2DTexture(0), MaterialRenderer2DNoTexture(0),
 	CurrentRenderMode(ERM_NONE), Transformation3DChanged(true),
 	OGLES2ShaderPath(params.OGLES2ShaderPath),
-	ColorFormat(ECF_R8G8B8), ContextManager(contextManager)
+	IndexRanges(0), IndexRangeCount(0), ColorFormat(ECF_R8G8B8), ContextManager(contextManager)
 {
 #ifdef _DEBUG
 	setDebugName("COGLES2Driver");
@@ -560,6 +560,8 @@ COGLES2Driver::~COGLES2Driver()
 
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, HWBuffer->vbo_indicesID);
 
+		IndexBytesUploaded += indexCount * indexSize;
+
 		// copy data to graphics card
 		if (!newBuffer)
 			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * indexSize, indices);
@@ -709,6 +711,53 @@ COGLES2Driver::~COGLES2Driver()
 	}
 
 
+	void COGLES2Driver::drawHardwareBufferRanges(SHWBufferLink *_HWBuffer, const SIndexRange* ranges, u32 rangeCount)
+	{
+		if (!_HWBuffer || !rangeCount)
+			return;
+
+		SHWBufferLink_opengl *HWBuffer = static_cast<SHWBufferLink_opengl*>(_HWBuffer);
+
+		updateHardwareBuffer(HWBuffer); //check if update is needed
+
+		HWBuffer->LastUsed = 0;//reset count
+
+		const scene::IMeshBuffer* mb = HWBuffer->MeshBuffer;
+		const void *vertices = mb->getVertices();
+		const void *indexList = mb->getIndices();
+
+		if (HWBuffer->Mapped_Vertex != scene::EHM_NEVER)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, HWBuffer->vbo_verticesID);
+			vertices = 0;
+		}
+
+		if (HWBuffer->Mapped_Index != scene::EHM_NEVER)
+		{
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, HWBuffer->vbo_indicesID);
+			indexList = 0;
+		}
+
+		u32 primitiveCount = 0;
+		for (u32 i = 0; i < rangeCount; ++i)
+			primitiveCount += ranges[i].Count / 3;
+
+		// the triangle list is drawn range by range instead of as a whole
+		IndexRanges = ranges;
+		IndexRangeCount = rangeCount;
+		drawVertexPrimitiveList(vertices, mb->getVertexCount(), indexList, primitiveCount,
+				mb->getVertexType(), scene::EPT_TRIANGLES, mb->getIndexType());
+		IndexRanges = 0;
+		IndexRangeCount = 0;
+
+		if (HWBuffer->Mapped_Vertex != scene::EHM_NEVER)
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		if (HWBuffer->Mapped_Index != scene::EHM_NEVER)
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
+
 	IRenderTarget* COGLES2Driver::addRenderTarget()
 	{
 		COGLES2RenderTarget* renderTarget = new COGLES2RenderTarget(this);
@@ -857,7 +906,18 @@ COGLES2Driver::~COGLES2Driver()
 				glDrawElements(GL_TRIANGLE_FAN, primitiveCount + 2, indexSize, indexList);
 				break;
 			case scene::EPT_TRIANGLES:
-				glDrawElements((LastMaterial.Wireframe) ? GL_LINES : (LastMaterial.PointCloud) ? GL_POINTS : GL_TRIANGLES, primitiveCount*3, indexSize, indexList);
+			{
+				const GLenum mode = (LastMaterial.Wireframe) ? GL_LINES : (LastMaterial.PointCloud) ? GL_POINTS : GL_TRIANGLES;
+				if (IndexRangeCount)
+				{
+					// no multi draw in GLES, one call per range with its byte offset into the index list
+					const u32 indexBytes = (iType == EIT_16BIT) ? sizeof(u16) : sizeof(u32);
+					for (u32 i = 0; i < IndexRangeCount; ++i)
+						glDrawElements(mode, IndexRanges[i].Count, indexSize, static_cast<const u8*>(indexList) + IndexRanges[i].Start * indexBytes);
+				}
+				else
+					glDrawElements(mode, primitiveCount*3, indexSize, indexList);
+			}
 				break;
 			default:
 				break;
@@ -92,6 +92,9 @@ namespace video
 		//! Draw hardware buffer
 		virtual void drawHardwareBuffer(SHWBufferLink *HWBuffer) _IRR_OVERRIDE_;
 
+		//! Draw parts of the indices of a hardware buffer, as triangle lists
+		virtual void drawHardwareBufferRanges(SHWBufferLink *HWBuffer, const SIndexRange* ranges, u32 rangeCount) _IRR_OVERRIDE_;
+
 		virtual IRenderTarget* addRenderTarget() _IRR_OVERRIDE_;
 
 		//! draws a vertex primitive list
@@ -424,6 +427,10 @@ private:
 
 		SMaterial Material, LastMaterial;
 
+		//! ranges drawn by drawVertexPrimitiveList instead of the whole index list, set by drawHardwareBufferRanges
+		const SIndexRange* IndexRanges;
+		u32 IndexRangeCount;
+
 		//! Color buffer format
 		ECOLOR_FORMAT ColorFormat;
 
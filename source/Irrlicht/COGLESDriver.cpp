@@ -32,7 +32,7 @@ namespace video
 COGLES1Driver::COGLES1Driver(const SIrrlichtCreationParameters& params, io::IFileSystem* io, IContextManager* contextManager) :
     CNullDriver(io, params.WindowSize), COGLES1ExtensionHandler(), CacheHandler(0), CurrentRenderMode(ERM_NONE),
     ResetRenderStates(true), Transformation3DChanged(true), AntiAlias(params.AntiAlias),
-    ColorFormat(ECF_R8G8B8), Params(params), ContextManager(contextManager)
+    IndexRanges(0), IndexRangeCount(0), ColorFormat(ECF_R8G8B8), Params(params), ContextManager(contextManager)
 {
 #ifdef _DEBUG
 	setDebugName("COGLESDriver");
@@ -403,6 +403,8 @@ bool COGLES1Driver::updateIndexHardwareBuffer(SHWBufferLink_opengl *HWBuffer)
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, HWBuffer->vbo_indicesID);
 
+	IndexBytesUploaded += indexCount * indexSize;
+
 	// copy data to graphics card
 	if (!newBuffer)
 		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * indexSize, indices);
@@ -551,6 +553,52 @@ void COGLES1Driver::drawHardwareBuffer(SHWBufferLink *_HWBuffer)
 }
 
 
+void COGLES1Driver::drawHardwareBufferRanges(SHWBufferLink *_HWBuffer, const SIndexRange* ranges, u32 rangeCount)
+{
+	if (!_HWBuffer || !rangeCount)
+		return;
+
+	SHWBufferLink_opengl *HWBuffer=static_cast<SHWBufferLink_opengl*>(_HWBuffer);
+
+	updateHardwareBuffer(HWBuffer); //check if update is needed
+
+	HWBuffer->LastUsed=0;//reset count
+
+	const scene::IMeshBuffer* mb = HWBuffer->MeshBuffer;
+	const void *vertices=mb->getVertices();
+	const void *indexList=mb->getIndices();
+
+	if (HWBuffer->Mapped_Vertex!=scene::EHM_NEVER)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, HWBuffer->vbo_verticesID);
+		vertices=0;
+	}
+
+	if (HWBuffer->Mapped_Index!=scene::EHM_NEVER)
+	{
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, HWBuffer->vbo_indicesID);
+		indexList=0;
+	}
+
+	u32 primitiveCount = 0;
+	for (u32 i=0; i<rangeCount; ++i)
+		primitiveCount += ranges[i].Count / 3;
+
+	// the triangle list is drawn range by range instead of as a whole
+	IndexRanges = ranges;
+	IndexRangeCount = rangeCount;
+	drawVertexPrimitiveList(vertices, mb->getVertexCount(), indexList, primitiveCount, mb->getVertexType(), scene::EPT_TRIANGLES, mb->getIndexType());
+	IndexRanges = 0;
+	IndexRangeCount = 0;
+
+	if (HWBuffer->Mapped_Vertex!=scene::EHM_NEVER)
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (HWBuffer->Mapped_Index!=scene::EHM_NEVER)
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+
 IRenderTarget* COGLES1Driver::addRenderTarget()
 {
 	COGLES1RenderTarget* renderTarget = new COGLES1RenderTarget(this);
@@ -816,7 +864,18 @@ void COGLES1Driver::drawVertexPrimitiveList2d3d(const void* vertices, u32 vertex
 			glDrawElements(GL_TRIANGLE_FAN, primitiveCount+2, indexSize, indexList);
 			break;
 		case scene::EPT_TRIANGLES:
-			glDrawElements((LastMaterial.Wireframe)?GL_LINES:(LastMaterial.PointCloud)?GL_POINTS:GL_TRIANGLES, primitiveCount*3, indexSize, indexList);
+		{
+			const GLenum mode = (LastMaterial.Wireframe)?GL_LINES:(LastMaterial.PointCloud)?GL_POINTS:GL_TRIANGLES;
+			if (IndexRangeCount)
+			{
+				// no multi draw in GLES, one call per range with its byte offset into the index list
+				const u32 indexBytes = (iType == EIT_16BIT) ? sizeof(u16) : sizeof(u32);
+				for (u32 i=0; i<IndexRangeCount; ++i)
+					glDrawElements(mode, IndexRanges[i].Count, indexSize, static_cast<const u8*>(indexList) + IndexRanges[i].Start * indexBytes);
+			}
+			else
+				glDrawElements(mode, primitiveCount*3, indexSize, indexList);
+		}
 			break;
 		case scene::EPT_QUAD_STRIP:
 		case scene::EPT_QUADS:
@@ -82,6 +82,9 @@ namespace video
 		//! Draw hardware buffer
 		virtual void drawHardwareBuffer(SHWBufferLink *HWBuffer) _IRR_OVERRIDE_;
 
+		//! Draw parts of the indices of a hardware buffer, as triangle lists
+		virtual void drawHardwareBufferRanges(SHWBufferLink *HWBuffer, const SIndexRange* ranges, u32 rangeCount) _IRR_OVERRIDE_;
+
 		virtual IRenderTarget* addRenderTarget() _IRR_OVERRIDE_;
 
 		//! draws a vertex primitive list
@@ -366,6 +369,11 @@ namespace video
 		u8 AntiAlias;
 
 		SMaterial Material, LastMaterial;
+
+		//! ranges drawn by drawVertexPrimitiveList2d3d instead of the whole index list, set by drawHardwareBufferRanges
+		const SIndexRange* IndexRanges;
+		u32 IndexRangeCount;
+
 		core::array<core::plane3df> UserClipPlane;
 		core::array<bool> UserClipPlaneEnabled;
 
@@ -0,0 +1,390 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "COcclusionCuller.h"
+#include "IVideoDriver.h"
+#include "ICameraSceneNode.h"
+#include "ISceneManager.h"
+#include "IMeshSceneNode.h"
+#include "SMesh.h"
+#include "SMeshBuffer.h"
+
+namespace irr
+{
+namespace scene
+{
+
+namespace
+{
+	// frames between the tests of a visible node
+	const u32 VISIBLE_TEST_INTERVAL = 8;
+
+	// frames after which a query without result counts as visible
+	const u32 MAX_QUERY_LATENCY = 8;
+
+	// frames after which the result of a software test is read
+	const u32 SOFTWARE_TEST_LATENCY = 1;
+
+	// frames after which nodes which didn't register are forgotten
+	const u32 FORGET_FRAMES = 120;
+
+	// triangles of the query box, the corners are in the order of aabbox3d::getEdges
+	const u16 BOX_INDICES[36] =
+	{
+		0,1,3, 0,3,2,
+		4,7,5, 4,6,7,
+		0,2,6, 0,6,4,
+		1,7,3, 1,5,7,
+		0,5,1, 0,4,5,
+		2,3,7, 2,7,6
+	};
+
+	// if the parents of a node lead to the root of its scene manager
+	bool isInScene(const ISceneNode* node)
+	{
+		ISceneManager* smgr = node->getSceneManager();
+		while (node->getParent())
+			node = node->getParent();
+		return !smgr || node == smgr->getRootSceneNode();
+	}
+}
+
+
+//! constructor
+COcclusionCuller::COcclusionCuller(video::IVideoDriver* driver)
+	: Driver(driver), Camera(0), HardwareQueries(false), OccludersDrawn(false),
+	Frame(0), NearValue(1.f)
+{
+}
+
+
+//! destructor
+COcclusionCuller::~COcclusionCuller()
+{
+	clear();
+}
+
+
+//! Reads the arrived results, call before the nodes register themselves
+void COcclusionCuller::beginFrame(const ICameraSceneNode* camera)
+{
+	++Frame;
+	Occluders.set_used(0);
+	OccludersDrawn = false;
+
+	// visibility belongs to a view, another camera starts with all nodes visible
+	if (camera != Camera)
+	{
+		for (u32 i=0; i<States.size(); ++i)
+		{
+			States[i].Visible = true;
+			States[i].Pending = false;
+			States[i].NextTestFrame = Frame;
+		}
+		Camera = camera;
+	}
+
+	if (!Camera)
+		return;
+
+	HardwareQueries = Driver->queryFeature(video::EVDF_OCCLUSION_QUERY);
+	View = Camera->getViewMatrix();
+	NearValue = Camera->getNearValue();
+
+	for (s32 i=(s32)States.size()-1; i>=0; --i)
+	{
+		SNodeState& state = States[i];
+
+		// nodes which didn't register may have been removed from the scene,
+		// don't keep them alive until they are forgotten
+		if (Frame - state.LastFrame > FORGET_FRAMES ||
+			(state.LastFrame != Frame - 1 && !isInScene(state.Node)))
+		{
+			removeState(i);
+			continue;
+		}
+
+		if (!state.Pending)
+			continue;
+
+		if (state.SoftwareTest)
+		{
+			// read like a query result arriving frames after the test
+			if (Frame - state.TestFrame < SOFTWARE_TEST_LATENCY)
+				continue;
+
+			state.Visible = state.SoftwareVisible;
+		}
+		else
+		{
+			// never wait, the result is read in a later frame if it didn't arrive
+			Driver->updateOcclusionQuery(state.Node, false);
+			const u32 result = Driver->getOcclusionQueryResult(state.Node);
+			if (result == 0xffffffff)
+			{
+				// lost queries count as visible
+				if (Frame - state.TestFrame > MAX_QUERY_LATENCY)
+				{
+					state.Pending = false;
+					state.Visible = true;
+					state.NextTestFrame = Frame;
+				}
+				continue;
+			}
+
+			state.Visible = result > 0;
+		}
+
+		state.Pending = false;
+		state.NextTestFrame = state.Visible ? Frame + VISIBLE_TEST_INTERVAL : Frame;
+	}
+}
+
+
+//! Returns if the last query found the node occluded, schedules the next query
+bool COcclusionCuller::isOccluded(ISceneNode* node)
+{
+	if (!Camera)
+		return false;
+
+	// nodes with solid and transparent parts register twice in a row
+	if (node->isOccluder() && (Occluders.empty() || Occluders.getLast() != node))
+		Occluders.push_back(node);
+
+	if (node->getAutomaticCulling() == EAC_OFF)
+		return false;
+
+	u32 index;
+	const core::hash_map<const ISceneNode*, u32>::Node* n = StateIndices.find(node);
+	if (n)
+		index = n->getValue();
+	else
+	{
+		index = States.size();
+
+		SNodeState state;
+		state.Node = node;
+		state.QueryMesh = 0;
+		state.LastFrame = Frame - 1;
+		// spread the tests of nodes appearing together over the interval
+		state.NextTestFrame = Frame + index % VISIBLE_TEST_INTERVAL;
+		state.TestFrame = 0;
+		state.Visible = true;
+		state.Pending = false;
+		state.SoftwareTest = false;
+		state.SoftwareVisible = true;
+
+		node->grab();
+		States.push_back(state);
+		StateIndices.insert(node, index);
+	}
+
+	SNodeState& state = States[index];
+
+	// registered for another render pass in this frame
+	if (state.LastFrame == Frame)
+		return isQueryOccluded(state);
+
+	// the last result was for another view when the node comes back into it
+	if (state.LastFrame != Frame - 1)
+	{
+		state.Visible = true;
+		state.Pending = false;
+		state.NextTestFrame = Frame;
+	}
+	state.LastFrame = Frame;
+
+	// tests can't see the parts of boxes in front of the near plane
+	if (crossesNearPlane(node->getTransformedBoundingBox()))
+	{
+		state.Visible = true;
+		return false;
+	}
+
+	if (!state.Pending && Frame >= state.NextTestFrame)
+		Scheduled.push_back(index);
+
+	return isQueryOccluded(state);
+}
+
+
+//! Draws the collected occluders into the software depth buffer
+bool COcclusionCuller::drawOccluders()
+{
+	if (!Camera || Occluders.empty())
+		return false;
+
+	Rasterizer.begin(View, Camera->getProjectionMatrix(), NearValue,
+		Driver->getCurrentRenderTargetSize());
+
+	for (u32 i=0; i<Occluders.size(); ++i)
+	{
+		ISceneNode* node = Occluders[i];
+		if (node->getType() != ESNT_MESH && node->getType() != ESNT_OCTREE)
+			continue;
+
+		const IMesh* mesh = static_cast<IMeshSceneNode*>(node)->getMesh();
+		if (!mesh)
+			continue;
+
+		const core::matrix4& world = node->getAbsoluteTransformation();
+		for (u32 b=0; b<mesh->getMeshBufferCount(); ++b)
+			Rasterizer.addMeshBuffer(world, mesh->getMeshBuffer(b));
+	}
+
+	Rasterizer.end();
+	Occluders.set_used(0);
+	OccludersDrawn = true;
+	return true;
+}
+
+
+//! Returns if the node is behind the occluders drawn by drawOccluders()
+bool COcclusionCuller::isHidden(const ISceneNode* node) const
+{
+	// occluders would only find themselves
+	if (node->isOccluder() || node->getAutomaticCulling() == EAC_OFF)
+		return false;
+
+	return !Rasterizer.isBoxVisible(node->getTransformedBoundingBox());
+}
+
+
+//! Runs the scheduled tests, call after the solid nodes were drawn
+void COcclusionCuller::runTests()
+{
+	if (Camera)
+	{
+		for (u32 i=0; i<Scheduled.size(); ++i)
+		{
+			SNodeState& state = States[Scheduled[i]];
+			if (HardwareQueries)
+			{
+				updateQueryMesh(state);
+				// the material of the query mesh keeps the box invisible
+				Driver->runOcclusionQuery(state.Node, true);
+				state.SoftwareTest = false;
+			}
+			else
+			{
+				// without occluders in this frame nothing is hidden
+				state.SoftwareVisible = !OccludersDrawn || !isHidden(state.Node);
+				state.SoftwareTest = true;
+			}
+			state.Pending = true;
+			state.TestFrame = Frame;
+		}
+	}
+
+	Scheduled.set_used(0);
+}
+
+
+//! Forgets all nodes
+void COcclusionCuller::clear()
+{
+	for (s32 i=(s32)States.size()-1; i>=0; --i)
+		removeState(i);
+
+	Scheduled.clear();
+	Occluders.clear();
+	Camera = 0;
+}
+
+
+bool COcclusionCuller::isQueryOccluded(const SNodeState& state) const
+{
+	// software results only schedule the next test, the software depth buffer
+	// of the current frame already removes the hidden nodes, an older result
+	// would only hide nodes coming out from behind the occluders for a frame
+	return !state.Visible && !state.SoftwareTest;
+}
+
+
+void COcclusionCuller::removeState(u32 index)
+{
+	SNodeState& state = States[index];
+	if (state.QueryMesh)
+	{
+		Driver->removeOcclusionQuery(state.Node);
+		state.QueryMesh->drop();
+	}
+	StateIndices.remove(state.Node);
+	state.Node->drop();
+
+	// the last state takes the place
+	const u32 last = States.size() - 1;
+	if (index != last)
+	{
+		States[index] = States[last];
+		StateIndices.find(States[index].Node)->setValue(index);
+	}
+	States.erase(last);
+}
+
+
+void COcclusionCuller::updateQueryMesh(SNodeState& state)
+{
+	const core::aabbox3df& box = state.Node->getBoundingBox();
+
+	if (!state.QueryMesh)
+	{
+		SMeshBuffer* buffer = new SMeshBuffer();
+
+		// only depth tested, both sides count so the winding doesn't matter
+		video::SMaterial& material = buffer->Material;
+		material.Lighting = false;
+		material.BackfaceCulling = false;
+		material.AntiAliasing = 0;
+		material.GouraudShading = false;
+		material.ColorMask = video::ECP_NONE;
+		material.ZWriteEnable = video::EZW_OFF;
+
+		buffer->Vertices.set_used(8);
+		for (u32 i=0; i<36; ++i)
+			buffer->Indices.push_back(BOX_INDICES[i]);
+
+		state.QueryMesh = new SMesh();
+		state.QueryMesh->addMeshBuffer(buffer);
+		buffer->drop();
+
+		// force the update below
+		state.QueryBox = core::aabbox3df(1.f, 1.f, 1.f, -1.f, -1.f, -1.f);
+	}
+
+	if (state.QueryBox.MinEdge != box.MinEdge || state.QueryBox.MaxEdge != box.MaxEdge)
+	{
+		SMeshBuffer* buffer = static_cast<SMeshBuffer*>(state.QueryMesh->getMeshBuffer(0));
+
+		core::vector3df corners[8];
+		box.getEdges(corners);
+		for (u32 i=0; i<8; ++i)
+			buffer->Vertices[i].Pos = corners[i];
+
+		buffer->setBoundingBox(box);
+		buffer->setDirty(EBT_VERTEX);
+		state.QueryMesh->setBoundingBox(box);
+		state.QueryBox = box;
+	}
+
+	// also adds the query again if the driver removed it
+	Driver->addOcclusionQuery(state.Node, state.QueryMesh);
+}
+
+
+bool COcclusionCuller::crossesNearPlane(const core::aabbox3df& box) const
+{
+	core::vector3df corners[8];
+	box.getEdges(corners);
+	for (u32 i=0; i<8; ++i)
+	{
+		const f32 viewZ = View[2]*corners[i].X + View[6]*corners[i].Y + View[10]*corners[i].Z + View[14];
+		if (viewZ < NearValue)
+			return true;
+	}
+	return false;
+}
+
+} // end namespace scene
+} // end namespace irr
+
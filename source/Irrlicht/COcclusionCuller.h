@@ -0,0 +1,122 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_OCCLUSION_CULLER_H_INCLUDED__
+#define __C_OCCLUSION_CULLER_H_INCLUDED__
+
+#include "irrArray.h"
+#include "irrHashMap.h"
+#include "matrix4.h"
+#include "aabbox3d.h"
+#include "COcclusionRasterizer.h"
+
+namespace irr
+{
+namespace video
+{
+	class IVideoDriver;
+} // end namespace video
+
+namespace scene
+{
+	class ISceneNode;
+	class ICameraSceneNode;
+	struct SMesh;
+
+	//! Occlusion culling of scene nodes
+	/** Used by CSceneManager for automatic occlusion culling. Nodes are
+	tested in two ways:
+	- Against a software depth buffer of the occluder nodes, drawn after the
+	nodes registered and before they are drawn, which needs no driver support.
+	- With occlusion queries of their bounding boxes if the driver supports
+	them. Their results are read frames after the test without waiting for the
+	driver, until then a node keeps the visibility of its last test. Visible
+	nodes are tested again every few frames, occluded ones every frame.
+	Without occlusion queries, the scheduled tests are run against the software
+	depth buffer instead and their results are read a frame later the same way,
+	but they only decide when a node is tested next. They never hide a node,
+	that's left to the software depth buffer of the frame the node is drawn in. */
+	class COcclusionCuller
+	{
+	public:
+
+		//! constructor
+		/** The driver isn't grabbed, the scene manager holding the culler does. */
+		COcclusionCuller(video::IVideoDriver* driver);
+
+		//! destructor
+		~COcclusionCuller();
+
+		//! Reads the arrived results, call before the nodes register themselves
+		void beginFrame(const ICameraSceneNode* camera);
+
+		//! Returns if the last query found the node occluded, schedules the next query
+		/** Also collects the occluders, call for the nodes passing frustum culling. */
+		bool isOccluded(ISceneNode* node);
+
+		//! Draws the collected occluders into the software depth buffer
+		/** \return False if there are no occluders, then isHidden() needn't be called. */
+		bool drawOccluders();
+
+		//! Returns if the node is behind the occluders drawn by drawOccluders()
+		bool isHidden(const ISceneNode* node) const;
+
+		//! Runs the scheduled tests, call after the solid nodes were drawn
+		void runTests();
+
+		//! Forgets all nodes
+		void clear();
+
+	private:
+
+		struct SNodeState
+		{
+			ISceneNode* Node;
+			// bounding box for hardware queries and the local box it was built for
+			SMesh* QueryMesh;
+			core::aabbox3df QueryBox;
+			// frame the node was registered in last
+			u32 LastFrame;
+			// frame of the next test of a visible node
+			u32 NextTestFrame;
+			// frame of the test whose result is pending
+			u32 TestFrame;
+			bool Visible;
+			bool Pending;
+			// the pending test ran against the software depth buffer and found
+			// the node SoftwareVisible
+			bool SoftwareTest;
+			bool SoftwareVisible;
+		};
+
+		// if the last result hides the node, only query results do
+		bool isQueryOccluded(const SNodeState& state) const;
+
+		void removeState(u32 index);
+		void updateQueryMesh(SNodeState& state);
+
+		// if a corner of a world space box is in front of the near plane
+		bool crossesNearPlane(const core::aabbox3df& box) const;
+
+		video::IVideoDriver* Driver;
+		const ICameraSceneNode* Camera;
+		bool HardwareQueries;
+		// if drawOccluders() filled the software depth buffer in this frame
+		bool OccludersDrawn;
+		u32 Frame;
+		core::matrix4 View;
+		f32 NearValue;
+
+		core::array<SNodeState> States;
+		core::hash_map<const ISceneNode*, u32> StateIndices;
+		core::array<u32> Scheduled;
+
+		core::array<ISceneNode*> Occluders;
+		COcclusionRasterizer Rasterizer;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -0,0 +1,513 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "COcclusionRasterizer.h"
+#include "IMeshBuffer.h"
+#include "irrSIMD.h"
+
+namespace irr
+{
+namespace scene
+{
+
+namespace
+{
+	// width of the depth buffer, the height follows the render target
+	const u32 DEPTH_BUFFER_WIDTH = 256;
+	const u32 MAX_DEPTH_BUFFER_HEIGHT = 256;
+
+	// tiles are multiples of the 4 pixels drawn at once
+	const u32 TILE_WIDTH = 32;
+	const u32 TILE_HEIGHT = 8;
+
+	// pixels this close outside a triangle are still drawn, as rounding would
+	// leave cracks at pixel centers on the edges shared by two triangles
+	const f32 EDGE_TOLERANCE = 1.f / 64.f;
+
+	typedef COcclusionRasterizer::STriangle STriangle;
+
+	//! Draws the pixels x0 <= x < x1, y0 <= y < y1 of a triangle, x0 and x1 are multiples of 4
+	typedef void (*TileRasterizer)(f32* depth, u32 pitch, const STriangle& tri,
+		s32 x0, s32 y0, s32 x1, s32 y1);
+
+	//! Returns the farthest depth of a tile
+	typedef f32 (*TileMaxDepthReader)(const f32* depth, u32 pitch);
+
+	struct STileKernels
+	{
+		TileRasterizer Rasterize;
+		TileMaxDepthReader GetMaxDepth;
+	};
+
+	void rasterizeTile(f32* depth, u32 pitch, const STriangle& tri,
+		s32 x0, s32 y0, s32 x1, s32 y1)
+	{
+		for (s32 y=y0; y<y1; ++y)
+		{
+			f32* row = depth + y * pitch;
+			for (s32 x=x0; x<x1; ++x)
+			{
+				const f32 fx = (f32)x;
+				const f32 fy = (f32)y;
+				if (tri.EdgeA[0] * fx + tri.EdgeB[0] * fy + tri.EdgeC[0] >= 0.f &&
+					tri.EdgeA[1] * fx + tri.EdgeB[1] * fy + tri.EdgeC[1] >= 0.f &&
+					tri.EdgeA[2] * fx + tri.EdgeB[2] * fy + tri.EdgeC[2] >= 0.f)
+				{
+					const f32 z = tri.DepthX * fx + tri.DepthY * fy + tri.Depth0;
+					if (z < row[x])
+						row[x] = z;
+				}
+			}
+		}
+	}
+
+	f32 getTileMaxDepth(const f32* depth, u32 pitch)
+	{
+		f32 maxDepth = -FLT_MAX;
+		for (u32 y=0; y<TILE_HEIGHT; ++y, depth += pitch)
+		{
+			for (u32 x=0; x<TILE_WIDTH; ++x)
+				maxDepth = core::max_(maxDepth, depth[x]);
+		}
+		return maxDepth;
+	}
+
+#ifdef _IRR_SIMD_X86_
+	_IRR_SIMD_TARGET_("sse2")
+	void rasterizeTile_SSE2(f32* depth, u32 pitch, const STriangle& tri,
+		s32 x0, s32 y0, s32 x1, s32 y1)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 xs = _mm_add_ps(_mm_set1_ps((f32)x0), _mm_set_ps(3.f, 2.f, 1.f, 0.f));
+
+		const __m128 a0 = _mm_set1_ps(tri.EdgeA[0]);
+		const __m128 a1 = _mm_set1_ps(tri.EdgeA[1]);
+		const __m128 a2 = _mm_set1_ps(tri.EdgeA[2]);
+		const __m128 az = _mm_set1_ps(tri.DepthX);
+		const __m128 step0 = _mm_mul_ps(a0, _mm_set1_ps(4.f));
+		const __m128 step1 = _mm_mul_ps(a1, _mm_set1_ps(4.f));
+		const __m128 step2 = _mm_mul_ps(a2, _mm_set1_ps(4.f));
+		const __m128 stepZ = _mm_mul_ps(az, _mm_set1_ps(4.f));
+
+		for (s32 y=y0; y<y1; ++y)
+		{
+			const f32 fy = (f32)y;
+			__m128 e0 = _mm_add_ps(_mm_mul_ps(a0, xs), _mm_set1_ps(tri.EdgeB[0] * fy + tri.EdgeC[0]));
+			__m128 e1 = _mm_add_ps(_mm_mul_ps(a1, xs), _mm_set1_ps(tri.EdgeB[1] * fy + tri.EdgeC[1]));
+			__m128 e2 = _mm_add_ps(_mm_mul_ps(a2, xs), _mm_set1_ps(tri.EdgeB[2] * fy + tri.EdgeC[2]));
+			__m128 z = _mm_add_ps(_mm_mul_ps(az, xs), _mm_set1_ps(tri.DepthY * fy + tri.Depth0));
+
+			f32* row = depth + y * pitch;
+			for (s32 x=x0; x<x1; x+=4)
+			{
+				const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero),
+					_mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+				const __m128 old = _mm_loadu_ps(row + x);
+				const __m128 nearest = _mm_min_ps(z, old);
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, old)));
+
+				e0 = _mm_add_ps(e0, step0);
+				e1 = _mm_add_ps(e1, step1);
+				e2 = _mm_add_ps(e2, step2);
+				z = _mm_add_ps(z, stepZ);
+			}
+		}
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	f32 getTileMaxDepth_SSE2(const f32* depth, u32 pitch)
+	{
+		__m128 maxDepth = _mm_set1_ps(-FLT_MAX);
+		for (u32 y=0; y<TILE_HEIGHT; ++y, depth += pitch)
+		{
+			for (u32 x=0; x<TILE_WIDTH; x+=4)
+				maxDepth = _mm_max_ps(maxDepth, _mm_loadu_ps(depth + x));
+		}
+		maxDepth = _mm_max_ps(maxDepth, _mm_shuffle_ps(maxDepth, maxDepth, _MM_SHUFFLE(1, 0, 3, 2)));
+		maxDepth = _mm_max_ps(maxDepth, _mm_shuffle_ps(maxDepth, maxDepth, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtss_f32(maxDepth);
+	}
+#endif // _IRR_SIMD_X86_
+
+#ifdef _IRR_SIMD_NEON_
+	void rasterizeTile_NEON(f32* depth, u32 pitch, const STriangle& tri,
+		s32 x0, s32 y0, s32 x1, s32 y1)
+	{
+		static const f32 laneOffsets[4] = { 0.f, 1.f, 2.f, 3.f };
+		const float32x4_t zero = vdupq_n_f32(0.f);
+		const float32x4_t xs = vaddq_f32(vdupq_n_f32((f32)x0), vld1q_f32(laneOffsets));
+
+		const float32x4_t a0 = vdupq_n_f32(tri.EdgeA[0]);
+		const float32x4_t a1 = vdupq_n_f32(tri.EdgeA[1]);
+		const float32x4_t a2 = vdupq_n_f32(tri.EdgeA[2]);
+		const float32x4_t az = vdupq_n_f32(tri.DepthX);
+		const float32x4_t step0 = vdupq_n_f32(tri.EdgeA[0] * 4.f);
+		const float32x4_t step1 = vdupq_n_f32(tri.EdgeA[1] * 4.f);
+		const float32x4_t step2 = vdupq_n_f32(tri.EdgeA[2] * 4.f);
+		const float32x4_t stepZ = vdupq_n_f32(tri.DepthX * 4.f);
+
+		for (s32 y=y0; y<y1; ++y)
+		{
+			const f32 fy = (f32)y;
+			float32x4_t e0 = vmlaq_f32(vdupq_n_f32(tri.EdgeB[0] * fy + tri.EdgeC[0]), a0, xs);
+			float32x4_t e1 = vmlaq_f32(vdupq_n_f32(tri.EdgeB[1] * fy + tri.EdgeC[1]), a1, xs);
+			float32x4_t e2 = vmlaq_f32(vdupq_n_f32(tri.EdgeB[2] * fy + tri.EdgeC[2]), a2, xs);
+			float32x4_t z = vmlaq_f32(vdupq_n_f32(tri.DepthY * fy + tri.Depth0), az, xs);
+
+			f32* row = depth + y * pitch;
+			for (s32 x=x0; x<x1; x+=4)
+			{
+				const uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(e0, zero),
+					vcgeq_f32(e1, zero)), vcgeq_f32(e2, zero));
+				const float32x4_t old = vld1q_f32(row + x);
+				vst1q_f32(row + x, vbslq_f32(inside, vminq_f32(z, old), old));
+
+				e0 = vaddq_f32(e0, step0);
+				e1 = vaddq_f32(e1, step1);
+				e2 = vaddq_f32(e2, step2);
+				z = vaddq_f32(z, stepZ);
+			}
+		}
+	}
+
+	f32 getTileMaxDepth_NEON(const f32* depth, u32 pitch)
+	{
+		float32x4_t maxDepth = vdupq_n_f32(-FLT_MAX);
+		for (u32 y=0; y<TILE_HEIGHT; ++y, depth += pitch)
+		{
+			for (u32 x=0; x<TILE_WIDTH; x+=4)
+				maxDepth = vmaxq_f32(maxDepth, vld1q_f32(depth + x));
+		}
+		float32x2_t half = vpmax_f32(vget_low_f32(maxDepth), vget_high_f32(maxDepth));
+		half = vpmax_f32(half, half);
+		return vget_lane_f32(half, 0);
+	}
+#endif // _IRR_SIMD_NEON_
+
+	STileKernels selectTileKernels()
+	{
+		STileKernels kernels;
+		kernels.Rasterize = rasterizeTile;
+		kernels.GetMaxDepth = getTileMaxDepth;
+#if defined(_IRR_SIMD_X86_)
+		if (os::getX86Features() & os::EXF_SSE2)
+		{
+			kernels.Rasterize = rasterizeTile_SSE2;
+			kernels.GetMaxDepth = getTileMaxDepth_SSE2;
+		}
+#elif defined(_IRR_SIMD_NEON_)
+		kernels.Rasterize = rasterizeTile_NEON;
+		kernels.GetMaxDepth = getTileMaxDepth_NEON;
+#endif
+		return kernels;
+	}
+
+	const STileKernels& getTileKernels()
+	{
+		// selected once, the initialization is thread safe
+		static const STileKernels kernels = selectTileKernels();
+		return kernels;
+	}
+}
+
+
+//! constructor
+COcclusionRasterizer::COcclusionRasterizer()
+	: NearValue(1.f), Size(0, 0), TilesX(0), TilesY(0)
+{
+}
+
+
+//! Starts an empty depth buffer for a view
+void COcclusionRasterizer::begin(const core::matrix4& view, const core::matrix4& projection,
+	f32 nearValue, const core::dimension2du& targetSize)
+{
+	View = view;
+	ViewProjection = projection * view;
+	NearValue = nearValue;
+
+	u32 height = targetSize.Width ? DEPTH_BUFFER_WIDTH * targetSize.Height / targetSize.Width : DEPTH_BUFFER_WIDTH;
+	height = core::clamp((height + TILE_HEIGHT - 1) / TILE_HEIGHT * TILE_HEIGHT, TILE_HEIGHT, MAX_DEPTH_BUFFER_HEIGHT);
+	Size.set(DEPTH_BUFFER_WIDTH, height);
+	TilesX = Size.Width / TILE_WIDTH;
+	TilesY = Size.Height / TILE_HEIGHT;
+
+	// tiles are cleared when a triangle touches them
+	Depth.set_used(Size.Width * Size.Height);
+	TileMaxDepth.set_used(TilesX * TilesY);
+	for (u32 i=0; i<TileMaxDepth.size(); ++i)
+		TileMaxDepth[i] = FLT_MAX;
+
+	Triangles.set_used(0);
+}
+
+
+//! Adds the triangles of a mesh buffer, its material selects the drawn sides
+void COcclusionRasterizer::addMeshBuffer(const core::matrix4& world, const IMeshBuffer* mb)
+{
+	// the sides the driver draws, front faces are clockwise on the screen
+	const video::SMaterial& material = mb->getMaterial();
+	const bool drawFront = !material.FrontfaceCulling;
+	const bool drawBack = !material.BackfaceCulling;
+	if (!drawFront && !drawBack)
+		return;
+
+	const core::matrix4 worldView = View * world;
+	const core::matrix4 worldViewProjection = ViewProjection * world;
+
+	const u32 vertexCount = mb->getVertexCount();
+	const u8* vertices = static_cast<const u8*>(mb->getVertices());
+	const u32 pitch = video::getVertexPitchFromType(mb->getVertexType());
+	Vertices.set_used(vertexCount);
+	for (u32 i=0; i<vertexCount; ++i)
+	{
+		const core::vector3df& p = reinterpret_cast<const video::S3DVertex*>(vertices + i*pitch)->Pos;
+		worldViewProjection.transformVect(Vertices[i].Clip, p);
+		Vertices[i].ViewZ = worldView[2]*p.X + worldView[6]*p.Y + worldView[10]*p.Z + worldView[14];
+	}
+
+	const u32 indexCount = mb->getIndexCount() - mb->getIndexCount() % 3;
+	const u16* indices16 = mb->getIndexType() == video::EIT_16BIT ? mb->getIndices() : 0;
+	const u32* indices32 = indices16 ? 0 : reinterpret_cast<const u32*>(mb->getIndices());
+
+	for (u32 t=0; t<indexCount; t+=3)
+	{
+		const u32 i0 = indices16 ? indices16[t] : indices32[t];
+		const u32 i1 = indices16 ? indices16[t+1] : indices32[t+1];
+		const u32 i2 = indices16 ? indices16[t+2] : indices32[t+2];
+		clipTriangle(Vertices[i0], Vertices[i1], Vertices[i2], drawFront, drawBack);
+	}
+}
+
+
+//! Rasterizes the added triangles, call before testing boxes
+void COcclusionRasterizer::end()
+{
+	if (Triangles.empty())
+		return;
+
+	// count the triangles of each tile, then place them after the ones of the tiles before
+	const u32 tileCount = TilesX * TilesY;
+	BinStart.set_used(tileCount + 1);
+	for (u32 i=0; i<=tileCount; ++i)
+		BinStart[i] = 0;
+
+	for (u32 i=0; i<Triangles.size(); ++i)
+	{
+		const STriangle& tri = Triangles[i];
+		for (s32 ty=tri.MinY / TILE_HEIGHT; ty<=tri.MaxY / (s32)TILE_HEIGHT; ++ty)
+			for (s32 tx=tri.MinX / TILE_WIDTH; tx<=tri.MaxX / (s32)TILE_WIDTH; ++tx)
+				++BinStart[ty * TilesX + tx + 1];
+	}
+
+	for (u32 i=1; i<=tileCount; ++i)
+		BinStart[i] += BinStart[i-1];
+
+	// BinStart[t] is moved to the end of tile t while filling, then restored
+	BinTriangles.set_used(BinStart[tileCount]);
+	for (u32 i=0; i<Triangles.size(); ++i)
+	{
+		const STriangle& tri = Triangles[i];
+		for (s32 ty=tri.MinY / TILE_HEIGHT; ty<=tri.MaxY / (s32)TILE_HEIGHT; ++ty)
+			for (s32 tx=tri.MinX / TILE_WIDTH; tx<=tri.MaxX / (s32)TILE_WIDTH; ++tx)
+				BinTriangles[BinStart[ty * TilesX + tx]++] = i;
+	}
+
+	for (u32 i=tileCount; i>0; --i)
+		BinStart[i] = BinStart[i-1];
+	BinStart[0] = 0;
+
+	const STileKernels& kernels = getTileKernels();
+	for (u32 ty=0; ty<TilesY; ++ty)
+	{
+		for (u32 tx=0; tx<TilesX; ++tx)
+		{
+			const u32 tile = ty * TilesX + tx;
+			if (BinStart[tile] == BinStart[tile + 1])
+				continue;
+
+			const s32 tileX0 = tx * TILE_WIDTH;
+			const s32 tileY0 = ty * TILE_HEIGHT;
+			f32* tileDepth = Depth.pointer() + tileY0 * Size.Width + tileX0;
+			for (u32 y=0; y<TILE_HEIGHT; ++y)
+			{
+				for (u32 x=0; x<TILE_WIDTH; ++x)
+					tileDepth[y * Size.Width + x] = FLT_MAX;
+			}
+
+			for (u32 b=BinStart[tile]; b<BinStart[tile + 1]; ++b)
+			{
+				const STriangle& tri = Triangles[BinTriangles[b]];
+				const s32 x0 = core::max_(tileX0, tri.MinX & ~3);
+				const s32 x1 = core::min_(tileX0 + (s32)TILE_WIDTH, (tri.MaxX + 4) & ~3);
+				const s32 y0 = core::max_(tileY0, tri.MinY);
+				const s32 y1 = core::min_(tileY0 + (s32)TILE_HEIGHT, tri.MaxY + 1);
+				kernels.Rasterize(Depth.pointer(), Size.Width, tri, x0, y0, x1, y1);
+			}
+
+			TileMaxDepth[tile] = kernels.GetMaxDepth(tileDepth, Size.Width);
+		}
+	}
+}
+
+
+//! Returns if a part of a world space box may be in front of the depth buffer
+bool COcclusionRasterizer::isBoxVisible(const core::aabbox3df& box) const
+{
+	if (Triangles.empty())
+		return true;
+
+	core::vector3df corners[8];
+	box.getEdges(corners);
+
+	// screen rectangle and nearest depth of the box
+	f32 minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX, minZ = FLT_MAX;
+	for (u32 i=0; i<8; ++i)
+	{
+		// the depth buffer doesn't know what's in front of the near plane
+		const f32 viewZ = View[2]*corners[i].X + View[6]*corners[i].Y + View[10]*corners[i].Z + View[14];
+		if (viewZ < NearValue)
+			return true;
+
+		f32 clip[4];
+		ViewProjection.transformVect(clip, corners[i]);
+		const f32 invW = 1.f / clip[3];
+		const f32 x = (clip[0] * invW + 1.f) * Size.Width * 0.5f;
+		const f32 y = (1.f - clip[1] * invW) * Size.Height * 0.5f;
+		minX = core::min_(minX, x);
+		maxX = core::max_(maxX, x);
+		minY = core::min_(minY, y);
+		maxY = core::max_(maxY, y);
+		minZ = core::min_(minZ, clip[2] * invW);
+	}
+
+	const s32 x0 = core::max_(0, (s32)floorf(minX));
+	const s32 x1 = core::min_((s32)Size.Width - 1, (s32)floorf(maxX));
+	const s32 y0 = core::max_(0, (s32)floorf(minY));
+	const s32 y1 = core::min_((s32)Size.Height - 1, (s32)floorf(maxY));
+
+	// outside of the screen, frustum culling decides
+	if (x0 > x1 || y0 > y1)
+		return true;
+
+	for (s32 ty=y0 / TILE_HEIGHT; ty<=y1 / (s32)TILE_HEIGHT; ++ty)
+	{
+		for (s32 tx=x0 / TILE_WIDTH; tx<=x1 / (s32)TILE_WIDTH; ++tx)
+		{
+			// the whole tile is in front of the box
+			const u32 tile = ty * TilesX + tx;
+			if (minZ > TileMaxDepth[tile])
+				continue;
+
+			// no triangle touched the tile, its pixels weren't cleared
+			if (BinStart[tile] == BinStart[tile + 1])
+				return true;
+
+			const s32 px0 = core::max_(x0, tx * (s32)TILE_WIDTH);
+			const s32 px1 = core::min_(x1, (tx + 1) * (s32)TILE_WIDTH - 1);
+			const s32 py0 = core::max_(y0, ty * (s32)TILE_HEIGHT);
+			const s32 py1 = core::min_(y1, (ty + 1) * (s32)TILE_HEIGHT - 1);
+			for (s32 y=py0; y<=py1; ++y)
+			{
+				const f32* row = Depth.const_pointer() + y * Size.Width;
+				for (s32 x=px0; x<=px1; ++x)
+				{
+					if (minZ <= row[x])
+						return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+
+void COcclusionRasterizer::clipTriangle(const SClipVertex& a, const SClipVertex& b, const SClipVertex& c,
+	bool drawFront, bool drawBack)
+{
+	// clip against the near plane, which leaves up to 4 corners
+	const SClipVertex* in[3] = { &a, &b, &c };
+	SClipVertex polygon[4];
+	u32 count = 0;
+	for (u32 i=0; i<3; ++i)
+	{
+		const SClipVertex& p = *in[i];
+		const SClipVertex& q = *in[(i + 1) % 3];
+		const bool pInside = p.ViewZ >= NearValue;
+		const bool qInside = q.ViewZ >= NearValue;
+
+		if (pInside)
+			polygon[count++] = p;
+		if (pInside != qInside)
+		{
+			const f32 t = (NearValue - p.ViewZ) / (q.ViewZ - p.ViewZ);
+			SClipVertex& v = polygon[count++];
+			for (u32 k=0; k<4; ++k)
+				v.Clip[k] = p.Clip[k] + (q.Clip[k] - p.Clip[k]) * t;
+			v.ViewZ = NearValue;
+		}
+	}
+
+	if (count < 3)
+		return;
+
+	core::vector3df screen[4];
+	const f32 halfWidth = Size.Width * 0.5f;
+	const f32 halfHeight = Size.Height * 0.5f;
+	for (u32 i=0; i<count; ++i)
+	{
+		const f32 invW = 1.f / polygon[i].Clip[3];
+		screen[i].set((polygon[i].Clip[0] * invW + 1.f) * halfWidth,
+			(1.f - polygon[i].Clip[1] * invW) * halfHeight, polygon[i].Clip[2] * invW);
+	}
+
+	addTriangle(screen[0], screen[1], screen[2], drawFront, drawBack);
+	if (count == 4)
+		addTriangle(screen[0], screen[2], screen[3], drawFront, drawBack);
+}
+
+
+void COcclusionRasterizer::addTriangle(const core::vector3df& a, const core::vector3df& b, const core::vector3df& c,
+	bool drawFront, bool drawBack)
+{
+	const f32 area = (b.X - a.X) * (c.Y - a.Y) - (b.Y - a.Y) * (c.X - a.X);
+	if (area == 0.f || (area > 0.f ? !drawFront : !drawBack))
+		return;
+
+	STriangle tri;
+	tri.MinX = core::max_(0, (s32)floorf(core::min_(a.X, b.X, c.X)));
+	tri.MaxX = core::min_((s32)Size.Width - 1, (s32)floorf(core::max_(a.X, b.X, c.X)));
+	tri.MinY = core::max_(0, (s32)floorf(core::min_(a.Y, b.Y, c.Y)));
+	tri.MaxY = core::min_((s32)Size.Height - 1, (s32)floorf(core::max_(a.Y, b.Y, c.Y)));
+	if (tri.MinX > tri.MaxX || tri.MinY > tri.MaxY)
+		return;
+
+	// edges in the order making the inside positive
+	const core::vector3df* corners[3] = { &a, &b, &c };
+	if (area < 0.f)
+		core::swap(corners[1], corners[2]);
+
+	for (u32 i=0; i<3; ++i)
+	{
+		const core::vector3df& p = *corners[i];
+		const core::vector3df& q = *corners[(i + 1) % 3];
+		tri.EdgeA[i] = p.Y - q.Y;
+		tri.EdgeB[i] = q.X - p.X;
+		// sampled at the pixel centers
+		tri.EdgeC[i] = (tri.EdgeA[i] + tri.EdgeB[i]) * 0.5f - tri.EdgeA[i] * p.X - tri.EdgeB[i] * p.Y +
+			(fabsf(tri.EdgeA[i]) + fabsf(tri.EdgeB[i])) * EDGE_TOLERANCE;
+	}
+
+	// the farthest depth of the plane inside each pixel, so the low resolution
+	// doesn't hide boxes which are only in front of a part of the pixel
+	const f32 invArea = 1.f / area;
+	tri.DepthX = ((b.Z - a.Z) * (c.Y - a.Y) - (c.Z - a.Z) * (b.Y - a.Y)) * invArea;
+	tri.DepthY = ((c.Z - a.Z) * (b.X - a.X) - (b.Z - a.Z) * (c.X - a.X)) * invArea;
+	tri.Depth0 = a.Z - tri.DepthX * a.X - tri.DepthY * a.Y +
+		(tri.DepthX + tri.DepthY + fabsf(tri.DepthX) + fabsf(tri.DepthY)) * 0.5f;
+
+	Triangles.push_back(tri);
+}
+
+} // end namespace scene
+} // end namespace irr
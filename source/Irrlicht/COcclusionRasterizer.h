@@ -0,0 +1,101 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_OCCLUSION_RASTERIZER_H_INCLUDED__
+#define __C_OCCLUSION_RASTERIZER_H_INCLUDED__
+
+#include "irrArray.h"
+#include "matrix4.h"
+#include "aabbox3d.h"
+#include "dimension2d.h"
+
+namespace irr
+{
+namespace scene
+{
+	class IMeshBuffer;
+
+	//! Low resolution software depth buffer of occluders
+	/** Triangles are binned into tiles of the screen and rasterized tile by
+	tile, 4 pixels at once with SSE2 or NEON. Each tile keeps the farthest
+	depth of its pixels, so boxes behind fully covered tiles are rejected
+	without reading their pixels. Used by COcclusionCuller to cull nodes
+	before they are drawn, independent of the driver. */
+	class COcclusionRasterizer
+	{
+	public:
+
+		//! constructor
+		COcclusionRasterizer();
+
+		//! Starts an empty depth buffer for a view
+		/** \param targetSize Size of the render target, the depth buffer
+		has its aspect ratio. */
+		void begin(const core::matrix4& view, const core::matrix4& projection,
+			f32 nearValue, const core::dimension2du& targetSize);
+
+		//! Adds the triangles of a mesh buffer, its material selects the drawn sides
+		void addMeshBuffer(const core::matrix4& world, const IMeshBuffer* mb);
+
+		//! Rasterizes the added triangles, call before testing boxes
+		void end();
+
+		//! Returns if a part of a world space box may be in front of the depth buffer
+		bool isBoxVisible(const core::aabbox3df& box) const;
+
+		//! Returns the size of the depth buffer
+		const core::dimension2du& getSize() const { return Size; }
+
+		//! Triangle prepared for rasterization
+		struct STriangle
+		{
+			// edge functions A*x + B*y + C of the pixel indices, not negative inside
+			f32 EdgeA[3];
+			f32 EdgeB[3];
+			f32 EdgeC[3];
+			// depth plane of the pixel indices, at the farthest point of each pixel
+			f32 DepthX;
+			f32 DepthY;
+			f32 Depth0;
+			// covered pixels, inclusive
+			s32 MinX;
+			s32 MinY;
+			s32 MaxX;
+			s32 MaxY;
+		};
+
+	private:
+
+		struct SClipVertex
+		{
+			f32 Clip[4];
+			f32 ViewZ;
+		};
+
+		void clipTriangle(const SClipVertex& a, const SClipVertex& b, const SClipVertex& c,
+			bool drawFront, bool drawBack);
+		void addTriangle(const core::vector3df& a, const core::vector3df& b, const core::vector3df& c,
+			bool drawFront, bool drawBack);
+
+		core::matrix4 View;
+		core::matrix4 ViewProjection;
+		f32 NearValue;
+
+		core::dimension2du Size;
+		u32 TilesX;
+		u32 TilesY;
+		core::array<f32> Depth;
+		// farthest depth in each tile
+		core::array<f32> TileMaxDepth;
+
+		core::array<STriangle> Triangles;
+		// triangles overlapping each tile, BinStart has a last entry for the end
+		core::array<u32> BinStart;
+		core::array<u32> BinTriangles;
+		core::array<SClipVertex> Vertices;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
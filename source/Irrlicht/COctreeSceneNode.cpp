@@ -101,7 +101,59 @@ void COctreeSceneNode::OnRegisterSceneNode()
 }
 
 template <class VT>
-void renderMeshBuffer(video::IVideoDriver* driver, EOCTREENODE_VBO useVBO, typename Octree<VT>::SMeshChunk& meshChunk, const typename Octree<VT>::SIndexData& indexData)
+void calculateVisiblePolys(Octree<VT>* octree, EOCTREENODE_VBO useVBO, EOCTREE_POLYGON_CHECKS checks,
+	const SViewFrustum& frustum, const core::aabbox3d<f32>& box)
+{
+	// with visibility checks on vbo's, only the ranges of the visible
+	// nodes are collected and the indices stay on the gpu
+	const bool ranges = useVBO == EOV_USE_VBO_WITH_VISIBITLY;
+
+	switch ( checks )
+	{
+		case EOPC_BOX:
+			if (ranges)
+				octree->calculateRanges(box);
+			else
+				octree->calculatePolys(box);
+			break;
+		case EOPC_FRUSTUM:
+			if (ranges)
+				octree->calculateRanges(frustum);
+			else
+				octree->calculatePolys(frustum);
+			break;
+	}
+}
+
+//! replaces the indices of the mesh chunks by those sorted by the octree nodes
+template <class VT>
+void sortIndicesByNodes(const Octree<VT>* octree, core::array<typename Octree<VT>::SMeshChunk>& meshes, EOCTREENODE_VBO useVBO)
+{
+	if (useVBO != EOV_USE_VBO_WITH_VISIBITLY)
+		return;
+
+	for (u32 i=0; i<meshes.size(); ++i)
+	{
+		octree->getSortedIndices(i, meshes[i].Indices);
+		meshes[i].setHardwareMappingHint(scene::EHM_STATIC);
+		meshes[i].setDirty(scene::EBT_INDEX);
+	}
+}
+
+//! frees the hardware buffers of the mesh chunks, which are about to be deleted
+template <class VT>
+void removeHardwareBuffers(video::IVideoDriver* driver, const core::array<typename Octree<VT>::SMeshChunk>& meshes)
+{
+	if (!driver)
+		return;
+
+	for (u32 i=0; i<meshes.size(); ++i)
+		driver->removeHardwareBuffer(&meshes[i]);
+}
+
+template <class VT>
+void renderMeshBuffer(video::IVideoDriver* driver, EOCTREENODE_VBO useVBO, typename Octree<VT>::SMeshChunk& meshChunk,
+	const typename Octree<VT>::SIndexData& indexData, const core::array<video::SIndexRange>& ranges)
 {
 	switch ( useVBO )
 	{
@@ -115,20 +167,22 @@ void renderMeshBuffer(video::IVideoDriver* driver, EOCTREENODE_VBO useVBO, typen
 			driver->drawMeshBuffer ( &meshChunk );
 			break;
 		case EOV_USE_VBO_WITH_VISIBITLY:
-		{
-			u16* oldPointer = meshChunk.Indices.pointer();
-			const u32 oldSize = meshChunk.Indices.size();
-			meshChunk.Indices.set_free_when_destroyed(false);
-			meshChunk.Indices.set_pointer(indexData.Indices, indexData.CurrentSize, false, false);
-			meshChunk.setDirty(scene::EBT_INDEX);
-			driver->drawMeshBuffer ( &meshChunk );
-			meshChunk.Indices.set_pointer(oldPointer, oldSize);
-			meshChunk.setDirty(scene::EBT_INDEX);
+			driver->drawMeshBufferRanges(&meshChunk, ranges.const_pointer(), ranges.size());
 			break;
-		}
 	}
 }
 
+//! OnAnimate() is called just before rendering the whole scene.
+void COctreeSceneNode::OnAnimate(u32 timeMs)
+{
+	// the render passes are counted again each frame, also when the node
+	// didn't register again because the scene manager kept its render lists
+	PassCount = 0;
+
+	ISceneNode::OnAnimate(timeMs);
+}
+
+
 //! renders the node.
 void COctreeSceneNode::render()
 {
@@ -167,15 +221,7 @@ void COctreeSceneNode::render()
 	case video::EVT_STANDARD:
 		{
 			IRR_PROFILE(getProfiler().start(EPID_OC_CALCPOLYS));
-			switch ( PolygonChecks )
-			{
-				case EOPC_BOX:
-					StdOctree->calculatePolys(box);
-					break;
-				case EOPC_FRUSTUM:
-					StdOctree->calculatePolys(frust);
-					break;
-			}
+			calculateVisiblePolys(StdOctree, UseVBOs, PolygonChecks, frust, box);
 			IRR_PROFILE(getProfiler().stop(EPID_OC_CALCPOLYS));
 
 			const Octree<video::S3DVertex>::SIndexData* d = StdOctree->getIndexData();
@@ -192,7 +238,7 @@ void COctreeSceneNode::render()
 				if (transparent == isTransparentPass)
 				{
 					driver->setMaterial(Materials[i]);
-					renderMeshBuffer<video::S3DVertex>(driver, UseVBOs, StdMeshes[i], d[i]);
+					renderMeshBuffer<video::S3DVertex>(driver, UseVBOs, StdMeshes[i], d[i], StdOctree->getRanges(i));
 				}
 			}
 		}
@@ -200,15 +246,7 @@ void COctreeSceneNode::render()
 	case video::EVT_2TCOORDS:
 		{
 			IRR_PROFILE(getProfiler().start(EPID_OC_CALCPOLYS));
-			switch ( PolygonChecks )
-			{
-				case EOPC_BOX:
-					LightMapOctree->calculatePolys(box);
-					break;
-				case EOPC_FRUSTUM:
-					LightMapOctree->calculatePolys(frust);
-					break;
-			}
+			calculateVisiblePolys(LightMapOctree, UseVBOs, PolygonChecks, frust, box);
 			IRR_PROFILE(getProfiler().stop(EPID_OC_CALCPOLYS));
 
 			const Octree<video::S3DVertex2TCoords>::SIndexData* d = LightMapOctree->getIndexData();
@@ -227,7 +265,7 @@ void COctreeSceneNode::render()
 				{
 					driver->setMaterial(Materials[i]);
 
-					renderMeshBuffer<video::S3DVertex2TCoords>(driver, UseVBOs, LightMapMeshes[i], d[i]);
+					renderMeshBuffer<video::S3DVertex2TCoords>(driver, UseVBOs, LightMapMeshes[i], d[i], LightMapOctree->getRanges(i));
 				}
 			}
 		}
@@ -235,15 +273,7 @@ void COctreeSceneNode::render()
 	case video::EVT_TANGENTS:
 		{
 			IRR_PROFILE(getProfiler().start(EPID_OC_CALCPOLYS));
-			switch ( PolygonChecks )
-			{
-				case EOPC_BOX:
-					TangentsOctree->calculatePolys(box);
-					break;
-				case EOPC_FRUSTUM:
-					TangentsOctree->calculatePolys(frust);
-					break;
-			}
+			calculateVisiblePolys(TangentsOctree, UseVBOs, PolygonChecks, frust, box);
 			IRR_PROFILE(getProfiler().stop(EPID_OC_CALCPOLYS));
 
 			const Octree<video::S3DVertexTangents>::SIndexData* d =  TangentsOctree->getIndexData();
@@ -261,7 +291,7 @@ void COctreeSceneNode::render()
 				if (transparent == isTransparentPass)
 				{
 					driver->setMaterial(Materials[i]);
-					renderMeshBuffer<video::S3DVertexTangents>(driver, UseVBOs, TangentsMeshes[i], d[i]);
+					renderMeshBuffer<video::S3DVertexTangents>(driver, UseVBOs, TangentsMeshes[i], d[i], TangentsOctree->getRanges(i));
 				}
 			}
 		}
@@ -457,6 +487,7 @@ bool COctreeSceneNode::createTree(IMesh* mesh)
 				}
 
 				StdOctree = new Octree<video::S3DVertex>(StdMeshes, MinimalPolysPerNode);
+				sortIndicesByNodes(StdOctree, StdMeshes, UseVBOs);
 				nodeCount = StdOctree->getNodeCount();
 			}
 			break;
@@ -475,13 +506,7 @@ bool COctreeSceneNode::createTree(IMesh* mesh)
 						Octree<video::S3DVertex2TCoords>::SMeshChunk& nchunk = LightMapMeshes.getLast();
 						nchunk.MaterialId = Materials.size() - 1;
 
-						if (UseVBOs == EOV_USE_VBO_WITH_VISIBITLY)
-						{
-							nchunk.setHardwareMappingHint(scene::EHM_STATIC, scene::EBT_VERTEX);
-							nchunk.setHardwareMappingHint(scene::EHM_DYNAMIC, scene::EBT_INDEX);
-						}
-						else
-							nchunk.setHardwareMappingHint(scene::EHM_STATIC);
+						nchunk.setHardwareMappingHint(scene::EHM_STATIC);
 
 						u32 v;
 						nchunk.Vertices.reallocate(b->getVertexCount());
@@ -509,6 +534,7 @@ bool COctreeSceneNode::createTree(IMesh* mesh)
 				}
 
 				LightMapOctree = new Octree<video::S3DVertex2TCoords>(LightMapMeshes, MinimalPolysPerNode);
+				sortIndicesByNodes(LightMapOctree, LightMapMeshes, UseVBOs);
 				nodeCount = LightMapOctree->getNodeCount();
 			}
 			break;
@@ -559,6 +585,7 @@ bool COctreeSceneNode::createTree(IMesh* mesh)
 				}
 
 				TangentsOctree = new Octree<video::S3DVertexTangents>(TangentsMeshes, MinimalPolysPerNode);
+				sortIndicesByNodes(TangentsOctree, TangentsMeshes, UseVBOs);
 				nodeCount = TangentsOctree->getNodeCount();
 			}
 			break;
@@ -632,6 +659,12 @@ void COctreeSceneNode::deserializeAttributes(io::IAttributes* in, io::SAttribute
 
 void COctreeSceneNode::deleteTree()
 {
+	// the driver keeps the hardware buffers of the chunks by address
+	video::IVideoDriver* driver = SceneManager->getVideoDriver();
+	removeHardwareBuffers<video::S3DVertex>(driver, StdMeshes);
+	removeHardwareBuffers<video::S3DVertex2TCoords>(driver, LightMapMeshes);
+	removeHardwareBuffers<video::S3DVertexTangents>(driver, TangentsMeshes);
+
 	delete StdOctree;
 	StdOctree = 0;
 	StdMeshes.clear();
@@ -653,6 +686,7 @@ void COctreeSceneNode::deleteTree()
 void COctreeSceneNode::setMesh(IMesh* mesh)
 {
 	createTree(mesh);
+	markChanged();
 }
 
 IMesh* COctreeSceneNode::getMesh(void)
@@ -28,6 +28,9 @@ namespace scene
 
 		virtual void OnRegisterSceneNode() _IRR_OVERRIDE_;
 
+		//! OnAnimate() is called just before rendering the whole scene.
+		virtual void OnAnimate(u32 timeMs) _IRR_OVERRIDE_;
+
 		//! renders the node.
 		virtual void render() _IRR_OVERRIDE_;
 
@@ -78,14 +81,10 @@ namespace scene
 		//! or to remove attached child.
 		virtual bool removeChild(ISceneNode* child) _IRR_OVERRIDE_;
 
-		// TODO: Currently using VBO's will crash when reloading the model.
-		//       The reason is that COctreeSceneNode uses Octree::SMeshChunk 
-		//       which does use a an IReferenceCounted object on the stack.
-		//       Which breaks VBO's which correctly use reference counting.,
 		//! Set if/how vertex buffer object are used for the meshbuffers
 		/** NOTE: When there is already a mesh in the node this will rebuild
 		the octree. */
-		virtual void setUseVBO(EOCTREENODE_VBO useVBO);
+		virtual void setUseVBO(EOCTREENODE_VBO useVBO) _IRR_OVERRIDE_;
 
 		//! Get if/how vertex buffer object are used for the meshbuffers
 		virtual EOCTREENODE_VBO getUseVBO() const _IRR_OVERRIDE_;
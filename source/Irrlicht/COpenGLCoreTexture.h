@@ -16,6 +16,9 @@
 #include "os.h"
 #include "CImage.h"
 #include "CColorConverter.h"
+#include "CImageResampler.h"
+#include "EProfileIDs.h"
+#include "IProfiler.h"
 
 // Check if GL version we compile with should have the glGenerateMipmap function.
 #if defined(GL_VERSION_3_0) || defined(GL_ES_VERSION_2_0)
@@ -75,7 +78,7 @@ public:
 
 				if (images[i]->getDimension() == Size)
 					images[i]->copyTo(Images[i]);
-				else
+				else if (!images[i]->copyToResampled(Images[i], EIF_TRIANGLE, 1))
 					images[i]->copyToScaling(Images[i]);
 
 				if ( images[i]->getMipMapsData() )
@@ -84,9 +87,9 @@ public:
 					{
 						Images[i]->setMipMapsData( images[i]->getMipMapsData(), false, true);
 					}
-					else
+					else if (!Images[i]->createMipMaps(EIF_BOX, 1))
 					{
-						// TODO: handle at least mipmap with changing color format
+						// TODO: handle the color formats the resampler doesn't support
 						os::Printer::log("COpenGLCoreTexture: Can't handle format changes for mipmap data. Mipmap data dropped", ELL_WARNING);
 					}
 				}
@@ -131,9 +134,18 @@ public:
 		if (HasMipMaps && !LegacyAutoGenerateMipMaps)
 		{
 			// Create mipmaps (either from image mipmaps or generate them)
+			core::array<u8> generatedMipMaps;
 			for (u32 i = 0; i < (*tmpImages).size(); ++i) {
 
 				void* mipmapsData = (*tmpImages)[i]->getMipMapsData();
+
+				// drivers usually use a box filter, the sharper mipmaps are made on the cpu
+				if (!mipmapsData && Driver->getTextureCreationFlag(ETCF_OPTIMIZED_FOR_QUALITY) && CImageResampler::canResample(ColorFormat))
+				{
+					generatedMipMaps.set_used(CImageResampler::getMipMapsDataSize(ColorFormat, Size));
+					if (CImageResampler::createMipMaps((*tmpImages)[i], EIF_LANCZOS, generatedMipMaps.pointer(), 0))
+						mipmapsData = generatedMipMaps.pointer();
+				}
 				Driver->testGLError(__LINE__);
 				regenerateMipMapLevels(mipmapsData, i);
 
@@ -578,8 +590,10 @@ protected:
 		if (!data)
 			return;
 
-		u32 width = Size.Width >> level;
-		u32 height = Size.Height >> level;
+		IRR_PROFILE(CProfileScope p1(EPID_VD_UPLOAD_TEXTURE);)
+
+		u32 width = core::max_(Size.Width >> level, 1u);
+		u32 height = core::max_(Size.Height >> level, 1u);
 
 		GLenum tmpTextureType = TextureType;
 
@@ -9,6 +9,8 @@
 #ifdef _IRR_COMPILE_WITH_OPENGL_
 
 #include "os.h"
+#include "EProfileIDs.h"
+#include "IProfiler.h"
 
 #include "COpenGLCacheHandler.h"
 #include "COpenGLMaterialRenderer.h"
@@ -34,6 +36,7 @@ const u16 COpenGLDriver::Quad2DIndices[4] = { 0, 1, 2, 3 };
 
 COpenGLDriver::COpenGLDriver(const SIrrlichtCreationParameters& params, io::IFileSystem* io, CIrrDeviceSDL* device)
 	: CNullDriver(io, params.WindowSize), COpenGLExtensionHandler(), CacheHandler(0),
+	IndexRanges(0), IndexRangeCount(0),
 	CurrentRenderMode(ERM_NONE), ResetRenderStates(true), Transformation3DChanged(true),
 	AntiAlias(params.AntiAlias), ColorFormat(ECF_R8G8B8), FixedPipelineState(EOFPS_ENABLE),
 	Params(params), SDLDevice(device), ContextManager(0), DeviceType(EIDT_SDL)
@@ -42,6 +45,16 @@ COpenGLDriver::COpenGLDriver(const SIrrlichtCreationParameters& params, io::IFil
 	setDebugName("COpenGLDriver");
 #endif
 
+	IRR_PROFILE(
+		static bool initProfile = false;
+		if (!initProfile )
+		{
+			initProfile = true;
+			getProfiler().add(EPID_GL_UPDATE_VERTEX_HW_BUF, L"upVertBuf", L"OpenGL");
+			getProfiler().add(EPID_GL_UPDATE_INDEX_HW_BUF, L"upIdxBuf", L"OpenGL");
+		}
+	)
+
 	genericDriverInit();
 }
 
@@ -358,6 +371,8 @@ bool COpenGLDriver::updateVertexHardwareBuffer(SHWBufferLink_opengl *HWBuffer)
 	if (!FeatureAvailable[IRR_ARB_vertex_buffer_object])
 		return false;
 
+	IRR_PROFILE(CProfileScope p1(EPID_GL_UPDATE_VERTEX_HW_BUF);)
+
 #if defined(GL_ARB_vertex_buffer_object)
 	const scene::IMeshBuffer* mb = HWBuffer->MeshBuffer;
 	const void* vertices=mb->getVertices();
@@ -462,6 +477,8 @@ bool COpenGLDriver::updateIndexHardwareBuffer(SHWBufferLink_opengl *HWBuffer)
 	if (!FeatureAvailable[IRR_ARB_vertex_buffer_object])
 		return false;
 
+	IRR_PROFILE(CProfileScope p1(EPID_GL_UPDATE_INDEX_HW_BUF);)
+
 #if defined(GL_ARB_vertex_buffer_object)
 	const scene::IMeshBuffer* mb = HWBuffer->MeshBuffer;
 
@@ -504,6 +521,8 @@ bool COpenGLDriver::updateIndexHardwareBuffer(SHWBufferLink_opengl *HWBuffer)
 
 	extGlBindBuffer(GL_ELEMENT_ARRAY_BUFFER, HWBuffer->vbo_indicesID);
 
+	IndexBytesUploaded += indexCount * indexSize;
+
 	// copy data to graphics card
 	if (!newBuffer)
 		extGlBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * indexSize, indices);
@@ -660,6 +679,53 @@ void COpenGLDriver::drawHardwareBuffer(SHWBufferLink *_HWBuffer)
 }
 
 
+//! Draw parts of the indices of a hardware buffer, with one multi draw call where available
+void COpenGLDriver::drawHardwareBufferRanges(SHWBufferLink *_HWBuffer, const SIndexRange* ranges, u32 rangeCount)
+{
+	if (!_HWBuffer || !rangeCount)
+		return;
+
+	updateHardwareBuffer(_HWBuffer); //check if update is needed
+	_HWBuffer->LastUsed=0; //reset count
+
+#if defined(GL_ARB_vertex_buffer_object)
+	SHWBufferLink_opengl *HWBuffer=(SHWBufferLink_opengl*)_HWBuffer;
+
+	const scene::IMeshBuffer* mb = HWBuffer->MeshBuffer;
+	const void *vertices=mb->getVertices();
+	const void *indexList=mb->getIndices();
+
+	if (HWBuffer->Mapped_Vertex!=scene::EHM_NEVER)
+	{
+		extGlBindBuffer(GL_ARRAY_BUFFER, HWBuffer->vbo_verticesID);
+		vertices=0;
+	}
+
+	if (HWBuffer->Mapped_Index!=scene::EHM_NEVER)
+	{
+		extGlBindBuffer(GL_ELEMENT_ARRAY_BUFFER, HWBuffer->vbo_indicesID);
+		indexList=0;
+	}
+
+	u32 primitiveCount = 0;
+	for (u32 i=0; i<rangeCount; ++i)
+		primitiveCount += ranges[i].Count / 3;
+
+	// renderArray draws the ranges instead of the whole index list
+	IndexRanges = ranges;
+	IndexRangeCount = rangeCount;
+	drawVertexPrimitiveList(vertices, mb->getVertexCount(), indexList, primitiveCount, mb->getVertexType(), scene::EPT_TRIANGLES, mb->getIndexType());
+	IndexRanges = 0;
+	IndexRangeCount = 0;
+
+	if (HWBuffer->Mapped_Vertex!=scene::EHM_NEVER)
+		extGlBindBuffer(GL_ARRAY_BUFFER, 0);
+	if (HWBuffer->Mapped_Index!=scene::EHM_NEVER)
+		extGlBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+#endif
+}
+
+
 //! Create occlusion query.
 /** Use node for identification and mesh for occlusion test. */
 void COpenGLDriver::addOcclusionQuery(scene::ISceneNode* node,
@@ -669,7 +735,7 @@ void COpenGLDriver::addOcclusionQuery(scene::ISceneNode* node,
 		return;
 
 	CNullDriver::addOcclusionQuery(node, mesh);
-	const s32 index = OcclusionQueries.linear_search(SOccQuery(node));
+	const s32 index = findOcclusionQuery(node);
 	if ((index != -1) && (OcclusionQueries[index].UID == 0))
 		extGlGenQueries(1, reinterpret_cast<GLuint*>(&OcclusionQueries[index].UID));
 }
@@ -678,7 +744,7 @@ void COpenGLDriver::addOcclusionQuery(scene::ISceneNode* node,
 //! Remove occlusion query.
 void COpenGLDriver::removeOcclusionQuery(scene::ISceneNode* node)
 {
-	const s32 index = OcclusionQueries.linear_search(SOccQuery(node));
+	const s32 index = findOcclusionQuery(node);
 	if (index != -1)
 	{
 		if (OcclusionQueries[index].UID != 0)
@@ -696,7 +762,7 @@ void COpenGLDriver::runOcclusionQuery(scene::ISceneNode* node, bool visible)
 	if (!node)
 		return;
 
-	const s32 index = OcclusionQueries.linear_search(SOccQuery(node));
+	const s32 index = findOcclusionQuery(node);
 	if (index != -1)
 	{
 		if (OcclusionQueries[index].UID)
@@ -725,7 +791,7 @@ void COpenGLDriver::runOcclusionQuery(scene::ISceneNode* node, bool visible)
 Update might not occur in this case, though */
 void COpenGLDriver::updateOcclusionQuery(scene::ISceneNode* node, bool block)
 {
-	const s32 index = OcclusionQueries.linear_search(SOccQuery(node));
+	const s32 index = findOcclusionQuery(node);
 	if (index != -1)
 	{
 		// not yet started
@@ -770,7 +836,7 @@ The value is a safe approximation, i.e. can be larger than the
 actual value of pixels. */
 u32 COpenGLDriver::getOcclusionQueryResult(scene::ISceneNode* node) const
 {
-	const s32 index = OcclusionQueries.linear_search(SOccQuery(node));
+	const s32 index = findOcclusionQuery(node);
 	if (index != -1)
 		return OcclusionQueries[index].Result;
 	else
@@ -1096,7 +1162,10 @@ void COpenGLDriver::renderArray(const void* indexList, u32 primitiveCount,
 			glDrawElements(GL_TRIANGLE_FAN, primitiveCount+2, indexSize, indexList);
 			break;
 		case scene::EPT_TRIANGLES:
-			glDrawElements(GL_TRIANGLES, primitiveCount*3, indexSize, indexList);
+			if (IndexRangeCount)
+				renderIndexRanges(indexList, iType);
+			else
+				glDrawElements(GL_TRIANGLES, primitiveCount*3, indexSize, indexList);
 			break;
 		case scene::EPT_QUAD_STRIP:
 			glDrawElements(GL_QUAD_STRIP, primitiveCount*2+2, indexSize, indexList);
@@ -1111,6 +1180,29 @@ void COpenGLDriver::renderArray(const void* indexList, u32 primitiveCount,
 }
 
 
+void COpenGLDriver::renderIndexRanges(const void* indexList, E_INDEX_TYPE iType)
+{
+	const GLenum indexType = (iType == EIT_16BIT) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	const u32 indexSize = (iType == EIT_16BIT) ? sizeof(u16) : sizeof(u32);
+
+	RangeCounts.set_used(IndexRangeCount);
+	RangeOffsets.set_used(IndexRangeCount);
+	for (u32 i=0; i<IndexRangeCount; ++i)
+	{
+		RangeCounts[i] = IndexRanges[i].Count;
+		RangeOffsets[i] = (const u8*)indexList + IndexRanges[i].Start * indexSize;
+	}
+
+	if (Version >= 104 || FeatureAvailable[IRR_EXT_multi_draw_arrays])
+		extGlMultiDrawElements(GL_TRIANGLES, RangeCounts.const_pointer(), indexType, RangeOffsets.const_pointer(), IndexRangeCount);
+	else
+	{
+		for (u32 i=0; i<IndexRangeCount; ++i)
+			glDrawElements(GL_TRIANGLES, RangeCounts[i], indexType, RangeOffsets[i]);
+	}
+}
+
+
 //! draws a vertex primitive list in 2d
 void COpenGLDriver::draw2DVertexPrimitiveList(const void* vertices, u32 vertexCount,
 		const void* indexList, u32 primitiveCount,
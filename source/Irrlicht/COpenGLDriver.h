@@ -91,6 +91,9 @@ namespace video
 		//! Draw hardware buffer
 		virtual void drawHardwareBuffer(SHWBufferLink *HWBuffer) _IRR_OVERRIDE_;
 
+		//! Draw parts of the indices of a hardware buffer, with one multi draw call where available
+		virtual void drawHardwareBufferRanges(SHWBufferLink *HWBuffer, const SIndexRange* ranges, u32 rangeCount) _IRR_OVERRIDE_;
+
 		//! Create occlusion query.
 		/** Use node for identification and mesh for occlusion test. */
 		virtual void addOcclusionQuery(scene::ISceneNode* node,
@@ -458,6 +461,9 @@ namespace video
 		void renderArray(const void* indexList, u32 primitiveCount,
 				scene::E_PRIMITIVE_TYPE pType, E_INDEX_TYPE iType);
 
+		//! draws IndexRanges of a triangle list for renderArray
+		void renderIndexRanges(const void* indexList, E_INDEX_TYPE iType);
+
 		//! Same as `CacheHandler->setViewport`, but also sets `ViewPort`
 		virtual void setViewPortRaw(u32 width, u32 height);
 
@@ -467,6 +473,12 @@ namespace video
 		core::matrix4 Matrices[ETS_COUNT];
 		core::array<u8> ColorBuffer;
 
+		//! ranges drawn by renderArray instead of the whole index list, set by drawHardwareBufferRanges
+		const SIndexRange* IndexRanges;
+		u32 IndexRangeCount;
+		core::array<GLsizei> RangeCounts;
+		core::array<const void*> RangeOffsets;
+
 		//! enumeration for rendering modes such as 2d and 3d for minizing the switching of renderStates.
 		enum E_RENDER_MODE
 		{
@@ -81,6 +81,8 @@ COpenGLExtensionHandler::COpenGLExtensionHandler() :
 	// Blend
 	pGlBlendFuncSeparateEXT(0), pGlBlendFuncSeparate(0),
 	pGlBlendEquationEXT(0), pGlBlendEquation(0), pGlBlendEquationSeparateEXT(0), pGlBlendEquationSeparate(0),
+	// Multi draw
+	pGlMultiDrawElements(0), pGlMultiDrawElementsEXT(0),
 	// Indexed
 	pGlEnableIndexedEXT(0), pGlDisableIndexedEXT(0),
 	pGlColorMaskIndexedEXT(0),
@@ -568,6 +570,10 @@ void COpenGLExtensionHandler::initExtensions(bool stencilBuffer)
 	pGlBlendEquationSeparateEXT = (PFNGLBLENDEQUATIONSEPARATEEXTPROC) IRR_OGL_LOAD_EXTENSION("glBlendEquationSeparateEXT");
 	pGlBlendEquationSeparate = (PFNGLBLENDEQUATIONSEPARATEPROC) IRR_OGL_LOAD_EXTENSION("glBlendEquationSeparate");
 
+	// multi draw
+	pGlMultiDrawElements = (PFNGLMULTIDRAWELEMENTSPROC) IRR_OGL_LOAD_EXTENSION("glMultiDrawElements");
+	pGlMultiDrawElementsEXT = (PFNGLMULTIDRAWELEMENTSEXTPROC) IRR_OGL_LOAD_EXTENSION("glMultiDrawElementsEXT");
+
 	// indexed
 	pGlEnableIndexedEXT = (PFNGLENABLEINDEXEDEXTPROC) IRR_OGL_LOAD_EXTENSION("glEnableIndexedEXT");
 	pGlDisableIndexedEXT = (PFNGLDISABLEINDEXEDEXTPROC) IRR_OGL_LOAD_EXTENSION("glDisableIndexedEXT");
@@ -1171,6 +1171,7 @@ class COpenGLExtensionHandler
 	void extGlGetBufferPointerv (GLenum target, GLenum pname, GLvoid **params);
 	void extGlProvokingVertex(GLenum mode);
 	void extGlProgramParameteri(GLuint program, GLenum pname, GLint value);
+	void extGlMultiDrawElements(GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount);
 
 	// occlusion query
 	void extGlGenQueries(GLsizei n, GLuint *ids);
@@ -1354,6 +1355,9 @@ class COpenGLExtensionHandler
 		PFNGLBLENDEQUATIONPROC pGlBlendEquation;
 		PFNGLBLENDEQUATIONSEPARATEEXTPROC pGlBlendEquationSeparateEXT;
 		PFNGLBLENDEQUATIONSEPARATEPROC pGlBlendEquationSeparate;
+		// Multi draw
+		PFNGLMULTIDRAWELEMENTSPROC pGlMultiDrawElements;
+		PFNGLMULTIDRAWELEMENTSEXTPROC pGlMultiDrawElementsEXT;
 		// Indexed
 		PFNGLENABLEINDEXEDEXTPROC pGlEnableIndexedEXT;
 		PFNGLDISABLEINDEXEDEXTPROC pGlDisableIndexedEXT;
@@ -2758,6 +2762,22 @@ inline void COpenGLExtensionHandler::irrGlBlendEquation(GLenum mode)
 #endif
 }
 
+inline void COpenGLExtensionHandler::extGlMultiDrawElements(GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount)
+{
+#ifdef _IRR_OPENGL_USE_EXTPOINTER_
+	if (pGlMultiDrawElements)
+		pGlMultiDrawElements(mode, count, type, indices, drawcount);
+	else if (pGlMultiDrawElementsEXT)
+		pGlMultiDrawElementsEXT(mode, count, type, indices, drawcount);
+#elif defined(GL_VERSION_1_4)
+	glMultiDrawElements(mode, count, type, indices, drawcount);
+#elif defined(GL_EXT_multi_draw_arrays)
+	glMultiDrawElementsEXT(mode, count, type, indices, drawcount);
+#else
+	os::Printer::log("glMultiDrawElements not supported", ELL_ERROR);
+#endif
+}
+
 inline void COpenGLExtensionHandler::irrGlEnableIndexed(GLenum target, GLuint index)
 {
 #ifdef _IRR_OPENGL_USE_EXTPOINTER_
@@ -4,9 +4,51 @@
 
 #include "CProfiler.h"
 #include "CTimer.h"
+#include "os.h"
+#include <thread>
 
 namespace irr
 {
+namespace
+{
+	// deeper nested scopes are still counted, but not recorded
+	const u32 MAX_TRACE_DEPTH = 64;
+
+	std::atomic<u32> NextTraceThread(0);
+
+	//! Stack of the open trace scopes of one thread
+	struct STraceThread
+	{
+		STraceThread() : Index(NextTraceThread++), Generation(0), Depth(0) {}
+
+		u32 Index;
+		u32 Generation;
+		u32 Depth;
+		s32 Ids[MAX_TRACE_DEPTH];
+		u64 Starts[MAX_TRACE_DEPTH];
+	};
+
+	thread_local STraceThread TraceThread;
+
+	//! Append a name as json string content
+	void appendJsonString(core::stringc &out, const core::stringw &str)
+	{
+		for ( u32 i=0; i<str.size(); ++i )
+		{
+			const wchar_t c = str[i];
+			if ( c == L'"' || c == L'\\' )
+			{
+				out.append('\\');
+				out.append((c8)c);
+			}
+			else if ( c < 32 || c > 126 )
+				out.append('?');
+			else
+				out.append((c8)c);
+		}
+	}
+} // end anonymous namespace
+
 IRRLICHT_API IProfiler& IRRCALLCONV getProfiler()
 {
 	static CProfiler profiler;
@@ -14,6 +56,7 @@ IRRLICHT_API IProfiler& IRRCALLCONV getProfiler()
 }
 
 CProfiler::CProfiler()
+	: TraceMask(0), TraceCount(0), TraceGeneration(0), TraceStartTime(0), TraceWriters(0)
 {
 	Timer = new CTimer(true);
 
@@ -101,4 +144,148 @@ core::stringw CProfiler::makeTitleString() const
 	return core::stringw("name           calls       time(sum)   time(avg)   time(max)");
 }
 
+void CProfiler::startTrace(u32 maxEvents)
+{
+	// no thread writes into the old ring buffer while it's replaced
+	stopTraceWriters();
+
+	u32 size = 1;
+	while ( size < maxEvents )
+		size <<= 1;
+
+	TraceEvents.set_used(size);
+	TraceMask = size-1;
+	TraceCount = 0;
+	TraceStartTime = os::Timer::getRealTimeNs();
+	++TraceGeneration;
+
+	// publishes the prepared ring buffer to the recording threads
+	Tracing.store(true);
+}
+
+void CProfiler::stopTrace()
+{
+	stopTraceWriters();
+}
+
+void CProfiler::stopTraceWriters()
+{
+	// sequentially consistent like the writers, so either they see the
+	// stopped trace or they are counted here
+	Tracing.store(false);
+	while ( TraceWriters.load() != 0 )
+		std::this_thread::yield();
+}
+
+void CProfiler::beginTraceScope(s32 id)
+{
+	STraceThread& thread = TraceThread;
+
+	// scopes still open from an older trace are dropped
+	const u32 generation = TraceGeneration.load(std::memory_order_relaxed);
+	if ( thread.Generation != generation )
+	{
+		thread.Generation = generation;
+		thread.Depth = 0;
+	}
+
+	if ( thread.Depth < MAX_TRACE_DEPTH )
+	{
+		thread.Ids[thread.Depth] = id;
+		thread.Starts[thread.Depth] = os::Timer::getRealTimeNs();
+	}
+	++thread.Depth;
+}
+
+void CProfiler::endTraceScope()
+{
+	const u64 now = os::Timer::getRealTimeNs();
+
+	STraceThread& thread = TraceThread;
+
+	// the trace might have been stopped since the scope began,
+	// stopTraceWriters waits for the threads counted here
+	TraceWriters.fetch_add(1);
+	if ( !Tracing.load() || thread.Depth == 0 ||
+		thread.Generation != TraceGeneration.load(std::memory_order_relaxed) )
+	{
+		TraceWriters.fetch_sub(1, std::memory_order_release);
+		return;
+	}
+
+	--thread.Depth;
+	if ( thread.Depth >= MAX_TRACE_DEPTH || TraceEvents.empty() )
+	{
+		TraceWriters.fetch_sub(1, std::memory_order_release);
+		return;
+	}
+
+	// claiming a slot is the only synchronization needed between threads
+	const u32 slot = TraceCount.fetch_add(1, std::memory_order_relaxed) & TraceMask;
+
+	STraceEvent& event = TraceEvents[slot];
+	event.Start = thread.Starts[thread.Depth] - TraceStartTime;
+	event.End = now - TraceStartTime;
+	event.Id = thread.Ids[thread.Depth];
+	event.Thread = (u16)thread.Index;
+	event.Depth = (u16)thread.Depth;
+
+	TraceWriters.fetch_sub(1, std::memory_order_release);
+}
+
+void CProfiler::printTrace(core::stringc &ostream) const
+{
+	// the ring buffer is still written while recording
+	const u32 total = isTracing() ? 0 : TraceCount.load();
+	const u32 count = core::min_(total, TraceEvents.size());
+
+	ostream.reserve(ostream.size() + count * 128 + 64);
+	ostream += "{\"traceEvents\":[";
+
+	// oldest event first, the ring buffer might have wrapped around
+	for ( u32 i=0; i<count; ++i )
+	{
+		const STraceEvent& event = TraceEvents[(total - count + i) & TraceMask];
+
+		// ProfileDatas is sorted by id
+		const SProfileData* data = 0;
+		s32 low = 0;
+		s32 high = (s32)ProfileDatas.size()-1;
+		while ( low <= high )
+		{
+			const s32 mid = (low + high) / 2;
+			if ( ProfileDatas[mid].getId() < event.Id )
+				low = mid+1;
+			else if ( ProfileDatas[mid].getId() > event.Id )
+				high = mid-1;
+			else
+			{
+				data = &ProfileDatas[mid];
+				break;
+			}
+		}
+
+		ostream += i ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+		if ( data )
+			appendJsonString(ostream, data->getName());
+		else
+			ostream += event.Id;
+		ostream += "\",\"cat\":\"";
+		if ( data )
+			appendJsonString(ostream, ProfileGroups[data->getGroupIndex()].getName());
+
+		// timestamps are in microseconds, keep the nanoseconds as fraction
+		const u64 duration = event.End - event.Start;
+		char dummy[160];
+		snprintf(dummy, sizeof(dummy), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu.%03u,\"dur\":%llu.%03u,\"args\":{\"depth\":%u}}",
+			(u32)event.Thread,
+			(unsigned long long)(event.Start / 1000), (u32)(event.Start % 1000),
+			(unsigned long long)(duration / 1000), (u32)(duration % 1000),
+			(u32)event.Depth);
+		ostream += dummy;
+	}
+
+	ostream += "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
 } // namespace irr
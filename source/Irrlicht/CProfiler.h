@@ -7,6 +7,7 @@
 
 #include "IrrCompileConfig.h"
 #include "IProfiler.h"
+#include <atomic>
 
 namespace irr
 {
@@ -23,9 +24,48 @@ public:
 	//! Write the profile data of one group into a string
     virtual void printGroup(core::stringw &result, u32 groupIndex, bool suppressUncalled) const  _IRR_OVERRIDE_;
 
+	//! Start recording a trace
+	virtual void startTrace(u32 maxEvents) _IRR_OVERRIDE_;
+
+	//! Stop recording the trace
+	virtual void stopTrace() _IRR_OVERRIDE_;
+
+	//! Begin a traced scope on the calling thread
+	virtual void beginTraceScope(s32 id) _IRR_OVERRIDE_;
+
+	//! End the innermost traced scope of the calling thread
+	virtual void endTraceScope() _IRR_OVERRIDE_;
+
+	//! Write the recorded trace in the Chrome trace event format
+	virtual void printTrace(core::stringc &result) const _IRR_OVERRIDE_;
+
 protected:
 	core::stringw makeTitleString() const;
 	core::stringw getAsString(const SProfileData& data) const;
+
+	//! One finished scope of the trace
+	struct STraceEvent
+	{
+		u64 Start;	// nanoseconds since startTrace
+		u64 End;
+		s32 Id;
+		u16 Thread;
+		u16 Depth;
+	};
+
+	// ring buffer, size is a power of two
+	core::array<STraceEvent> TraceEvents;
+	u32 TraceMask;
+	// total number of recorded events, wraps around the ring buffer
+	std::atomic<u32> TraceCount;
+	// incremented by startTrace to invalidate scopes of older traces
+	std::atomic<u32> TraceGeneration;
+	u64 TraceStartTime;
+	// threads inside endTraceScope, the ring buffer is only changed when there are none
+	std::atomic<u32> TraceWriters;
+
+	//! Stops recording and waits until no thread writes into the ring buffer
+	void stopTraceWriters();
 };
 } // namespace irr
 
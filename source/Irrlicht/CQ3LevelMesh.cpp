@@ -13,6 +13,7 @@
 #include "ILightSceneNode.h"
 #include "IQ3Shader.h"
 #include "IFileList.h"
+#include "irrHashMap.h"
 
 //#define TJUNCTION_SOLVER_ROUND
 //#define TJUNCTION_SOLVER_0125
@@ -162,6 +163,7 @@ bool CQ3LevelMesh::loadFile(io::IReadFile* file)
 
 	cleanMeshes();
 	calcBoundingBoxes();
+	buildBSPTree();
 	cleanLoader();
 
 	return true;
@@ -185,6 +187,7 @@ void CQ3LevelMesh::cleanLoader ()
 
 	Lightmap.clear();
 	Tex.clear();
+	FaceBuffers.clear();
 }
 
 //! returns the amount of frames in milliseconds. If the amount is 1, it is a static (=non animated) mesh.
@@ -314,7 +317,24 @@ void CQ3LevelMesh::loadFaces(tBSPLump* l, io::IReadFile* file)
 */
 void CQ3LevelMesh::loadPlanes(tBSPLump* l, io::IReadFile* file)
 {
-	// ignore
+	NumPlanes = l->length / sizeof(tBSPPlane);
+	if (!NumPlanes)
+		return;
+	Planes = new tBSPPlane[NumPlanes];
+
+	file->seek(l->offset);
+	file->read(Planes, l->length);
+
+	if ( LoadParam.swapHeader )
+	{
+		for (s32 i=0;i<NumPlanes;++i)
+		{
+			Planes[i].vNormal[0] = os::Byteswap::byteswap(Planes[i].vNormal[0]);
+			Planes[i].vNormal[1] = os::Byteswap::byteswap(Planes[i].vNormal[1]);
+			Planes[i].vNormal[2] = os::Byteswap::byteswap(Planes[i].vNormal[2]);
+			Planes[i].d = os::Byteswap::byteswap(Planes[i].d);
+		}
+	}
 }
 
 
@@ -322,7 +342,28 @@ void CQ3LevelMesh::loadPlanes(tBSPLump* l, io::IReadFile* file)
 */
 void CQ3LevelMesh::loadNodes(tBSPLump* l, io::IReadFile* file)
 {
-	// ignore
+	NumNodes = l->length / sizeof(tBSPNode);
+	if (!NumNodes)
+		return;
+	Nodes = new tBSPNode[NumNodes];
+
+	file->seek(l->offset);
+	file->read(Nodes, l->length);
+
+	if ( LoadParam.swapHeader )
+	{
+		for (s32 i=0;i<NumNodes;++i)
+		{
+			Nodes[i].plane = os::Byteswap::byteswap(Nodes[i].plane);
+			Nodes[i].front = os::Byteswap::byteswap(Nodes[i].front);
+			Nodes[i].back = os::Byteswap::byteswap(Nodes[i].back);
+			for (u32 j=0; j!=3; ++j)
+			{
+				Nodes[i].mins[j] = os::Byteswap::byteswap(Nodes[i].mins[j]);
+				Nodes[i].maxs[j] = os::Byteswap::byteswap(Nodes[i].maxs[j]);
+			}
+		}
+	}
 }
 
 
@@ -330,7 +371,31 @@ void CQ3LevelMesh::loadNodes(tBSPLump* l, io::IReadFile* file)
 */
 void CQ3LevelMesh::loadLeafs(tBSPLump* l, io::IReadFile* file)
 {
-	// ignore
+	NumLeafs = l->length / sizeof(tBSPLeaf);
+	if (!NumLeafs)
+		return;
+	Leafs = new tBSPLeaf[NumLeafs];
+
+	file->seek(l->offset);
+	file->read(Leafs, l->length);
+
+	if ( LoadParam.swapHeader )
+	{
+		for (s32 i=0;i<NumLeafs;++i)
+		{
+			Leafs[i].cluster = os::Byteswap::byteswap(Leafs[i].cluster);
+			Leafs[i].area = os::Byteswap::byteswap(Leafs[i].area);
+			for (u32 j=0; j!=3; ++j)
+			{
+				Leafs[i].mins[j] = os::Byteswap::byteswap(Leafs[i].mins[j]);
+				Leafs[i].maxs[j] = os::Byteswap::byteswap(Leafs[i].maxs[j]);
+			}
+			Leafs[i].leafface = os::Byteswap::byteswap(Leafs[i].leafface);
+			Leafs[i].numOfLeafFaces = os::Byteswap::byteswap(Leafs[i].numOfLeafFaces);
+			Leafs[i].leafBrush = os::Byteswap::byteswap(Leafs[i].leafBrush);
+			Leafs[i].numOfLeafBrushes = os::Byteswap::byteswap(Leafs[i].numOfLeafBrushes);
+		}
+	}
 }
 
 
@@ -338,15 +403,57 @@ void CQ3LevelMesh::loadLeafs(tBSPLump* l, io::IReadFile* file)
 */
 void CQ3LevelMesh::loadLeafFaces(tBSPLump* l, io::IReadFile* file)
 {
-	// ignore
+	NumLeafFaces = l->length / sizeof(s32);
+	if (!NumLeafFaces)
+		return;
+	LeafFaces = new s32[NumLeafFaces];
+
+	file->seek(l->offset);
+	file->read(LeafFaces, l->length);
+
+	if ( LoadParam.swapHeader )
+	{
+		for (s32 i=0;i<NumLeafFaces;++i)
+			LeafFaces[i] = os::Byteswap::byteswap(LeafFaces[i]);
+	}
 }
 
 
 /*!
+	the visibility data is kept in the bsp tree, it isn't needed to build the meshes
 */
 void CQ3LevelMesh::loadVisData(tBSPLump* l, io::IReadFile* file)
 {
-	// ignore
+	BSPTree.ClusterCount = 0;
+	BSPTree.BytesPerCluster = 0;
+	BSPTree.Visibility.clear();
+
+	if ( l->length < (s32) (2 * sizeof(s32)) )
+		return;
+
+	s32 header[2];
+	file->seek(l->offset);
+	file->read(header, sizeof(header));
+
+	if ( LoadParam.swapHeader )
+	{
+		header[0] = os::Byteswap::byteswap(header[0]);
+		header[1] = os::Byteswap::byteswap(header[1]);
+	}
+
+	if ( header[0] <= 0 || header[1] <= 0 ||
+		header[1] < (header[0] + 7) / 8 ||
+		(s64) header[0] * header[1] > l->length - (s32) sizeof(header) )
+	{
+		os::Printer::log("quake3::loadVisData ignoring invalid visibility data", LevelName.c_str(), ELL_WARNING);
+		return;
+	}
+
+	const s32 size = header[0] * header[1];
+	BSPTree.Visibility.set_used(size);
+	file->read(BSPTree.Visibility.pointer(), size);
+	BSPTree.ClusterCount = header[0];
+	BSPTree.BytesPerCluster = header[1];
 }
 
 
@@ -863,6 +970,20 @@ scene::SMesh** CQ3LevelMesh::buildMesh(s32 num)
 	SToBuffer item [ E_Q3_MESH_SIZE ];
 	u32 itemSize;
 
+	if ( 0 == num )
+	{
+		// remember where the faces of the level end up, for the bsp tree
+		SFaceBuffer none;
+		none.Buffer = 0;
+		none.Indices.Start = 0;
+		none.Indices.Count = 0;
+
+		FaceBuffers.set_used(0);
+		FaceBuffers.reallocate(NumFaces);
+		for (i = 0; i < NumFaces; ++i)
+			FaceBuffers.push_back(none);
+	}
+
 	for (i = Models[num].faceIndex; i < Models[num].numOfFaces + Models[num].faceIndex; ++i)
 	{
 		const tBSPFace * face = Faces + i;
@@ -965,6 +1086,8 @@ scene::SMesh** CQ3LevelMesh::buildMesh(s32 num)
 			}
 
 
+			const u32 firstIndex = buffer->getIndexCount();
+
 			switch(Faces[i].type)
 			{
 				case 4: // billboards
@@ -1018,12 +1141,124 @@ scene::SMesh** CQ3LevelMesh::buildMesh(s32 num)
 					break;
 
 			} // end switch
+
+			if ( 0 == num && item[g].index == E_Q3_MESH_GEOMETRY )
+			{
+				FaceBuffers[i].Buffer = buffer;
+				FaceBuffers[i].Indices.Start = firstIndex;
+				FaceBuffers[i].Indices.Count = buffer->getIndexCount() - firstIndex;
+			}
 		}
 	}
 
 	return newmesh;
 }
 
+/*!
+	keeps the bsp tree of the level, to find the visible faces of the geometry mesh.
+	Needs the final mesh buffers, so it's done after cleanMeshes.
+*/
+void CQ3LevelMesh::buildBSPTree()
+{
+	BSPTree.Nodes.clear();
+	BSPTree.Leafs.clear();
+	BSPTree.LeafFaces.clear();
+	BSPTree.Faces.clear();
+
+	if ( !NumNodes || !NumLeafs || !NumPlanes )
+		return;
+
+	s32 i;
+
+	// the nodes reference their children by index, and every child follows its parent.
+	// So the tree can't contain loops.
+	for ( i = 0; i < NumNodes; ++i )
+	{
+		const tBSPNode& node = Nodes[i];
+		if ( node.plane < 0 || node.plane >= NumPlanes ||
+			( node.front >= 0 && ( node.front <= i || node.front >= NumNodes ) ) ||
+			( node.front < 0 && -( node.front + 1 ) >= NumLeafs ) ||
+			( node.back >= 0 && ( node.back <= i || node.back >= NumNodes ) ) ||
+			( node.back < 0 && -( node.back + 1 ) >= NumLeafs )
+			)
+		{
+			os::Printer::log("quake3::buildBSPTree invalid bsp nodes", LevelName.c_str(), ELL_WARNING);
+			return;
+		}
+	}
+
+	for ( i = 0; i < NumLeafs; ++i )
+	{
+		const tBSPLeaf& leaf = Leafs[i];
+		if ( leaf.leafface < 0 || leaf.numOfLeafFaces < 0 ||
+			leaf.leafface + leaf.numOfLeafFaces > NumLeafFaces )
+		{
+			os::Printer::log("quake3::buildBSPTree invalid bsp leafs", LevelName.c_str(), ELL_WARNING);
+			return;
+		}
+	}
+
+	// indices of the mesh buffers which survived cleanMeshes
+	core::hash_map<const IMeshBuffer*, s32> bufferIndex;
+	const SMesh* geometry = Mesh[E_Q3_MESH_GEOMETRY];
+	for ( u32 b = 0; b != geometry->MeshBuffers.size(); ++b )
+		bufferIndex.insert( geometry->MeshBuffers[b], b );
+
+	BSPTree.Faces.reallocate( FaceBuffers.size() );
+	for ( u32 f = 0; f != FaceBuffers.size(); ++f )
+	{
+		quake3::SBSPFace face;
+		face.MeshBuffer = -1;
+		face.Indices = FaceBuffers[f].Indices;
+
+		const core::hash_map<const IMeshBuffer*, s32>::Node* n =
+			FaceBuffers[f].Buffer ? bufferIndex.find( FaceBuffers[f].Buffer ) : 0;
+		if ( n && face.Indices.Count )
+			face.MeshBuffer = n->getValue();
+
+		BSPTree.Faces.push_back( face );
+	}
+
+	// quake3 is z up, irrlicht y up
+	BSPTree.Nodes.reallocate( NumNodes );
+	for ( i = 0; i < NumNodes; ++i )
+	{
+		const tBSPPlane& plane = Planes[Nodes[i].plane];
+
+		quake3::SBSPNode node;
+		node.Plane.setPlane( core::vector3df( plane.vNormal[0], plane.vNormal[2], plane.vNormal[1] ), -plane.d );
+		node.Children[0] = Nodes[i].front;
+		node.Children[1] = Nodes[i].back;
+		BSPTree.Nodes.push_back( node );
+	}
+
+	BSPTree.Leafs.reallocate( NumLeafs );
+	for ( i = 0; i < NumLeafs; ++i )
+	{
+		const tBSPLeaf& leaf = Leafs[i];
+
+		quake3::SBSPLeaf l;
+		l.Box.reset( core::vector3df( (f32) leaf.mins[0], (f32) leaf.mins[2], (f32) leaf.mins[1] ) );
+		l.Box.addInternalPoint( core::vector3df( (f32) leaf.maxs[0], (f32) leaf.maxs[2], (f32) leaf.maxs[1] ) );
+		l.Cluster = leaf.cluster;
+		l.FirstFace = leaf.leafface;
+		l.FaceCount = leaf.numOfLeafFaces;
+		BSPTree.Leafs.push_back( l );
+	}
+
+	// invalid face indices are ignored
+	BSPTree.LeafFaces.reallocate( NumLeafFaces );
+	for ( i = 0; i < NumLeafFaces; ++i )
+		BSPTree.LeafFaces.push_back( LeafFaces[i] >= 0 && LeafFaces[i] < NumFaces ? LeafFaces[i] : -1 );
+}
+
+
+//! returns the bsp tree and the potentially visible sets of the level
+const quake3::SBSPTree& CQ3LevelMesh::getBSPTree() const
+{
+	return BSPTree;
+}
+
 /*!
 */
 void CQ3LevelMesh::solveTJunction()
@@ -89,6 +89,9 @@ namespace scene
 		//! returns the requested brush entity
 		virtual IMesh* getBrushEntityMesh(quake3::IEntity &ent) const _IRR_OVERRIDE_;
 
+		//! returns the bsp tree and the potentially visible sets of the level
+		virtual const quake3::SBSPTree& getBSPTree() const _IRR_OVERRIDE_;
+
 		//Link to held meshes? ...
 
 
@@ -133,6 +136,7 @@ namespace scene
 
 
 		void constructMesh();
+		void buildBSPTree();
 		void solveTJunction();
 		void loadTextures();
 		scene::SMesh** buildMesh(s32 num);
@@ -473,6 +477,16 @@ namespace scene
 			u32 index;
 		};
 
+		//! mesh buffer of E_Q3_MESH_GEOMETRY a face of the level was added to
+		struct SFaceBuffer
+		{
+			const IMeshBuffer* Buffer;
+			video::SIndexRange Indices;
+		};
+		core::array<SFaceBuffer> FaceBuffers;
+
+		quake3::SBSPTree BSPTree;
+
 		void cleanMeshes();
 		void cleanMesh(SMesh *m, const bool texture0important = false);
 		void cleanLoader ();
@@ -14,6 +14,7 @@
 #include "IMeshManipulator.h"
 #include "SMesh.h"
 #include "IMaterialRenderer.h"
+#include "irrSIMD.h"
 #ifdef _IRR_COMPILE_WITH_SHADOW_VOLUME_SCENENODE_
 #include "CShadowVolumeSceneNode.h"
 #else
@@ -28,6 +29,313 @@ namespace scene
 // who, if not you..
 using namespace quake3;
 
+namespace
+{
+	//! Samples of one period in the wave tables, a power of two
+	const u32 WAVE_TABLE_SIZE = 1024;
+
+	//! One period of each wave function of SModifierFunction
+	/** Deformations look up the table instead of evaluating the function for
+	each vertex. Quake 3 samples its waves the same way. */
+	struct SWaveTables
+	{
+		SWaveTables()
+		{
+			for ( u32 i = 0; i != WAVE_TABLE_SIZE; ++i )
+			{
+				const f32 x = (f32) i / (f32) WAVE_TABLE_SIZE;
+
+				Table[0][i] = sinf ( x * core::PI * 2.f );
+				Table[1][i] = cosf ( x * core::PI * 2.f );
+				Table[2][i] = x < 0.5f ? 1.f : -1.f;
+				Table[3][i] = x < 0.5f ? ( 4.f * x ) - 1.f : ( -4.f * x ) + 3.f;
+				Table[4][i] = x;
+				Table[5][i] = 1.f - x;
+				Table[6][i] = 0.f;
+			}
+		}
+
+		// SINUS to SAWTOOTH_INVERSE, then zero for unknown functions
+		f32 Table[7][WAVE_TABLE_SIZE];
+	};
+
+	//! Returns the table of a wave function
+	/** Noise has no period, so the noise table is filled with new values. */
+	const f32* getWaveTable( eQ3ModifierFunction func, f32* noise )
+	{
+		// built once, the initialization is thread safe
+		static const SWaveTables tables;
+
+		if ( func == NOISE )
+		{
+			for ( u32 i = 0; i != WAVE_TABLE_SIZE; ++i )
+				noise[i] = Noiser::get();
+			return noise;
+		}
+
+		if ( func < SINUS || func > SAWTOOTH_INVERSE )
+			return tables.Table[6];
+
+		return tables.Table[func - SINUS];
+	}
+
+	//! Returns the sine of an angle in radians from the sine table
+	inline f32 tableSin( const f32* sine, f32 angle )
+	{
+		return sine[ (s32) ( angle * ( WAVE_TABLE_SIZE / ( core::PI * 2.f ) ) ) & ( WAVE_TABLE_SIZE - 1 ) ];
+	}
+
+	//! Returns the cosine of an angle in radians from the sine table
+	inline f32 tableCos( const f32* sine, f32 angle )
+	{
+		return sine[ ( (s32) ( angle * ( WAVE_TABLE_SIZE / ( core::PI * 2.f ) ) ) + WAVE_TABLE_SIZE / 4 ) & ( WAVE_TABLE_SIZE - 1 ) ];
+	}
+
+	//! A wave function with an additional phase for each vertex
+	/** Evaluates function at time + spread * vertexPhase. */
+	struct SVertexWave
+	{
+		SVertexWave( const f32* table, const SModifierFunction &function, f32 time, f32 spread )
+			: Table( table ), Base( function.base ), Amp( function.amp ),
+			Offset( core::fract( ( time + function.phase ) * function.frequency ) * WAVE_TABLE_SIZE ),
+			Scale( spread * function.frequency * WAVE_TABLE_SIZE )
+		{
+		}
+
+		f32 at( f32 vertexPhase ) const
+		{
+			return Base + Amp * Table[ (s32) ( Offset + Scale * vertexPhase ) & ( WAVE_TABLE_SIZE - 1 ) ];
+		}
+
+		const f32* Table;
+		f32 Base;
+		f32 Amp;
+
+		// table position of the phase of the function, and of one unit of vertex phase
+		f32 Offset;
+		f32 Scale;
+	};
+
+	//! Moves the vertices along their normals by a wave
+	struct SNormalDeform
+	{
+		SNormalDeform( const SVertexWave &wave, const core::vector3df &offset, bool reset, bool phaseFromTCoords )
+			: Wave( wave ), Offset( offset ), Reset( reset ), PhaseFromTCoords( phaseFromTCoords )
+		{
+		}
+
+		SVertexWave Wave;
+
+		// subtracted from the original positions
+		core::vector3df Offset;
+
+		// start from the original positions, else from the already deformed ones
+		bool Reset;
+
+		// the phase of a vertex is its texture coordinate u, else the sum of its position
+		bool PhaseFromTCoords;
+	};
+
+	typedef void (*NormalDeformer)( video::S3DVertex* dst, const video::S3DVertex2TCoords* src, u32 count,
+		const SNormalDeform &deform, core::aabbox3df &box );
+
+	//! Deforms the vertices from first to count, the box is reset by vertex 0
+	inline void deformRange( video::S3DVertex* dst, const video::S3DVertex2TCoords* src, u32 first, u32 count,
+		const SNormalDeform &deform, core::aabbox3df &box )
+	{
+		for ( u32 i = first; i != count; ++i )
+		{
+			core::vector3df pos = deform.Reset ? src[i].Pos - deform.Offset : dst[i].Pos;
+
+			const f32 vertexPhase = deform.PhaseFromTCoords ? src[i].TCoords.X : pos.X + pos.Y + pos.Z;
+			pos += src[i].Normal * deform.Wave.at( vertexPhase );
+			dst[i].Pos = pos;
+
+			if ( i == 0 )
+				box.reset ( pos );
+			else
+				box.addInternalPoint ( pos );
+		}
+	}
+
+	void deformAlongNormals( video::S3DVertex* dst, const video::S3DVertex2TCoords* src, u32 count,
+		const SNormalDeform &deform, core::aabbox3df &box )
+	{
+		deformRange( dst, src, 0, count, deform, box );
+	}
+
+	// The kernels below deform four vertices at a time, with x, y and z in the
+	// lanes of a vector. They look up the wave table once for the four
+	// vertices and deform the remaining vertices with deformRange.
+
+#ifdef _IRR_SIMD_X86_
+
+	_IRR_SIMD_TARGET_("sse2")
+	inline __m128 load3_SSE2( const core::vector3df &v )
+	{
+		return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd((const double*)&v.X)), _mm_load_ss(&v.Z));
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	inline void store3_SSE2( core::vector3df &v, __m128 value )
+	{
+		_mm_storel_pi((__m64*)&v.X, value);
+		_mm_store_ss(&v.Z, _mm_movehl_ps(value, value));
+	}
+
+	_IRR_SIMD_TARGET_("sse2")
+	void deformAlongNormals_SSE2( video::S3DVertex* dst, const video::S3DVertex2TCoords* src, u32 count,
+		const SNormalDeform &deform, core::aabbox3df &box )
+	{
+		const __m128 offset = load3_SSE2(deform.Offset);
+		const __m128 waveOffset = _mm_set1_ps(deform.Wave.Offset);
+		const __m128 waveScale = _mm_set1_ps(deform.Wave.Scale);
+		const __m128i mask = _mm_set1_epi32(WAVE_TABLE_SIZE - 1);
+		__m128 minEdge = _mm_set1_ps(FLT_MAX);
+		__m128 maxEdge = _mm_set1_ps(-FLT_MAX);
+
+		u32 i = 0;
+		for ( ; i + 4 <= count; i += 4 )
+		{
+			__m128 pos[4];
+			for ( u32 k = 0; k != 4; ++k )
+				pos[k] = deform.Reset ? _mm_sub_ps(load3_SSE2(src[i+k].Pos), offset) : load3_SSE2(dst[i+k].Pos);
+
+			__m128 phase;
+			if ( deform.PhaseFromTCoords )
+			{
+				phase = _mm_setr_ps(src[i].TCoords.X, src[i+1].TCoords.X, src[i+2].TCoords.X, src[i+3].TCoords.X);
+			}
+			else
+			{
+				// x + y + z of the four positions
+				const __m128 xy01 = _mm_unpacklo_ps(pos[0], pos[1]);
+				const __m128 xy23 = _mm_unpacklo_ps(pos[2], pos[3]);
+				const __m128 z01 = _mm_unpackhi_ps(pos[0], pos[1]);
+				const __m128 z23 = _mm_unpackhi_ps(pos[2], pos[3]);
+				phase = _mm_add_ps(_mm_add_ps(_mm_movelh_ps(xy01, xy23), _mm_movehl_ps(xy23, xy01)),
+					_mm_movelh_ps(z01, z23));
+			}
+
+			u32 index[4];
+			_mm_storeu_si128((__m128i*)index, _mm_and_si128(_mm_cvttps_epi32(
+				_mm_add_ps(waveOffset, _mm_mul_ps(waveScale, phase))), mask));
+
+			for ( u32 k = 0; k != 4; ++k )
+			{
+				const f32 f = deform.Wave.Base + deform.Wave.Amp * deform.Wave.Table[index[k]];
+				const __m128 p = _mm_add_ps(pos[k], _mm_mul_ps(load3_SSE2(src[i+k].Normal), _mm_set1_ps(f)));
+				store3_SSE2(dst[i+k].Pos, p);
+				minEdge = _mm_min_ps(minEdge, p);
+				maxEdge = _mm_max_ps(maxEdge, p);
+			}
+		}
+
+		if ( i )
+		{
+			f32 edge[4];
+			_mm_storeu_ps(edge, minEdge);
+			box.MinEdge.set ( edge[0], edge[1], edge[2] );
+			_mm_storeu_ps(edge, maxEdge);
+			box.MaxEdge.set ( edge[0], edge[1], edge[2] );
+		}
+
+		deformRange( dst, src, i, count, deform, box );
+	}
+
+#endif // _IRR_SIMD_X86_
+
+#ifdef _IRR_SIMD_NEON_
+
+	inline float32x4_t load3_NEON( const core::vector3df &v )
+	{
+		return vcombine_f32(vld1_f32(&v.X), vld1_lane_f32(&v.Z, vdup_n_f32(0.f), 0));
+	}
+
+	inline void store3_NEON( core::vector3df &v, float32x4_t value )
+	{
+		vst1_f32(&v.X, vget_low_f32(value));
+		vst1q_lane_f32(&v.Z, value, 2);
+	}
+
+	void deformAlongNormals_NEON( video::S3DVertex* dst, const video::S3DVertex2TCoords* src, u32 count,
+		const SNormalDeform &deform, core::aabbox3df &box )
+	{
+		const float32x4_t offset = load3_NEON(deform.Offset);
+		const float32x4_t waveOffset = vdupq_n_f32(deform.Wave.Offset);
+		const uint32x4_t mask = vdupq_n_u32(WAVE_TABLE_SIZE - 1);
+		float32x4_t minEdge = vdupq_n_f32(FLT_MAX);
+		float32x4_t maxEdge = vdupq_n_f32(-FLT_MAX);
+
+		u32 i = 0;
+		for ( ; i + 4 <= count; i += 4 )
+		{
+			float32x4_t pos[4];
+			f32 phase[4];
+			for ( u32 k = 0; k != 4; ++k )
+			{
+				pos[k] = deform.Reset ? vsubq_f32(load3_NEON(src[i+k].Pos), offset) : load3_NEON(dst[i+k].Pos);
+
+				if ( deform.PhaseFromTCoords )
+				{
+					phase[k] = src[i+k].TCoords.X;
+				}
+				else
+				{
+					// (x + y, z), then x + y + z
+					const float32x2_t sum = vpadd_f32(vget_low_f32(pos[k]), vget_high_f32(pos[k]));
+					phase[k] = vget_lane_f32(vpadd_f32(sum, sum), 0);
+				}
+			}
+
+			u32 index[4];
+			vst1q_u32(index, vandq_u32(vreinterpretq_u32_s32(vcvtq_s32_f32(
+				vmlaq_n_f32(waveOffset, vld1q_f32(phase), deform.Wave.Scale))), mask));
+
+			for ( u32 k = 0; k != 4; ++k )
+			{
+				const f32 f = deform.Wave.Base + deform.Wave.Amp * deform.Wave.Table[index[k]];
+				const float32x4_t p = vmlaq_n_f32(pos[k], load3_NEON(src[i+k].Normal), f);
+				store3_NEON(dst[i+k].Pos, p);
+				minEdge = vminq_f32(minEdge, p);
+				maxEdge = vmaxq_f32(maxEdge, p);
+			}
+		}
+
+		if ( i )
+		{
+			f32 edge[4];
+			vst1q_f32(edge, minEdge);
+			box.MinEdge.set ( edge[0], edge[1], edge[2] );
+			vst1q_f32(edge, maxEdge);
+			box.MaxEdge.set ( edge[0], edge[1], edge[2] );
+		}
+
+		deformRange( dst, src, i, count, deform, box );
+	}
+
+#endif // _IRR_SIMD_NEON_
+
+	NormalDeformer selectNormalDeformer()
+	{
+#if defined(_IRR_SIMD_X86_)
+		if (os::getX86Features() & os::EXF_SSE2)
+			return deformAlongNormals_SSE2;
+#elif defined(_IRR_SIMD_NEON_)
+		return deformAlongNormals_NEON;
+#endif
+		return deformAlongNormals;
+	}
+
+	NormalDeformer getNormalDeformer()
+	{
+		// selected once, the initialization is thread safe
+		static const NormalDeformer deformer = selectNormalDeformer();
+		return deformer;
+	}
+
+} // end anonymous namespace
+
 /*!
 */
 CQuake3ShaderSceneNode::CQuake3ShaderSceneNode(
@@ -38,7 +346,9 @@ CQuake3ShaderSceneNode::CQuake3ShaderSceneNode(
 		core::vector3df(0.f, 0.f, 0.f),
 		core::vector3df(0.f, 0.f, 0.f),
 		core::vector3df(1.f, 1.f, 1.f)),
-	Shader(shader), Mesh(0), Shadow(0), Original(0), MeshBuffer(0), TimeAbs(0.f)
+	Shader(shader), Mesh(0), Shadow(0), Original(0), MeshBuffer(0),
+	VertexColorSource(CONSTANT), VertexColor(0xFFFFFFFF), TCoordSource(TEXTURE),
+	VerticesChanged(true), TimeAbs(0.f)
 {
 	#ifdef _DEBUG
 		core::stringc dName = "CQuake3ShaderSceneNode ";
@@ -68,7 +378,17 @@ CQuake3ShaderSceneNode::CQuake3ShaderSceneNode(
 	// load all Textures in all stages
 	loadTextures( fileSystem );
 
-	setAutomaticCulling( scene::EAC_OFF );
+	// stages rewrite the vertices, the indices never change
+	MeshBuffer->setHardwareMappingHint( EHM_DYNAMIC, EBT_VERTEX );
+	MeshBuffer->setHardwareMappingHint( EHM_STATIC, EBT_INDEX );
+
+	// deformations only run for visible nodes, so cull with all possible deformations
+	const f32 extent = getDeformExtent();
+	CullingBox = MeshBuffer->getBoundingBox();
+	CullingBox.MinEdge -= core::vector3df( extent );
+	CullingBox.MaxEdge += core::vector3df( extent );
+
+	setAutomaticCulling( scene::EAC_FRUSTUM_BOX );
 }
 
 
@@ -133,6 +453,82 @@ void CQuake3ShaderSceneNode::cloneBuffer( scene::SMeshBuffer *dest, const scene:
 }
 
 
+/*
+	largest distance a vertex is moved by the deformations of the shader
+*/
+f32 CQuake3ShaderSceneNode::getDeformExtent() const
+{
+	static const c8 * const deformList[] =
+	{
+		"wave","bulge","move","autosprite","autosprite2"
+	};
+
+	// waves move along the normals, sprites rotate around the center of their quad
+	f32 normalLength = 0.f;
+	f32 spriteRadius = 0.f;
+
+	const u32 vsize = Original->Vertices.size();
+	const video::S3DVertex2TCoords * vin = Original->Vertices.const_pointer();
+	for ( u32 i = 0; i != vsize; ++i )
+		normalLength = core::max_( normalLength, vin[i].Normal.getLengthSQ() );
+	normalLength = sqrtf( normalLength );
+
+	for ( u32 i = 0; i + 3 < vsize; i += 4 )
+	{
+		const core::vector3df center = 0.25f * ( vin[i+0].Pos + vin[i+1].Pos + vin[i+2].Pos + vin[i+3].Pos );
+		for ( u32 g = 0; g < 4; ++g )
+			spriteRadius = core::max_( spriteRadius, vin[i+g].Pos.getDistanceFromSQ( center ) );
+	}
+	spriteRadius = sqrtf( spriteRadius );
+
+	f32 extent = 0.f;
+	for ( u32 stage = 0; stage < Shader->VarGroup->VariableGroup.size(); ++stage )
+	{
+		const SVarGroup *group = Shader->getGroup( stage );
+
+		for ( u32 g = 0; g != group->Variable.size(); ++g )
+		{
+			const SVariable &v = group->Variable[g];
+			if ( v.name != "deformvertexes" )
+				continue;
+
+			SModifierFunction function;
+			u32 pos = 0;
+			switch ( isEqual( v.content, pos, deformList, 5 ) )
+			{
+				case 0:
+					// deformVertexes wave <div> <func> <base> <amplitude> <phase> <freq>
+					getAsFloat( v.content, pos );
+					getModifierFunc( function, v.content, pos );
+					extent += ( core::abs_( function.base ) + core::abs_( function.amp ) ) * normalLength;
+					break;
+				case 1:
+					// deformVertexes bulge <width> <height> <speed>, width is the base of the wave
+					function.bulgewidth = getAsFloat( v.content, pos );
+					function.bulgeheight = getAsFloat( v.content, pos );
+					extent += ( core::abs_( function.base ) + core::abs_( function.amp ) ) * normalLength;
+					break;
+				case 2:
+				{
+					// deformVertexes move <x> <y> <z> <func> <base> <amplitude> <phase> <freq>
+					const core::vector3df move = getAsVector3df( v.content, pos );
+					getModifierFunc( function, v.content, pos );
+					extent += ( core::abs_( function.base ) + core::abs_( function.amp ) ) * move.getLength();
+				} break;
+				case 3:
+				case 4:
+					extent += spriteRadius;
+					break;
+				default:
+					break;
+			}
+		}
+	}
+
+	return extent;
+}
+
+
 /*
 	load the textures for all stages
 */
@@ -393,6 +789,12 @@ void CQuake3ShaderSceneNode::render()
 		//material.TextureLayer[0].AnisotropicFilter = 0xFF;
 		material.setTextureMatrix( 0, textureMatrix );
 
+		if ( VerticesChanged )
+		{
+			MeshBuffer->setDirty( EBT_VERTEX );
+			VerticesChanged = false;
+		}
+
 		driver->setMaterial( material );
 		driver->drawMeshBuffer( MeshBuffer );
 		drawCount += 1;
@@ -551,32 +953,16 @@ void CQuake3ShaderSceneNode::deformvertexes_wave( f32 dt, SModifierFunction &fun
 {
 	function.wave = core::reciprocal( function.wave );
 
-	const f32 phase = function.phase;
-
-	const u32 vsize = Original->Vertices.size();
-	for ( u32 i = 0; i != vsize; ++i )
-	{
-		const video::S3DVertex2TCoords &src = Original->Vertices[i];
-		video::S3DVertex &dst = MeshBuffer->Vertices[i];
-
-		if ( 0 == function.count )
-			dst.Pos = src.Pos - MeshOffset;
-
-		const f32 wavephase = (dst.Pos.X + dst.Pos.Y + dst.Pos.Z) * function.wave;
-		function.phase = phase + wavephase;
+	// the phase of a vertex is the sum of its position
+	f32 noise[WAVE_TABLE_SIZE];
+	const SVertexWave wave( getWaveTable( function.func, noise ), function, dt, function.wave );
 
-		const f32 f = function.evaluate( dt );
+	getNormalDeformer()( MeshBuffer->Vertices.pointer(), Original->Vertices.const_pointer(),
+		Original->Vertices.size(), SNormalDeform( wave, MeshOffset, 0 == function.count, false ),
+		MeshBuffer->BoundingBox );
 
-		dst.Pos.X += f * src.Normal.X;
-		dst.Pos.Y += f * src.Normal.Y;
-		dst.Pos.Z += f * src.Normal.Z;
-
-		if ( i == 0 )
-			MeshBuffer->BoundingBox.reset ( dst.Pos );
-		else
-			MeshBuffer->BoundingBox.addInternalPoint ( dst.Pos );
-	}
 	function.count = 1;
+	VerticesChanged = true;
 }
 
 /*!
@@ -624,7 +1010,7 @@ void CQuake3ShaderSceneNode::deformvertexes_move( f32 dt, SModifierFunction &fun
 			MeshBuffer->BoundingBox.addInternalPoint ( dst.Pos );
 	}
 	function.count = 1;
-
+	VerticesChanged = true;
 }
 
 /*!
@@ -641,27 +1027,29 @@ void CQuake3ShaderSceneNode::deformvertexes_move( f32 dt, SModifierFunction &fun
 void CQuake3ShaderSceneNode::deformvertexes_normal( f32 dt, SModifierFunction &function )
 {
 	function.func = SINUS;
+
+	// the angles are a sinus around a base, with a phase per vertex
+	SModifierFunction sinus = function;
+	sinus.base = 0.f;
+	sinus.phase = 0.f;
+	const SVertexWave wave( getWaveTable( SINUS, 0 ), sinus, dt, 1.f );
+	const f32 *sine = wave.Table;
+
 	const u32 vsize = Original->Vertices.size();
 	for ( u32 i = 0; i != vsize; ++i )
 	{
 		const video::S3DVertex2TCoords &src = Original->Vertices[i];
 		video::S3DVertex &dst = MeshBuffer->Vertices[i];
 
-		function.base = atan2f ( src.Pos.X, src.Pos.Y );
-		function.phase = src.Pos.X + src.Pos.Z;
-
-		const f32 lat = function.evaluate( dt );
-
-		function.base = src.Normal.Y;
-		function.phase = src.Normal.Z + src.Normal.X;
-
-		const f32 lng = function.evaluate( dt );
-
-		dst.Normal.X = cosf ( lat ) * sinf ( lng );
-		dst.Normal.Y = sinf ( lat ) * sinf ( lng );
-		dst.Normal.Z = cosf ( lng );
+		const f32 lat = atan2f ( src.Pos.X, src.Pos.Y ) + wave.at( src.Pos.X + src.Pos.Z );
+		const f32 lng = src.Normal.Y + wave.at( src.Normal.Z + src.Normal.X );
 
+		const f32 sinLng = tableSin( sine, lng );
+		dst.Normal.X = tableCos( sine, lat ) * sinLng;
+		dst.Normal.Y = tableSin( sine, lat ) * sinLng;
+		dst.Normal.Z = tableCos( sine, lng );
 	}
+	VerticesChanged = true;
 }
 
 
@@ -715,33 +1103,16 @@ void CQuake3ShaderSceneNode::deformvertexes_bulge( f32 dt, SModifierFunction &fu
 	function.wave = core::reciprocal( function.bulgewidth );
 
 	dt *= function.bulgespeed * 0.1f;
-	const f32 phase = function.phase;
 
-	const u32 vsize = Original->Vertices.size();
-	for ( u32 i = 0; i != vsize; ++i )
-	{
-		const video::S3DVertex2TCoords &src = Original->Vertices[i];
-		video::S3DVertex &dst = MeshBuffer->Vertices[i];
-
-		const f32 wavephase = (Original->Vertices[i].TCoords.X ) * function.wave;
-		function.phase = phase + wavephase;
-
-		const f32 f = function.evaluate( dt );
-
-		if ( 0 == function.count )
-			dst.Pos = src.Pos - MeshOffset;
+	// the phase of a vertex is its texture coordinate u
+	const SVertexWave wave( getWaveTable( SINUS, 0 ), function, dt, function.wave );
 
-		dst.Pos.X += f * src.Normal.X;
-		dst.Pos.Y += f * src.Normal.Y;
-		dst.Pos.Z += f * src.Normal.Z;
-
-		if ( i == 0 )
-			MeshBuffer->BoundingBox.reset ( dst.Pos );
-		else
-			MeshBuffer->BoundingBox.addInternalPoint ( dst.Pos );
-	}
+	getNormalDeformer()( MeshBuffer->Vertices.pointer(), Original->Vertices.const_pointer(),
+		Original->Vertices.size(), SNormalDeform( wave, MeshOffset, 0 == function.count, true ),
+		MeshBuffer->BoundingBox );
 
 	function.count = 1;
+	VerticesChanged = true;
 }
 
 
@@ -787,6 +1158,7 @@ void CQuake3ShaderSceneNode::deformvertexes_autosprite( f32 dt, SModifierFunctio
 
 	}
 	function.count = 1;
+	VerticesChanged = true;
 }
 
 
@@ -844,6 +1216,45 @@ void CQuake3ShaderSceneNode::deformvertexes_autosprite2( f32 dt, SModifierFuncti
 		}
 	}
 	function.count = 1;
+	VerticesChanged = true;
+}
+
+/*
+	Fill the vertex colors, unless they already have the color
+*/
+void CQuake3ShaderSceneNode::setVertexColor( video::SColor color )
+{
+	if ( VertexColorSource == CONSTANT && VertexColor == color )
+		return;
+
+	const u32 vsize = MeshBuffer->Vertices.size();
+	for ( u32 i = 0; i != vsize; ++i )
+		MeshBuffer->Vertices[i].Color = color;
+
+	VertexColorSource = CONSTANT;
+	VertexColor = color;
+	VerticesChanged = true;
+}
+
+/*
+	Set the alpha of all vertex colors
+*/
+void CQuake3ShaderSceneNode::setVertexAlpha( u32 alpha )
+{
+	if ( VertexColorSource == CONSTANT )
+	{
+		video::SColor color = VertexColor;
+		color.setAlpha ( alpha );
+		setVertexColor( color );
+		return;
+	}
+
+	const u32 vsize = MeshBuffer->Vertices.size();
+	for ( u32 i = 0; i != vsize; ++i )
+		MeshBuffer->Vertices[i].Color.setAlpha ( alpha );
+
+	VertexColorSource = UNKNOWN;
+	VerticesChanged = true;
 }
 
 /*
@@ -858,22 +1269,26 @@ void CQuake3ShaderSceneNode::vertextransform_rgbgen( f32 dt, SModifierFunction &
 	{
 		case IDENTITY:
 			//rgbgen identity
-			for ( i = 0; i != vsize; ++i )
-				MeshBuffer->Vertices[i].Color.set(0xFFFFFFFF);
+			setVertexColor( 0xFFFFFFFF );
 			break;
 
 		case IDENTITYLIGHTING:
 			// rgbgen identitylighting TODO: overbright
-			for ( i = 0; i != vsize; ++i )
-				MeshBuffer->Vertices[i].Color.set(0xFF7F7F7F);
+			setVertexColor( 0xFF7F7F7F );
 			break;
 
 		case EXACTVERTEX:
 			// alphagen exactvertex TODO lighting
 		case VERTEX:
 			// rgbgen vertex
+			if ( VertexColorSource == VERTEX )
+				break;
+
 			for ( i = 0; i != vsize; ++i )
 				MeshBuffer->Vertices[i].Color=Original->Vertices[i].Color;
+
+			VertexColorSource = VERTEX;
+			VerticesChanged = true;
 			break;
 		case WAVE:
 		{
@@ -882,16 +1297,13 @@ void CQuake3ShaderSceneNode::vertextransform_rgbgen( f32 dt, SModifierFunction &
 			s32 value = core::clamp( core::floor32(f), 0, 255 );
 			value = 0xFF000000 | value << 16 | value << 8 | value;
 
-			for ( i = 0; i != vsize; ++i )
-				MeshBuffer->Vertices[i].Color.set(value);
+			setVertexColor( value );
 		} break;
 		case CONSTANT:
 		{
 			//rgbgen const ( x y z )
 			video::SColorf cf( function.x, function.y, function.z );
-			video::SColor col = cf.toSColor();
-			for ( i = 0; i != vsize; ++i )
-				MeshBuffer->Vertices[i].Color=col;
+			setVertexColor( cf.toSColor() );
 		} break;
 		default:
 			break;
@@ -910,23 +1322,26 @@ void CQuake3ShaderSceneNode::vertextransform_alphagen( f32 dt, SModifierFunction
 	{
 		case IDENTITY:
 			//alphagen identity
-			for ( i = 0; i != vsize; ++i )
-				MeshBuffer->Vertices[i].Color.setAlpha ( 0xFF );
+			setVertexAlpha( 0xFF );
 			break;
 
 		case EXACTVERTEX:
 			// alphagen exactvertex TODO lighting
 		case VERTEX:
 			// alphagen vertex
+			if ( VertexColorSource == VERTEX )
+				break;
+
 			for ( i = 0; i != vsize; ++i )
 				MeshBuffer->Vertices[i].Color.setAlpha ( Original->Vertices[i].Color.getAlpha() );
+
+			VertexColorSource = UNKNOWN;
+			VerticesChanged = true;
 			break;
 		case CONSTANT:
 		{
 			// alphagen const
-			u32 a = (u32) ( function.x * 255.f );
-			for ( i = 0; i != vsize; ++i )
-				MeshBuffer->Vertices[i].Color.setAlpha ( a );
+			setVertexAlpha( (u32) ( function.x * 255.f ) );
 		} break;
 
 		case LIGHTINGSPECULAR:
@@ -943,6 +1358,8 @@ void CQuake3ShaderSceneNode::vertextransform_alphagen( f32 dt, SModifierFunction
 				MeshBuffer->Vertices[i].Color.setAlpha ((u32)( 128.f *(1.f+(n.X*m[0]+n.Y*m[1]+n.Z*m[2]))));
 			}
 
+			VertexColorSource = UNKNOWN;
+			VerticesChanged = true;
 		} break;
 
 
@@ -952,8 +1369,7 @@ void CQuake3ShaderSceneNode::vertextransform_alphagen( f32 dt, SModifierFunction
 			f32 f = function.evaluate( dt ) * 255.f;
 			s32 value = core::clamp( core::floor32(f), 0, 255 );
 
-			for ( i = 0; i != vsize; ++i )
-				MeshBuffer->Vertices[i].Color.setAlpha ( value );
+			setVertexAlpha( value );
 		} break;
 		default:
 			break;
@@ -977,33 +1393,47 @@ void CQuake3ShaderSceneNode::vertextransform_tcgen( f32 dt, SModifierFunction &f
 		{
 			function.wave = core::reciprocal( function.phase );
 
-			const f32 phase = function.phase;
+			// the phase of a vertex is the sum of its position
+			f32 noise[WAVE_TABLE_SIZE];
+			const SVertexWave wave( getWaveTable( function.func, noise ), function, dt, function.wave );
 
 			for ( i = 0; i != vsize; ++i )
 			{
 				const video::S3DVertex2TCoords &src = Original->Vertices[i];
 				video::S3DVertex &dst = MeshBuffer->Vertices[i];
 
-				const f32 wavephase = (src.Pos.X + src.Pos.Y + src.Pos.Z) * function.wave;
-				function.phase = phase + wavephase;
-
-				const f32 f = function.evaluate( dt );
+				const f32 f = wave.at( src.Pos.X + src.Pos.Y + src.Pos.Z );
 
 				dst.TCoords.X = src.TCoords.X + f * src.Normal.X;
 				dst.TCoords.Y = src.TCoords.Y + f * src.Normal.Y;
 			}
+
+			TCoordSource = UNKNOWN;
+			VerticesChanged = true;
 		}
 		break;
 
 		case TEXTURE:
 			// tcgen texture
+			if ( TCoordSource == TEXTURE )
+				break;
+
 			for ( i = 0; i != vsize; ++i )
 				MeshBuffer->Vertices[i].TCoords = Original->Vertices[i].TCoords;
+
+			TCoordSource = TEXTURE;
+			VerticesChanged = true;
 			break;
 		case LIGHTMAP:
 			// tcgen lightmap
+			if ( TCoordSource == LIGHTMAP )
+				break;
+
 			for ( i = 0; i != vsize; ++i )
 				MeshBuffer->Vertices[i].TCoords = Original->Vertices[i].TCoords2;
+
+			TCoordSource = LIGHTMAP;
+			VerticesChanged = true;
 			break;
 		case ENVIRONMENT:
 		{
@@ -1027,6 +1457,8 @@ void CQuake3ShaderSceneNode::vertextransform_tcgen( f32 dt, SModifierFunction &f
 				MeshBuffer->Vertices[i].TCoords.Y = 0.5f*(1.f+(n.X*m[4]+n.Y*m[5]+n.Z*m[6]));
 			}
 
+			TCoordSource = UNKNOWN;
+			VerticesChanged = true;
 		} break;
 		default:
 			break;
@@ -1359,7 +1791,7 @@ void CQuake3ShaderSceneNode::OnAnimate(u32 timeMs)
 
 const core::aabbox3d<f32>& CQuake3ShaderSceneNode::getBoundingBox() const
 {
-	return MeshBuffer->getBoundingBox();
+	return CullingBox;
 }
 
 
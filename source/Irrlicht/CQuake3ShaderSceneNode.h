@@ -101,6 +101,24 @@ private:
 
 	void transformtex ( const core::matrix4 &m, const u32 clamp );
 
+	void setVertexColor ( video::SColor color );
+	void setVertexAlpha ( u32 alpha );
+
+	f32 getDeformExtent () const;
+
+	// bounding box including the largest displacement of all deformations,
+	// so culling doesn't depend on the deformation of the last frame
+	core::aabbox3d<f32> CullingBox;
+
+	// what the vertices of MeshBuffer hold, to only rewrite them if a stage needs other values
+	// colors: CONSTANT for VertexColor, VERTEX for the colors of Original, or UNKNOWN
+	quake3::eQ3ModifierFunction VertexColorSource;
+	video::SColor VertexColor;
+	// texture coordinates: TEXTURE, LIGHTMAP or UNKNOWN
+	quake3::eQ3ModifierFunction TCoordSource;
+	// vertices were modified since MeshBuffer was drawn
+	bool VerticesChanged;
+
 	f32 TimeAbs;
 
 	void animate( u32 stage, core::matrix4 &texture );
@@ -4,6 +4,17 @@
 
 #include "CReadFile.h"
 
+#if !defined(_IRR_WINDOWS_API_)
+	#include <unistd.h>
+	#include <errno.h>
+	#if defined(__has_include)
+		#if __has_include(<sys/mman.h>)
+			#include <sys/mman.h>
+			#define _IRR_READ_FILE_MMAP_
+		#endif
+	#endif
+#endif
+
 namespace irr
 {
 namespace io
@@ -11,7 +22,7 @@ namespace io
 
 
 CReadFile::CReadFile(const io::path& fileName)
-: File(0), FileSize(0), Filename(fileName)
+: File(0), FileSize(0), Filename(fileName), Mapping(0), Pos(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CReadFile");
@@ -23,6 +34,11 @@ CReadFile::CReadFile(const io::path& fileName)
 
 CReadFile::~CReadFile()
 {
+#if defined(_IRR_READ_FILE_MMAP_)
+	if (Mapping)
+		munmap((void*)Mapping, FileSize);
+#endif
+
 	if (File)
 		fclose(File);
 }
@@ -31,6 +47,13 @@ CReadFile::~CReadFile()
 //! returns how much was read
 size_t CReadFile::read(void* buffer, size_t sizeToRead)
 {
+	if (Mapping)
+	{
+		const size_t r = readAt(Pos, buffer, sizeToRead);
+		Pos += (long)r;
+		return r;
+	}
+
 	if (!isOpen())
 		return 0;
 
@@ -38,11 +61,62 @@ size_t CReadFile::read(void* buffer, size_t sizeToRead)
 }
 
 
+//! returns how much was read from a position, without changing the position
+size_t CReadFile::readAt(long pos, void* buffer, size_t sizeToRead)
+{
+	if (!isOpen() || pos < 0)
+		return 0;
+
+	if (Mapping)
+	{
+		if (pos >= FileSize)
+			return 0;
+
+		const size_t amount = core::min_(sizeToRead, (size_t)(FileSize - pos));
+		memcpy(buffer, Mapping + pos, amount);
+		return amount;
+	}
+
+#if defined(_IRR_WINDOWS_API_)
+	// ReadFile with an offset would move the position under the FILE's feet
+	return IReadFile::readAt(pos, buffer, sizeToRead);
+#else
+	// pread neither uses nor moves the file offset, and the FILE's buffer
+	// can't get stale as the file is never written.
+	const int fd = fileno(File);
+	c8* out = (c8*)buffer;
+	size_t done = 0;
+	while (done < sizeToRead)
+	{
+		const ssize_t r = pread(fd, out + done, sizeToRead - done, (off_t)pos + (off_t)done);
+		if (r < 0 && errno == EINTR)
+			continue;
+		if (r <= 0)
+			break;
+		done += (size_t)r;
+	}
+	return done;
+#endif
+}
+
+
 //! changes position in file, returns true if successful
 //! if relativeMovement==true, the pos is changed relative to current pos,
 //! otherwise from begin of file
 bool CReadFile::seek(long finalPos, bool relativeMovement)
 {
+	if (Mapping)
+	{
+		// like fseek, positions behind the end are fine and read nothing
+		if (relativeMovement)
+			finalPos += Pos;
+		if (finalPos < 0)
+			return false;
+
+		Pos = finalPos;
+		return true;
+	}
+
 	if (!isOpen())
 		return false;
 
@@ -60,6 +134,9 @@ long CReadFile::getSize() const
 //! returns where in the file we are.
 long CReadFile::getPos() const
 {
+	if (Mapping)
+		return Pos;
+
 	return ftell(File);
 }
 
@@ -86,6 +163,23 @@ void CReadFile::openFile()
 		fseek(File, 0, SEEK_END);
 		FileSize = getPos();
 		fseek(File, 0, SEEK_SET);
+
+#if defined(_IRR_READ_FILE_MMAP_)
+		// Map the whole file. Reads are copies from the page cache then, and
+		// loaders can parse the contents in place through getBuffer().
+		if (FileSize > 0)
+		{
+			void* mapping = mmap(0, FileSize, PROT_READ, MAP_PRIVATE, fileno(File), 0);
+			if (mapping != MAP_FAILED)
+			{
+				Mapping = (const c8*)mapping;
+
+				// the mapping stays valid without the descriptor
+				fclose(File);
+				File = 0;
+			}
+		}
+#endif
 	}
 }
 
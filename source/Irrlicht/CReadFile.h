@@ -29,6 +29,9 @@ namespace io
 		//! returns how much was read
 		virtual size_t read(void* buffer, size_t sizeToRead) _IRR_OVERRIDE_;
 
+		//! returns how much was read from a position, without changing the position
+		virtual size_t readAt(long pos, void* buffer, size_t sizeToRead) _IRR_OVERRIDE_;
+
 		//! changes position in file, returns true if successful
 		virtual bool seek(long finalPos, bool relativeMovement = false) _IRR_OVERRIDE_;
 
@@ -38,7 +41,7 @@ namespace io
 		//! returns if file is open
 		bool isOpen() const
 		{
-			return File != 0;
+			return File != 0 || Mapping != 0;
 		}
 
 		//! returns where in the file we are.
@@ -53,6 +56,12 @@ namespace io
 			return ERFT_READ_FILE;
 		}
 
+		//! returns the mapped contents of the file, 0 if it couldn't be mapped
+		virtual const void* getBuffer() const _IRR_OVERRIDE_
+		{
+			return Mapping;
+		}
+
 		//! create read file on disk.
 		static IReadFile* createReadFile(const io::path& fileName);
 
@@ -61,9 +70,15 @@ namespace io
 		//! opens the file
 		void openFile();
 
+		//! 0 once the file is mapped
 		FILE* File;
 		long FileSize;
 		io::path Filename;
+
+		//! contents of the file if it could be mapped into memory
+		const c8* Mapping;
+		//! position in the mapped file
+		long Pos;
 	};
 
 } // end namespace io
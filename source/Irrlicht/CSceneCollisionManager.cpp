@@ -351,7 +351,8 @@ bool CSceneCollisionManager::getCollisionPoint(SCollisionHit& hitResult, const c
 	Triangles.set_used(totalcnt);
 
 	s32 cnt = 0;
-	irr::core::array<SCollisionTriangleRange> outTriangleInfo;
+	core::array<SCollisionTriangleRange>& outTriangleInfo = TriangleRanges;
+	outTriangleInfo.set_used(0);
 	selector->getTriangles(Triangles.pointer(), totalcnt, cnt, ray, 0, true, &outTriangleInfo);
 
 	const core::vector3df linevect = ray.getVector().normalize();
@@ -790,7 +791,8 @@ core::vector3df CSceneCollisionManager::collideWithWorld(s32 recursionDepth,
 					1.0f / colData.eRadius.Y,
 					1.0f / colData.eRadius.Z));
 
-	irr::core::array<SCollisionTriangleRange> outTriangleInfo;
+	core::array<SCollisionTriangleRange>& outTriangleInfo = TriangleRanges;
+	outTriangleInfo.set_used(0);
 	s32 triangleCnt = 0;
 	colData.selector->getTriangles(Triangles.pointer(), totalTriangleCnt, triangleCnt, box, &scaleMatrix, true, &outTriangleInfo);
 
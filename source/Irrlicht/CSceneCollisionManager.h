@@ -143,6 +143,7 @@ namespace scene
 		ISceneManager* SceneManager;
 		video::IVideoDriver* Driver;
 		core::array<core::triangle3df> Triangles; // triangle buffer
+		core::array<SCollisionTriangleRange> TriangleRanges; // buffer for the ranges of Triangles
 	};
 
 
@@ -153,6 +153,7 @@
 #include "CLightSceneNode.h"
 #ifdef _IRR_COMPILE_WITH_BILLBOARD_SCENENODE_
 #include "CBillboardSceneNode.h"
+#include "CBillboardGroupSceneNode.h"
 #endif // _IRR_COMPILE_WITH_BILLBOARD_SCENENODE_
 #include "CMeshSceneNode.h"
 #include "CSkyBoxSceneNode.h"
@@ -180,6 +181,7 @@
 #include "CEmptySceneNode.h"
 #include "CTextSceneNode.h"
 #include "CQuake3ShaderSceneNode.h"
+#include "CBSPLevelSceneNode.h"
 #include "CVolumeLightSceneNode.h"
 
 #include "CDefaultSceneNodeFactory.h"
@@ -189,6 +191,8 @@
 #include "COctreeTriangleSelector.h"
 #include "CTriangleBBSelector.h"
 #include "CMetaTriangleSelector.h"
+#include "CClusteredLightManager.h"
+#include "COcclusionCuller.h"
 #ifdef _IRR_COMPILE_WITH_TERRAIN_SCENENODE_
 #include "CTerrainTriangleSelector.h"
 #endif // _IRR_COMPILE_WITH_TERRAIN_SCENENODE_
@@ -220,7 +224,12 @@ CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 : ISceneNode(0, 0), Driver(driver), FileSystem(fs), GUIEnvironment(gui),
 	CursorControl(cursorControl), CollisionManager(0),
 	ActiveCamera(0), ShadowColor(150,0,0,0), AmbientLight(0,0,0,0), Parameters(0),
-	MeshCache(cache), CurrentRenderPass(ESNRP_NONE), LightManager(0),
+	MeshCache(cache), CurrentRenderPass(ESNRP_NONE),
+	AnimationTimeUs(0), AnimationDeltaTime(0.f), Animated(false),
+	LightManager(0), OcclusionCuller(0),
+	RenderListCaching(false), RecordingRenderLists(false), RenderListsValid(false),
+	RenderListCellSize(100.f), RenderListCamera(0), RenderListCell(0,0,0),
+	RenderListChangeCounter(0), RenderListSubtreeChangeCounter(0),
 	IRR_XML_FORMAT_SCENE(L"irr_scene"), IRR_XML_FORMAT_NODE(L"node"), IRR_XML_FORMAT_NODE_ATTR_TYPE(L"type")
 {
 	#ifdef _DEBUG
@@ -362,6 +371,9 @@ CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 			getProfiler().add(EPID_SM_RENDER_EFFECT, L"effectnodes", L"Irrlicht scene");
 			getProfiler().add(EPID_SM_RENDER_GUI_NODES, L"guinodes", L"Irrlicht scene");
 			getProfiler().add(EPID_SM_REGISTER, L"reg.render.node", L"Irrlicht scene");
+			getProfiler().add(EPID_SM_REGISTER_NODES, L"reg.all.nodes", L"Irrlicht scene");
+			getProfiler().add(EPID_SM_SORT_NODES, L"sortnodes", L"Irrlicht scene");
+			getProfiler().add(EPID_SM_LOAD_MESH, L"loadmesh", L"Irrlicht scene");
 		}
  	)
 }
@@ -372,6 +384,11 @@ CSceneManager::~CSceneManager()
 {
 	clearDeletionList();
 
+	// releases the nodes and queries it holds
+	delete OcclusionCuller;
+
+	clearRenderLists();
+
 	//! force to remove hardwareTextures from the driver
 	//! because Scenes may hold internally data bounded to sceneNodes
 	//! which may be destroyed twice
@@ -472,6 +489,8 @@ IAnimatedMesh* CSceneManager::getMesh(io::IReadFile* file)
 // load and create a mesh which we know already isn't in the cache and put it in there
 IAnimatedMesh* CSceneManager::getUncachedMesh(io::IReadFile* file, const io::path& filename, const io::path& cachename)
 {
+	IRR_PROFILE(CProfileScope p1(EPID_SM_LOAD_MESH);)
+
 	IAnimatedMesh* msh = 0;
 
 	// iterate the list in reverse order so user-added loaders can override the built-in ones
@@ -590,6 +609,27 @@ IMeshSceneNode* CSceneManager::addQuake3SceneNode(const IMeshBuffer* meshBuffer,
 }
 
 
+//! Adds a scene node drawing the geometry of a quake3 level with its bsp tree.
+IBSPLevelSceneNode* CSceneManager::addBSPLevelSceneNode(IQ3LevelMesh* mesh,
+					ISceneNode* parent, s32 id)
+{
+#ifdef _IRR_COMPILE_WITH_BSP_LEVEL_SCENENODE_
+	if (!mesh)
+		return 0;
+
+	if (!parent)
+		parent = this;
+
+	CBSPLevelSceneNode* node = new CBSPLevelSceneNode(mesh, parent, this, id);
+	node->drop();
+
+	return node;
+#else
+	return 0;
+#endif
+}
+
+
 //! adds Volume Lighting Scene Node.
 //! the returned pointer must not be dropped.
 IVolumeLightSceneNode* CSceneManager::addVolumeLightSceneNode(
@@ -858,6 +898,24 @@ IBillboardSceneNode* CSceneManager::addBillboardSceneNode(ISceneNode* parent,
 }
 
 
+//! Adds a scene node drawing a group of billboards with one draw call.
+IBillboardGroupSceneNode* CSceneManager::addBillboardGroupSceneNode(ISceneNode* parent,
+	const core::vector3df& position, s32 id)
+{
+#ifdef _IRR_COMPILE_WITH_BILLBOARD_SCENENODE_
+	if (!parent)
+		parent = this;
+
+	IBillboardGroupSceneNode* node = new CBillboardGroupSceneNode(parent, this, id, position);
+	node->drop();
+
+	return node;
+#else
+	return 0;
+#endif
+}
+
+
 //! Adds a skybox scene node. A skybox is a big cube with 6 textures on it and
 //! is drawn around the camera position.
 ISceneNode* CSceneManager::addSkyBoxSceneNode(video::ITexture* top, video::ITexture* bottom,
@@ -969,7 +1027,7 @@ ITerrainSceneNode* CSceneManager::addTerrainSceneNode(
 		return 0;
 	}
 
-	CTerrainSceneNode* node = new CTerrainSceneNode(parent, this, FileSystem, id,
+	CTerrainSceneNode* node = new CTerrainSceneNode(parent, this, id,
 		maxLOD, patchSize, position, rotation, scale);
 
 	if (!node->loadHeightMap(heightMapFile, vertexColor, smoothFactor))
@@ -1244,8 +1302,8 @@ bool CSceneManager::isCulled(const ISceneNode* node) const
 	}
 	bool result = false;
 
-	// has occlusion query information
-	if (node->getAutomaticCulling() & scene::EAC_OCC_QUERY)
+	// has occlusion query information, occlusion culling reads the results itself
+	if (!OcclusionCuller && (node->getAutomaticCulling() & scene::EAC_OCC_QUERY))
 	{
 		result = (Driver->getOcclusionQueryResult(const_cast<ISceneNode*>(node))==0);
 	}
@@ -1315,6 +1373,11 @@ bool CSceneManager::isCulled(const ISceneNode* node) const
 u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDER_PASS pass)
 {
 	IRR_PROFILE(CProfileScope p1(EPID_SM_REGISTER);)
+
+	// nodes registering into the cached render lists are culled when they are drawn
+	if (RecordingRenderLists)
+		return retainNodeForRendering(node, pass);
+
 	u32 taken = 0;
 
 	switch(pass)
@@ -1353,28 +1416,28 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 		taken = 1;
 		break;
 	case ESNRP_SOLID:
-		if (!isCulled(node))
+		if (!isCulled(node) && !isOccluded(node))
 		{
 			SolidNodeList.push_back(node);
 			taken = 1;
 		}
 		break;
 	case ESNRP_TRANSPARENT:
-		if (!isCulled(node))
+		if (!isCulled(node) && !isOccluded(node))
 		{
 			TransparentNodeList.push_back(TransparentNodeEntry(node, camWorldPos));
 			taken = 1;
 		}
 		break;
 	case ESNRP_TRANSPARENT_EFFECT:
-		if (!isCulled(node))
+		if (!isCulled(node) && !isOccluded(node))
 		{
 			TransparentEffectNodeList.push_back(TransparentNodeEntry(node, camWorldPos));
 			taken = 1;
 		}
 		break;
 	case ESNRP_AUTOMATIC:
-		if (!isCulled(node))
+		if (!isCulled(node) && !isOccluded(node))
 		{
 			const u32 count = node->getMaterialCount();
 
@@ -1432,6 +1495,301 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 	return taken;
 }
 
+//! returns if occlusion culling found the node occluded
+bool CSceneManager::isOccluded(ISceneNode* node) const
+{
+	return OcclusionCuller && OcclusionCuller->isOccluded(node);
+}
+
+//! removes the nodes behind the occluders from a render list
+template <class T>
+void CSceneManager::removeHiddenNodes(core::array<T>& list) const
+{
+	u32 kept = 0;
+	for (u32 i=0; i<list.size(); ++i)
+	{
+		if (!OcclusionCuller->isHidden(list[i].Node))
+			list[kept++] = list[i];
+	}
+	list.set_used(kept);
+}
+
+
+//! keeps a registration in the cached render lists
+u32 CSceneManager::retainNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDER_PASS pass)
+{
+	if (pass == ESNRP_NONE)
+		return 0;
+
+	// changing materials mark the node, so the pass can be chosen once
+	if (pass == ESNRP_AUTOMATIC)
+	{
+		pass = ESNRP_SOLID;
+
+		const u32 count = node->getMaterialCount();
+		for (u32 i=0; i<count; ++i)
+		{
+			if (Driver->needsTransparentRenderPass(node->getMaterial(i)))
+			{
+				pass = ESNRP_TRANSPARENT;
+				break;
+			}
+		}
+	}
+
+	node->grab();
+	if (pass == ESNRP_SOLID)
+	{
+		RetainedSolidNodeList.push_back(node);
+	}
+	else
+	{
+		RetainedNodeEntry e;
+		e.Node = node;
+		e.Pass = pass;
+		RetainedNodeList.push_back(e);
+	}
+
+	return 1;
+}
+
+
+//! brings the cached render lists up to date with the scene and camera
+void CSceneManager::updateRenderLists()
+{
+	core::vector3di cell(0,0,0);
+	if (ActiveCamera && RenderListCellSize > 0.f)
+	{
+		const core::vector3df pos = camWorldPos / RenderListCellSize;
+		cell.set(core::floor32(pos.X), core::floor32(pos.Y), core::floor32(pos.Z));
+	}
+
+	if (!RenderListsValid || RenderListCamera != ActiveCamera || RenderListCell != cell ||
+		RenderListChangeCounter != getChangeCounter())
+	{
+		RenderListCamera = ActiveCamera;
+		RenderListCell = cell;
+		rebuildRenderLists();
+	}
+	else if (RenderListSubtreeChangeCounter != getSubtreeChangeCounter())
+	{
+		patchRenderLists();
+	}
+}
+
+
+//! registers all nodes into the cached render lists
+void CSceneManager::rebuildRenderLists()
+{
+	clearRenderLists();
+
+	// the counters are kept first, so changes while registering are found next frame
+	RenderListChangeCounter = getChangeCounter();
+	RenderListSubtreeChangeCounter = getSubtreeChangeCounter();
+	ISceneNodeList::Iterator it = Children.begin();
+	for (; it != Children.end(); ++it)
+		retainChangeCounters(*it);
+
+	RecordingRenderLists = true;
+	OnRegisterSceneNode();
+	RecordingRenderLists = false;
+
+	RetainedSolidNodeList.sort();
+	RenderListsValid = true;
+}
+
+
+//! registers the changed nodes again and forgets the removed ones
+void CSceneManager::patchRenderLists()
+{
+	RenderListSubtreeChangeCounter = getSubtreeChangeCounter();
+
+	core::array<ISceneNode*> changed;
+	findChangedNodes(this, changed);
+
+	// forget the registrations of the changed and removed nodes
+	u32 kept = 0;
+	u32 i;
+	for (i=0; i<RetainedSolidNodeList.size(); ++i)
+	{
+		if (isRetainedNodeValid(RetainedSolidNodeList[i].Node))
+			RetainedSolidNodeList[kept++] = RetainedSolidNodeList[i];
+		else
+			RetainedSolidNodeList[i].Node->drop();
+	}
+	RetainedSolidNodeList.set_used(kept);
+
+	kept = 0;
+	for (i=0; i<RetainedNodeList.size(); ++i)
+	{
+		if (isRetainedNodeValid(RetainedNodeList[i].Node))
+			RetainedNodeList[kept++] = RetainedNodeList[i];
+		else
+			RetainedNodeList[i].Node->drop();
+	}
+	RetainedNodeList.set_used(kept);
+
+	// forget the counters of the nodes which are no longer in the scene
+	for (s32 c=(s32)RetainedCounters.size()-1; c>=0; --c)
+	{
+		ISceneNode* node = RetainedCounters[c].Node;
+		const ISceneNode* root = node;
+		while (root && root != this)
+			root = root->getParent();
+
+		if (root)
+			continue;
+
+		RetainedCounterIndices.remove(node);
+
+		// the last counters take the place
+		const u32 last = RetainedCounters.size() - 1;
+		if ((u32)c != last)
+		{
+			RetainedCounters[c] = RetainedCounters[last];
+			RetainedCounterIndices.find(RetainedCounters[c].Node)->setValue(c);
+		}
+		RetainedCounters.erase(last);
+		node->drop();
+	}
+
+	const u32 sortedCount = RetainedSolidNodeList.size();
+
+	RecordingRenderLists = true;
+	for (i=0; i<changed.size(); ++i)
+	{
+		retainChangeCounters(changed[i]);
+
+		// invisible parents don't let their children register
+		const ISceneNode* parent = changed[i]->getParent();
+		if (parent && parent->isTrulyVisible())
+			changed[i]->OnRegisterSceneNode();
+	}
+	RecordingRenderLists = false;
+
+	// move the new solid nodes to their place in the sorted list
+	if (RetainedSolidNodeList.size() > sortedCount)
+	{
+		core::array<DefaultNodeEntry> added(RetainedSolidNodeList.size() - sortedCount);
+		for (i=sortedCount; i<RetainedSolidNodeList.size(); ++i)
+			added.push_back(RetainedSolidNodeList[i]);
+		RetainedSolidNodeList.set_used(sortedCount);
+
+		for (i=0; i<added.size(); ++i)
+		{
+			u32 first = 0;
+			u32 end = RetainedSolidNodeList.size();
+			while (first < end)
+			{
+				const u32 middle = (first + end) / 2;
+				if (added[i] < RetainedSolidNodeList[middle])
+					end = middle;
+				else
+					first = middle + 1;
+			}
+			RetainedSolidNodeList.insert(added[i], first);
+		}
+	}
+}
+
+
+//! collects the topmost changed nodes below a node
+void CSceneManager::findChangedNodes(ISceneNode* node, core::array<ISceneNode*>& changed)
+{
+	ISceneNodeList::ConstIterator it = node->getChildren().begin();
+	for (; it != node->getChildren().end(); ++it)
+	{
+		ISceneNode* child = *it;
+
+		const core::hash_map<const ISceneNode*, u32>::Node* n = RetainedCounterIndices.find(child);
+		if (!n || RetainedCounters[n->getValue()].ChangeCounter != child->getChangeCounter())
+		{
+			// added or changed, registers again with all nodes below it
+			changed.push_back(child);
+		}
+		else if (RetainedCounters[n->getValue()].SubtreeChangeCounter != child->getSubtreeChangeCounter())
+		{
+			RetainedCounters[n->getValue()].SubtreeChangeCounter = child->getSubtreeChangeCounter();
+			findChangedNodes(child, changed);
+		}
+	}
+}
+
+
+//! returns if a node changed since its counters were kept
+bool CSceneManager::isNodeChanged(const ISceneNode* node) const
+{
+	const core::hash_map<const ISceneNode*, u32>::Node* n = RetainedCounterIndices.find(node);
+	return !n || RetainedCounters[n->getValue()].ChangeCounter != node->getChangeCounter();
+}
+
+
+//! returns if a node is still in the scene and neither it nor a parent changed
+bool CSceneManager::isRetainedNodeValid(const ISceneNode* node) const
+{
+	for (; node; node=node->getParent())
+	{
+		if (node == this)
+			return true;
+
+		if (isNodeChanged(node))
+			return false;
+	}
+
+	// removed from the scene
+	return false;
+}
+
+
+//! keeps the change counters of a node and all nodes below it
+void CSceneManager::retainChangeCounters(ISceneNode* node)
+{
+	const core::hash_map<const ISceneNode*, u32>::Node* n = RetainedCounterIndices.find(node);
+	if (n)
+	{
+		RetainedNodeCounters& counters = RetainedCounters[n->getValue()];
+		counters.ChangeCounter = node->getChangeCounter();
+		counters.SubtreeChangeCounter = node->getSubtreeChangeCounter();
+	}
+	else
+	{
+		RetainedNodeCounters counters;
+		counters.Node = node;
+		counters.ChangeCounter = node->getChangeCounter();
+		counters.SubtreeChangeCounter = node->getSubtreeChangeCounter();
+
+		node->grab();
+		RetainedCounterIndices.insert(node, RetainedCounters.size());
+		RetainedCounters.push_back(counters);
+	}
+
+	ISceneNodeList::ConstIterator it = node->getChildren().begin();
+	for (; it != node->getChildren().end(); ++it)
+		retainChangeCounters(*it);
+}
+
+
+//! forgets the cached render lists
+void CSceneManager::clearRenderLists()
+{
+	u32 i;
+	for (i=0; i<RetainedSolidNodeList.size(); ++i)
+		RetainedSolidNodeList[i].Node->drop();
+	RetainedSolidNodeList.clear();
+
+	for (i=0; i<RetainedNodeList.size(); ++i)
+		RetainedNodeList[i].Node->drop();
+	RetainedNodeList.clear();
+
+	for (i=0; i<RetainedCounters.size(); ++i)
+		RetainedCounters[i].Node->drop();
+	RetainedCounters.clear();
+	RetainedCounterIndices.clear();
+
+	RenderListsValid = false;
+}
+
+
 void CSceneManager::clearAllRegisteredNodesForRendering()
 {
 	CameraList.clear();
@@ -1476,7 +1834,12 @@ void CSceneManager::drawAll()
 
 	// do animations and other stuff.
 	IRR_PROFILE(getProfiler().start(EPID_SM_ANIMATE));
-	OnAnimate(os::Timer::getTime());
+	const u64 timeUs = os::Timer::getTimeUs();
+	// 0 when the timer was set back, or drawAll() runs twice in one frame
+	AnimationDeltaTime = Animated && timeUs > AnimationTimeUs ? (f32)((timeUs - AnimationTimeUs) * 0.000001) : 0.f;
+	AnimationTimeUs = timeUs;
+	Animated = true;
+	OnAnimate((u32)(timeUs / 1000));
 	IRR_PROFILE(getProfiler().stop(EPID_SM_ANIMATE));
 
 	/*!
@@ -1492,8 +1855,37 @@ void CSceneManager::drawAll()
 	}
 	IRR_PROFILE(getProfiler().stop(EPID_SM_RENDER_CAMERAS));
 
+	// read the occlusion results of earlier frames
+	if (OcclusionCuller)
+		OcclusionCuller->beginFrame(ActiveCamera);
+
 	// let all nodes register themselves
-	OnRegisterSceneNode();
+	IRR_PROFILE(getProfiler().start(EPID_SM_REGISTER_NODES));
+	if (RenderListCaching)
+	{
+		updateRenderLists();
+
+		// the cached solid nodes are already sorted
+		const bool sorted = SolidNodeList.empty();
+		for (i=0; i<RetainedSolidNodeList.size(); ++i)
+			registerNodeForRendering(RetainedSolidNodeList[i].Node, ESNRP_SOLID);
+		if (sorted)
+			SolidNodeList.set_sorted(true);
+
+		for (i=0; i<RetainedNodeList.size(); ++i)
+			registerNodeForRendering(RetainedNodeList[i].Node, RetainedNodeList[i].Pass);
+	}
+	else
+		OnRegisterSceneNode();
+	IRR_PROFILE(getProfiler().stop(EPID_SM_REGISTER_NODES));
+
+	// drop the nodes behind the occluders before anything is drawn
+	if (OcclusionCuller && OcclusionCuller->drawOccluders())
+	{
+		removeHiddenNodes(SolidNodeList);
+		removeHiddenNodes(TransparentNodeList);
+		removeHiddenNodes(TransparentEffectNodeList);
+	}
 
 	if (LightManager)
 		LightManager->OnPreRender(LightList);
@@ -1533,7 +1925,8 @@ void CSceneManager::drawAll()
 			if (ActiveCamera)
 				camWorldPos = ActiveCamera->getAbsolutePosition();
 
-			core::array<DistanceNodeEntry> SortedLights;
+			core::array<DistanceNodeEntry, core::irrFrameAllocator<DistanceNodeEntry> > SortedLights(
+				core::irrFrameAllocator<DistanceNodeEntry>(Driver->getFrameArena()));
 			SortedLights.set_used(LightList.size());
 			for (s32 light = (s32)LightList.size() - 1; light >= 0; --light)
 				SortedLights[light].setNodeAndDistanceFromPosition(LightList[light], camWorldPos);
@@ -1597,7 +1990,9 @@ void CSceneManager::drawAll()
 		CurrentRenderPass = ESNRP_SOLID;
 		Driver->getOverrideMaterial().Enabled = ((Driver->getOverrideMaterial().EnablePasses & CurrentRenderPass) != 0);
 
+		IRR_PROFILE(getProfiler().start(EPID_SM_SORT_NODES));
 		SolidNodeList.sort(); // sort by textures
+		IRR_PROFILE(getProfiler().stop(EPID_SM_SORT_NODES));
 
 		if (LightManager)
 		{
@@ -1616,6 +2011,10 @@ void CSceneManager::drawAll()
 				SolidNodeList[i].Node->render();
 		}
 
+		// query the nodes against the depth of the solid ones
+		if (OcclusionCuller)
+			OcclusionCuller->runTests();
+
 #ifdef _IRR_SCENEMANAGER_DEBUG
 		Parameters->setAttribute("drawn_solid", (s32) SolidNodeList.size() );
 #endif
@@ -1664,7 +2063,9 @@ void CSceneManager::drawAll()
 		CurrentRenderPass = ESNRP_TRANSPARENT;
 		Driver->getOverrideMaterial().Enabled = ((Driver->getOverrideMaterial().EnablePasses & CurrentRenderPass) != 0);
 
+		IRR_PROFILE(getProfiler().start(EPID_SM_SORT_NODES));
 		TransparentNodeList.sort(); // sort by distance from camera
+		IRR_PROFILE(getProfiler().stop(EPID_SM_SORT_NODES));
 		if (LightManager)
 		{
 			LightManager->OnRenderPassPreRender(CurrentRenderPass);
@@ -1698,7 +2099,9 @@ void CSceneManager::drawAll()
 		CurrentRenderPass = ESNRP_TRANSPARENT_EFFECT;
 		Driver->getOverrideMaterial().Enabled = ((Driver->getOverrideMaterial().EnablePasses & CurrentRenderPass) != 0);
 
+		IRR_PROFILE(getProfiler().start(EPID_SM_SORT_NODES));
 		TransparentEffectNodeList.sort(); // sort by distance from camera
+		IRR_PROFILE(getProfiler().stop(EPID_SM_SORT_NODES));
 
 		if (LightManager)
 		{
@@ -1773,6 +2176,49 @@ void CSceneManager::setLightManager(ILightManager* lightManager)
 }
 
 
+//! Creates a light manager which assigns the lights to clusters of the view frustum.
+IClusteredLightManager* CSceneManager::createClusteredLightManager()
+{
+	return new CClusteredLightManager(this);
+}
+
+
+//! Enables automatic occlusion culling of the nodes drawn by drawAll().
+void CSceneManager::setOcclusionCulling(bool enable)
+{
+	if (enable && !OcclusionCuller && Driver)
+		OcclusionCuller = new COcclusionCuller(Driver);
+	else if (!enable && OcclusionCuller)
+	{
+		delete OcclusionCuller;
+		OcclusionCuller = 0;
+	}
+}
+
+
+//! Returns if automatic occlusion culling is enabled.
+bool CSceneManager::getOcclusionCulling() const
+{
+	return OcclusionCuller != 0;
+}
+
+
+//! Enables keeping the render lists of drawAll() between frames.
+void CSceneManager::setRenderListCaching(bool enable, f32 cellSize)
+{
+	RenderListCaching = enable;
+	RenderListCellSize = cellSize;
+	clearRenderLists();
+}
+
+
+//! Returns if the render lists are kept between frames.
+bool CSceneManager::getRenderListCaching() const
+{
+	return RenderListCaching;
+}
+
+
 //! Sets the color of stencil buffers shadows drawn by the scene manager.
 void CSceneManager::setShadowColor(video::SColor color)
 {
@@ -2164,6 +2610,7 @@ bool CSceneManager::postEventFromUser(const SEvent& event)
 void CSceneManager::removeAll()
 {
 	ISceneNode::removeAll();
+	clearRenderLists();
 	setActiveCamera(0);
 	// Make sure the driver is reset, might need a more complex method at some point
 	if (Driver)
@@ -2175,6 +2622,9 @@ void CSceneManager::removeAll()
 void CSceneManager::clear()
 {
 	removeAll();
+
+	if (OcclusionCuller)
+		OcclusionCuller->clear();
 }
 
 
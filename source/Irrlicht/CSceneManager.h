@@ -10,6 +10,7 @@
 #include "ICursorControl.h"
 #include "irrString.h"
 #include "irrArray.h"
+#include "irrHashMap.h"
 #include "IMeshLoader.h"
 #include "CAttributes.h"
 #include "ILightManager.h"
@@ -24,6 +25,7 @@ namespace scene
 {
 	class IMeshCache;
 	class IGeometryCreator;
+	class COcclusionCuller;
 
 	/*!
 		The Scene Manager manages scene nodes, mesh resources, cameras and all the other stuff.
@@ -117,6 +119,9 @@ namespace scene
 		//! draws all scene nodes
 		virtual void drawAll() _IRR_OVERRIDE_;
 
+		//! Get the time which passed between the last two scene animations.
+		virtual f32 getAnimationDeltaTime() const _IRR_OVERRIDE_ { return AnimationDeltaTime; }
+
 		//! Adds a scene node for rendering using a octree to the scene graph. This a good method for rendering
 		//! scenes with lots of geometry. The Octree is built on the fly from the mesh, much
 		//! faster then a bsp tree.
@@ -172,6 +177,10 @@ namespace scene
 			const core::vector3df& position = core::vector3df(0,0,0), s32 id=-1,
 			video::SColor shadeTop = 0xFFFFFFFF, video::SColor shadeBottom = 0xFFFFFFFF) _IRR_OVERRIDE_;
 
+		//! Adds a scene node drawing a group of billboards with one draw call.
+		virtual IBillboardGroupSceneNode* addBillboardGroupSceneNode(ISceneNode* parent = 0,
+			const core::vector3df& position = core::vector3df(0,0,0), s32 id=-1) _IRR_OVERRIDE_;
+
 		//! Adds a skybox scene node. A skybox is a big cube with 6 textures on it and
 		//! is drawn around the camera position.
 		virtual ISceneNode* addSkyBoxSceneNode(video::ITexture* top, video::ITexture* bottom,
@@ -203,6 +212,10 @@ namespace scene
 		virtual IMeshSceneNode* addQuake3SceneNode(const IMeshBuffer* meshBuffer, const quake3::IShader * shader,
 			ISceneNode* parent=0, s32 id=-1) _IRR_OVERRIDE_;
 
+		//! Adds a scene node drawing the geometry of a quake3 level with its bsp tree.
+		virtual IBSPLevelSceneNode* addBSPLevelSceneNode(IQ3LevelMesh* mesh,
+			ISceneNode* parent=0, s32 id=-1) _IRR_OVERRIDE_;
+
 
 		//! Adds a Hill Plane mesh to the mesh pool. The mesh is
 		//! generated on the fly and looks like a plane with some hills
@@ -522,6 +535,21 @@ namespace scene
 		//! Register a custom callbacks manager which gets callbacks during scene rendering.
 		virtual void setLightManager(ILightManager* lightManager) _IRR_OVERRIDE_;
 
+		//! Creates a light manager which assigns the lights to clusters of the view frustum.
+		virtual IClusteredLightManager* createClusteredLightManager() _IRR_OVERRIDE_;
+
+		//! Enables automatic occlusion culling of the nodes drawn by drawAll().
+		virtual void setOcclusionCulling(bool enable) _IRR_OVERRIDE_;
+
+		//! Returns if automatic occlusion culling is enabled.
+		virtual bool getOcclusionCulling() const _IRR_OVERRIDE_;
+
+		//! Enables keeping the render lists of drawAll() between frames.
+		virtual void setRenderListCaching(bool enable, f32 cellSize=100.f) _IRR_OVERRIDE_;
+
+		//! Returns if the render lists are kept between frames.
+		virtual bool getRenderListCaching() const _IRR_OVERRIDE_;
+
 		//! Get current render time.
 		virtual E_SCENE_NODE_RENDER_PASS getCurrentRenderPass() const _IRR_OVERRIDE_ { return CurrentRenderPass; }
 
@@ -542,6 +570,40 @@ namespace scene
 		//! clears the deletion list
 		void clearDeletionList();
 
+		//! returns if occlusion culling found the node occluded
+		bool isOccluded(ISceneNode* node) const;
+
+		//! removes the nodes behind the occluders from a render list
+		template <class T>
+		void removeHiddenNodes(core::array<T>& list) const;
+
+		//! keeps a registration in the cached render lists
+		u32 retainNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDER_PASS pass);
+
+		//! brings the cached render lists up to date with the scene and camera
+		void updateRenderLists();
+
+		//! registers all nodes into the cached render lists
+		void rebuildRenderLists();
+
+		//! registers the changed nodes again and forgets the removed ones
+		void patchRenderLists();
+
+		//! collects the topmost changed nodes below a node
+		void findChangedNodes(ISceneNode* node, core::array<ISceneNode*>& changed);
+
+		//! returns if a node changed since its counters were kept
+		bool isNodeChanged(const ISceneNode* node) const;
+
+		//! returns if a node is still in the scene and neither it nor a parent changed
+		bool isRetainedNodeValid(const ISceneNode* node) const;
+
+		//! keeps the change counters of a node and all nodes below it
+		void retainChangeCounters(ISceneNode* node);
+
+		//! forgets the cached render lists
+		void clearRenderLists();
+
 		//! writes a scene node
 		void writeSceneNode(io::IXMLWriter* writer, ISceneNode* node, ISceneUserDataSerializer* userDataSerializer, const fschar_t* currentPath=0, bool init=false);
 
@@ -564,6 +626,21 @@ namespace scene
 			void* TextureValue;
 		};
 
+		//! registration in the cached render lists
+		struct RetainedNodeEntry
+		{
+			ISceneNode* Node;
+			E_SCENE_NODE_RENDER_PASS Pass;
+		};
+
+		//! change counters of a node when the cached render lists were updated
+		struct RetainedNodeCounters
+		{
+			ISceneNode* Node;
+			u32 ChangeCounter;
+			u32 SubtreeChangeCounter;
+		};
+
 		//! sort on distance (center) to camera
 		struct TransparentNodeEntry
 		{
@@ -656,10 +733,34 @@ namespace scene
 
 		E_SCENE_NODE_RENDER_PASS CurrentRenderPass;
 
+		//! virtual time of the last animation in microseconds and the time passed before it
+		u64 AnimationTimeUs;
+		f32 AnimationDeltaTime;
+		bool Animated;
+
 		//! An optional callbacks manager to allow the user app finer control
 		//! over the scene lighting and rendering.
 		ILightManager* LightManager;
 
+		//! Schedules the occlusion tests, if occlusion culling is enabled
+		COcclusionCuller* OcclusionCuller;
+
+		//! render lists kept between frames, if render list caching is enabled
+		bool RenderListCaching;
+		bool RecordingRenderLists;
+		bool RenderListsValid;
+		f32 RenderListCellSize;
+		const ICameraSceneNode* RenderListCamera;
+		core::vector3di RenderListCell;
+		u32 RenderListChangeCounter;
+		u32 RenderListSubtreeChangeCounter;
+		// solid nodes sorted like SolidNodeList, all other registrations in their order
+		core::array<DefaultNodeEntry> RetainedSolidNodeList;
+		core::array<RetainedNodeEntry> RetainedNodeList;
+		// counters of all nodes in the scene, the nodes are grabbed
+		core::array<RetainedNodeCounters> RetainedCounters;
+		core::hash_map<const ISceneNode*, u32> RetainedCounterIndices;
+
 		//! constants for reading and writing XML.
 		//! Not made static due to portability problems.
 		const core::stringw IRR_XML_FORMAT_SCENE;
@@ -146,8 +146,8 @@ void CSceneNodeAnimatorCameraFPS::animateNode(ISceneNode* node, u32 timeMs)
 	if(smgr && smgr->getActiveCamera() != camera)
 		return;
 
-	// get time
-	f32 timeDiff = (f32) ( timeMs - LastAnimationTime );
+	// get time, in microsecond precision from the scene manager
+	f32 timeDiff = smgr ? smgr->getAnimationDeltaTime() * 1000.f : (f32) ( timeMs - LastAnimationTime );
 	LastAnimationTime = timeMs;
 
 	// Update rotation
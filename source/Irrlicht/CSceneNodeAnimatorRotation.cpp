@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in irrlicht.h
 
 #include "CSceneNodeAnimatorRotation.h"
+#include "ISceneManager.h"
 
 namespace irr
 {
@@ -27,9 +28,13 @@ void CSceneNodeAnimatorRotation::animateNode(ISceneNode* node, u32 timeMs)
 {
 	if (node) // thanks to warui for this fix
 	{
-		const u32 diffTime = timeMs - StartTime;
+		// rotate by the microsecond frame time of the scene manager,
+		// timeMs only advances every few frames at high frame rates
+		const ISceneManager* smgr = node->getSceneManager();
+		const f32 diffTime = smgr ? smgr->getAnimationDeltaTime()*1000.f : (f32)(timeMs - StartTime);
+		StartTime = timeMs;
 
-		if (diffTime != 0)
+		if (diffTime != 0.f)
 		{
 			// clip the rotation to small values, to avoid
 			// precision problems with huge floats.
@@ -41,7 +46,6 @@ void CSceneNodeAnimatorRotation::animateNode(ISceneNode* node, u32 timeMs)
 			if (rot.Z>360.f)
 				rot.Z=fmodf(rot.Z, 360.f);
 			node->setRotation(rot);
-			StartTime=timeMs;
 		}
 	}
 }
@@ -248,6 +248,7 @@ ISceneNode* CSkyBoxSceneNode::clone(ISceneNode* newParent, ISceneManager* newMan
 
 	for (u32 i=0; i<6; ++i)
 		nb->Material[i] = Material[i];
+	nb->markChanged();
 
 	if ( newParent )
 		nb->drop();
@@ -0,0 +1,786 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+#ifdef _IRR_COMPILE_WITH_TERRAIN_SCENENODE_
+#include "CTerrainSceneNode.h"
+#include "IVideoDriver.h"
+#include "ISceneManager.h"
+#include "ICameraSceneNode.h"
+#include "IReadFile.h"
+#include "IImage.h"
+#include "SViewFrustum.h"
+#include "os.h"
+
+namespace irr
+{
+namespace scene
+{
+
+namespace
+{
+	//! Tolerance of the edges of the terrain and cells against rounding errors, in node space
+	const f32 EDGE_TOLERANCE = 0.001f;
+
+	//! Clips the parameter range of a line to a slab of one axis
+	/** \return False if nothing of the line is left. */
+	bool clipLine(f32 start, f32 dir, f32 low, f32 high, f32& t0, f32& t1)
+	{
+		if (core::iszero(dir))
+			return start >= low - EDGE_TOLERANCE && start <= high + EDGE_TOLERANCE;
+
+		f32 ta = (low - EDGE_TOLERANCE - start) / dir;
+		f32 tb = (high + EDGE_TOLERANCE - start) / dir;
+		if (ta > tb)
+			core::swap(ta, tb);
+
+		t0 = core::max_(t0, ta);
+		t1 = core::min_(t1, tb);
+		return t0 <= t1;
+	}
+}
+
+
+//! constructor
+CTerrainSceneNode::CTerrainSceneNode(ISceneNode* parent, ISceneManager* mgr, s32 id,
+		s32 maxLOD, E_TERRAIN_PATCH_SIZE patchSize,
+		const core::vector3df& position, const core::vector3df& rotation,
+		const core::vector3df& scale)
+	: ITerrainSceneNode(parent, mgr, id, position, rotation, scale),
+	Size(0), PatchSize(patchSize), PatchCount(0), LODCount(1),
+	VertexColor(255,255,255,255), TCoordScale1(1.0f), TCoordScale2(0.0f),
+	MaxScreenError(4.0f), LODErrorScale(0.0f), LODDirty(true), IndexCount(0)
+{
+	#ifdef _DEBUG
+	setDebugName("CTerrainSceneNode");
+	#endif
+
+	// each LOD halves the cells of a patch, at least two cells are left
+	s32 lods = 0;
+	for (u32 cells = PatchSize - 1; cells >= 2; cells >>= 1)
+		++lods;
+	LODCount = core::s32_clamp(maxLOD, 1, lods);
+
+	BoundingBox.reset(0,0,0);
+}
+
+
+CTerrainSceneNode::~CTerrainSceneNode()
+{
+	removePatchBuffers();
+}
+
+
+//! Initializes the terrain data from a heightmap file
+bool CTerrainSceneNode::loadHeightMap(io::IReadFile* file, video::SColor vertexColor,
+		s32 smoothFactor)
+{
+	if (!file)
+		return false;
+
+	video::IImage* heightmap = SceneManager->getVideoDriver()->createImageFromFile(file);
+	if (!heightmap)
+	{
+		os::Printer::log("Unable to load heightmap.", file->getFileName(), ELL_ERROR);
+		return false;
+	}
+
+	const bool result = loadHeightMap(heightmap, vertexColor, smoothFactor);
+	heightmap->drop();
+	return result;
+}
+
+
+//! Initializes the terrain data from a heightmap image
+bool CTerrainSceneNode::loadHeightMap(video::IImage* heightmap, video::SColor vertexColor,
+		s32 smoothFactor)
+{
+	if (!heightmap)
+		return false;
+
+	const core::dimension2d<u32> dim = heightmap->getDimension();
+	const u32 side = core::min_(dim.Width, dim.Height);
+	if (side < PatchSize)
+	{
+		os::Printer::log("Heightmap is smaller than one patch of the terrain.", ELL_ERROR);
+		return false;
+	}
+
+	PatchCount = (side - 1) / (PatchSize - 1);
+	Size = PatchCount * (PatchSize - 1) + 1;
+	VertexColor = vertexColor;
+
+	Heights.set_used(Size * Size);
+	for (u32 z=0; z<Size; ++z)
+		for (u32 x=0; x<Size; ++x)
+			Heights[z * Size + x] = (f32)heightmap->getPixel(x, z).getAverage();
+
+	// average of each sample and its neighbours
+	core::array<f32> smoothed;
+	for (s32 run=0; run<smoothFactor; ++run)
+	{
+		smoothed = Heights;
+		for (u32 z=0; z<Size; ++z)
+		{
+			for (u32 x=0; x<Size; ++x)
+			{
+				f32 sum = smoothed[z * Size + x];
+				u32 count = 1;
+				if (x > 0)
+					sum += smoothed[z * Size + x - 1], ++count;
+				if (x + 1 < Size)
+					sum += smoothed[z * Size + x + 1], ++count;
+				if (z > 0)
+					sum += smoothed[(z - 1) * Size + x], ++count;
+				if (z + 1 < Size)
+					sum += smoothed[(z + 1) * Size + x], ++count;
+				Heights[z * Size + x] = sum / count;
+			}
+		}
+	}
+
+	createPatches();
+
+	c8 tmp[128];
+	snprintf_irr(tmp, sizeof(tmp), "Generated terrain data (%ux%u) with %u patches and %d LODs.",
+		Size, Size, PatchCount * PatchCount, LODCount);
+	os::Printer::log(tmp);
+	return true;
+}
+
+
+void CTerrainSceneNode::createPatches()
+{
+	removePatchBuffers();
+	Patches.clear();
+	Patches.reallocate(PatchCount * PatchCount);
+
+	const u32 cells = PatchSize - 1;
+	for (u32 pz=0; pz<PatchCount; ++pz)
+	{
+		for (u32 px=0; px<PatchCount; ++px)
+		{
+			SPatch patch;
+			const u32 x0 = px * cells;
+			const u32 z0 = pz * cells;
+
+			f32 minHeight = height(x0, z0);
+			f32 maxHeight = minHeight;
+			for (u32 j=0; j<PatchSize; ++j)
+			{
+				for (u32 i=0; i<PatchSize; ++i)
+				{
+					const f32 h = height(x0 + i, z0 + j);
+					minHeight = core::min_(minHeight, h);
+					maxHeight = core::max_(maxHeight, h);
+				}
+			}
+			patch.BoundingBox.reset((f32)x0, minHeight, (f32)z0);
+			patch.BoundingBox.addInternalPoint((f32)(x0 + cells), maxHeight, (f32)(z0 + cells));
+
+			// difference of the samples to the bilinear interpolation
+			// between the vertices of the LOD
+			for (s32 lod=1; lod<LODCount; ++lod)
+			{
+				const u32 step = 1 << lod;
+				f32 error = patch.Errors[lod - 1];
+				for (u32 j=0; j<PatchSize; ++j)
+				{
+					const u32 cj = core::min_(j / step * step, cells - step);
+					const f32 fz = (f32)(j - cj) / step;
+					for (u32 i=0; i<PatchSize; ++i)
+					{
+						const u32 ci = core::min_(i / step * step, cells - step);
+						const f32 fx = (f32)(i - ci) / step;
+
+						const f32 h0 = core::lerp(height(x0 + ci, z0 + cj), height(x0 + ci + step, z0 + cj), fx);
+						const f32 h1 = core::lerp(height(x0 + ci, z0 + cj + step), height(x0 + ci + step, z0 + cj + step), fx);
+						error = core::max_(error, fabsf(height(x0 + i, z0 + j) - core::lerp(h0, h1, fz)));
+					}
+				}
+				patch.Errors[lod] = error;
+			}
+
+			if (Patches.empty())
+				BoundingBox = patch.BoundingBox;
+			else
+				BoundingBox.addInternalBox(patch.BoundingBox);
+			Patches.push_back(patch);
+		}
+	}
+
+	// Each LOD is drawn in blocks of 2x2 cells, as a fan of 8 triangles
+	// around the center of the block. On sides towards a coarser patch the
+	// fans leave out the vertex in the middle of the block's side, which the
+	// neighbour doesn't have.
+	static const s32 ring[8][2] = {
+		{-1,-1}, {-1,0}, {-1,1}, {0,1}, {1,1}, {1,0}, {1,-1}, {0,-1} };
+
+	IndexSets.clear();
+	IndexSets.reallocate(LODCount * 16);
+	for (s32 lod=0; lod<LODCount; ++lod)
+	{
+		const u32 lodCells = cells >> lod;
+		const u32 n = lodCells + 1;
+		const u32 blocks = lodCells / 2;
+
+		for (u32 sides=0; sides<16; ++sides)
+		{
+			core::array<u16> indices(blocks * blocks * 24);
+			for (u32 bz=0; bz<blocks; ++bz)
+			{
+				for (u32 bx=0; bx<blocks; ++bx)
+				{
+					const u32 cx = bx * 2 + 1;
+					const u32 cz = bz * 2 + 1;
+
+					u16 fan[8];
+					u32 count = 0;
+					for (u32 k=0; k<8; ++k)
+					{
+						if ((k == 1 && bx == 0 && (sides & EPS_LEFT)) ||
+							(k == 3 && bz == blocks - 1 && (sides & EPS_TOP)) ||
+							(k == 5 && bx == blocks - 1 && (sides & EPS_RIGHT)) ||
+							(k == 7 && bz == 0 && (sides & EPS_BOTTOM)))
+							continue;
+
+						fan[count++] = (u16)((cz + ring[k][1]) * n + cx + ring[k][0]);
+					}
+
+					const u16 center = (u16)(cz * n + cx);
+					for (u32 k=0; k<count; ++k)
+					{
+						indices.push_back(center);
+						indices.push_back(fan[k]);
+						indices.push_back(fan[(k + 1) % count]);
+					}
+				}
+			}
+			IndexSets.push_back(indices);
+		}
+	}
+
+	LODDirty = true;
+	IndexCount = 0;
+
+	// registers from the first patches on
+	markChanged();
+}
+
+
+void CTerrainSceneNode::removePatchBuffers()
+{
+	for (u32 i=0; i<Patches.size(); ++i)
+	{
+		if (Patches[i].Buffer)
+			Patches[i].Buffer->drop();
+		Patches[i].Buffer = 0;
+		Patches[i].BuiltLOD = -1;
+	}
+}
+
+
+//! pre render event
+void CTerrainSceneNode::OnRegisterSceneNode()
+{
+	if (IsVisible && Patches.size())
+		SceneManager->registerNodeForRendering(this);
+
+	ISceneNode::OnRegisterSceneNode();
+}
+
+
+//! render
+void CTerrainSceneNode::render()
+{
+	video::IVideoDriver* driver = SceneManager->getVideoDriver();
+	ICameraSceneNode* camera = SceneManager->getActiveCamera();
+
+	if (!camera || !driver || !Patches.size())
+		return;
+
+	updateLODs(camera);
+
+	SViewFrustum frust = *camera->getViewFrustum();
+
+	//transform the frustum to the current absolute transformation
+	if ( !AbsoluteTransformation.isIdentity() )
+	{
+		core::matrix4 invTrans(AbsoluteTransformation, core::matrix4::EM4CONST_INVERSE);
+		frust.transform(invTrans);
+	}
+
+	driver->setTransform(video::ETS_WORLD, AbsoluteTransformation);
+	driver->setMaterial(Material);
+
+	IndexCount = 0;
+	for (u32 pz=0; pz<PatchCount; ++pz)
+	{
+		for (u32 px=0; px<PatchCount; ++px)
+		{
+			SPatch& patch = Patches[pz * PatchCount + px];
+
+			bool visible = true;
+			for (u32 i=0; i!=SViewFrustum::VF_PLANE_COUNT && visible; ++i)
+				visible = patch.BoundingBox.classifyPlaneRelation(frust.planes[i]) != core::ISREL3D_FRONT;
+			if (!visible)
+				continue;
+
+			if (patch.BuiltLOD != patch.LOD || patch.BuiltSides != patch.Sides)
+				buildPatch(px, pz);
+
+			driver->drawMeshBuffer(patch.Buffer);
+			IndexCount += patch.Buffer->getIndexCount();
+		}
+	}
+
+	if (DebugDataVisible & scene::EDS_BBOX)
+	{
+		video::SMaterial m;
+		m.Lighting = false;
+		driver->setMaterial(m);
+		driver->draw3DBox(BoundingBox, video::SColor(255,255,255,255));
+	}
+}
+
+
+void CTerrainSceneNode::updateLODs(const ICameraSceneNode* camera)
+{
+	core::matrix4 toNode;
+	if (!AbsoluteTransformation.getInverse(toNode))
+		return;
+
+	core::vector3df cameraPosition = camera->getAbsolutePosition();
+	toNode.transformVect(cameraPosition);
+
+	// pixels covered by a height difference of one unit at a distance of one unit
+	const core::vector3df scale = AbsoluteTransformation.getScale();
+	const f32 viewHeight = (f32)SceneManager->getVideoDriver()->getCurrentRenderTargetSize().Height;
+	const f32 errorScale = viewHeight / (2.f * tanf(camera->getFOV() * 0.5f)) * scale.Y;
+
+	// the LODs only change when the camera moves
+	if (!LODDirty && cameraPosition == LODCameraPosition && errorScale == LODErrorScale)
+		return;
+
+	LODCameraPosition = cameraPosition;
+	LODErrorScale = errorScale;
+	LODDirty = false;
+
+	for (u32 i=0; i<Patches.size(); ++i)
+	{
+		SPatch& patch = Patches[i];
+
+		// world space distance to the closest point of the patch
+		const core::aabbox3d<f32>& box = patch.BoundingBox;
+		const core::vector3df closest(
+			core::clamp(cameraPosition.X, box.MinEdge.X, box.MaxEdge.X),
+			core::clamp(cameraPosition.Y, box.MinEdge.Y, box.MaxEdge.Y),
+			core::clamp(cameraPosition.Z, box.MinEdge.Z, box.MaxEdge.Z));
+		const f32 distance = ((cameraPosition - closest) * scale).getLength();
+
+		s32 lod = LODCount - 1;
+		while (lod > 0 && patch.Errors[lod] * errorScale > MaxScreenError * distance)
+			--lod;
+		patch.LOD = lod;
+	}
+
+	// neighbours may only be one LOD coarser, the coarser ones are refined
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (u32 pz=0; pz<PatchCount; ++pz)
+		{
+			for (u32 px=0; px<PatchCount; ++px)
+			{
+				const s32 lod = Patches[pz * PatchCount + px].LOD + 1;
+				s32* neighbours[4] = {
+					px > 0 ? &Patches[pz * PatchCount + px - 1].LOD : 0,
+					px + 1 < PatchCount ? &Patches[pz * PatchCount + px + 1].LOD : 0,
+					pz > 0 ? &Patches[(pz - 1) * PatchCount + px].LOD : 0,
+					pz + 1 < PatchCount ? &Patches[(pz + 1) * PatchCount + px].LOD : 0 };
+
+				for (u32 k=0; k<4; ++k)
+				{
+					if (neighbours[k] && *neighbours[k] > lod)
+					{
+						*neighbours[k] = lod;
+						changed = true;
+					}
+				}
+			}
+		}
+	}
+
+	for (u32 pz=0; pz<PatchCount; ++pz)
+	{
+		for (u32 px=0; px<PatchCount; ++px)
+		{
+			SPatch& patch = Patches[pz * PatchCount + px];
+			patch.Sides = 0;
+			if (px > 0 && Patches[pz * PatchCount + px - 1].LOD > patch.LOD)
+				patch.Sides |= EPS_LEFT;
+			if (px + 1 < PatchCount && Patches[pz * PatchCount + px + 1].LOD > patch.LOD)
+				patch.Sides |= EPS_RIGHT;
+			if (pz > 0 && Patches[(pz - 1) * PatchCount + px].LOD > patch.LOD)
+				patch.Sides |= EPS_BOTTOM;
+			if (pz + 1 < PatchCount && Patches[(pz + 1) * PatchCount + px].LOD > patch.LOD)
+				patch.Sides |= EPS_TOP;
+		}
+	}
+}
+
+
+void CTerrainSceneNode::buildPatch(u32 patchX, u32 patchZ)
+{
+	SPatch& patch = Patches[patchZ * PatchCount + patchX];
+	if (!patch.Buffer)
+	{
+		patch.Buffer = new SMeshBufferLightMap();
+		patch.Buffer->setHardwareMappingHint(EHM_STATIC);
+	}
+	SMeshBufferLightMap* buffer = patch.Buffer;
+
+	if (patch.BuiltLOD != patch.LOD)
+	{
+		const u32 step = 1 << patch.LOD;
+		const u32 n = (PatchSize - 1) / step + 1;
+		const u32 x0 = patchX * (PatchSize - 1);
+		const u32 z0 = patchZ * (PatchSize - 1);
+		const f32 tcoordScale = 1.f / (Size - 1);
+
+		buffer->Vertices.set_used(n * n);
+		for (u32 j=0; j<n; ++j)
+		{
+			for (u32 i=0; i<n; ++i)
+			{
+				const u32 x = x0 + i * step;
+				const u32 z = z0 + j * step;
+				video::S3DVertex2TCoords& v = buffer->Vertices[j * n + i];
+
+				v.Pos.set((f32)x, height(x, z), (f32)z);
+
+				// slope between the neighbouring samples at full resolution
+				const u32 left = x > 0 ? x - 1 : x;
+				const u32 right = x + 1 < Size ? x + 1 : x;
+				const u32 bottom = z > 0 ? z - 1 : z;
+				const u32 top = z + 1 < Size ? z + 1 : z;
+				v.Normal.set((height(left, z) - height(right, z)) / (right - left), 1.f,
+					(height(x, bottom) - height(x, top)) / (top - bottom));
+				v.Normal.normalize();
+
+				v.Color = VertexColor;
+				v.TCoords.set(x * tcoordScale * TCoordScale1, z * tcoordScale * TCoordScale1);
+				if (TCoordScale2 != 0.f)
+					v.TCoords2.set(x * tcoordScale * TCoordScale2, z * tcoordScale * TCoordScale2);
+				else
+					v.TCoords2 = v.TCoords;
+			}
+		}
+
+		buffer->BoundingBox = patch.BoundingBox;
+		buffer->setDirty(EBT_VERTEX);
+	}
+
+	buffer->Indices = IndexSets[patch.LOD * 16 + patch.Sides];
+	buffer->setDirty(EBT_INDEX);
+
+	patch.BuiltLOD = patch.LOD;
+	patch.BuiltSides = patch.Sides;
+}
+
+
+void CTerrainSceneNode::getCellTriangles(u32 x, u32 z, core::triangle3df* triangles) const
+{
+	const core::vector3df p00((f32)x, height(x, z), (f32)z);
+	const core::vector3df p10((f32)(x + 1), height(x + 1, z), (f32)z);
+	const core::vector3df p01((f32)x, height(x, z + 1), (f32)(z + 1));
+	const core::vector3df p11((f32)(x + 1), height(x + 1, z + 1), (f32)(z + 1));
+
+	// the diagonals point to the centers of the fans of LOD 0
+	if (((x + z) & 1) == 0)
+	{
+		triangles[0].set(p00, p01, p11);
+		triangles[1].set(p00, p11, p10);
+	}
+	else
+	{
+		triangles[0].set(p00, p01, p10);
+		triangles[1].set(p01, p11, p10);
+	}
+}
+
+
+//! returns the axis aligned bounding box of this node
+const core::aabbox3d<f32>& CTerrainSceneNode::getBoundingBox() const
+{
+	return BoundingBox;
+}
+
+
+video::SMaterial& CTerrainSceneNode::getMaterial(u32 i)
+{
+	return Material;
+}
+
+
+//! returns amount of materials used by this scene node.
+u32 CTerrainSceneNode::getMaterialCount() const
+{
+	return 1;
+}
+
+
+//! Get height of a point of the terrain
+f32 CTerrainSceneNode::getHeight(f32 x, f32 z) const
+{
+	core::matrix4 toNode;
+	if (!Size || !AbsoluteTransformation.getInverse(toNode))
+		return -FLT_MAX;
+
+	core::vector3df pos(x, 0.f, z);
+	toNode.transformVect(pos);
+
+	const f32 last = (f32)(Size - 1);
+	if (pos.X < -EDGE_TOLERANCE || pos.Z < -EDGE_TOLERANCE ||
+		pos.X > last + EDGE_TOLERANCE || pos.Z > last + EDGE_TOLERANCE)
+		return -FLT_MAX;
+
+	pos.X = core::clamp(pos.X, 0.f, last);
+	pos.Z = core::clamp(pos.Z, 0.f, last);
+	const u32 cx = core::min_((u32)pos.X, Size - 2);
+	const u32 cz = core::min_((u32)pos.Z, Size - 2);
+	const f32 fx = pos.X - cx;
+	const f32 fz = pos.Z - cz;
+
+	const f32 h00 = height(cx, cz);
+	const f32 h10 = height(cx + 1, cz);
+	const f32 h01 = height(cx, cz + 1);
+	const f32 h11 = height(cx + 1, cz + 1);
+
+	// on the triangles of getCellTriangles
+	if (((cx + cz) & 1) == 0)
+	{
+		if (fx >= fz)
+			pos.Y = h00 + fx * (h10 - h00) + fz * (h11 - h10);
+		else
+			pos.Y = h00 + fz * (h01 - h00) + fx * (h11 - h01);
+	}
+	else
+	{
+		if (fx + fz <= 1.f)
+			pos.Y = h00 + fx * (h10 - h00) + fz * (h01 - h00);
+		else
+			pos.Y = h11 + (1.f - fx) * (h01 - h11) + (1.f - fz) * (h10 - h11);
+	}
+
+	AbsoluteTransformation.transformVect(pos);
+	return pos.Y;
+}
+
+
+//! Finds the first intersection of a line with the terrain
+bool CTerrainSceneNode::getIntersectionWithLine(const core::line3d<f32>& line,
+		core::vector3df& outIntersection) const
+{
+	core::matrix4 toNode;
+	if (!Size || !AbsoluteTransformation.getInverse(toNode))
+		return false;
+
+	core::line3d<f32> segment;
+	toNode.transformVect(segment.start, line.start);
+	toNode.transformVect(segment.end, line.end);
+	const core::vector3df dir = segment.getVector();
+
+	// part of the line inside of the box of the terrain
+	f32 t0 = 0.f;
+	f32 t1 = 1.f;
+	if (!clipLine(segment.start.X, dir.X, BoundingBox.MinEdge.X, BoundingBox.MaxEdge.X, t0, t1) ||
+		!clipLine(segment.start.Y, dir.Y, BoundingBox.MinEdge.Y, BoundingBox.MaxEdge.Y, t0, t1) ||
+		!clipLine(segment.start.Z, dir.Z, BoundingBox.MinEdge.Z, BoundingBox.MaxEdge.Z, t0, t1))
+		return false;
+
+	// walk through the cells below the line, in the order the line crosses them
+	const core::vector3df first = segment.start + dir * t0;
+	const s32 lastCell = (s32)Size - 2;
+	s32 cx = core::s32_clamp((s32)floorf(first.X), 0, lastCell);
+	s32 cz = core::s32_clamp((s32)floorf(first.Z), 0, lastCell);
+
+	const s32 stepX = dir.X > 0.f ? 1 : -1;
+	const s32 stepZ = dir.Z > 0.f ? 1 : -1;
+	const f32 deltaX = core::iszero(dir.X) ? FLT_MAX : fabsf(1.f / dir.X);
+	const f32 deltaZ = core::iszero(dir.Z) ? FLT_MAX : fabsf(1.f / dir.Z);
+	f32 nextX = core::iszero(dir.X) ? FLT_MAX : ((cx + (stepX > 0 ? 1 : 0)) - segment.start.X) / dir.X;
+	f32 nextZ = core::iszero(dir.Z) ? FLT_MAX : ((cz + (stepZ > 0 ? 1 : 0)) - segment.start.Z) / dir.Z;
+
+	f32 t = t0;
+	for (;;)
+	{
+		const f32 tExit = core::min_(nextX, nextZ, t1);
+
+		// only cells whose heights overlap those of the line in the cell
+		const f32 y0 = segment.start.Y + dir.Y * t;
+		const f32 y1 = segment.start.Y + dir.Y * tExit;
+		const f32 h00 = height(cx, cz);
+		const f32 h10 = height(cx + 1, cz);
+		const f32 h01 = height(cx, cz + 1);
+		const f32 h11 = height(cx + 1, cz + 1);
+		if (core::min_(y0, y1) <= core::max_(core::max_(h00, h10), core::max_(h01, h11)) + EDGE_TOLERANCE &&
+			core::max_(y0, y1) >= core::min_(core::min_(h00, h10), core::min_(h01, h11)) - EDGE_TOLERANCE)
+		{
+			core::triangle3df triangles[2];
+			getCellTriangles(cx, cz, triangles);
+
+			bool found = false;
+			f32 closest = FLT_MAX;
+			core::vector3df intersection;
+			for (u32 i=0; i<2; ++i)
+			{
+				core::vector3df p;
+				if (triangles[i].getIntersectionWithLimitedLine(segment, p))
+				{
+					const f32 d = p.getDistanceFromSQ(segment.start);
+					if (d < closest)
+					{
+						closest = d;
+						intersection = p;
+						found = true;
+					}
+				}
+			}
+
+			if (found)
+			{
+				AbsoluteTransformation.transformVect(outIntersection, intersection);
+				return true;
+			}
+		}
+
+		if (tExit >= t1)
+			break;
+
+		if (nextX < nextZ)
+		{
+			cx += stepX;
+			nextX += deltaX;
+		}
+		else
+		{
+			cz += stepZ;
+			nextZ += deltaZ;
+		}
+
+		if (cx < 0 || cz < 0 || cx > lastCell || cz > lastCell)
+			break;
+		t = tExit;
+	}
+
+	return false;
+}
+
+
+//! Returns the number of heightmap samples along each side of the terrain
+u32 CTerrainSceneNode::getHeightMapSize() const
+{
+	return Size;
+}
+
+
+//! Returns the height of a heightmap sample, in node space
+f32 CTerrainSceneNode::getHeightSample(u32 x, u32 z) const
+{
+	if (!Size)
+		return 0.f;
+	return height(core::min_(x, Size - 1), core::min_(z, Size - 1));
+}
+
+
+//! Sets the maximum height error of the drawn patches on the screen
+void CTerrainSceneNode::setMaxScreenError(f32 pixels)
+{
+	MaxScreenError = core::max_(pixels, 0.f);
+	LODDirty = true;
+}
+
+
+//! Returns the maximum height error of the drawn patches on the screen
+f32 CTerrainSceneNode::getMaxScreenError() const
+{
+	return MaxScreenError;
+}
+
+
+//! Gets the LODs selected for the patches in the last frame
+s32 CTerrainSceneNode::getCurrentLODOfPatches(core::array<s32>& LODs) const
+{
+	LODs.set_used(Patches.size());
+	for (u32 i=0; i<Patches.size(); ++i)
+		LODs[i] = Patches[i].LOD;
+	return LODs.size();
+}
+
+
+//! Returns the number of indices drawn in the last frame
+u32 CTerrainSceneNode::getIndexCount() const
+{
+	return IndexCount;
+}
+
+
+//! Returns the center of the terrain, in world space
+core::vector3df CTerrainSceneNode::getTerrainCenter() const
+{
+	core::vector3df center = BoundingBox.getCenter();
+	AbsoluteTransformation.transformVect(center);
+	return center;
+}
+
+
+//! Scales the base texture
+void CTerrainSceneNode::scaleTexture(f32 scale, f32 scale2)
+{
+	TCoordScale1 = scale;
+	TCoordScale2 = scale2;
+
+	// the vertices are rebuilt when the patches are drawn again
+	for (u32 i=0; i<Patches.size(); ++i)
+		Patches[i].BuiltLOD = -1;
+}
+
+
+//! Creates a clone of this scene node and its children.
+ISceneNode* CTerrainSceneNode::clone(ISceneNode* newParent, ISceneManager* newManager)
+{
+	if (!newParent)
+		newParent = Parent;
+	if (!newManager)
+		newManager = SceneManager;
+
+	CTerrainSceneNode* nb = new CTerrainSceneNode(newParent, newManager, ID,
+		LODCount, (E_TERRAIN_PATCH_SIZE)PatchSize,
+		RelativeTranslation, RelativeRotation, RelativeScale);
+
+	nb->cloneMembers(this, newManager);
+	nb->Material = Material;
+	nb->markChanged();
+	nb->VertexColor = VertexColor;
+	nb->TCoordScale1 = TCoordScale1;
+	nb->TCoordScale2 = TCoordScale2;
+	nb->MaxScreenError = MaxScreenError;
+	nb->Heights = Heights;
+	nb->Size = Size;
+	nb->PatchCount = PatchCount;
+	if (Size)
+		nb->createPatches();
+
+	if ( newParent )
+		nb->drop();
+	return nb;
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_TERRAIN_SCENENODE_
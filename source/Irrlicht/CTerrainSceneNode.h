@@ -0,0 +1,199 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_TERRAIN_SCENE_NODE_H_INCLUDED__
+#define __C_TERRAIN_SCENE_NODE_H_INCLUDED__
+
+#include "ITerrainSceneNode.h"
+#include "SMeshBufferLightMap.h"
+#include "triangle3d.h"
+
+namespace irr
+{
+namespace io
+{
+	class IReadFile;
+} // end namespace io
+
+namespace scene
+{
+	class ICameraSceneNode;
+
+//! A scene node drawing a heightmap with one geo mip mapped mesh buffer per patch
+class CTerrainSceneNode : public ITerrainSceneNode
+{
+public:
+
+	//! constructor
+	/** \param maxLOD Number of LODs, limited by the patch size. */
+	CTerrainSceneNode(ISceneNode* parent, ISceneManager* mgr, s32 id,
+		s32 maxLOD, E_TERRAIN_PATCH_SIZE patchSize,
+		const core::vector3df& position = core::vector3df(0.0f, 0.0f, 0.0f),
+		const core::vector3df& rotation = core::vector3df(0.0f, 0.0f, 0.0f),
+		const core::vector3df& scale = core::vector3df(1.0f, 1.0f, 1.0f));
+
+	virtual ~CTerrainSceneNode();
+
+	//! Initializes the terrain data from a heightmap file
+	bool loadHeightMap(io::IReadFile* file,
+		video::SColor vertexColor=video::SColor(255,255,255,255),
+		s32 smoothFactor=0);
+
+	//! Initializes the terrain data from a heightmap image
+	virtual bool loadHeightMap(video::IImage* heightmap,
+		video::SColor vertexColor=video::SColor(255,255,255,255),
+		s32 smoothFactor=0) _IRR_OVERRIDE_;
+
+	//! pre render event
+	virtual void OnRegisterSceneNode() _IRR_OVERRIDE_;
+
+	//! render
+	virtual void render() _IRR_OVERRIDE_;
+
+	//! returns the axis aligned bounding box of this node
+	virtual const core::aabbox3d<f32>& getBoundingBox() const _IRR_OVERRIDE_;
+
+	virtual video::SMaterial& getMaterial(u32 i) _IRR_OVERRIDE_;
+
+	//! returns amount of materials used by this scene node.
+	virtual u32 getMaterialCount() const _IRR_OVERRIDE_;
+
+	//! Get height of a point of the terrain
+	virtual f32 getHeight(f32 x, f32 z) const _IRR_OVERRIDE_;
+
+	//! Finds the first intersection of a line with the terrain
+	virtual bool getIntersectionWithLine(const core::line3d<f32>& line,
+		core::vector3df& outIntersection) const _IRR_OVERRIDE_;
+
+	//! Returns the number of heightmap samples along each side of the terrain
+	virtual u32 getHeightMapSize() const _IRR_OVERRIDE_;
+
+	//! Returns the height of a heightmap sample, in node space
+	virtual f32 getHeightSample(u32 x, u32 z) const _IRR_OVERRIDE_;
+
+	//! Sets the maximum height error of the drawn patches on the screen
+	virtual void setMaxScreenError(f32 pixels) _IRR_OVERRIDE_;
+
+	//! Returns the maximum height error of the drawn patches on the screen
+	virtual f32 getMaxScreenError() const _IRR_OVERRIDE_;
+
+	//! Gets the LODs selected for the patches in the last frame
+	virtual s32 getCurrentLODOfPatches(core::array<s32>& LODs) const _IRR_OVERRIDE_;
+
+	//! Returns the number of indices drawn in the last frame
+	virtual u32 getIndexCount() const _IRR_OVERRIDE_;
+
+	//! Returns the center of the terrain, in world space
+	virtual core::vector3df getTerrainCenter() const _IRR_OVERRIDE_;
+
+	//! Scales the base texture
+	virtual void scaleTexture(f32 scale = 1.0f, f32 scale2=0.0f) _IRR_OVERRIDE_;
+
+	//! Returns type of the scene node
+	virtual ESCENE_NODE_TYPE getType() const _IRR_OVERRIDE_ { return ESNT_TERRAIN; }
+
+	//! Creates a clone of this scene node and its children.
+	virtual ISceneNode* clone(ISceneNode* newParent=0, ISceneManager* newManager=0) _IRR_OVERRIDE_;
+
+private:
+
+	//! Most LODs, for ETPS_129
+	enum { MAX_LOD_COUNT = 7 };
+
+	//! Bits of the sides of a patch whose neighbour has a coarser LOD
+	enum E_PATCH_SIDE
+	{
+		EPS_LEFT = 1,	// -X
+		EPS_RIGHT = 2,	// +X
+		EPS_BOTTOM = 4,	// -Z
+		EPS_TOP = 8	// +Z
+	};
+
+	struct SPatch
+	{
+		SPatch() : LOD(0), Sides(0), BuiltLOD(-1), BuiltSides(0), Buffer(0)
+		{
+			for (u32 i=0; i<MAX_LOD_COUNT; ++i)
+				Errors[i] = 0.f;
+		}
+
+		//! Box in node space
+		core::aabbox3d<f32> BoundingBox;
+
+		//! Largest height difference to the heightmap for each LOD
+		f32 Errors[MAX_LOD_COUNT];
+
+		//! Selected LOD and E_PATCH_SIDE bits
+		s32 LOD;
+		u32 Sides;
+
+		//! LOD and sides the buffer was built for
+		s32 BuiltLOD;
+		u32 BuiltSides;
+
+		//! Vertices and indices, created when the patch is visible for the first time
+		SMeshBufferLightMap* Buffer;
+	};
+
+	//! calculates the patches, their errors and the index sets from Heights
+	void createPatches();
+
+	//! drops the buffers of all patches
+	void removePatchBuffers();
+
+	//! selects the LODs of all patches for the camera
+	void updateLODs(const ICameraSceneNode* camera);
+
+	//! writes the vertices and indices of a patch for its LOD and sides
+	void buildPatch(u32 patchX, u32 patchZ);
+
+	//! returns the two triangles of a heightmap cell in node space
+	void getCellTriangles(u32 x, u32 z, core::triangle3df* triangles) const;
+
+	//! height of a sample
+	f32 height(u32 x, u32 z) const
+	{
+		return Heights[z * Size + x];
+	}
+
+	//! Heights of the samples, row by row along the Z axis
+	core::array<f32> Heights;
+
+	//! Samples along each side of the terrain
+	u32 Size;
+
+	//! Samples along each side of a patch
+	u32 PatchSize;
+
+	//! Patches along each side of the terrain
+	u32 PatchCount;
+
+	s32 LODCount;
+
+	core::array<SPatch> Patches;
+
+	//! Indices of the patches for each LOD and combination of E_PATCH_SIDE bits
+	core::array<core::array<u16> > IndexSets;
+
+	video::SMaterial Material;
+	video::SColor VertexColor;
+	f32 TCoordScale1;
+	f32 TCoordScale2;
+	f32 MaxScreenError;
+
+	//! Camera position in node space and error scale the LODs were selected for
+	core::vector3df LODCameraPosition;
+	f32 LODErrorScale;
+	bool LODDirty;
+
+	core::aabbox3d<f32> BoundingBox;
+	u32 IndexCount;
+};
+
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -0,0 +1,249 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+#ifdef _IRR_COMPILE_WITH_TERRAIN_SCENENODE_
+#include "CTerrainTriangleSelector.h"
+#include "ITerrainSceneNode.h"
+
+namespace irr
+{
+namespace scene
+{
+
+//! constructor
+CTerrainTriangleSelector::CTerrainTriangleSelector(ITerrainSceneNode* node, s32 LOD)
+	: SceneNode(node), LOD(core::max_(LOD, 0))
+{
+	#ifdef _DEBUG
+	setDebugName("CTerrainTriangleSelector");
+	#endif
+}
+
+
+u32 CTerrainTriangleSelector::getStep() const
+{
+	// the heightmap may be loaded after the selector was created
+	const u32 cells = SceneNode ? SceneNode->getHeightMapSize() : 0;
+	if (cells < 2)
+		return 0;
+
+	u32 step = 1 << core::min_(LOD, 16);
+	while ((cells - 1) % step)
+		step >>= 1;
+	return step;
+}
+
+
+void CTerrainTriangleSelector::getCellTriangles(core::triangle3df* triangles,
+					s32 arraySize, s32& outTriangleCount,
+					u32 minX, u32 minZ, u32 maxX, u32 maxZ, f32 minY, f32 maxY,
+					const core::matrix4* transform, bool useNodeTransform,
+					irr::core::array<SCollisionTriangleRange>* outTriangleInfo) const
+{
+	core::matrix4 mat;
+	if (transform)
+		mat = *transform;
+	if (useNodeTransform)
+		mat *= SceneNode->getAbsoluteTransformation();
+
+	const u32 step = getStep();
+	s32 triangleCount = 0;
+
+	for (u32 z=minZ; z<=maxZ && triangleCount + 2 <= arraySize; ++z)
+	{
+		for (u32 x=minX; x<=maxX && triangleCount + 2 <= arraySize; ++x)
+		{
+			const u32 x0 = x * step;
+			const u32 z0 = z * step;
+			const core::vector3df p00((f32)x0, SceneNode->getHeightSample(x0, z0), (f32)z0);
+			const core::vector3df p10((f32)(x0 + step), SceneNode->getHeightSample(x0 + step, z0), (f32)z0);
+			const core::vector3df p01((f32)x0, SceneNode->getHeightSample(x0, z0 + step), (f32)(z0 + step));
+			const core::vector3df p11((f32)(x0 + step), SceneNode->getHeightSample(x0 + step, z0 + step), (f32)(z0 + step));
+
+			if (core::max_(core::max_(p00.Y, p10.Y), core::max_(p01.Y, p11.Y)) < minY ||
+				core::min_(core::min_(p00.Y, p10.Y), core::min_(p01.Y, p11.Y)) > maxY)
+				continue;
+
+			// same diagonals as the terrain at LOD 0
+			core::triangle3df* tri = triangles + triangleCount;
+			if (((x + z) & 1) == 0)
+			{
+				tri[0].set(p00, p01, p11);
+				tri[1].set(p00, p11, p10);
+			}
+			else
+			{
+				tri[0].set(p00, p01, p10);
+				tri[1].set(p01, p11, p10);
+			}
+
+			for (u32 i=0; i<2; ++i)
+			{
+				mat.transformVect(tri[i].pointA);
+				mat.transformVect(tri[i].pointB);
+				mat.transformVect(tri[i].pointC);
+			}
+			triangleCount += 2;
+		}
+	}
+
+	if ( outTriangleInfo )
+	{
+		SCollisionTriangleRange triRange;
+		triRange.RangeSize = triangleCount;
+		triRange.Selector = const_cast<CTerrainTriangleSelector*>(this);
+		triRange.SceneNode = SceneNode;
+		outTriangleInfo->push_back(triRange);
+	}
+
+	outTriangleCount = triangleCount;
+}
+
+
+//! Gets all triangles.
+void CTerrainTriangleSelector::getTriangles(core::triangle3df* triangles,
+					s32 arraySize, s32& outTriangleCount,
+					const core::matrix4* transform, bool useNodeTransform,
+					irr::core::array<SCollisionTriangleRange>* outTriangleInfo) const
+{
+	const u32 step = getStep();
+	if (!step)
+	{
+		outTriangleCount = 0;
+		return;
+	}
+
+	const u32 last = (SceneNode->getHeightMapSize() - 1) / step - 1;
+	getCellTriangles(triangles, arraySize, outTriangleCount,
+		0, 0, last, last, -FLT_MAX, FLT_MAX,
+		transform, useNodeTransform, outTriangleInfo);
+}
+
+
+//! Gets all triangles which lie within a specific bounding box.
+void CTerrainTriangleSelector::getTriangles(core::triangle3df* triangles,
+					s32 arraySize, s32& outTriangleCount,
+					const core::aabbox3d<f32>& box,
+					const core::matrix4* transform, bool useNodeTransform,
+					irr::core::array<SCollisionTriangleRange>* outTriangleInfo) const
+{
+	outTriangleCount = 0;
+
+	const u32 step = getStep();
+	if (!step)
+		return;
+
+	core::aabbox3df tBox(box);
+	if (useNodeTransform)
+	{
+		core::matrix4 mat(core::matrix4::EM4CONST_NOTHING);
+		if ( SceneNode->getAbsoluteTransformation().getInverse(mat) )
+			mat.transformBoxEx(tBox);
+		else
+		{
+			// If a node has an axis scaled to 0 we return all triangles without any check
+			return getTriangles(triangles, arraySize, outTriangleCount,
+					transform, useNodeTransform, outTriangleInfo );
+		}
+	}
+
+	// cells below the box
+	const f32 size = (f32)(SceneNode->getHeightMapSize() - 1);
+	if (tBox.MaxEdge.X < 0.f || tBox.MaxEdge.Z < 0.f ||
+		tBox.MinEdge.X > size || tBox.MinEdge.Z > size)
+	{
+		if ( outTriangleInfo )
+		{
+			SCollisionTriangleRange triRange;
+			triRange.Selector = const_cast<CTerrainTriangleSelector*>(this);
+			triRange.SceneNode = SceneNode;
+			outTriangleInfo->push_back(triRange);
+		}
+		return;
+	}
+
+	const s32 last = (s32)size / step - 1;
+	const u32 minX = core::s32_clamp((s32)floorf(tBox.MinEdge.X / step), 0, last);
+	const u32 minZ = core::s32_clamp((s32)floorf(tBox.MinEdge.Z / step), 0, last);
+	const u32 maxX = core::s32_clamp((s32)floorf(tBox.MaxEdge.X / step), 0, last);
+	const u32 maxZ = core::s32_clamp((s32)floorf(tBox.MaxEdge.Z / step), 0, last);
+
+	getCellTriangles(triangles, arraySize, outTriangleCount,
+		minX, minZ, maxX, maxZ, tBox.MinEdge.Y, tBox.MaxEdge.Y,
+		transform, useNodeTransform, outTriangleInfo);
+}
+
+
+//! Gets all triangles which have or may have contact with a 3d line.
+void CTerrainTriangleSelector::getTriangles(core::triangle3df* triangles,
+					s32 arraySize, s32& outTriangleCount,
+					const core::line3d<f32>& line,
+					const core::matrix4* transform, bool useNodeTransform,
+					irr::core::array<SCollisionTriangleRange>* outTriangleInfo) const
+{
+	core::aabbox3d<f32> box(line.start);
+	box.addInternalPoint(line.end);
+
+	getTriangles(triangles, arraySize, outTriangleCount,
+				box, transform, useNodeTransform, outTriangleInfo);
+}
+
+
+//! Returns amount of all available triangles in this selector
+s32 CTerrainTriangleSelector::getTriangleCount() const
+{
+	const u32 step = getStep();
+	if (!step)
+		return 0;
+
+	const u32 cells = (SceneNode->getHeightMapSize() - 1) / step;
+	return cells * cells * 2;
+}
+
+
+//! Return the scene node associated with a given triangle.
+ISceneNode* CTerrainTriangleSelector::getSceneNodeForTriangle(u32 triangleIndex) const
+{
+	return SceneNode;
+}
+
+
+/* Get the number of TriangleSelectors that are part of this one.
+Only useful for MetaTriangleSelector others return 1
+*/
+u32 CTerrainTriangleSelector::getSelectorCount() const
+{
+	return 1;
+}
+
+
+/* Get the TriangleSelector based on index based on getSelectorCount.
+Only useful for MetaTriangleSelector others return 'this' or 0
+*/
+ITriangleSelector* CTerrainTriangleSelector::getSelector(u32 index)
+{
+	if (index)
+		return 0;
+	else
+		return this;
+}
+
+
+/* Get the TriangleSelector based on index based on getSelectorCount.
+Only useful for MetaTriangleSelector others return 'this' or 0
+*/
+const ITriangleSelector* CTerrainTriangleSelector::getSelector(u32 index) const
+{
+	if (index)
+		return 0;
+	else
+		return this;
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_TERRAIN_SCENENODE_
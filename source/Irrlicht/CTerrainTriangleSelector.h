@@ -0,0 +1,77 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_TERRAIN_TRIANGLE_SELECTOR_H_INCLUDED__
+#define __C_TERRAIN_TRIANGLE_SELECTOR_H_INCLUDED__
+
+#include "ITriangleSelector.h"
+
+namespace irr
+{
+namespace scene
+{
+
+class ITerrainSceneNode;
+
+//! Triangle selector reading the triangles of a terrain directly from its heightmap
+/** Only the cells inside of the queried box are generated, so no triangles
+of the whole terrain are kept. */
+class CTerrainTriangleSelector : public ITriangleSelector
+{
+public:
+
+	//! Constructs a selector for a terrain
+	/** \param LOD Triangles are built from every 2^LOD-th heightmap sample. */
+	CTerrainTriangleSelector(ITerrainSceneNode* node, s32 LOD);
+
+	//! Gets all triangles.
+	virtual void getTriangles(core::triangle3df* triangles, s32 arraySize, s32& outTriangleCount,
+		const core::matrix4* transform, bool useNodeTransform,
+		irr::core::array<SCollisionTriangleRange>* outTriangleInfo) const _IRR_OVERRIDE_;
+
+	//! Gets all triangles which lie within a specific bounding box.
+	virtual void getTriangles(core::triangle3df* triangles, s32 arraySize, s32& outTriangleCount,
+		const core::aabbox3d<f32>& box, const core::matrix4* transform, bool useNodeTransform,
+		irr::core::array<SCollisionTriangleRange>* outTriangleInfo) const _IRR_OVERRIDE_;
+
+	//! Gets all triangles which have or may have contact with a 3d line.
+	virtual void getTriangles(core::triangle3df* triangles, s32 arraySize,
+		s32& outTriangleCount, const core::line3d<f32>& line,
+		const core::matrix4* transform, bool useNodeTransform,
+		irr::core::array<SCollisionTriangleRange>* outTriangleInfo) const _IRR_OVERRIDE_;
+
+	//! Returns amount of all available triangles in this selector
+	virtual s32 getTriangleCount() const _IRR_OVERRIDE_;
+
+	//! Return the scene node associated with a given triangle.
+	virtual ISceneNode* getSceneNodeForTriangle(u32 triangleIndex) const _IRR_OVERRIDE_;
+
+	// Get the number of TriangleSelectors that are part of this one
+	virtual u32 getSelectorCount() const _IRR_OVERRIDE_;
+
+	// Get the TriangleSelector based on index based on getSelectorCount
+	virtual ITriangleSelector* getSelector(u32 index) _IRR_OVERRIDE_;
+
+	// Get the TriangleSelector based on index based on getSelectorCount
+	virtual const ITriangleSelector* getSelector(u32 index) const _IRR_OVERRIDE_;
+
+private:
+
+	//! distance of the used samples, fitting the current heightmap
+	u32 getStep() const;
+
+	//! writes the triangles of the cells in a range, in node space
+	void getCellTriangles(core::triangle3df* triangles, s32 arraySize, s32& outTriangleCount,
+		u32 minX, u32 minZ, u32 maxX, u32 maxZ, f32 minY, f32 maxY,
+		const core::matrix4* transform, bool useNodeTransform,
+		irr::core::array<SCollisionTriangleRange>* outTriangleInfo) const;
+
+	ITerrainSceneNode* SceneNode;
+	s32 LOD;
+};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
@@ -29,6 +29,12 @@ namespace irr
 			return os::Timer::getRealTime();
 		}
 
+		//! Returns current real time in microseconds of the system.
+		virtual u64 getRealTimeUs() const _IRR_OVERRIDE_
+		{
+			return os::Timer::getRealTimeUs();
+		}
+
 		//! Get current time and date in calendar form
 		virtual RealTimeDate getRealTimeAndDate() const _IRR_OVERRIDE_
 		{
@@ -44,6 +50,18 @@ namespace irr
 			return os::Timer::getTime();
 		}
 
+		//! Returns current virtual time in microseconds.
+		virtual u64 getTimeUs() const _IRR_OVERRIDE_
+		{
+			return os::Timer::getTimeUs();
+		}
+
+		//! Returns the virtual time passed with the last call to tick() in seconds.
+		virtual f32 getDeltaTime() const _IRR_OVERRIDE_
+		{
+			return os::Timer::getDeltaTime();
+		}
+
 		//! sets current virtual time
 		virtual void setTime(u32 time) _IRR_OVERRIDE_
 		{
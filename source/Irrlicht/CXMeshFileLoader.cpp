@@ -29,7 +29,7 @@ namespace scene
 //! Constructor
 CXMeshFileLoader::CXMeshFileLoader(scene::ISceneManager* smgr, io::IFileSystem* fs)
 : SceneManager(smgr), FileSystem(fs), AnimatedMesh(0),
-	Buffer(0), P(0), End(0), BinaryNumCount(0), Line(0),
+	Buffer(0), BufferCopy(0), P(0), End(0), BinaryNumCount(0), Line(0),
 	CurFrame(0), MajorVersion(0), MinorVersion(0), BinaryFormat(false), FloatSize(0)
 {
 	#ifdef _DEBUG
@@ -90,7 +90,8 @@ IAnimatedMesh* CXMeshFileLoader::createMesh(io::IReadFile* file)
 	End=0;
 	CurFrame=0;
 
-	delete [] Buffer;
+	delete [] BufferCopy;
+	BufferCopy = 0;
 	Buffer = 0;
 
 	for (u32 i=0; i<Meshes.size(); ++i)
@@ -394,20 +395,28 @@ bool CXMeshFileLoader::load(io::IReadFile* file)
 //! Reads file into memory
 bool CXMeshFileLoader::readFileIntoMemory(io::IReadFile* file)
 {
-	const long size = file->getSize();
+	// the mesh starts at the current position of the file
+	const long size = file->getSize() - file->getPos();
 	if (size < 12)
 	{
 		os::Printer::log("X File is too small.", ELL_WARNING);
 		return false;
 	}
 
-	Buffer = new c8[size];
-
-	//! read all into memory
-	if (file->read(Buffer, size) != static_cast<size_t>(size))
+	//! parse straight from the file's memory if it has some, else read all into memory
+	Buffer = (const c8*)file->getBuffer();
+	if (Buffer)
+		Buffer += file->getPos();
+	else
 	{
-		os::Printer::log("Could not read from x file.", ELL_WARNING);
-		return false;
+		BufferCopy = new c8[size];
+		Buffer = BufferCopy;
+
+		if (file->read(BufferCopy, size) != static_cast<size_t>(size))
+		{
+			os::Printer::log("Could not read from x file.", ELL_WARNING);
+			return false;
+		}
 	}
 
 	Line = 1;
@@ -164,9 +164,11 @@ private:
 
 	CSkinnedMesh* AnimatedMesh;
 
-	c8* Buffer;
+	//! contents of the file, in BufferCopy if the file has no buffer of its own
+	const c8* Buffer;
+	c8* BufferCopy;
 	const c8* P;
-	c8* End;
+	const c8* End;
 	// counter for number arrays in binary format
 	u32 BinaryNumCount;
 	u32 Line;
@@ -11,6 +11,7 @@
 
 #include "CFileList.h"
 #include "CReadFile.h"
+#include "CInflateReadFile.h"
 #include "coreutil.h"
 
 #include "IrrCompileConfig.h"
@@ -23,6 +24,12 @@ namespace irr
 namespace io
 {
 
+namespace
+{
+	//! Deflated files of at least this size are inflated while they are read
+	const u32 ZIP_INFLATE_STREAM_SIZE = 256 * 1024;
+}
+
 
 // -----------------------------------------------------------------------------
 // zip loader
@@ -115,7 +122,8 @@ bool CArchiveLoaderZIP::isALoadableFileFormat(io::IReadFile* file) const
 // -----------------------------------------------------------------------------
 
 CZipReader::CZipReader(IFileSystem* fs, IReadFile* file, bool ignoreCase, bool ignorePaths, bool isGZip)
- : CFileList((file ? file->getFileName() : io::path("")), ignoreCase, ignorePaths), FileSystem(fs), File(file), IsGZip(isGZip)
+ : CFileList((file ? file->getFileName() : io::path("")), ignoreCase, ignorePaths), FileSystem(fs), File(file), IsGZip(isGZip),
+	CacheSize(0), CacheUsed(0), CacheUseCounter(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CZipReader");
@@ -137,6 +145,9 @@ CZipReader::CZipReader(IFileSystem* fs, IReadFile* file, bool ignoreCase, bool i
 
 CZipReader::~CZipReader()
 {
+	for (u32 i=0; i<Cache.size(); ++i)
+		Cache[i].File->drop();
+
 	if (File)
 		File->drop();
 }
@@ -154,6 +165,71 @@ const IFileList* CZipReader::getFileList() const
 }
 
 
+//! Set how much decompressed data the archive may keep for opening files again
+void CZipReader::setDecompressedCacheSize(u32 bytes)
+{
+	CacheSize = bytes;
+	trimCache(0);
+}
+
+
+//! opens a file from the cache of decompressed files, 0 if it is not in there
+IReadFile* CZipReader::openCachedFile(u32 index)
+{
+	for (u32 i=0; i<Cache.size(); ++i)
+	{
+		if (Cache[i].ID == Files[index].ID)
+		{
+			Cache[i].LastUse = ++CacheUseCounter;
+			// positional reads, so all opened views have their own position
+			return createLimitReadFile(Files[index].FullName, Cache[i].File, 0, Cache[i].File->getSize());
+		}
+	}
+	return 0;
+}
+
+
+//! adds a decompressed file to the cache, returns the file to give out
+IReadFile* CZipReader::addCachedFile(u32 index, IReadFile* file)
+{
+	// a single file shouldn't push everything else out
+	const u32 size = (u32)file->getSize();
+	if (!CacheSize || size > CacheSize / 4)
+		return file;
+
+	trimCache(size);
+
+	SCachedFile entry;
+	entry.File = file;
+	entry.ID = Files[index].ID;
+	entry.LastUse = ++CacheUseCounter;
+	Cache.push_back(entry);
+	CacheUsed += size;
+
+	return createLimitReadFile(Files[index].FullName, file, 0, size);
+}
+
+
+//! releases least recently used files until size more bytes fit into the cache
+void CZipReader::trimCache(u32 size)
+{
+	while (!Cache.empty() && CacheUsed + size > CacheSize)
+	{
+		u32 oldest = 0;
+		for (u32 i=1; i<Cache.size(); ++i)
+		{
+			if (Cache[i].LastUse < Cache[oldest].LastUse)
+				oldest = i;
+		}
+
+		// files given out keep the data alive
+		CacheUsed -= (u32)Cache[oldest].File->getSize();
+		Cache[oldest].File->drop();
+		Cache.erase(oldest);
+	}
+}
+
+
 //! scans for a local header, returns false if there is no more local file header.
 //! The gzip file format seems to think that there can be multiple files in a gzip file
 //! but none
@@ -467,6 +543,26 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
   			#ifdef _IRR_COMPILE_WITH_ZLIB_
 
 			const u32 uncompressedSize = e.header.DataDescriptor.UncompressedSize;
+
+			IReadFile* cached = openCachedFile(index);
+			if (cached)
+				return cached;
+
+			// Large files are inflated while they are read, so neither the
+			// compressed nor the whole uncompressed data has to be in memory.
+			if (uncompressedSize >= ZIP_INFLATE_STREAM_SIZE && uncompressedSize > CacheSize / 4)
+			{
+				CInflateReadFile* stream = new CInflateReadFile(File, e.Offset,
+					decryptedSize, uncompressedSize, Files[index].FullName);
+				if (stream->isOpen())
+					return stream;
+
+				stream->drop();
+				swprintf_irr ( buf, 64, L"Error decompressing %s", core::stringw(Files[index].FullName).c_str() );
+				os::Printer::log( buf, ELL_ERROR);
+				return 0;
+			}
+
 			c8* pBuf = new c8[ uncompressedSize ];
 			if (!pBuf)
 			{
@@ -490,8 +586,7 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 				}
 
 				//memset(pcData, 0, decryptedSize);
-				File->seek(e.Offset);
-				File->read(pcData, decryptedSize);
+				File->readAt(e.Offset, pcData, decryptedSize);
 			}
 
 			// Setup the inflate stream.
@@ -530,7 +625,7 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 				return 0;
 			}
 			else
-				return FileSystem->createMemoryReadFile(pBuf, uncompressedSize, Files[index].FullName, true);
+				return addCachedFile(index, FileSystem->createMemoryReadFile(pBuf, uncompressedSize, Files[index].FullName, true));
 
 			#else
 			return 0; // zlib not compiled, we cannot decompress the data.
@@ -200,6 +200,9 @@ namespace io
 		//! return the id of the file Archive
 		virtual const io::path& getArchiveName() const _IRR_OVERRIDE_ {return Path;}
 
+		//! Set how much decompressed data the archive may keep for opening files again
+		virtual void setDecompressedCacheSize(u32 bytes) _IRR_OVERRIDE_;
+
 	protected:
 
 		//! reads the next file header from a ZIP file, returns false if there are no more headers.
@@ -213,6 +216,15 @@ namespace io
 
 		bool scanCentralDirectoryHeader();
 
+		//! opens a file from the cache of decompressed files, 0 if it is not in there
+		IReadFile* openCachedFile(u32 index);
+
+		//! adds a decompressed file to the cache, returns the file to give out
+		IReadFile* addCachedFile(u32 index, IReadFile* file);
+
+		//! releases least recently used files until size more bytes fit into the cache
+		void trimCache(u32 size);
+
 		io::IFileSystem* FileSystem;
 		IReadFile* File;
 
@@ -220,6 +232,22 @@ namespace io
 		core::array<SZipFileEntry> FileInfo;
 
 		bool IsGZip;
+
+		//! A decompressed file kept in memory
+		struct SCachedFile
+		{
+			//! Memory read file with the data, never given out itself
+			IReadFile* File;
+			//! ID of the entry in the file list
+			u32 ID;
+			//! Value of CacheUseCounter when the file was last opened
+			u32 LastUse;
+		};
+
+		core::array<SCachedFile> Cache;
+		u32 CacheSize;
+		u32 CacheUsed;
+		u32 CacheUseCounter;
 	};
 
 
@@ -26,11 +26,28 @@ namespace irr
 		EPID_SM_RENDER_TRANSPARENT,
 		EPID_SM_RENDER_EFFECT,
 		EPID_SM_REGISTER,
+		EPID_SM_RENDER_GUI_NODES,
+		EPID_SM_REGISTER_NODES,
+		EPID_SM_SORT_NODES,
+		EPID_SM_LOAD_MESH,
 
 		//! octrees
 		EPID_OC_RENDER,
 		EPID_OC_CALCPOLYS,
 
+		//! video driver
+		EPID_VD_LOAD_IMAGE,
+		EPID_VD_LOAD_IMAGES,
+		EPID_VD_CREATE_TEXTURE,
+		EPID_VD_UPLOAD_TEXTURE,
+
+		//! opengl driver
+		EPID_GL_UPDATE_VERTEX_HW_BUF,
+		EPID_GL_UPDATE_INDEX_HW_BUF,
+
+		//! file system
+		EPID_FS_ADD_ARCHIVE,
+
 		//! es2 driver
 		EPID_ES2_END_SCENE,
 		EPID_ES2_BEGIN_SCENE,
@@ -55,6 +55,12 @@ public:
 	{
 		core::array<u16> Indices;
 		s32 MaterialId;
+
+		//! position of the indices in the sorted index list of the mesh
+		u32 Offset;
+
+		//! end of the indices of this node and all its children in the sorted index list
+		u32 SubtreeEnd;
 	};
 
 	struct SIndexData
@@ -90,6 +96,18 @@ public:
 
 		// create tree
 		Root = new OctreeNode(NodeCount, 0, meshes, indexChunks, minimalPolysPerNode);
+
+		// place the indices of each node in front of those of its children,
+		// so every subtree uses one range of the sorted index list
+		core::array<u32> offsets;
+		offsets.set_used(IndexDataCount);
+		for (u32 i=0; i!=IndexDataCount; ++i)
+			offsets[i] = 0;
+		Root->assignOffsets(offsets.pointer());
+
+		Ranges.reallocate(IndexDataCount);
+		for (u32 i=0; i!=IndexDataCount; ++i)
+			Ranges.push_back(core::array<video::SIndexRange>());
 	}
 
 	//! returns all ids of polygons partially or fully enclosed
@@ -112,6 +130,45 @@ public:
 		Root->getPolys(frustum, IndexData, 0);
 	}
 
+	//! collects the ranges of the sorted index list which are partially
+	//! or fully enclosed by this bounding box.
+	/** Instead of copying indices, this only fills getRanges(). The
+	CurrentSize of the index data is set to the number of indices in the
+	ranges. */
+	void calculateRanges(const core::aabbox3d<f32>& box)
+	{
+		for (u32 i=0; i!=IndexDataCount; ++i)
+			Ranges[i].set_used(0);
+
+		Root->getRanges(box, Ranges.pointer());
+		updateRangeSizes();
+	}
+
+	//! collects the ranges of the sorted index list which are partially
+	//! or fully enclosed by a view frustum.
+	void calculateRanges(const scene::SViewFrustum& frustum)
+	{
+		for (u32 i=0; i!=IndexDataCount; ++i)
+			Ranges[i].set_used(0);
+
+		Root->getRanges(frustum, Ranges.pointer());
+		updateRangeSizes();
+	}
+
+	//! returns the ranges of a mesh found by the last calculateRanges call
+	const core::array<video::SIndexRange>& getRanges(u32 mesh) const
+	{
+		return Ranges[mesh];
+	}
+
+	//! returns the indices of a mesh in the order of the tree nodes
+	/** The ranges of calculateRanges refer to this index list. */
+	void getSortedIndices(u32 mesh, core::array<u16>& outIndices) const
+	{
+		outIndices.set_used(IndexData[mesh].MaxSize);
+		Root->getSortedIndices(mesh, outIndices.pointer());
+	}
+
 	const SIndexData* getIndexData() const
 	{
 		return IndexData;
@@ -145,6 +202,17 @@ public:
 	}
 
 private:
+
+	void updateRangeSizes()
+	{
+		for (u32 i=0; i!=IndexDataCount; ++i)
+		{
+			IndexData[i].CurrentSize = 0;
+			for (u32 r=0; r<Ranges[i].size(); ++r)
+				IndexData[i].CurrentSize += Ranges[i][r].Count;
+		}
+	}
+
 	// private inner class
 	class OctreeNode
 	{
@@ -355,6 +423,84 @@ private:
 					Children[i]->getPolys(frustum, idxdata,parentTest);
 		}
 
+		//! sets the offsets of the nodes indices in the sorted index lists
+		void assignOffsets(u32* offsets)
+		{
+			if (!IndexData)
+				return;
+
+			u32 i;
+			for (i=0; i<IndexData->size(); ++i)
+			{
+				(*IndexData)[i].Offset = offsets[i];
+				offsets[i] += (*IndexData)[i].Indices.size();
+			}
+
+			for (i=0; i!=8; ++i)
+				if (Children[i])
+					Children[i]->assignOffsets(offsets);
+
+			for (i=0; i<IndexData->size(); ++i)
+				(*IndexData)[i].SubtreeEnd = offsets[i];
+		}
+
+		//! copies the indices of a mesh to their place in the sorted index list
+		void getSortedIndices(u32 mesh, u16* outIndices) const
+		{
+			if (!IndexData)
+				return;
+
+			const SIndexChunk& chunk = (*IndexData)[mesh];
+			if (!chunk.Indices.empty())
+				memcpy(outIndices + chunk.Offset, chunk.Indices.const_pointer(), chunk.Indices.size() * sizeof(u16));
+
+			for (u32 i=0; i!=8; ++i)
+				if (Children[i])
+					Children[i]->getSortedIndices(mesh, outIndices);
+		}
+
+		// collects the ranges of polygons partially or full enclosed
+		// by this bounding box.
+		void getRanges(const core::aabbox3d<f32>& box, core::array<video::SIndexRange>* ranges) const
+		{
+			if (!IndexData || !Box.intersectsWithBox(box))
+				return;
+
+			// the children of a node which is fully inside are in the same range
+			const bool fullInside = Box.isFullInside(box);
+			addRanges(ranges, fullInside);
+
+			if (!fullInside)
+				for (u32 i=0; i!=8; ++i)
+					if (Children[i])
+						Children[i]->getRanges(box, ranges);
+		}
+
+		// collects the ranges of polygons partially or full enclosed
+		// by the view frustum.
+		void getRanges(const scene::SViewFrustum& frustum, core::array<video::SIndexRange>* ranges) const
+		{
+			if (!IndexData)
+				return;
+
+			bool fullInside = true;
+			for (u32 i=0; i!=scene::SViewFrustum::VF_PLANE_COUNT; ++i)
+			{
+				core::EIntersectionRelation3D r = Box.classifyPlaneRelation(frustum.planes[i]);
+				if ( r == core::ISREL3D_FRONT )
+					return;
+				if ( r == core::ISREL3D_CLIPPED )
+					fullInside = false;
+			}
+
+			addRanges(ranges, fullInside);
+
+			if (!fullInside)
+				for (u32 i=0; i!=8; ++i)
+					if (Children[i])
+						Children[i]->getRanges(frustum, ranges);
+		}
+
 		//! for debug purposes only, collects the bounding boxes of the node
 		void getBoundingBoxes(const core::aabbox3d<f32>& box,
 			core::array< const core::aabbox3d<f32>* >&outBoxes) const
@@ -371,6 +517,32 @@ private:
 
 	private:
 
+		//! adds the range of this node, or of the whole subtree, to each mesh
+		void addRanges(core::array<video::SIndexRange>* ranges, bool subtree) const
+		{
+			for (u32 i=0; i<IndexData->size(); ++i)
+			{
+				const SIndexChunk& chunk = (*IndexData)[i];
+				const u32 count = subtree ? chunk.SubtreeEnd - chunk.Offset : chunk.Indices.size();
+				if (!count)
+					continue;
+
+				// ranges of neighbouring nodes are merged
+				if (!ranges[i].empty() &&
+					ranges[i].getLast().Start + ranges[i].getLast().Count == chunk.Offset)
+				{
+					ranges[i].getLast().Count += count;
+				}
+				else
+				{
+					video::SIndexRange range;
+					range.Start = chunk.Offset;
+					range.Count = count;
+					ranges[i].push_back(range);
+				}
+			}
+		}
+
 		core::aabbox3df Box;
 		core::array<SIndexChunk>* IndexData;
 		OctreeNode* Children[8];
@@ -381,6 +553,7 @@ private:
 	SIndexData* IndexData;
 	u32 IndexDataCount;
 	u32 NodeCount;
+	core::array<core::array<video::SIndexRange> > Ranges;
 };
 
 } // end namespace
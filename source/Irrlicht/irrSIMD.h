@@ -0,0 +1,87 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __IRR_SIMD_H_INCLUDED__
+#define __IRR_SIMD_H_INCLUDED__
+
+#include "IrrCompileConfig.h"
+#include "irrTypes.h"
+
+// Instruction sets for the SIMD code paths inside the engine:
+// _IRR_SIMD_X86_ when SSE2, SSSE3 and AVX2 code can be compiled, it has to be selected with getX86Features()
+// _IRR_SIMD_NEON_ when the compiler targets NEON, it's always available then
+#ifdef _IRR_COMPILE_WITH_SIMD_
+	#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+		#define _IRR_SIMD_X86_
+		#include <immintrin.h>
+		#ifdef _MSC_VER
+			#include <intrin.h>
+		#endif
+	#elif (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)) && !defined(__ARM_BIG_ENDIAN)
+		#define _IRR_SIMD_NEON_
+		#include <arm_neon.h>
+	#endif
+#endif
+
+#ifdef _IRR_SIMD_X86_
+	// Lets single functions use instructions the rest of the engine isn't compiled for
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#define _IRR_SIMD_TARGET_(instructions)
+	#else
+		#define _IRR_SIMD_TARGET_(instructions) __attribute__((target(instructions)))
+	#endif
+#endif
+
+namespace irr
+{
+namespace os
+{
+#ifdef _IRR_SIMD_X86_
+	//! x86 instruction sets used by the SIMD code paths
+	enum E_X86_FEATURE
+	{
+		EXF_SSE2 = 1,
+		EXF_SSSE3 = 2,
+		EXF_AVX2 = 4
+	};
+
+	//! Returns the E_X86_FEATUREs of the cpu, AVX2 only if the os also saves the registers
+	inline u32 getX86Features()
+	{
+		u32 features = 0;
+
+	#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		const int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		if (info[3] & (1 << 26))
+			features |= EXF_SSE2;
+		if (info[2] & (1 << 9))
+			features |= EXF_SSSE3;
+
+		// osxsave and avx, then xgetbv tells if the os saves xmm and ymm registers
+		if ((info[2] & (1 << 27)) && (info[2] & (1 << 28)) && maxLeaf >= 7 && (_xgetbv(0) & 6) == 6)
+		{
+			__cpuidex(info, 7, 0);
+			if (info[1] & (1 << 5))
+				features |= EXF_AVX2;
+		}
+	#else
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("sse2"))
+			features |= EXF_SSE2;
+		if (__builtin_cpu_supports("ssse3"))
+			features |= EXF_SSSE3;
+		if (__builtin_cpu_supports("avx2"))
+			features |= EXF_AVX2;
+	#endif
+
+		return features;
+	}
+#endif
+} // end namespace os
+} // end namespace irr
+
+#endif // __IRR_SIMD_H_INCLUDED__
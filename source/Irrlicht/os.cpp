@@ -106,7 +106,7 @@ extern std::ostream infostream;
 		initVirtualTimer();
 	}
 
-	u32 Timer::getRealTime()
+	u64 Timer::getRealTimeNs()
 	{
 		if (HighPerformanceTimerSupport)
 		{
@@ -126,11 +126,15 @@ extern std::ostream infostream;
 				(void)SetThreadAffinityMask(GetCurrentThread(), affinityMask);
 #endif
 			if(queriedOK)
-				return u32((nTime.QuadPart) * 1000 / HighPerformanceFreq.QuadPart);
-
+			{
+				// split to avoid overflowing the multiplication
+				const u64 freq = HighPerformanceFreq.QuadPart;
+				const u64 count = nTime.QuadPart;
+				return (count / freq) * 1000000000 + (count % freq) * 1000000000 / freq;
+			}
 		}
 
-		return GetTickCount();
+		return (u64)GetTickCount() * 1000000;
 	}
 
 } // end namespace os
@@ -143,6 +147,7 @@ extern std::ostream infostream;
 // ----------------------------------------------------------------
 
 #include <android/log.h>
+#include <time.h>
 
 namespace irr
 {
@@ -191,11 +196,11 @@ namespace os
 		initVirtualTimer();
 	}
 
-	u32 Timer::getRealTime()
+	u64 Timer::getRealTimeNs()
 	{
-		timeval tv;
-		gettimeofday(&tv, 0);
-		return (u32)(tv.tv_sec * 1000) + (tv.tv_usec / 1000);
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (u64)ts.tv_sec * 1000000000 + ts.tv_nsec;
 	}
 } // end namespace os
 
@@ -244,10 +249,10 @@ namespace os
 		initVirtualTimer();
 	}
 
-	u32 Timer::getRealTime()
+	u64 Timer::getRealTimeNs()
 	{
-        double time = emscripten_get_now();
-        return (u32)(time);
+		double time = emscripten_get_now();
+		return (u64)(time * 1000000.0);
 	}
 } // end namespace os
 
@@ -277,11 +282,17 @@ namespace os
 		initVirtualTimer();
 	}
 
-	u32 Timer::getRealTime()
+	u64 Timer::getRealTimeNs()
 	{
+#if defined(CLOCK_MONOTONIC)
+		// not affected by changes of the system time
+		timespec ts;
+		if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+			return (u64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
 		timeval tv;
 		gettimeofday(&tv, 0);
-		return (u32)(tv.tv_sec * 1000) + (tv.tv_usec / 1000);
+		return (u64)tv.tv_sec * 1000000000 + (u64)tv.tv_usec * 1000;
 	}
 } // end namespace os
 
@@ -292,30 +303,69 @@ namespace os
 	// The platform independent implementation of the printer
 	ILogger* Printer::Logger = 0;
 
+	namespace
+	{
+		// messages of the calling thread are kept here instead of being logged
+		thread_local core::array<Printer::SMessage>* ThreadMessages = 0;
+
+		void keepMessage(const core::stringc& text, const c8* hint, ELOG_LEVEL ll)
+		{
+			Printer::SMessage message;
+			message.Text = text;
+			message.Hint = hint;
+			message.Level = ll;
+			ThreadMessages->push_back(message);
+		}
+	}
+
 	void Printer::log(const c8* message, ELOG_LEVEL ll)
 	{
-		if (Logger)
+		if (ThreadMessages)
+			keepMessage(message, "", ll);
+		else if (Logger)
 			Logger->log(message, ll);
 	}
 
 	void Printer::log(const wchar_t* message, ELOG_LEVEL ll)
 	{
-		if (Logger)
+		if (ThreadMessages)
+			keepMessage(core::stringc(message), "", ll);
+		else if (Logger)
 			Logger->log(message, ll);
 	}
 
 	void Printer::log(const c8* message, const c8* hint, ELOG_LEVEL ll)
 	{
-		if (Logger)
+		if (ThreadMessages)
+			keepMessage(message, hint, ll);
+		else if (Logger)
 			Logger->log(message, hint, ll);
 	}
 
 	void Printer::log(const c8* message, const io::path& hint, ELOG_LEVEL ll)
 	{
-		if (Logger)
+		if (ThreadMessages)
+			keepMessage(message, hint.c_str(), ll);
+		else if (Logger)
 			Logger->log(message, hint.c_str(), ll);
 	}
 
+	void Printer::setThreadMessages(core::array<SMessage>* messages)
+	{
+		ThreadMessages = messages;
+	}
+
+	void Printer::logMessages(const core::array<SMessage>& messages)
+	{
+		for (u32 i=0; i<messages.size(); ++i)
+		{
+			if (messages[i].Hint.empty())
+				log(messages[i].Text.c_str(), messages[i].Level);
+			else
+				log(messages[i].Text.c_str(), messages[i].Hint.c_str(), messages[i].Level);
+		}
+	}
+
 	// our Randomizer is not really os specific, so we
 	// code one for all, which should work on every platform the same,
 	// which is desirable.
@@ -361,9 +411,22 @@ namespace os
 
 	f32 Timer::VirtualTimerSpeed = 1.0f;
 	s32 Timer::VirtualTimerStopCounter = 0;
-	u32 Timer::LastVirtualTime = 0;
-	u32 Timer::StartRealTime = 0;
-	u32 Timer::StaticTime = 0;
+	u64 Timer::LastVirtualTime = 0;
+	u64 Timer::StartRealTime = 0;
+	u64 Timer::StaticTime = 0;
+	f32 Timer::DeltaTime = 0.f;
+
+	//! returns current real time in milliseconds
+	u32 Timer::getRealTime()
+	{
+		return (u32)(getRealTimeNs() / 1000000);
+	}
+
+	//! returns current real time in microseconds
+	u64 Timer::getRealTimeUs()
+	{
+		return getRealTimeNs() / 1000;
+	}
 
 	//! Get real time and date in calendar form
 	ITimer::RealTimeDate Timer::getRealTimeAndDate()
@@ -396,24 +459,39 @@ namespace os
 
 	//! returns current virtual time
 	u32 Timer::getTime()
+	{
+		return (u32)(getTimeUs() / 1000);
+	}
+
+	//! returns current virtual time in microseconds
+	u64 Timer::getTimeUs()
 	{
 		if (isStopped())
 			return LastVirtualTime;
 
-		return LastVirtualTime + (u32)((StaticTime - StartRealTime) * VirtualTimerSpeed);
+		return LastVirtualTime + (u64)((f64)(StaticTime - StartRealTime) * VirtualTimerSpeed);
+	}
+
+	//! returns the virtual time passed with the last tick in seconds
+	f32 Timer::getDeltaTime()
+	{
+		return DeltaTime;
 	}
 
 	//! ticks, advances the virtual timer
 	void Timer::tick()
 	{
-		StaticTime = getRealTime();
+		const u64 lastTime = getTimeUs();
+		StaticTime = getRealTimeUs();
+		const u64 now = getTimeUs();
+		DeltaTime = now > lastTime ? (f32)((now - lastTime) * 0.000001) : 0.f;
 	}
 
 	//! sets the current virtual time
 	void Timer::setTime(u32 time)
 	{
-		StaticTime = getRealTime();
-		LastVirtualTime = time;
+		StaticTime = getRealTimeUs();
+		LastVirtualTime = (u64)time * 1000;
 		StartRealTime = StaticTime;
 	}
 
@@ -423,7 +501,7 @@ namespace os
 		if (!isStopped())
 		{
 			// stop the virtual timer
-			LastVirtualTime = getTime();
+			LastVirtualTime = getTimeUs();
 		}
 
 		--VirtualTimerStopCounter;
@@ -437,14 +515,17 @@ namespace os
 		if (!isStopped())
 		{
 			// restart virtual timer
-			setTime(LastVirtualTime);
+			StaticTime = getRealTimeUs();
+			StartRealTime = StaticTime;
 		}
 	}
 
 	//! sets the speed of the virtual timer
 	void Timer::setSpeed(f32 speed)
 	{
-		setTime(getTime());
+		LastVirtualTime = getTimeUs();
+		StaticTime = getRealTimeUs();
+		StartRealTime = StaticTime;
 
 		VirtualTimerSpeed = speed;
 		if (VirtualTimerSpeed < 0.0f)
@@ -465,7 +546,7 @@ namespace os
 
 	void Timer::initVirtualTimer()
 	{
-		StaticTime = getRealTime();
+		StaticTime = getRealTimeUs();
 		StartRealTime = StaticTime;
 	}
 
@@ -9,6 +9,7 @@
 #include "IrrCompileConfig.h" // for endian check
 #include "irrTypes.h"
 #include "irrString.h"
+#include "irrArray.h"
 #include "path.h"
 #include "ILogger.h"
 #include "ITimer.h"
@@ -43,6 +44,20 @@ namespace os
 		static void log(const c8* message, const c8* hint, ELOG_LEVEL ll = ELL_INFORMATION);
 		static void log(const c8* message, const io::path& hint, ELOG_LEVEL ll = ELL_INFORMATION);
 		static ILogger* Logger;
+
+		//! message kept by a thread which must not log
+		struct SMessage
+		{
+			core::stringc Text;
+			core::stringc Hint;
+			ELOG_LEVEL Level;
+		};
+
+		// The logger and its event receiver are not thread safe. Worker threads
+		// keep their messages in an array until the thread owning them logs them.
+		// 0 logs the messages of the calling thread again.
+		static void setThreadMessages(core::array<SMessage>* messages);
+		static void logMessages(const core::array<SMessage>& messages);
 	};
 
 
@@ -86,6 +101,12 @@ namespace os
 		//! returns the current time in milliseconds
 		static u32 getTime();
 
+		//! returns the current virtual time in microseconds
+		static u64 getTimeUs();
+
+		//! returns the virtual time passed with the last tick in seconds
+		static f32 getDeltaTime();
+
 		//! get current time and date in calendar form
 		static ITimer::RealTimeDate getRealTimeAndDate();
 
@@ -116,15 +137,23 @@ namespace os
 		//! returns the current real time in milliseconds
 		static u32 getRealTime();
 
+		//! returns the current monotonic real time in microseconds
+		static u64 getRealTimeUs();
+
+		//! returns the current monotonic real time in nanoseconds
+		static u64 getRealTimeNs();
+
 	private:
 
 		static void initVirtualTimer();
 
 		static f32 VirtualTimerSpeed;
 		static s32 VirtualTimerStopCounter;
-		static u32 StartRealTime;
-		static u32 LastVirtualTime;
-		static u32 StaticTime;
+		// all in microseconds
+		static u64 StartRealTime;
+		static u64 LastVirtualTime;
+		static u64 StaticTime;
+		static f32 DeltaTime;
 	};
 
 } // end namespace os